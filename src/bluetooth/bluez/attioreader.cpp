@@ -0,0 +1,151 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "attioreader_p.h"
+#include "bluez_data_p.h"
+
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QThread>
+#include <QtCore/private/qcore_unix_p.h>
+
+#include <sys/socket.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_BT_BLUEZ)
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+class AttIoThread : public QThread
+{
+public:
+    AttIoThread()
+    {
+        setObjectName(u"QtBluetoothAttIo"_s);
+        start();
+    }
+
+    ~AttIoThread() override
+    {
+        quit();
+        wait();
+    }
+};
+
+// Large enough for any ATT PDU, the negotiated MTU is capped at 512 bytes
+constexpr qsizetype MaxPduSize = 1024;
+
+// Bounds the work done per wake-up so that a single chatty peer cannot
+// starve the other connections sharing the I/O thread
+constexpr int MaxPacketsPerActivation = 64;
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(AttIoThread, attIoThread)
+
+/*!
+    Starts reading from \a socket on the shared I/O thread. The reader works
+    on a duplicate of \a socket, the caller keeps ownership of the original
+    descriptor. Returns \c nullptr if the descriptor could not be duplicated.
+ */
+AttIoReader *AttIoReader::start(int socket)
+{
+    const int ioSocket = qt_safe_dup(socket);
+    if (ioSocket == -1) {
+        qCWarning(QT_BT_BLUEZ) << "Cannot duplicate ATT socket:" << qt_error_string(errno);
+        return nullptr;
+    }
+
+    AttIoReader *reader = new AttIoReader(ioSocket);
+    reader->moveToThread(attIoThread());
+    QMetaObject::invokeMethod(reader, &AttIoReader::enable, Qt::QueuedConnection);
+    return reader;
+}
+
+/*!
+    Stops reading and schedules the deletion of the reader. Once this function
+    returns no further signals are emitted, although signals emitted earlier
+    may still be pending in the receiver's event queue.
+ */
+void AttIoReader::stop()
+{
+    if (thread() == QThread::currentThread() || !thread()->isRunning())
+        disable();
+    else
+        QMetaObject::invokeMethod(this, &AttIoReader::disable, Qt::BlockingQueuedConnection);
+    deleteLater();
+}
+
+AttIoReader::AttIoReader(int socket)
+    : m_socket(socket)
+{
+}
+
+AttIoReader::~AttIoReader()
+{
+    disable();
+}
+
+void AttIoReader::enable()
+{
+    if (m_socket == -1 || m_notifier)
+        return;
+
+    m_notifier = new QSocketNotifier(m_socket, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &AttIoReader::readPackets);
+}
+
+void AttIoReader::disable()
+{
+    delete m_notifier;
+    m_notifier = nullptr;
+
+    if (m_socket != -1) {
+        qt_safe_close(m_socket);
+        m_socket = -1;
+    }
+}
+
+void AttIoReader::readPackets()
+{
+    char buffer[MaxPduSize];
+
+    for (int i = 0; i < MaxPacketsPerActivation; ++i) {
+        ssize_t size;
+        EINTR_LOOP(size, ::recv(m_socket, buffer, sizeof buffer, MSG_DONTWAIT));
+        if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+
+        if (size <= 0) {
+            const int error = size < 0 ? errno : 0;
+            qCDebug(QT_BT_BLUEZ) << "ATT socket closed:"
+                                 << (error ? qt_error_string(error) : u"end of stream"_s);
+            disable();
+            emit socketClosed(error);
+            return;
+        }
+
+        bool confirmed = false;
+        if (static_cast<QBluezConst::AttCommand>(buffer[0])
+                == QBluezConst::AttCommand::ATT_OP_HANDLE_VAL_INDICATION) {
+            const char confirmation =
+                    static_cast<char>(QBluezConst::AttCommand::ATT_OP_HANDLE_VAL_CONFIRMATION);
+            ssize_t sent;
+            EINTR_LOOP(sent, ::send(m_socket, &confirmation, 1, MSG_NOSIGNAL | MSG_DONTWAIT));
+            confirmed = (sent == 1);
+            if (!confirmed) {
+                qCWarning(QT_BT_BLUEZ) << "Cannot confirm indication on I/O thread:"
+                                       << qt_error_string(errno);
+            }
+        }
+
+        emit packetReceived(QByteArray(buffer, size), confirmed);
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_attioreader_p.cpp"
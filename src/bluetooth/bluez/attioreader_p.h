@@ -0,0 +1,55 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef ATTIOREADER_P_H
+#define ATTIOREADER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifier;
+
+// Reads ATT PDUs from an L2CAP socket on a shared I/O thread. Indications are
+// confirmed right away so that the remote device is not stalled by a busy
+// thread owning the QLowEnergyController. Every PDU is handed to the owner via
+// the queued packetReceived() signal.
+class Q_AUTOTEST_EXPORT AttIoReader : public QObject
+{
+    Q_OBJECT
+public:
+    static AttIoReader *start(int socket);
+    void stop();
+
+signals:
+    void packetReceived(const QByteArray &packet, bool indicationConfirmed);
+    void socketClosed(int error);
+
+private:
+    explicit AttIoReader(int socket);
+    ~AttIoReader() override;
+
+    void enable();
+    void disable();
+    void readPackets();
+
+    int m_socket = -1;
+    QSocketNotifier *m_notifier = nullptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // ATTIOREADER_P_H
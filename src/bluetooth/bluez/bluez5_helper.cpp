@@ -8,6 +8,7 @@
 #include <QtNetwork/private/qnet_unix_p.h>
 #include "bluez5_helper_p.h"
 #include "bluez_data_p.h"
+#include "bluezobjecttree_p.h"
 #include "objectmanager_p.h"
 #include "properties_p.h"
 #include "adapter1_bluez5_p.h"
@@ -39,17 +40,13 @@ Q_GLOBAL_STATIC_WITH_ARGS(QVersionNumber, bluezDaemonVersion, (QVersionNumber())
 void initializeBluez5()
 {
     if (*bluezVersion() == BluezVersionUnknown) {
-        OrgFreedesktopDBusObjectManagerInterface manager(QStringLiteral("org.bluez"),
-                                                         QStringLiteral("/"),
-                                                         QDBusConnection::systemBus());
         qDBusRegisterMetaType<InterfaceList>();
         qDBusRegisterMetaType<ManagedObjectList>();
         qDBusRegisterMetaType<ManufacturerDataList>();
         qDBusRegisterMetaType<ServiceDataList>();
 
-        QDBusPendingReply<ManagedObjectList> reply = manager.GetManagedObjects();
-        reply.waitForFinished();
-        if (reply.isError()) {
+        // Fetching the object tree doubles as the check for a running bluetoothd
+        if (!QtBluezObjectTree::instance()->ensureLoaded()) {
             *bluezVersion() = BluezNotAvailable;
             qWarning() << "Cannot find a compatible running Bluez. "
                           "Please check the Bluez installation. "
@@ -343,7 +340,15 @@ bool QtBluezDiscoveryManager::registerDiscoveryInterest(const QString &adapterPa
 
     OrgBluezAdapter1Interface iface(QStringLiteral("org.bluez"), adapterPath,
                                     QDBusConnection::systemBus());
-    data->wasListeningAlready = iface.discovering();
+    // the cached tree avoids a blocking property read
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    if (objectTree->isLoaded()) {
+        data->wasListeningAlready =
+                objectTree->properties(adapterPath, QStringLiteral("org.bluez.Adapter1"))
+                        .value(QStringLiteral("Discovering")).toBool();
+    } else {
+        data->wasListeningAlready = iface.discovering();
+    }
 
     d->references[adapterPath] = data;
 
@@ -460,13 +465,8 @@ void QtBluezDiscoveryManager::removeAdapterFromMonitoring(const QString &dbusPat
  */
 QString findAdapterForAddress(const QBluetoothAddress &wantedAddress, bool *ok = nullptr)
 {
-    OrgFreedesktopDBusObjectManagerInterface manager(QStringLiteral("org.bluez"),
-                                                     QStringLiteral("/"),
-                                                     QDBusConnection::systemBus());
-
-    QDBusPendingReply<ManagedObjectList> reply = manager.GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError()) {
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    if (!objectTree->ensureLoaded()) {
         if (ok)
             *ok = false;
 
@@ -481,25 +481,17 @@ QString findAdapterForAddress(const QBluetoothAddress &wantedAddress, bool *ok =
     };
     QList<AdapterInfo> localAdapters;
 
-    ManagedObjectList managedObjectList = reply.value();
-    for (ManagedObjectList::const_iterator it = managedObjectList.constBegin(); it != managedObjectList.constEnd(); ++it) {
-        const QDBusObjectPath &path = it.key();
-        const InterfaceList &ifaceList = it.value();
-
-        for (InterfaceList::const_iterator jt = ifaceList.constBegin(); jt != ifaceList.constEnd(); ++jt) {
-            const QString &iface = jt.key();
-
-            if (iface == QStringLiteral("org.bluez.Adapter1")) {
-                AdapterInfo info;
-                info.path = path.path();
-                info.address = QBluetoothAddress(ifaceList.value(iface).value(
-                                                    QStringLiteral("Address")).toString());
-                info.powered = ifaceList.value(iface).value(QStringLiteral("Powered")).toBool();
-                if (!info.address.isNull())
-                    localAdapters.append(info);
-                break;
-            }
-        }
+    const QStringList adapterPaths = objectTree->adapterPaths();
+    for (const QString &path : adapterPaths) {
+        const QVariantMap properties =
+                objectTree->properties(path, QStringLiteral("org.bluez.Adapter1"));
+
+        AdapterInfo info;
+        info.path = path;
+        info.address = QBluetoothAddress(properties.value(QStringLiteral("Address")).toString());
+        info.powered = properties.value(QStringLiteral("Powered")).toBool();
+        if (!info.address.isNull())
+            localAdapters.append(info);
     }
 
     if (ok)
@@ -548,19 +540,10 @@ QString adapterWithDBusPeripheralInterface(const QBluetoothAddress &localAddress
         return {};
 
     // Then check if that adapter provides peripheral dbus interface
-    OrgFreedesktopDBusObjectManagerInterface manager(QStringLiteral("org.bluez"),
-                                                     QStringLiteral("/"),
-                                                     QDBusConnection::systemBus());
-    QDBusPendingReply<ManagedObjectList> reply = manager.GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError())
-        return {};
-
     using namespace Qt::StringLiterals;
     // For example /org/bluez/hci0 contains org.bluezLEAdvertisingManager1
-    const bool peripheralSupported = reply.value()
-                   .value(QDBusObjectPath(hostAdapterPath))
-                   .contains("org.bluez.LEAdvertisingManager1"_L1);
+    const bool peripheralSupported = QtBluezObjectTree::instance()->hasInterface(
+            hostAdapterPath, "org.bluez.LEAdvertisingManager1"_L1);
 
     qCDebug(QT_BT_BLUEZ) << "Peripheral role"
                          << (peripheralSupported ? "" : "not")
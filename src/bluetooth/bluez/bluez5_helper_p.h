@@ -19,8 +19,11 @@
 #include <QtDBus/QtDBus>
 #include <QtBluetooth/QBluetoothUuid>
 #include <QtBluetooth/QBluetoothAddress>
+#include <QtBluetooth/private/qbluetoothaddress_p.h>
 #include <QtBluetooth/private/qtbluetoothglobal_p.h>
 
+#include <algorithm>
+
 typedef QMap<QString, QVariantMap> InterfaceList;
 typedef QMap<QDBusObjectPath, InterfaceList> ManagedObjectList;
 typedef QMap<quint16, QDBusVariant> ManufacturerDataList;
@@ -45,6 +48,29 @@ QString findAdapterForAddress(const QBluetoothAddress &wantedAddress, bool *ok);
 
 QString adapterWithDBusPeripheralInterface(const QBluetoothAddress &localAddress);
 
+// BlueZ names device objects <adapter path>/dev_XX_XX_XX_XX_XX_XX
+inline QBluetoothAddress addressFromDevicePath(QStringView devicePath) noexcept
+{
+    constexpr QStringView prefix = u"/dev_";
+    const qsizetype nameLength = prefix.size() + QtBluetoothPrivate::AddressStringLength;
+    if (devicePath.size() < nameLength || !devicePath.last(nameLength).startsWith(prefix))
+        return QBluetoothAddress();
+    return QtBluetoothPrivate::addressFromString(
+            devicePath.last(QtBluetoothPrivate::AddressStringLength), '_');
+}
+
+inline QString devicePathForAddress(QStringView adapterPath, const QBluetoothAddress &address)
+{
+    constexpr QStringView prefix = u"/dev_";
+    QString path(adapterPath.size() + prefix.size() + QtBluetoothPrivate::AddressStringLength,
+                 Qt::Uninitialized);
+    char16_t *out = reinterpret_cast<char16_t *>(path.data());
+    out = std::copy(adapterPath.utf16(), adapterPath.utf16() + adapterPath.size(), out);
+    out = std::copy(prefix.utf16(), prefix.utf16() + prefix.size(), out);
+    QtBluetoothPrivate::toAddressString(address, out, '_');
+    return path;
+}
+
 class QtBluezDiscoveryManagerPrivate;
 class QtBluezDiscoveryManager : public QObject
 {
@@ -0,0 +1,412 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "bluezobjecttree_p.h"
+#include "objectmanager_p.h"
+#include "properties_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QGlobalStatic>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QThread>
+#include <QtDBus/QDBusPendingCallWatcher>
+#include <QtDBus/QDBusReply>
+#include <QtDBus/QDBusServiceWatcher>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_BT_BLUEZ)
+
+using namespace Qt::StringLiterals;
+
+static constexpr auto bluezService = "org.bluez"_L1;
+static constexpr auto adapterInterface = "org.bluez.Adapter1"_L1;
+static constexpr auto deviceInterface = "org.bluez.Device1"_L1;
+static constexpr auto objectManagerInterface = "org.freedesktop.DBus.ObjectManager"_L1;
+
+Q_GLOBAL_STATIC(QtBluezObjectTree, objectTree)
+
+static QString parentPath(const QString &path)
+{
+    const qsizetype index = path.lastIndexOf(u'/');
+    return index > 0 ? path.left(index) : QString();
+}
+
+static void insertSorted(QStringList &list, const QString &value)
+{
+    // Paths are mostly added in order, check the end first
+    if (list.isEmpty() || list.constLast() < value) {
+        list.append(value);
+        return;
+    }
+    const auto it = std::lower_bound(list.begin(), list.end(), value);
+    if (it == list.end() || *it != value)
+        list.insert(it, value);
+}
+
+static void removeSorted(QStringList &list, const QString &value)
+{
+    const auto it = std::lower_bound(list.begin(), list.end(), value);
+    if (it != list.end() && *it == value)
+        list.erase(it);
+}
+
+QtBluezObjectTree::QtBluezObjectTree(QObject *parent) : QObject(parent)
+{
+    qDBusRegisterMetaType<InterfaceList>();
+    qDBusRegisterMetaType<ManagedObjectList>();
+
+    // The instance may be created by any thread, the D-Bus signals are
+    // received by the application thread which outlives all others
+    if (QCoreApplication *app = QCoreApplication::instance())
+        moveToThread(app->thread());
+}
+
+QtBluezObjectTree::~QtBluezObjectTree() = default;
+
+QtBluezObjectTree *QtBluezObjectTree::instance()
+{
+    return objectTree();
+}
+
+void QtBluezObjectTree::connectToBluez()
+{
+    if (m_manager)
+        return;
+
+    const QDBusConnection bus = QDBusConnection::systemBus();
+
+    m_manager = new OrgFreedesktopDBusObjectManagerInterface(bluezService, u"/"_s, bus, this);
+    connect(m_manager, &OrgFreedesktopDBusObjectManagerInterface::InterfacesAdded, this,
+            [this](const QDBusObjectPath &objectPath, const InterfaceList &interfaces) {
+        addInterfaces(objectPath.path(), interfaces);
+    });
+    connect(m_manager, &OrgFreedesktopDBusObjectManagerInterface::InterfacesRemoved, this,
+            [this](const QDBusObjectPath &objectPath, const QStringList &interfaces) {
+        removeInterfaces(objectPath.path(), interfaces);
+    });
+
+    // An empty path receives the signals of all objects
+    m_propertiesMonitor = new OrgFreedesktopDBusPropertiesInterfaceBluetooth(bluezService,
+                                                                             QString(), bus, this);
+    connect(m_propertiesMonitor, &OrgFreedesktopDBusPropertiesInterfaceBluetooth::PropertiesChanged,
+            this, [this](const QString &interface, const QVariantMap &changedProperties,
+                         const QStringList &invalidatedProperties, const QDBusMessage &signal) {
+        changeProperties(signal.path(), interface, changedProperties, invalidatedProperties);
+    });
+
+    m_serviceWatcher = new QDBusServiceWatcher(bluezService, bus,
+                                               QDBusServiceWatcher::WatchForUnregistration, this);
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, [this]() {
+        qCDebug(QT_BT_BLUEZ) << "bluetoothd left the bus, dropping the object tree";
+        clear();
+    });
+}
+
+bool QtBluezObjectTree::ensureLoaded()
+{
+    if (isLoaded())
+        return true;
+    if (thread() != QThread::currentThread())
+        return loadFromOtherThread();
+
+    load();
+    if (m_loadWatcher)
+        m_loadWatcher->waitForFinished();
+    // waitForFinished() does not deliver the finished() signal
+    if (m_loadWatcher)
+        loadReplyReceived(m_loadWatcher);
+    return m_loaded;
+}
+
+void QtBluezObjectTree::load()
+{
+    if (thread() != QThread::currentThread()) {
+        // The D-Bus objects of the tree belong to its thread. The caller has
+        // seen the tree unloaded, so it is told even if another caller has
+        // loaded it in the meantime.
+        QMetaObject::invokeMethod(this, [this]() {
+            if (isLoaded())
+                emit loadFinished(true);
+            else
+                load();
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    if (isLoaded() || m_loadWatcher)
+        return;
+
+    // Connect to the signals first to not miss changes made while fetching
+    connectToBluez();
+    startLoading();
+}
+
+void QtBluezObjectTree::startLoading()
+{
+    m_loadWatcher = new QDBusPendingCallWatcher(m_manager->GetManagedObjects(), this);
+    connect(m_loadWatcher, &QDBusPendingCallWatcher::finished,
+            this, &QtBluezObjectTree::loadReplyReceived);
+}
+
+/*
+    The D-Bus objects of the tree belong to its thread, and waiting for it
+    could deadlock. Fetch the objects with a blocking call in the current
+    thread instead, and let the tree thread connect to the signals and fetch
+    the objects again, so that the changes made in between are not missed.
+*/
+bool QtBluezObjectTree::loadFromOtherThread()
+{
+    const QDBusMessage call = QDBusMessage::createMethodCall(bluezService, u"/"_s,
+                                                             objectManagerInterface,
+                                                             u"GetManagedObjects"_s);
+    const QDBusReply<ManagedObjectList> reply = QDBusConnection::systemBus().call(call);
+    if (!reply.isValid()) {
+        qCDebug(QT_BT_BLUEZ) << "Cannot fetch the BlueZ object tree:" << reply.error().message();
+        return false;
+    }
+    setObjects(reply.value());
+
+    QMetaObject::invokeMethod(this, [this]() {
+        if (m_manager || m_loadWatcher)
+            return;
+        connectToBluez();
+        startLoading();
+    }, Qt::QueuedConnection);
+    return true;
+}
+
+void QtBluezObjectTree::loadReplyReceived(QDBusPendingCallWatcher *watcher)
+{
+    if (watcher != m_loadWatcher)
+        return;
+    m_loadWatcher = nullptr;
+    watcher->deleteLater();
+
+    const QDBusPendingReply<ManagedObjectList> reply = *watcher;
+    if (reply.isError()) {
+        qCDebug(QT_BT_BLUEZ) << "Cannot fetch the BlueZ object tree:" << reply.error().message();
+        emit loadFinished(false);
+        return;
+    }
+
+    const ManagedObjectList objects = reply.value();
+    setObjects(objects);
+    qCDebug(QT_BT_BLUEZ) << "Fetched BlueZ object tree with" << objects.size() << "objects";
+    emit loadFinished(true);
+}
+
+bool QtBluezObjectTree::isLoaded() const
+{
+    QReadLocker locker(&m_lock);
+    return m_loaded;
+}
+
+bool QtBluezObjectTree::contains(const QString &path) const
+{
+    QReadLocker locker(&m_lock);
+    return m_objects.contains(path);
+}
+
+InterfaceList QtBluezObjectTree::interfaces(const QString &path) const
+{
+    QReadLocker locker(&m_lock);
+    return m_objects.value(path);
+}
+
+QVariantMap QtBluezObjectTree::properties(const QString &path, const QString &interface) const
+{
+    QReadLocker locker(&m_lock);
+    const auto it = m_objects.constFind(path);
+    if (it == m_objects.cend())
+        return {};
+    return it->value(interface);
+}
+
+bool QtBluezObjectTree::hasInterface(const QString &path, const QString &interface) const
+{
+    QReadLocker locker(&m_lock);
+    const auto it = m_objects.constFind(path);
+    return it != m_objects.cend() && it->contains(interface);
+}
+
+QString QtBluezObjectTree::devicePath(const QString &adapterPath,
+                                      const QBluetoothAddress &address) const
+{
+    QReadLocker locker(&m_lock);
+    const auto it = m_devices.constFind(adapterPath);
+    if (it == m_devices.cend())
+        return {};
+    return it->value(address);
+}
+
+QStringList QtBluezObjectTree::childPaths(const QString &path) const
+{
+    QReadLocker locker(&m_lock);
+    return m_children.value(path);
+}
+
+QStringList QtBluezObjectTree::adapterPaths() const
+{
+    QReadLocker locker(&m_lock);
+    return m_adapters;
+}
+
+void QtBluezObjectTree::setObjects(const ManagedObjectList &objects)
+{
+    QWriteLocker locker(&m_lock);
+    clearObjects();
+
+    // The list is sorted by path, so the child lists are built in order
+    for (auto it = objects.cbegin(), end = objects.cend(); it != end; ++it) {
+        const QString path = it.key().path();
+        insertObject(path);
+        m_objects[path] = it.value();
+        for (auto jt = it.value().cbegin(), jend = it.value().cend(); jt != jend; ++jt)
+            indexInterface(path, jt.key(), jt.value());
+    }
+
+    m_loaded = true;
+}
+
+void QtBluezObjectTree::addInterfaces(const QString &path, const InterfaceList &interfaces)
+{
+    QWriteLocker locker(&m_lock);
+    if (m_loaded) {
+        if (!m_objects.contains(path))
+            insertObject(path);
+
+        InterfaceList &object = m_objects[path];
+        for (auto it = interfaces.cbegin(), end = interfaces.cend(); it != end; ++it) {
+            const auto existing = object.constFind(it.key());
+            if (existing != object.cend())
+                unindexInterface(path, existing.key(), existing.value());
+            object.insert(it.key(), it.value());
+            indexInterface(path, it.key(), it.value());
+        }
+    }
+    locker.unlock();
+
+    emit interfacesAdded(QDBusObjectPath(path), interfaces);
+}
+
+void QtBluezObjectTree::removeInterfaces(const QString &path, const QStringList &interfaces)
+{
+    QWriteLocker locker(&m_lock);
+    const auto it = m_objects.find(path);
+    if (it != m_objects.end()) {
+        for (const QString &interface : interfaces) {
+            const auto jt = it->find(interface);
+            if (jt == it->end())
+                continue;
+            unindexInterface(path, interface, jt.value());
+            it->erase(jt);
+        }
+        if (it->isEmpty())
+            removeObject(path);
+    }
+    locker.unlock();
+
+    emit interfacesRemoved(QDBusObjectPath(path), interfaces);
+}
+
+void QtBluezObjectTree::changeProperties(const QString &path, const QString &interface,
+                                         const QVariantMap &changedProperties,
+                                         const QStringList &invalidatedProperties)
+{
+    QWriteLocker locker(&m_lock);
+    const auto it = m_objects.find(path);
+    if (it != m_objects.end()) {
+        const auto jt = it->find(interface);
+        if (jt != it->end()) {
+            QVariantMap &properties = jt.value();
+            unindexInterface(path, interface, properties);
+            for (auto kt = changedProperties.cbegin(), end = changedProperties.cend();
+                 kt != end; ++kt) {
+                properties.insert(kt.key(), kt.value());
+            }
+            for (const QString &property : invalidatedProperties)
+                properties.remove(property);
+            indexInterface(path, interface, properties);
+        }
+    }
+    locker.unlock();
+
+    emit propertiesChanged(path, interface, changedProperties, invalidatedProperties);
+}
+
+void QtBluezObjectTree::clear()
+{
+    QWriteLocker locker(&m_lock);
+    clearObjects();
+}
+
+void QtBluezObjectTree::clearObjects()
+{
+    m_loaded = false;
+    m_objects.clear();
+    m_children.clear();
+    m_adapters.clear();
+    m_devices.clear();
+}
+
+void QtBluezObjectTree::insertObject(const QString &path)
+{
+    m_objects.insert(path, {});
+    const QString parent = parentPath(path);
+    if (!parent.isEmpty())
+        insertSorted(m_children[parent], path);
+}
+
+void QtBluezObjectTree::removeObject(const QString &path)
+{
+    m_objects.remove(path);
+
+    const auto it = m_children.find(parentPath(path));
+    if (it == m_children.end())
+        return;
+    removeSorted(it.value(), path);
+    if (it->isEmpty())
+        m_children.erase(it);
+}
+
+void QtBluezObjectTree::indexInterface(const QString &path, const QString &interface,
+                                       const QVariantMap &properties)
+{
+    if (interface == adapterInterface) {
+        insertSorted(m_adapters, path);
+    } else if (interface == deviceInterface) {
+        const QString adapterPath =
+                qvariant_cast<QDBusObjectPath>(properties.value(u"Adapter"_s)).path();
+        const QBluetoothAddress address(properties.value(u"Address"_s).toString());
+        if (!adapterPath.isEmpty() && !address.isNull())
+            m_devices[adapterPath].insert(address, path);
+    }
+}
+
+void QtBluezObjectTree::unindexInterface(const QString &path, const QString &interface,
+                                         const QVariantMap &properties)
+{
+    if (interface == adapterInterface) {
+        removeSorted(m_adapters, path);
+    } else if (interface == deviceInterface) {
+        const QString adapterPath =
+                qvariant_cast<QDBusObjectPath>(properties.value(u"Adapter"_s)).path();
+        const auto it = m_devices.find(adapterPath);
+        if (it == m_devices.end())
+            return;
+
+        const QBluetoothAddress address(properties.value(u"Address"_s).toString());
+        const auto jt = it->constFind(address);
+        if (jt != it->cend() && jt.value() == path)
+            it->erase(jt);
+        if (it->isEmpty())
+            m_devices.erase(it);
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_bluezobjecttree_p.cpp"
@@ -0,0 +1,122 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef BLUEZOBJECTTREE_P_H
+#define BLUEZOBJECTTREE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "bluez5_helper_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QStringList>
+
+QT_BEGIN_NAMESPACE
+
+class OrgFreedesktopDBusObjectManagerInterface;
+class OrgFreedesktopDBusPropertiesInterfaceBluetooth;
+class QDBusPendingCallWatcher;
+class QDBusServiceWatcher;
+
+/*
+    A process-wide mirror of the objects exported by bluetoothd.
+
+    The tree is fetched with one GetManagedObjects() call when it is first
+    needed and then kept up to date with the InterfacesAdded,
+    InterfacesRemoved and PropertiesChanged signals. Lookups by adapter,
+    device address and parent path do not go to bluetoothd, and their cost
+    does not depend on the number of devices bluetoothd knows about.
+
+    The tree is dropped when bluetoothd leaves the bus and fetched again on
+    the next use.
+
+    The tree lives in the thread of QCoreApplication, where it receives the
+    D-Bus signals. The lookups and updates are thread-safe.
+*/
+class Q_BLUETOOTH_EXPORT QtBluezObjectTree : public QObject // exported for unit test purposes
+{
+    Q_OBJECT
+public:
+    explicit QtBluezObjectTree(QObject *parent = nullptr);
+    ~QtBluezObjectTree();
+    static QtBluezObjectTree *instance();
+
+    // Fetches the tree if needed, returns false if bluetoothd cannot be reached
+    bool ensureLoaded();
+    // Starts fetching the tree without blocking, loadFinished() is emitted
+    // once it is done. Concurrent callers share one GetManagedObjects() call.
+    // Can be called from any thread, the loading then starts in the tree's.
+    void load();
+    bool isLoaded() const;
+
+    bool contains(const QString &path) const;
+    InterfaceList interfaces(const QString &path) const;
+    QVariantMap properties(const QString &path, const QString &interface) const;
+    bool hasInterface(const QString &path, const QString &interface) const;
+
+    // The objects directly below path, sorted by path
+    QStringList childPaths(const QString &path) const;
+
+    // Sorted by path
+    QStringList adapterPaths() const;
+    QString devicePath(const QString &adapterPath, const QBluetoothAddress &address) const;
+
+    // The updates applied from the D-Bus signals
+    void setObjects(const ManagedObjectList &objects);
+    void addInterfaces(const QString &path, const InterfaceList &interfaces);
+    void removeInterfaces(const QString &path, const QStringList &interfaces);
+    void changeProperties(const QString &path, const QString &interface,
+                          const QVariantMap &changedProperties,
+                          const QStringList &invalidatedProperties);
+    void clear();
+
+signals:
+    void interfacesAdded(const QDBusObjectPath &objectPath, const InterfaceList &interfaces);
+    void interfacesRemoved(const QDBusObjectPath &objectPath, const QStringList &interfaces);
+    void propertiesChanged(const QString &path, const QString &interface,
+                           const QVariantMap &changedProperties,
+                           const QStringList &invalidatedProperties);
+    void loadFinished(bool loaded);
+
+private:
+    void connectToBluez();
+    void startLoading();
+    bool loadFromOtherThread();
+    void loadReplyReceived(QDBusPendingCallWatcher *watcher);
+    void insertObject(const QString &path);
+    void removeObject(const QString &path);
+    void clearObjects();
+    void indexInterface(const QString &path, const QString &interface,
+                        const QVariantMap &properties);
+    void unindexInterface(const QString &path, const QString &interface,
+                          const QVariantMap &properties);
+
+    OrgFreedesktopDBusObjectManagerInterface *m_manager = nullptr;
+    OrgFreedesktopDBusPropertiesInterfaceBluetooth *m_propertiesMonitor = nullptr;
+    QDBusServiceWatcher *m_serviceWatcher = nullptr;
+    QDBusPendingCallWatcher *m_loadWatcher = nullptr;
+
+    // Guards the members below
+    mutable QReadWriteLock m_lock;
+    bool m_loaded = false;
+    QHash<QString, InterfaceList> m_objects;
+    QHash<QString, QStringList> m_children;
+    QStringList m_adapters;
+    // Device paths by adapter path and device address
+    QHash<QString, QHash<QBluetoothAddress, QString>> m_devices;
+};
+
+QT_END_NAMESPACE
+
+#endif // BLUEZOBJECTTREE_P_H
@@ -9,8 +9,12 @@
 #include "gattdescriptor1adaptor_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/private/qcore_unix_p.h>
 #include <QtDBus/QDBusConnection>
 
+#include <sys/socket.h>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_BT_BLUEZ)
@@ -29,6 +33,9 @@ static constexpr auto bluezDescriptorInterface{"org.bluez.GattDescriptor1"_L1};
 static constexpr auto bluezErrorInvalidValueLength{"org.bluez.Error.InvalidValueLength"_L1};
 static constexpr auto bluezErrorInvalidOffset{"org.bluez.Error.InvalidOffset"_L1};
 static constexpr auto bluezErrorNotAuthorized{"org.bluez.Error.NotAuthorized"_L1};
+static constexpr auto bluezErrorNotSupported{"org.bluez.Error.NotSupported"_L1};
+static constexpr auto bluezErrorNotPermitted{"org.bluez.Error.NotPermitted"_L1};
+static constexpr auto bluezErrorFailed{"org.bluez.Error.Failed"_L1};
 // Bluetooth Core v5.3, 3.2.9, Vol 3, Part F
 static constexpr int maximumAttributeLength{512};
 
@@ -211,15 +218,29 @@ QtBluezPeripheralCharacteristic::QtBluezPeripheralCharacteristic(
     initializeValue(characteristicData.value());
 }
 
+QtBluezPeripheralCharacteristic::~QtBluezPeripheralCharacteristic()
+{
+    releaseAcquiredWrite();
+    releaseAcquiredNotify();
+}
+
 InterfaceList QtBluezPeripheralCharacteristic::properties() const
 {
+    QVariantMap characteristicProperties{
+        {"UUID"_L1, uuid},
+        {"Service"_L1, QDBusObjectPath(m_servicePath)},
+        {"Flags"_L1, m_flags}
+    };
+    // The presence of these properties tells Bluez that we implement AcquireWrite
+    // and AcquireNotify, in which case Bluez prefers them over WriteValue (for
+    // write-without-response) and PropertiesChanged (for notifications)
+    if (m_flags.contains("write-without-response"_L1))
+        characteristicProperties.insert("WriteAcquired"_L1, writeAcquired());
+    if (m_flags.contains("notify"_L1))
+        characteristicProperties.insert("NotifyAcquired"_L1, notifyAcquired());
+
     InterfaceList properties;
-    properties.insert(bluezCharacteristicInterface,
-                      {
-                          {"UUID"_L1, uuid},
-                          {"Service"_L1, QDBusObjectPath(m_servicePath)},
-                          {"Flags"_L1, m_flags}
-                      });
+    properties.insert(bluezCharacteristicInterface, characteristicProperties);
     return properties;
 }
 
@@ -282,7 +303,11 @@ bool QtBluezPeripheralCharacteristic::localValueUpdate(const QByteArray& value)
         return false;
     }
     m_value = value;
-    if (m_notifying) {
+    if (m_notifySocket != -1) {
+        // While the socket is full the latest value is sent once it has room
+        if (!m_notifyWriteNotifier->isEnabled())
+            sendAcquiredNotify();
+    } else if (m_notifying) {
         emit propertiesAdaptor->PropertiesChanged(
                     bluezCharacteristicInterface, {{"Value"_L1, m_value}}, {});
     }
@@ -303,6 +328,184 @@ void QtBluezPeripheralCharacteristic::StopNotify()
     m_notifying = false;
 }
 
+// Creates a socket pair, keeps one end in 'localSocket' and returns the other end
+// to be handed over to Bluez. Returns an invalid descriptor on failure
+static QDBusUnixFileDescriptor createAcquiredSocket(int& localSocket)
+{
+    int sockets[2];
+    if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, sockets) < 0) {
+        qCWarning(QT_BT_BLUEZ) << "Failed to create socket pair:" << qt_error_string(errno);
+        return {};
+    }
+    // QDBusUnixFileDescriptor duplicates the descriptor, our copy can be closed
+    QDBusUnixFileDescriptor remote(sockets[1]);
+    qt_safe_close(sockets[1]);
+    localSocket = sockets[0];
+    return remote;
+}
+
+// org.bluez.GattCharacteristic1
+// This function is invoked when remote device starts writing without response
+QDBusUnixFileDescriptor QtBluezPeripheralCharacteristic::AcquireWrite(const QVariantMap &options,
+                                                                      quint16 &mtu,
+                                                                      QString &error)
+{
+    accessEvent(options);
+
+    if (!m_flags.contains("write-without-response"_L1)) {
+        error = bluezErrorNotSupported;
+        return {};
+    }
+    if (m_writeSocket != -1) {
+        qCWarning(QT_BT_BLUEZ) << "Write already acquired for characteristic" << uuid;
+        error = bluezErrorNotPermitted;
+        return {};
+    }
+
+    auto remote = createAcquiredSocket(m_writeSocket);
+    if (!remote.isValid()) {
+        error = bluezErrorFailed;
+        return {};
+    }
+    mtu = options.value("mtu"_L1).toUInt();
+    m_writeNotifier = new QSocketNotifier(m_writeSocket, QSocketNotifier::Read, this);
+    QObject::connect(m_writeNotifier, &QSocketNotifier::activated,
+                     this, &QtBluezPeripheralCharacteristic::readAcquiredWrite);
+
+    qCDebug(QT_BT_BLUEZ) << "Write acquired for characteristic" << uuid << "mtu:" << mtu;
+    emit propertiesAdaptor->PropertiesChanged(
+                bluezCharacteristicInterface, {{"WriteAcquired"_L1, true}}, {});
+    return remote;
+}
+
+// org.bluez.GattCharacteristic1
+// This function is invoked when remote client enables NTF
+QDBusUnixFileDescriptor QtBluezPeripheralCharacteristic::AcquireNotify(const QVariantMap &options,
+                                                                       quint16 &mtu,
+                                                                       QString &error)
+{
+    accessEvent(options);
+
+    if (!m_flags.contains("notify"_L1)) {
+        error = bluezErrorNotSupported;
+        return {};
+    }
+    if (m_notifySocket != -1) {
+        qCWarning(QT_BT_BLUEZ) << "Notify already acquired for characteristic" << uuid;
+        error = bluezErrorNotPermitted;
+        return {};
+    }
+
+    auto remote = createAcquiredSocket(m_notifySocket);
+    if (!remote.isValid()) {
+        error = bluezErrorFailed;
+        return {};
+    }
+    mtu = options.value("mtu"_L1).toUInt();
+    // Bluez does not write to the notify socket, it only closes it when
+    // the remote client disables the notifications
+    m_notifyNotifier = new QSocketNotifier(m_notifySocket, QSocketNotifier::Read, this);
+    QObject::connect(m_notifyNotifier, &QSocketNotifier::activated,
+                     this, &QtBluezPeripheralCharacteristic::readAcquiredNotify);
+    m_notifyWriteNotifier = new QSocketNotifier(m_notifySocket, QSocketNotifier::Write, this);
+    m_notifyWriteNotifier->setEnabled(false);
+    QObject::connect(m_notifyWriteNotifier, &QSocketNotifier::activated,
+                     this, &QtBluezPeripheralCharacteristic::sendAcquiredNotify);
+
+    qCDebug(QT_BT_BLUEZ) << "Notify acquired for characteristic" << uuid << "mtu:" << mtu;
+    emit propertiesAdaptor->PropertiesChanged(
+                bluezCharacteristicInterface, {{"NotifyAcquired"_L1, true}}, {});
+    return remote;
+}
+
+void QtBluezPeripheralCharacteristic::readAcquiredWrite()
+{
+    // Each datagram is one written value. One extra byte in the buffer lets us
+    // detect values which exceed the maximum length
+    QByteArray value(maximumAttributeLength + 1, Qt::Uninitialized);
+    while (m_writeSocket != -1) {
+        const auto readBytes = qt_safe_read(m_writeSocket, value.data(), value.size());
+        if (readBytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+        if (readBytes <= 0) {
+            // Remote closed the socket, or an error occurred
+            releaseAcquiredWrite();
+            return;
+        }
+        if (readBytes < m_minimumValueLength || readBytes > m_maximumValueLength) {
+            qCWarning(QT_BT_BLUEZ) << "Characteristic value has invalid length" << readBytes
+                                   << "min:" << m_minimumValueLength
+                                   << "max:" << m_maximumValueLength;
+            continue;
+        }
+        m_value = value.left(readBytes);
+        emit valueUpdatedByRemote(handle, m_value);
+    }
+}
+
+void QtBluezPeripheralCharacteristic::readAcquiredNotify()
+{
+    char buffer[maximumAttributeLength];
+    const auto readBytes = qt_safe_read(m_notifySocket, buffer, sizeof(buffer));
+    if (readBytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return;
+    if (readBytes <= 0) {
+        qCDebug(QT_BT_BLUEZ) << "Acquired notify socket closed for characteristic" << uuid;
+        releaseAcquiredNotify();
+    }
+}
+
+void QtBluezPeripheralCharacteristic::sendAcquiredNotify()
+{
+    m_notifyWriteNotifier->setEnabled(false);
+
+    // Bluez reads the socket and sends the notification, bypassing DBus.
+    // MSG_NOSIGNAL avoids SIGPIPE if Bluez has already closed its end
+    ssize_t sentBytes;
+    EINTR_LOOP(sentBytes, ::send(m_notifySocket, m_value.constData(), m_value.size(),
+                                 MSG_NOSIGNAL));
+    if (sentBytes >= 0)
+        return;
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // Bluez did not yet take the earlier notifications
+        qCDebug(QT_BT_BLUEZ) << "Acquired notify socket is full for characteristic" << uuid;
+        m_notifyWriteNotifier->setEnabled(true);
+        return;
+    }
+    qCWarning(QT_BT_BLUEZ) << "Writing to the acquired notify socket failed for"
+                           << uuid << qt_error_string(errno);
+    releaseAcquiredNotify();
+}
+
+void QtBluezPeripheralCharacteristic::releaseAcquiredWrite()
+{
+    if (m_writeSocket == -1)
+        return;
+    delete m_writeNotifier;
+    m_writeNotifier = nullptr;
+    qt_safe_close(m_writeSocket);
+    m_writeSocket = -1;
+    qCDebug(QT_BT_BLUEZ) << "Write released for characteristic" << uuid;
+    emit propertiesAdaptor->PropertiesChanged(
+                bluezCharacteristicInterface, {{"WriteAcquired"_L1, false}}, {});
+}
+
+void QtBluezPeripheralCharacteristic::releaseAcquiredNotify()
+{
+    if (m_notifySocket == -1)
+        return;
+    delete m_notifyNotifier;
+    m_notifyNotifier = nullptr;
+    delete m_notifyWriteNotifier;
+    m_notifyWriteNotifier = nullptr;
+    qt_safe_close(m_notifySocket);
+    m_notifySocket = -1;
+    qCDebug(QT_BT_BLUEZ) << "Notify released for characteristic" << uuid;
+    emit propertiesAdaptor->PropertiesChanged(
+                bluezCharacteristicInterface, {{"NotifyAcquired"_L1, false}}, {});
+}
+
 
 void QtBluezPeripheralCharacteristic::initializeValue(const QByteArray& value)
 {
@@ -23,6 +23,8 @@
 #include <QtBluetooth/QLowEnergyCharacteristicData>
 #include <QtBluetooth/QLowEnergyServiceData>
 
+#include <QtDBus/QDBusUnixFileDescriptor>
+
 class OrgFreedesktopDBusPropertiesAdaptor;
 class OrgBluezGattCharacteristic1Adaptor;
 class OrgBluezGattDescriptor1Adaptor;
@@ -30,8 +32,10 @@ class OrgBluezGattService1Adaptor;
 
 QT_BEGIN_NAMESPACE
 
+class QSocketNotifier;
+
 // The QtBluezPeripheralGattObject is the base class for services, characteristics, and descriptors
-class QtBluezPeripheralGattObject : public QObject
+class Q_AUTOTEST_EXPORT QtBluezPeripheralGattObject : public QObject
 {
     Q_OBJECT
 
@@ -105,14 +109,17 @@ private:
 };
 
 
-class QtBluezPeripheralCharacteristic : public QtBluezPeripheralGattObject
+class Q_AUTOTEST_EXPORT QtBluezPeripheralCharacteristic : public QtBluezPeripheralGattObject
 {
     Q_OBJECT
+    Q_PROPERTY(bool WriteAcquired READ writeAcquired)
+    Q_PROPERTY(bool NotifyAcquired READ notifyAcquired)
 
 public:
     QtBluezPeripheralCharacteristic(const QLowEnergyCharacteristicData& characteristicData,
                                     const QString& servicePath, quint16 ordinal,
                                     QLowEnergyHandle handle, QObject* parent);
+    ~QtBluezPeripheralCharacteristic() override;
 
     InterfaceList properties() const final;
 
@@ -129,6 +136,18 @@ public:
     Q_INVOKABLE void StartNotify();
     Q_INVOKABLE void StopNotify();
 
+    // org.bluez.GattCharacteristic1
+    // These are called when remote client writes without response or enables NTF, and
+    // Bluez wants a socket for the values instead of WriteValue calls and PropertiesChanged
+    // signals. Sets error if any
+    Q_INVOKABLE QDBusUnixFileDescriptor AcquireWrite(const QVariantMap &options,
+                                                     quint16 &mtu, QString &error);
+    Q_INVOKABLE QDBusUnixFileDescriptor AcquireNotify(const QVariantMap &options,
+                                                      quint16 &mtu, QString &error);
+
+    bool writeAcquired() const { return m_writeSocket != -1; }
+    bool notifyAcquired() const { return m_notifySocket != -1; }
+
     // Call this function when value has been updated locally (server/user application side)
     bool localValueUpdate(const QByteArray& value);
 
@@ -138,6 +157,11 @@ signals:
 private:
     void initializeValue(const QByteArray& value);
     void initializeFlags(const QLowEnergyCharacteristicData& data);
+    void readAcquiredWrite();
+    void readAcquiredNotify();
+    void sendAcquiredNotify();
+    void releaseAcquiredWrite();
+    void releaseAcquiredNotify();
 
     OrgBluezGattCharacteristic1Adaptor* m_adaptor{};
     QString m_servicePath;
@@ -146,6 +170,13 @@ private:
     QStringList m_flags;
     int m_minimumValueLength;
     int m_maximumValueLength;
+    // Sockets handed out with AcquireWrite / AcquireNotify, -1 if not acquired
+    int m_writeSocket{-1};
+    int m_notifySocket{-1};
+    QSocketNotifier* m_writeNotifier{};
+    QSocketNotifier* m_notifyNotifier{};
+    // Enabled while a notification waits for room in the notify socket
+    QSocketNotifier* m_notifyWriteNotifier{};
 };
 
 class QtBluezPeripheralService : public QtBluezPeripheralGattObject
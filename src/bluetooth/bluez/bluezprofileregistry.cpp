@@ -0,0 +1,292 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "bluezprofileregistry_p.h"
+#include "bluez5_helper_p.h"
+#include "profile1context_p.h"
+#include "profilemanager1_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QGlobalStatic>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QThread>
+#include <QtDBus/QDBusPendingCallWatcher>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_BT_BLUEZ)
+
+using namespace Qt::StringLiterals;
+
+Q_GLOBAL_STATIC(QtBluezProfileRegistry, profileRegistry)
+
+QtBluezProfileClient::QtBluezProfileClient(QtBluezProfileRegistry *registry, const QString &uuid,
+                                           const QString &devicePath, QObject *parent)
+    : QObject(parent), m_registry(registry), m_uuid(uuid), m_devicePath(devicePath)
+{
+}
+
+QtBluezProfileClient::~QtBluezProfileClient()
+{
+    if (m_registry)
+        m_registry->release(this);
+}
+
+bool QtBluezProfileClient::isRegistered() const
+{
+    return m_registry && m_registry->isRegistered(m_uuid);
+}
+
+QtBluezProfileRegistry::QtBluezProfileRegistry(QObject *parent) : QObject(parent)
+{
+    // The instance may be created by any thread, the calls of bluetoothd are
+    // received by the application thread which outlives all others
+    if (QCoreApplication *app = QCoreApplication::instance())
+        moveToThread(app->thread());
+}
+
+QtBluezProfileRegistry::~QtBluezProfileRegistry() = default;
+
+QtBluezProfileRegistry *QtBluezProfileRegistry::instance()
+{
+    return profileRegistry();
+}
+
+QtBluezProfileClient *QtBluezProfileRegistry::acquire(const QString &uuid,
+                                                      const QString &devicePath, QObject *parent)
+{
+    const bool inRegistryThread = thread() == QThread::currentThread();
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_profiles.find(uuid);
+    if (it == m_profiles.end()) {
+        Profile profile;
+        if (inRegistryThread && !exportProfile(uuid, profile))
+            return nullptr;
+        it = m_profiles.insert(uuid, profile);
+    }
+
+    // A profile released by bluetoothd is registered again
+    if (!it->registered && !it->registration) {
+        if (inRegistryThread) {
+            registerProfile(uuid, *it);
+        } else {
+            // The D-Bus objects of the registry belong to its thread
+            QMetaObject::invokeMethod(this, [this, uuid]() { ensureRegistered(uuid); },
+                                      Qt::QueuedConnection);
+        }
+    }
+
+    QtBluezProfileClient *client = new QtBluezProfileClient(this, uuid, devicePath, parent);
+    it->clients.append(client);
+    qCDebug(QT_BT_BLUEZ) << "Client profile" << uuid << "has" << it->clients.size() << "users";
+    return client;
+}
+
+bool QtBluezProfileRegistry::isRegistered(const QString &uuid) const
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_profiles.constFind(uuid);
+    return it != m_profiles.cend() && it->registered;
+}
+
+void QtBluezProfileRegistry::release(QtBluezProfileClient *client)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_profiles.find(client->uuid());
+    // The client may belong to a profile whose registration failed
+    if (it == m_profiles.end() || !it->clients.removeOne(client))
+        return;
+    if (!it->clients.isEmpty())
+        return;
+
+    if (thread() == QThread::currentThread()) {
+        removeProfile(client->uuid(), true);
+        return;
+    }
+
+    // Another socket may acquire the profile in the meantime
+    QMetaObject::invokeMethod(this, [this, uuid = client->uuid()]() {
+        QMutexLocker locker(&m_mutex);
+        const auto it = m_profiles.constFind(uuid);
+        if (it != m_profiles.cend() && it->clients.isEmpty())
+            removeProfile(uuid, true);
+    }, Qt::QueuedConnection);
+}
+
+/*
+    Exports and registers the profile acquired by another thread, unless it
+    was released again or is being registered already.
+*/
+void QtBluezProfileRegistry::ensureRegistered(const QString &uuid)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_profiles.find(uuid);
+    if (it == m_profiles.end() || it->registered || it->registration)
+        return;
+
+    if (!it->context && !exportProfile(uuid, *it)) {
+        notifyRegistration(uuid, u"Cannot export profile on DBus"_s);
+        return;
+    }
+    registerProfile(uuid, *it);
+}
+
+bool QtBluezProfileRegistry::exportProfile(const QString &uuid, Profile &profile)
+{
+    if (!m_profileManager) {
+        m_profileManager = new OrgBluezProfileManager1Interface(
+                u"org.bluez"_s, u"/org/bluez"_s, QDBusConnection::systemBus(), this);
+    }
+
+    profile.path = u"/qt/btsocket/%1%2/profile_%3"_s
+                           .arg(sanitizeNameForDBus(QCoreApplication::applicationName()))
+                           .arg(QCoreApplication::applicationPid())
+                           .arg(sanitizeNameForDBus(uuid));
+    profile.context = new OrgBluezProfile1ContextInterface(this);
+    if (!QDBusConnection::systemBus().registerObject(profile.path, profile.context,
+                                                     QDBusConnection::ExportAllSlots)) {
+        qCWarning(QT_BT_BLUEZ) << "Cannot export client profile on DBus" << profile.path;
+        delete profile.context;
+        profile.context = nullptr;
+        return false;
+    }
+
+    connect(profile.context, &OrgBluezProfile1ContextInterface::newConnection,
+            this, [this, uuid](const QDBusObjectPath &devicePath,
+                               const QDBusUnixFileDescriptor &fd) {
+        dispatchConnection(uuid, devicePath, fd);
+    });
+    connect(profile.context, &OrgBluezProfile1ContextInterface::released, this, [this, uuid]() {
+        QMutexLocker locker(&m_mutex);
+        const auto it = m_profiles.find(uuid);
+        if (it != m_profiles.end())
+            it->registered = false;
+    });
+    return true;
+}
+
+void QtBluezProfileRegistry::registerProfile(const QString &uuid, Profile &profile)
+{
+    QVariantMap profileOptions;
+    profileOptions.insert(u"Role"_s, u"client"_s);
+    profileOptions.insert(u"Service"_s, uuid);
+    profileOptions.insert(u"Name"_s,
+                          u"QBluetoothSocket-%1"_s.arg(QCoreApplication::applicationPid()));
+
+    qCDebug(QT_BT_BLUEZ) << "Registering client profile on" << profile.path << "with options:";
+    qCDebug(QT_BT_BLUEZ) << profileOptions;
+    profile.registration = new QDBusPendingCallWatcher(
+            m_profileManager->RegisterProfile(QDBusObjectPath(profile.path), uuid,
+                                              profileOptions),
+            this);
+    connect(profile.registration, &QDBusPendingCallWatcher::finished,
+            this, [this, uuid](QDBusPendingCallWatcher *watcher) {
+        registrationReplyReceived(uuid, watcher);
+    });
+}
+
+void QtBluezProfileRegistry::registrationReplyReceived(const QString &uuid,
+                                                       QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_profiles.find(uuid);
+    if (it == m_profiles.end() || it->registration != watcher)
+        return;
+    it->registration = nullptr;
+
+    const QDBusPendingReply<> reply = *watcher;
+    if (reply.isError()) {
+        qCWarning(QT_BT_BLUEZ) << "Client profile registration failed:"
+                               << reply.error().message();
+        notifyRegistration(uuid, reply.error().message());
+        return;
+    }
+
+    it->registered = true;
+    notifyRegistration(uuid, QString());
+}
+
+/*
+    Notifies the clients of the profile about the end of its registration.
+    A failed profile is removed, its clients stay unregistered. Called with
+    m_mutex locked.
+*/
+void QtBluezProfileRegistry::notifyRegistration(const QString &uuid, const QString &errorMessage)
+{
+    const auto it = m_profiles.constFind(uuid);
+    if (it == m_profiles.cend())
+        return;
+
+    // The clients of this thread may go away while they are notified, the
+    // others wait for the mutex before they go away
+    QList<QPointer<QtBluezProfileClient>> clients;
+    for (QtBluezProfileClient *client : it->clients)
+        clients.append(client);
+
+    if (!errorMessage.isNull())
+        removeProfile(uuid, false);
+
+    for (const QPointer<QtBluezProfileClient> &client : std::as_const(clients)) {
+        if (client)
+            emit client->registrationFinished(errorMessage.isNull(), errorMessage);
+    }
+}
+
+void QtBluezProfileRegistry::dispatchConnection(const QString &uuid,
+                                                const QDBusObjectPath &devicePath,
+                                                const QDBusUnixFileDescriptor &fd)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_profiles.constFind(uuid);
+    if (it != m_profiles.cend()) {
+        for (QtBluezProfileClient *client : it->clients) {
+            if (client->m_waiting && client->m_devicePath == devicePath.path()) {
+                client->m_waiting = false;
+                emit client->newConnection(fd);
+                return;
+            }
+        }
+    }
+
+    // Closing our copy of the descriptor drops the connection
+    qCWarning(QT_BT_BLUEZ) << "No socket is waiting for the connection of" << devicePath.path()
+                           << "to" << uuid;
+}
+
+/*
+    Called with m_mutex locked, in the thread of the registry.
+*/
+void QtBluezProfileRegistry::removeProfile(const QString &uuid, bool unregister)
+{
+    const Profile profile = m_profiles.take(uuid);
+
+    // bluetoothd handles the calls in order, a registration still in
+    // flight is undone as well
+    if (unregister && (profile.registered || profile.registration)) {
+        qCDebug(QT_BT_BLUEZ) << "Unregistering client profile on" << profile.path;
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(
+                m_profileManager->UnregisterProfile(QDBusObjectPath(profile.path)), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished,
+                this, [](QDBusPendingCallWatcher *call) {
+            const QDBusPendingReply<> reply = *call;
+            if (reply.isError())
+                qCWarning(QT_BT_BLUEZ) << "Unregister profile:" << reply.error().message();
+            call->deleteLater();
+        });
+    }
+
+    delete profile.registration;
+    // The profile of another thread may not have been exported yet
+    if (!profile.context)
+        return;
+    QDBusConnection::systemBus().unregisterObject(profile.path);
+    // The context may be emitting the signal that led here
+    profile.context->deleteLater();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_bluezprofileregistry_p.cpp"
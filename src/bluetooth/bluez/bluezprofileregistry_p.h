@@ -0,0 +1,130 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef BLUEZPROFILEREGISTRY_P_H
+#define BLUEZPROFILEREGISTRY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtBluetooth/private/qtbluetoothglobal_p.h>
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/private/qglobal_p.h>
+#include <QtDBus/qdbusextratypes.h>
+#include <QtDBus/qdbusunixfiledescriptor.h>
+
+class OrgBluezProfileManager1Interface;
+
+QT_BEGIN_NAMESPACE
+
+class OrgBluezProfile1ContextInterface;
+class QDBusPendingCallWatcher;
+class QtBluezProfileRegistry;
+
+/*
+    A reference to the client profile of one service UUID, held by a socket
+    connecting to the device at devicePath(). Deleting the client drops the
+    reference.
+*/
+class Q_BLUETOOTH_EXPORT QtBluezProfileClient : public QObject // exported for unit test purposes
+{
+    Q_OBJECT
+public:
+    ~QtBluezProfileClient();
+
+    QString uuid() const { return m_uuid; }
+    QString devicePath() const { return m_devicePath; }
+    bool isRegistered() const;
+
+signals:
+    // Emitted if the profile was still being registered when the client was created
+    void registrationFinished(bool registered, const QString &errorMessage);
+    void newConnection(const QDBusUnixFileDescriptor &fd);
+
+private:
+    friend class QtBluezProfileRegistry;
+    QtBluezProfileClient(QtBluezProfileRegistry *registry, const QString &uuid,
+                         const QString &devicePath, QObject *parent);
+
+    QPointer<QtBluezProfileRegistry> m_registry;
+    QString m_uuid;
+    QString m_devicePath;
+    bool m_waiting = true; // no connection handed over yet
+};
+
+/*
+    Keeps one client profile per service UUID registered with bluetoothd as
+    long as a socket uses it. The profile manager of bluetoothd is not bound
+    to an adapter, the device paths passed to NewConnection() contain the
+    adapter and select the socket the connection is handed to.
+
+    Without the registry every socket would export and register its own
+    profile, and two sockets using the same UUID could be handed each
+    other's connections.
+
+    The registry lives in the thread of QCoreApplication, where it receives
+    the D-Bus calls of bluetoothd. Sockets of any thread may acquire and
+    release profiles.
+*/
+class Q_BLUETOOTH_EXPORT QtBluezProfileRegistry : public QObject // exported for unit test purposes
+{
+    Q_OBJECT
+public:
+    explicit QtBluezProfileRegistry(QObject *parent = nullptr);
+    ~QtBluezProfileRegistry();
+    static QtBluezProfileRegistry *instance();
+
+    // Returns nullptr if the profile cannot be exported on the bus. When
+    // called from another thread, the profile is exported later and an
+    // export failure is reported by registrationFinished().
+    QtBluezProfileClient *acquire(const QString &uuid, const QString &devicePath,
+                                  QObject *parent);
+    bool isRegistered(const QString &uuid) const;
+
+private:
+    struct Profile
+    {
+        QString path;
+        OrgBluezProfile1ContextInterface *context = nullptr;
+        QDBusPendingCallWatcher *registration = nullptr;
+        bool registered = false;
+        // The connections of a device go to the first client waiting for it
+        QList<QtBluezProfileClient *> clients;
+    };
+
+    friend class QtBluezProfileClient;
+    void release(QtBluezProfileClient *client);
+
+    void ensureRegistered(const QString &uuid);
+    bool exportProfile(const QString &uuid, Profile &profile);
+    void registerProfile(const QString &uuid, Profile &profile);
+    void registrationReplyReceived(const QString &uuid, QDBusPendingCallWatcher *watcher);
+    void notifyRegistration(const QString &uuid, const QString &errorMessage);
+    void dispatchConnection(const QString &uuid, const QDBusObjectPath &devicePath,
+                            const QDBusUnixFileDescriptor &fd);
+    void removeProfile(const QString &uuid, bool unregister);
+
+    OrgBluezProfileManager1Interface *m_profileManager = nullptr;
+
+    // Guards m_profiles and the clients. It is recursive since a client may
+    // be deleted by a slot connected to the signals emitted while locked.
+    mutable QRecursiveMutex m_mutex;
+    QHash<QString, Profile> m_profiles;
+};
+
+QT_END_NAMESPACE
+
+#endif // BLUEZPROFILEREGISTRY_P_H
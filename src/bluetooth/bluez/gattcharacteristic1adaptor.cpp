@@ -39,6 +39,12 @@ QStringList OrgBluezGattCharacteristic1Adaptor::flags() const
     return qvariant_cast< QStringList >(parent()->property("Flags"));
 }
 
+bool OrgBluezGattCharacteristic1Adaptor::notifyAcquired() const
+{
+    // get the value of property NotifyAcquired
+    return qvariant_cast< bool >(parent()->property("NotifyAcquired"));
+}
+
 bool OrgBluezGattCharacteristic1Adaptor::notifying() const
 {
     // get the value of property Notifying
@@ -63,6 +69,56 @@ QByteArray OrgBluezGattCharacteristic1Adaptor::value() const
     return qvariant_cast< QByteArray >(parent()->property("Value"));
 }
 
+bool OrgBluezGattCharacteristic1Adaptor::writeAcquired() const
+{
+    // get the value of property WriteAcquired
+    return qvariant_cast< bool >(parent()->property("WriteAcquired"));
+}
+
+QDBusUnixFileDescriptor OrgBluezGattCharacteristic1Adaptor::AcquireNotify(
+                                                         const QVariantMap &options,
+                                                         const QDBusMessage& msg,
+                                                         ushort &mtu)
+{
+    // handle method call org.bluez.GattCharacteristic1.AcquireNotify
+    QDBusUnixFileDescriptor fd;
+    QString error;
+    QMetaObject::invokeMethod(parent(), "AcquireNotify",
+                              Q_RETURN_ARG(QDBusUnixFileDescriptor, fd),
+                              Q_ARG(QVariantMap, options), Q_ARG(quint16&, mtu),
+                              Q_ARG(QString&, error));
+    if (!error.isEmpty()) {
+        // Reply with error if needed. There is no descriptor to return, so
+        // QtDBus must not send the regular reply
+        msg.setDelayedReply(true);
+        auto reply = msg.createErrorReply(error, {});
+        QDBusConnection::systemBus().send(reply);
+    }
+    return fd;
+}
+
+QDBusUnixFileDescriptor OrgBluezGattCharacteristic1Adaptor::AcquireWrite(
+                                                         const QVariantMap &options,
+                                                         const QDBusMessage& msg,
+                                                         ushort &mtu)
+{
+    // handle method call org.bluez.GattCharacteristic1.AcquireWrite
+    QDBusUnixFileDescriptor fd;
+    QString error;
+    QMetaObject::invokeMethod(parent(), "AcquireWrite",
+                              Q_RETURN_ARG(QDBusUnixFileDescriptor, fd),
+                              Q_ARG(QVariantMap, options), Q_ARG(quint16&, mtu),
+                              Q_ARG(QString&, error));
+    if (!error.isEmpty()) {
+        // Reply with error if needed. There is no descriptor to return, so
+        // QtDBus must not send the regular reply
+        msg.setDelayedReply(true);
+        auto reply = msg.createErrorReply(error, {});
+        QDBusConnection::systemBus().send(reply);
+    }
+    return fd;
+}
+
 QByteArray OrgBluezGattCharacteristic1Adaptor::ReadValue(const QVariantMap &options,
                                                          const QDBusMessage& msg)
 {
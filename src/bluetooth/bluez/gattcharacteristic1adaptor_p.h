@@ -47,6 +47,18 @@ class OrgBluezGattCharacteristic1Adaptor: public QDBusAbstractAdaptor
 "      <arg direction=\"in\" type=\"a{sv}\" name=\"options\"/>\n"
 "      <annotation value=\"QVariantMap\" name=\"org.qtproject.QtDBus.QtTypeName.In1\"/>\n"
 "    </method>\n"
+"    <method name=\"AcquireWrite\">\n"
+"      <arg direction=\"in\" type=\"a{sv}\" name=\"options\"/>\n"
+"      <annotation value=\"QVariantMap\" name=\"org.qtproject.QtDBus.QtTypeName.In0\"/>\n"
+"      <arg direction=\"out\" type=\"h\" name=\"fd\"/>\n"
+"      <arg direction=\"out\" type=\"q\" name=\"mtu\"/>\n"
+"    </method>\n"
+"    <method name=\"AcquireNotify\">\n"
+"      <arg direction=\"in\" type=\"a{sv}\" name=\"options\"/>\n"
+"      <annotation value=\"QVariantMap\" name=\"org.qtproject.QtDBus.QtTypeName.In0\"/>\n"
+"      <arg direction=\"out\" type=\"h\" name=\"fd\"/>\n"
+"      <arg direction=\"out\" type=\"q\" name=\"mtu\"/>\n"
+"    </method>\n"
 "    <method name=\"StartNotify\"/>\n"
 "    <method name=\"StopNotify\"/>\n"
 "    <property access=\"read\" type=\"s\" name=\"UUID\"/>\n"
@@ -54,6 +66,8 @@ class OrgBluezGattCharacteristic1Adaptor: public QDBusAbstractAdaptor
 "    <property access=\"read\" type=\"ay\" name=\"Value\"/>\n"
 "    <property access=\"read\" type=\"b\" name=\"Notifying\"/>\n"
 "    <property access=\"read\" type=\"as\" name=\"Flags\"/>\n"
+"    <property access=\"read\" type=\"b\" name=\"WriteAcquired\"/>\n"
+"    <property access=\"read\" type=\"b\" name=\"NotifyAcquired\"/>\n"
 "  </interface>\n"
         "")
 public:
@@ -64,6 +78,9 @@ public: // PROPERTIES
     Q_PROPERTY(QStringList Flags READ flags)
     QStringList flags() const;
 
+    Q_PROPERTY(bool NotifyAcquired READ notifyAcquired)
+    bool notifyAcquired() const;
+
     Q_PROPERTY(bool Notifying READ notifying)
     bool notifying() const;
 
@@ -76,7 +93,15 @@ public: // PROPERTIES
     Q_PROPERTY(QByteArray Value READ value)
     QByteArray value() const;
 
+    Q_PROPERTY(bool WriteAcquired READ writeAcquired)
+    bool writeAcquired() const;
+
 public Q_SLOTS: // METHODS
+    // HAND-EDIT: the QDBusMessage is needed for replying with an error
+    QDBusUnixFileDescriptor AcquireNotify(const QVariantMap &options, const QDBusMessage &msg,
+                                          ushort &mtu);
+    QDBusUnixFileDescriptor AcquireWrite(const QVariantMap &options, const QDBusMessage &msg,
+                                         ushort &mtu);
     QByteArray ReadValue(const QVariantMap &options, const QDBusMessage &msg);
     void StartNotify();
     void StopNotify();
@@ -47,7 +47,8 @@ public:
     explicit OrgBluezProfile1ContextInterface(QObject *parent = nullptr);
 
 Q_SIGNALS:
-    void newConnection(const QDBusUnixFileDescriptor &fd);
+    void newConnection(const QDBusObjectPath &remotePath, const QDBusUnixFileDescriptor &fd);
+    void released();
 
 public Q_SLOTS:
     void NewConnection(const QDBusObjectPath &, const QDBusUnixFileDescriptor &,
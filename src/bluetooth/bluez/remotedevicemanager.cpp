@@ -5,8 +5,8 @@
 
 #include "remotedevicemanager_p.h"
 #include "bluez5_helper_p.h"
+#include "bluezobjecttree_p.h"
 #include "device1_bluez5_p.h"
-#include "objectmanager_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -77,53 +77,28 @@ void RemoteDeviceManager::prepareNextJob()
 
 void RemoteDeviceManager::disconnectDevice(const QBluetoothAddress &remote)
 {
-    // collect initial set of information
-    OrgFreedesktopDBusObjectManagerInterface managerBluez5(
-                                               QStringLiteral("org.bluez"),
-                                               QStringLiteral("/"),
-                                               QDBusConnection::systemBus(), this);
-    QDBusPendingReply<ManagedObjectList> reply = managerBluez5.GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError()) {
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    if (!objectTree->ensureLoaded()) {
         QTimer::singleShot(0, this, [this](){ prepareNextJob(); });
         return;
     }
 
     bool jobStarted = false;
-    ManagedObjectList managedObjectList = reply.value();
-    for (auto it = managedObjectList.constBegin(); it != managedObjectList.constEnd(); ++it) {
-        const QDBusObjectPath &path = it.key();
-        const InterfaceList &ifaceList = it.value();
-
-        for (auto jt = ifaceList.constBegin(); jt != ifaceList.constEnd(); ++jt) {
-            const QString &iface = jt.key();
-
-            if (path.path().indexOf(adapterPath) != 0)
-                continue; //devices whose path doesn't start with same path we skip
-
-            if (iface != QStringLiteral("org.bluez.Device1"))
-                continue;
-
-            const QBluetoothAddress foundAddress(ifaceList.value(iface).value(QStringLiteral("Address")).toString());
-            if (foundAddress != remote)
-                continue;
-
-            // found the correct Device1 path
-            OrgBluezDevice1Interface* device1 = new OrgBluezDevice1Interface(QStringLiteral("org.bluez"),
-                                                                             path.path(),
-                                                                             QDBusConnection::systemBus(),
-                                                                             this);
-            QDBusPendingReply<> asyncReply = device1->Disconnect();
-            QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(asyncReply, this);
-            const auto watcherFinished = [this, device1](QDBusPendingCallWatcher* call) {
-                call->deleteLater();
-                device1->deleteLater();
-                prepareNextJob();
-            };
-            connect(watcher, &QDBusPendingCallWatcher::finished, this, watcherFinished);
-            jobStarted = true;
-            break;
-        }
+    const QString devicePath = objectTree->devicePath(adapterPath, remote);
+    if (!devicePath.isEmpty()) {
+        OrgBluezDevice1Interface* device1 = new OrgBluezDevice1Interface(QStringLiteral("org.bluez"),
+                                                                         devicePath,
+                                                                         QDBusConnection::systemBus(),
+                                                                         this);
+        QDBusPendingReply<> asyncReply = device1->Disconnect();
+        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(asyncReply, this);
+        const auto watcherFinished = [this, device1](QDBusPendingCallWatcher* call) {
+            call->deleteLater();
+            device1->deleteLater();
+            prepareNextJob();
+        };
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, watcherFinished);
+        jobStarted = true;
     }
 
     if (!jobStarted) {
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qbluetoothaddress.h"
+#include "qbluetoothaddress_p.h"
 
 #ifndef QT_NO_DEBUG_STREAM
 #include <QDebug>
@@ -49,20 +50,8 @@ Q_CONSTRUCTOR_FUNCTION(registerQBluetoothAddress)
     where X is a hexadecimal digit.  Case is not important.
 */
 QBluetoothAddress::QBluetoothAddress(const QString &address)
+    : m_address(QtBluetoothPrivate::addressFromString(QStringView(address)).toUInt64())
 {
-    QString a = address;
-
-    if (a.size() == 17)
-        a.remove(QLatin1Char(':'));
-
-    if (a.size() == 12) {
-        bool ok;
-        m_address = a.toULongLong(&ok, 16);
-        if (!ok)
-            clear();
-    } else {
-        m_address = 0;
-    }
 }
 
 /*!
@@ -96,14 +85,9 @@ QBluetoothAddress::QBluetoothAddress(const QString &address)
 */
 QString QBluetoothAddress::toString() const
 {
-    QString s(QStringLiteral("%1:%2:%3:%4:%5:%6"));
-
-    for (int i = 5; i >= 0; --i) {
-        const quint8 a = (m_address >> (i*8)) & 0xff;
-        s = s.arg(a, 2, 16, QLatin1Char('0'));
-    }
-
-    return s.toUpper();
+    QString s(QtBluetoothPrivate::AddressStringLength, Qt::Uninitialized);
+    QtBluetoothPrivate::toAddressString(*this, reinterpret_cast<char16_t *>(s.data()));
+    return s;
 }
 
 /*!
@@ -130,7 +114,9 @@ QString QBluetoothAddress::toString() const
 #ifndef QT_NO_DEBUG_STREAM
 QDebug QBluetoothAddress::streamingOperator(QDebug debug, const QBluetoothAddress &address)
 {
-    debug << address.toString();
+    char buffer[QtBluetoothPrivate::AddressStringLength];
+    QtBluetoothPrivate::toAddressString(address, buffer);
+    debug << QLatin1StringView(buffer, QtBluetoothPrivate::AddressStringLength);
     return debug;
 }
 #endif
@@ -0,0 +1,99 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QBLUETOOTHADDRESS_P_H
+#define QBLUETOOTHADDRESS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtBluetooth/qbluetoothaddress.h>
+
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlatin1stringview.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtBluetoothPrivate {
+
+// Characters of the XX:XX:XX:XX:XX:XX form
+constexpr qsizetype AddressStringLength = 17;
+
+/*
+    Writes the address in the XX:XX:XX:XX:XX:XX form to out, which must
+    have room for AddressStringLength characters. BlueZ object paths use '_'
+    as separator. Returns the position after the last written character.
+*/
+template <typename Char>
+Char *toAddressString(const QBluetoothAddress &address, Char *out, char separator = ':') noexcept
+{
+    const quint64 value = address.toUInt64();
+    for (int shift = 40; shift >= 0; shift -= 8) {
+        *out++ = Char(QtMiscUtils::toHexUpper(char32_t(value >> (shift + 4))));
+        *out++ = Char(QtMiscUtils::toHexUpper(char32_t(value >> shift)));
+        if (shift)
+            *out++ = Char(separator);
+    }
+    return out;
+}
+
+/*
+    Parses the XX:XX:XX:XX:XX:XX or XXXXXXXXXXXX form in either case.
+    Returns a null address if chars is in neither form.
+*/
+template <typename Char>
+QBluetoothAddress addressFromString(const Char *chars, qsizetype size,
+                                    char separator = ':') noexcept
+{
+    const bool separated = size == AddressStringLength;
+    if (!separated && size != 12)
+        return QBluetoothAddress();
+
+    quint64 value = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        if (separated && i % 3 == 2) {
+            if (chars[i] != Char(separator))
+                return QBluetoothAddress();
+            continue;
+        }
+        const int digit = QtMiscUtils::fromHex(char32_t(std::make_unsigned_t<Char>(chars[i])));
+        if (digit < 0)
+            return QBluetoothAddress();
+        value = (value << 4) | quint64(digit);
+    }
+    return QBluetoothAddress(value);
+}
+
+inline QBluetoothAddress addressFromString(QStringView address, char separator = ':') noexcept
+{
+    return addressFromString(address.utf16(), address.size(), separator);
+}
+
+inline QBluetoothAddress addressFromString(QLatin1StringView address,
+                                           char separator = ':') noexcept
+{
+    return addressFromString(address.data(), address.size(), separator);
+}
+
+inline QBluetoothAddress addressFromString(QByteArrayView address, char separator = ':') noexcept
+{
+    return addressFromString(address.data(), address.size(), separator);
+}
+
+} // namespace QtBluetoothPrivate
+
+QT_END_NAMESPACE
+
+#endif // QBLUETOOTHADDRESS_P_H
@@ -128,6 +128,24 @@ Q_DECLARE_LOGGING_CATEGORY(QT_BT)
     \sa QBluetoothDeviceInfo::rssi(), lowEnergyDiscoveryTimeout()
 */
 
+/*!
+    \fn void QBluetoothDeviceDiscoveryAgent::deviceLost(const QBluetoothDeviceInfo &info)
+    \since 6.10
+
+    This signal is emitted when the Bluetooth device described by \a info is
+    removed from \l discoveredDevices() while the discovery is active.
+
+    This happens if \l lowEnergyDiscoveryTimeout() is \c 0 and the platform
+    stops tracking the device because it has not been seen for a while. It
+    also happens if more devices were found than
+    \l maximumDiscoveredDevices(). The device seen least recently is then
+    removed.
+
+    \note This signal is currently only emitted on Linux with BlueZ.
+
+    \sa deviceDiscovered(), lowEnergyDiscoveryTimeout(), setMaximumDiscoveredDevices()
+*/
+
 /*!
     \fn void QBluetoothDeviceDiscoveryAgent::finished()
 
@@ -205,6 +223,11 @@ QBluetoothDeviceDiscoveryAgent::~QBluetoothDeviceDiscoveryAgent()
 
 /*!
     Returns a list of all discovered Bluetooth devices.
+
+    The list and the QBluetoothDeviceInfo objects in it are implicitly
+    shared with the agent. Iterating over the returned list does not copy
+    the device information, and the agent only copies the list itself once
+    it records the next change.
 */
 QList<QBluetoothDeviceInfo> QBluetoothDeviceDiscoveryAgent::discoveredDevices() const
 {
@@ -266,6 +289,58 @@ int QBluetoothDeviceDiscoveryAgent::lowEnergyDiscoveryTimeout() const
     return d->lowEnergySearchTimeout;
 }
 
+/*!
+    Sets the maximum number of devices retained in \l discoveredDevices() to
+    \a maximum. If \a maximum is \c 0 every device found is retained until the
+    discovery is restarted.
+
+    Once more devices are found, the device seen least recently is removed
+    and reported by \l deviceLost(). A removed device that is seen again is
+    reported by \l deviceDiscovered() again. A continuous discovery among
+    devices using random addresses otherwise retains more and more devices.
+
+    The new maximum is applied when the next device is found. The default
+    is \c 0, or the value of the \e QT_BLUETOOTH_MAX_DISCOVERED_DEVICES
+    environment variable when the agent is created.
+
+    \note The number of retained devices can currently only be bounded on
+    Linux with BlueZ.
+
+    \sa maximumDiscoveredDevices(), deviceLost()
+    \since 6.10
+ */
+void QBluetoothDeviceDiscoveryAgent::setMaximumDiscoveredDevices(int maximum)
+{
+    Q_D(QBluetoothDeviceDiscoveryAgent);
+
+    if (maximum < 0) {
+        qCDebug(QT_BT) << "The maximum number of discovered devices cannot be negative.";
+        return;
+    }
+
+    if (d->maximumDevices < 0) {
+        qCDebug(QT_BT) << "The maximum number of discovered devices cannot be "
+                          "set on a backend which does not support this feature.";
+        return;
+    }
+
+    d->maximumDevices = maximum;
+}
+
+/*!
+    Returns the maximum number of devices retained in \l discoveredDevices().
+    A value of \c 0 implies that all devices found are retained. A value of
+    \c -1 implies that the platform does not support this property.
+
+    \sa setMaximumDiscoveredDevices()
+    \since 6.10
+ */
+int QBluetoothDeviceDiscoveryAgent::maximumDiscoveredDevices() const
+{
+    Q_D(const QBluetoothDeviceDiscoveryAgent);
+    return d->maximumDevices;
+}
+
 /*!
     \fn QBluetoothDeviceDiscoveryAgent::DiscoveryMethods QBluetoothDeviceDiscoveryAgent::supportedDiscoveryMethods()
 
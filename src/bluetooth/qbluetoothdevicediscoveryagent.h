@@ -59,6 +59,9 @@ public:
     void setLowEnergyDiscoveryTimeout(int msTimeout);
     int lowEnergyDiscoveryTimeout() const;
 
+    void setMaximumDiscoveredDevices(int maximum);
+    int maximumDiscoveredDevices() const;
+
     static DiscoveryMethods supportedDiscoveryMethods();
 public Q_SLOTS:
     void start();
@@ -71,6 +74,7 @@ Q_SIGNALS:
     void finished();
     void errorOccurred(QBluetoothDeviceDiscoveryAgent::Error error);
     void canceled();
+    void deviceLost(const QBluetoothDeviceInfo &info);
 
 private:
     Q_DECLARE_PRIVATE(QBluetoothDeviceDiscoveryAgent)
@@ -11,16 +11,21 @@
 #include "qbluetoothuuid.h"
 
 #include "bluez/bluez5_helper_p.h"
+#include "bluez/bluezobjecttree_p.h"
 #include "bluez/objectmanager_p.h"
 #include "bluez/adapter1_bluez5_p.h"
 #include "bluez/device1_bluez5_p.h"
 #include "bluez/properties_p.h"
 #include "bluez/bluetoothmanagement_p.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_BT_BLUEZ)
 
+using namespace Qt::StringLiterals;
+
 QBluetoothDeviceDiscoveryAgentPrivate::QBluetoothDeviceDiscoveryAgentPrivate(
     const QBluetoothAddress &deviceAdapter, QBluetoothDeviceDiscoveryAgent *parent) :
     adapterAddress(deviceAdapter),
@@ -37,6 +42,21 @@ QBluetoothDeviceDiscoveryAgentPrivate::QBluetoothDeviceDiscoveryAgentPrivate(
                      [this](const QDBusObjectPath &objectPath, InterfaceList interfacesAndProperties) {
         this->_q_InterfacesAdded(objectPath, interfacesAndProperties);
     });
+    QObject::connect(manager,
+                     &OrgFreedesktopDBusObjectManagerInterface::InterfacesRemoved,
+                     q_ptr,
+                     [this](const QDBusObjectPath &objectPath, const QStringList &interfaces) {
+        this->_q_InterfacesRemoved(objectPath, interfaces);
+    });
+
+    // Otherwise a continuous scan keeps every device that was ever in range
+    maximumDevices = 0;
+    if (Q_UNLIKELY(!qEnvironmentVariableIsEmpty("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES"))) {
+        bool ok = false;
+        const int value = qEnvironmentVariableIntValue("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES", &ok);
+        if (ok && value > 0)
+            maximumDevices = value;
+    }
 
     // start private address monitoring
     BluetoothManagement::instance();
@@ -80,6 +100,7 @@ void QBluetoothDeviceDiscoveryAgentPrivate::start(QBluetoothDeviceDiscoveryAgent
     errorString.clear();
     discoveredDevices.clear();
     devicesProperties.clear();
+    recentlySeen.clear();
 
     Q_Q(QBluetoothDeviceDiscoveryAgent);
 
@@ -96,7 +117,9 @@ void QBluetoothDeviceDiscoveryAgentPrivate::start(QBluetoothDeviceDiscoveryAgent
     adapter = new OrgBluezAdapter1Interface(QStringLiteral("org.bluez"), adapterPath,
                                             QDBusConnection::systemBus());
 
-    if (!adapter->powered()) {
+    const QVariantMap adapterProperties = QtBluezObjectTree::instance()->properties(
+                adapterPath, QStringLiteral("org.bluez.Adapter1"));
+    if (!adapterProperties.value(QStringLiteral("Powered")).toBool()) {
         qCDebug(QT_BT_BLUEZ) << "Aborting device discovery due to offline Bluetooth Adapter";
         lastError = QBluetoothDeviceDiscoveryAgent::PoweredOffError;
         errorString = QBluetoothDeviceDiscoveryAgent::tr("Device is powered off");
@@ -114,10 +137,25 @@ void QBluetoothDeviceDiscoveryAgentPrivate::start(QBluetoothDeviceDiscoveryAgent
     else
         map.insert(QStringLiteral("Transport"), QStringLiteral("bredr"));
 
+    // The agent is active from here on, discovery continues once bluetoothd
+    // accepted the filter
+    filterWatcher = new QDBusPendingCallWatcher(adapter->SetDiscoveryFilter(map), q);
+    QObject::connect(filterWatcher, &QDBusPendingCallWatcher::finished,
+                     q, [this, methods](QDBusPendingCallWatcher *watcher) {
+        filterWatcher = nullptr;
+        watcher->deleteLater();
+        startDiscovery(*watcher, methods);
+    });
+}
+
+void QBluetoothDeviceDiscoveryAgentPrivate::startDiscovery(
+        const QDBusPendingReply<> &filterReply,
+        QBluetoothDeviceDiscoveryAgent::DiscoveryMethods methods)
+{
+    Q_Q(QBluetoothDeviceDiscoveryAgent);
+
     // older BlueZ 5.x versions don't have this function
     // filterReply returns UnknownMethod which we ignore
-    QDBusPendingReply<> filterReply = adapter->SetDiscoveryFilter(map);
-    filterReply.waitForFinished();
     if (filterReply.isError()) {
         if (filterReply.error().type() == QDBusError::Other
                     && filterReply.error().name() == QStringLiteral("org.bluez.Error.Failed")) {
@@ -151,29 +189,21 @@ void QBluetoothDeviceDiscoveryAgentPrivate::start(QBluetoothDeviceDiscoveryAgent
     // remember what we have to cleanup
     propertyMonitors.append(prop);
 
-    // collect initial set of information
-    QDBusPendingReply<ManagedObjectList> reply = manager->GetManagedObjects();
-    reply.waitForFinished();
-    if (!reply.isError()) {
-        ManagedObjectList managedObjectList = reply.value();
-        for (ManagedObjectList::const_iterator it = managedObjectList.constBegin(); it != managedObjectList.constEnd(); ++it) {
-            const QDBusObjectPath &path = it.key();
-            const InterfaceList &ifaceList = it.value();
-
-            for (InterfaceList::const_iterator jt = ifaceList.constBegin(); jt != ifaceList.constEnd(); ++jt) {
-                const QString &iface = jt.key();
-
-                if (iface == QStringLiteral("org.bluez.Device1")) {
-
-                    if (path.path().indexOf(adapter->path()) != 0)
-                        continue; //devices whose path doesn't start with same path we skip
-
-                    deviceFound(path.path(), jt.value());
-                    if (!isActive()) // Can happen if stop() was called from a slot in user code.
-                      return;
-                }
-            }
-        }
+    // collect initial set of information, without waiting for bluetoothd
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    if (objectTree->isLoaded()) {
+        if (!reportKnownDevices())
+            return;
+    } else {
+        objectTreeConnection = QObject::connect(objectTree, &QtBluezObjectTree::loadFinished,
+                                                q, [this](bool loaded) {
+            // The tree may report more than one load
+            if (!QObject::disconnect(objectTreeConnection))
+                return;
+            if (loaded)
+                reportKnownDevices();
+        });
+        objectTree->load();
     }
 
     // wait interval and sum up what was found
@@ -192,6 +222,26 @@ void QBluetoothDeviceDiscoveryAgentPrivate::start(QBluetoothDeviceDiscoveryAgent
     }
 }
 
+/*
+    Reports the devices bluetoothd already knows about. Returns false if the
+    agent was stopped from a slot in user code.
+*/
+bool QBluetoothDeviceDiscoveryAgentPrivate::reportKnownDevices()
+{
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    // The devices are the children of the adapter
+    const QStringList devicePaths = objectTree->childPaths(adapter->path());
+    for (const QString &path : devicePaths) {
+        if (!objectTree->hasInterface(path, QStringLiteral("org.bluez.Device1")))
+            continue;
+
+        deviceFound(path, objectTree->properties(path, QStringLiteral("org.bluez.Device1")));
+        if (!isActive())
+            return false;
+    }
+    return true;
+}
+
 void QBluetoothDeviceDiscoveryAgentPrivate::stop()
 {
     if (!adapter)
@@ -203,40 +253,88 @@ void QBluetoothDeviceDiscoveryAgentPrivate::stop()
     _q_discoveryFinished();
 }
 
+// Takes over the properties the device information is created from
+static void updateDeviceProperties(QBluetoothDeviceDiscoveryAgentPrivate::DeviceProperties &device,
+                                   const QVariantMap &properties)
+{
+    for (auto it = properties.cbegin(); it != properties.cend(); ++it) {
+        const QString &name = it.key();
+        if (name == "Address"_L1) {
+            device.address = QBluetoothAddress(it.value().toString());
+        } else if (name == "Alias"_L1) {
+            device.alias = it.value().toString();
+        } else if (name == "Class"_L1) {
+            device.deviceClass = it.value().toUInt();
+        } else if (name == "RSSI"_L1) {
+            device.rssi = qvariant_cast<short>(it.value());
+        } else if (name == "UUIDs"_L1) {
+            device.uuids.clear();
+            const QStringList uuids = qvariant_cast<QStringList>(it.value());
+            for (const QString &uuid : uuids) {
+                const QBluetoothUuid id(uuid);
+                if (!id.isNull())
+                    device.uuids.append(id);
+            }
+        } else if (name == "ManufacturerData"_L1) {
+            device.manufacturerData.clear();
+            const ManufacturerDataList data = qdbus_cast<ManufacturerDataList>(it.value());
+            for (auto entry = data.cbegin(); entry != data.cend(); ++entry)
+                device.manufacturerData.insert(entry.key(), entry->variant().toByteArray());
+        } else if (name == "ServiceData"_L1) {
+            device.serviceData.clear();
+            const ServiceDataList data = qdbus_cast<ServiceDataList>(it.value());
+            for (auto entry = data.cbegin(); entry != data.cend(); ++entry)
+                device.serviceData.insert(entry.key(), entry->variant().toByteArray());
+        }
+    }
+}
+
+static void invalidateDeviceProperties(
+        QBluetoothDeviceDiscoveryAgentPrivate::DeviceProperties &device,
+        const QStringList &properties)
+{
+    for (const QString &name : properties) {
+        if (name == "Address"_L1)
+            device.address = QBluetoothAddress();
+        else if (name == "Alias"_L1)
+            device.alias.clear();
+        else if (name == "Class"_L1)
+            device.deviceClass = 0;
+        else if (name == "RSSI"_L1)
+            device.rssi = 0;
+        else if (name == "UUIDs"_L1)
+            device.uuids.clear();
+        else if (name == "ManufacturerData"_L1)
+            device.manufacturerData.clear();
+        else if (name == "ServiceData"_L1)
+            device.serviceData.clear();
+    }
+}
+
 // Returns invalid QBluetoothDeviceInfo in case of error
-static QBluetoothDeviceInfo createDeviceInfoFromBluez5Device(const QVariantMap& properties)
+static QBluetoothDeviceInfo createDeviceInfoFromBluez5Device(
+        const QBluetoothDeviceDiscoveryAgentPrivate::DeviceProperties &device)
 {
-    const QBluetoothAddress btAddress(properties[QStringLiteral("Address")].toString());
-    if (btAddress.isNull())
+    if (device.address.isNull())
         return QBluetoothDeviceInfo();
 
-    const QString btName = properties[QStringLiteral("Alias")].toString();
-    quint32 btClass = properties[QStringLiteral("Class")].toUInt();
-
-    QBluetoothDeviceInfo deviceInfo(btAddress, btName, btClass);
-    deviceInfo.setRssi(qvariant_cast<short>(properties[QStringLiteral("RSSI")]));
+    QBluetoothDeviceInfo deviceInfo(device.address, device.alias, device.deviceClass);
+    deviceInfo.setRssi(device.rssi);
+    deviceInfo.setServiceUuids(device.uuids);
 
-    QList<QBluetoothUuid> uuids;
     bool foundLikelyLowEnergyUuid = false;
-    const QStringList foundUuids = qvariant_cast<QStringList>(properties[QStringLiteral("UUIDs")]);
-    for (const auto &u: foundUuids) {
-        const QBluetoothUuid id(u);
-        if (id.isNull())
-            continue;
-
-        if (!foundLikelyLowEnergyUuid) {
-            //once we found one BTLE service we are done
-            bool ok = false;
-            quint16 shortId = id.toUInt16(&ok);
-            quint16 genericAccessInt = static_cast<quint16>(QBluetoothUuid::ServiceClassUuid::GenericAccess);
-            if (ok && ((shortId & genericAccessInt) == genericAccessInt))
-                foundLikelyLowEnergyUuid = true;
+    for (const QBluetoothUuid &id : device.uuids) {
+        //once we found one BTLE service we are done
+        bool ok = false;
+        quint16 shortId = id.toUInt16(&ok);
+        quint16 genericAccessInt = static_cast<quint16>(QBluetoothUuid::ServiceClassUuid::GenericAccess);
+        if (ok && ((shortId & genericAccessInt) == genericAccessInt)) {
+            foundLikelyLowEnergyUuid = true;
+            break;
         }
-        uuids.append(id);
     }
-    deviceInfo.setServiceUuids(uuids);
 
-    if (!btClass) {
+    if (!device.deviceClass) {
         deviceInfo.setCoreConfigurations(QBluetoothDeviceInfo::LowEnergyCoreConfiguration);
     } else {
         deviceInfo.setCoreConfigurations(QBluetoothDeviceInfo::BaseRateCoreConfiguration);
@@ -244,18 +342,11 @@ static QBluetoothDeviceInfo createDeviceInfoFromBluez5Device(const QVariantMap&
             deviceInfo.setCoreConfigurations(QBluetoothDeviceInfo::BaseRateAndLowEnergyCoreConfiguration);
     }
 
-    const ManufacturerDataList deviceManufacturerData = qdbus_cast<ManufacturerDataList>(properties[QStringLiteral("ManufacturerData")]);
-    const QList<quint16> keysManufacturer = deviceManufacturerData.keys();
-    for (quint16 key : keysManufacturer)
-        deviceInfo.setManufacturerData(
-                    key, deviceManufacturerData.value(key).variant().toByteArray());
+    for (auto it = device.manufacturerData.cbegin(); it != device.manufacturerData.cend(); ++it)
+        deviceInfo.setManufacturerData(it.key(), it.value());
 
-    const ServiceDataList deviceServiceData =
-            qdbus_cast<ServiceDataList>(properties[QStringLiteral("ServiceData")]);
-    const QList<QString> keysService = deviceServiceData.keys();
-    for (QString key : keysService)
-        deviceInfo.setServiceData(QBluetoothUuid(key),
-                                  deviceServiceData.value(key).variant().toByteArray());
+    for (auto it = device.serviceData.cbegin(); it != device.serviceData.cend(); ++it)
+        deviceInfo.setServiceData(QBluetoothUuid(it.key()), it.value());
 
     return deviceInfo;
 }
@@ -273,7 +364,9 @@ void QBluetoothDeviceDiscoveryAgentPrivate::deviceFound(const QString &devicePat
         return;
 
     // read information
-    QBluetoothDeviceInfo deviceInfo = createDeviceInfoFromBluez5Device(properties);
+    DeviceProperties device;
+    updateDeviceProperties(device, properties);
+    QBluetoothDeviceInfo deviceInfo = createDeviceInfoFromBluez5Device(device);
     if (!deviceInfo.isValid()) // no point reporting an empty address
         return;
 
@@ -285,7 +378,27 @@ void QBluetoothDeviceDiscoveryAgentPrivate::deviceFound(const QString &devicePat
                          << "Num ServiceData" << deviceInfo.serviceData().size();
 
     // Cache the properties so we do not have to access dbus every time to get a value
-    devicesProperties[devicePath] = properties;
+    const auto cached = devicesProperties.find(devicePath);
+    const bool newDevice = cached == devicesProperties.end();
+    if (!newDevice) {
+        device.lastSeen = cached->lastSeen;
+        *cached = std::move(device);
+        markSeen(devicePath, *cached);
+    } else {
+        markSeen(devicePath, *devicesProperties.insert(devicePath, std::move(device)));
+    }
+
+    reportDevice(deviceInfo);
+
+    // The device just found is the most recently seen one and stays. Slots
+    // connected to deviceDiscovered() may have stopped the discovery.
+    if (newDevice && q->isActive())
+        pruneDevices();
+}
+
+void QBluetoothDeviceDiscoveryAgentPrivate::reportDevice(const QBluetoothDeviceInfo &deviceInfo)
+{
+    Q_Q(QBluetoothDeviceDiscoveryAgent);
 
     for (qsizetype i = 0; i < discoveredDevices.size(); ++i) {
         if (discoveredDevices[i].address() == deviceInfo.address()) {
@@ -320,6 +433,102 @@ void QBluetoothDeviceDiscoveryAgentPrivate::_q_InterfacesAdded(const QDBusObject
     }
 }
 
+void QBluetoothDeviceDiscoveryAgentPrivate::_q_InterfacesRemoved(const QDBusObjectPath &object_path,
+                                                                 const QStringList &interfaces)
+{
+    Q_Q(QBluetoothDeviceDiscoveryAgent);
+
+    if (!q->isActive() || !interfaces.contains("org.bluez.Device1"_L1))
+        return;
+
+    // bluetoothd removes devices it did not see for a while. A timed
+    // discovery reports all devices it found when it finishes, a
+    // continuous one follows the devices in range.
+    if (lowEnergySearchTimeout == 0)
+        removeLostDevice(object_path.path());
+    else
+        forgetDevice(object_path.path());
+}
+
+void QBluetoothDeviceDiscoveryAgentPrivate::markSeen(const QString &devicePath,
+                                                     DeviceProperties &device)
+{
+    recentlySeen.remove(device.lastSeen);
+    device.lastSeen = ++seenCount;
+    recentlySeen.insert(device.lastSeen, devicePath);
+}
+
+// Drops the cached properties, returns the address of the device
+QBluetoothAddress QBluetoothDeviceDiscoveryAgentPrivate::forgetDevice(const QString &devicePath)
+{
+    const auto it = devicesProperties.constFind(devicePath);
+    if (it == devicesProperties.cend())
+        return QBluetoothAddress();
+
+    const QBluetoothAddress address = it->address;
+    recentlySeen.remove(it->lastSeen);
+    devicesProperties.erase(it);
+    return address;
+}
+
+void QBluetoothDeviceDiscoveryAgentPrivate::removeLostDevice(const QString &devicePath)
+{
+    Q_Q(QBluetoothDeviceDiscoveryAgent);
+
+    const QBluetoothAddress address = forgetDevice(devicePath);
+    if (address.isNull())
+        return;
+
+    const auto it = std::find_if(discoveredDevices.cbegin(), discoveredDevices.cend(),
+                                 [&address](const QBluetoothDeviceInfo &info) {
+        return info.address() == address;
+    });
+    if (it == discoveredDevices.cend())
+        return;
+
+    const QBluetoothDeviceInfo info = *it;
+    discoveredDevices.erase(it);
+    qCDebug(QT_BT_BLUEZ) << "Lost:" << info.name() << address
+                         << "total device" << discoveredDevices.size();
+    emit q->deviceLost(info);
+}
+
+void QBluetoothDeviceDiscoveryAgentPrivate::pruneDevices()
+{
+    Q_Q(QBluetoothDeviceDiscoveryAgent);
+
+    if (maximumDevices <= 0)
+        return;
+
+    // Slots connected to deviceLost() may stop or restart the discovery
+    while (q->isActive() && devicesProperties.size() > maximumDevices
+           && !recentlySeen.isEmpty()) {
+        const QString devicePath = recentlySeen.first();
+        removeLostDevice(devicePath);
+    }
+}
+
+/*
+    Reports a device of the object tree again, the changed properties may
+    not have been applied to the tree yet.
+*/
+void QBluetoothDeviceDiscoveryAgentPrivate::rediscoverDevice(
+        const QString &devicePath, const QVariantMap &changedProperties,
+        const QStringList &invalidatedProperties)
+{
+    const QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    // Devices of a tree that is still loading are reported once it is loaded
+    if (!objectTree->hasInterface(devicePath, QStringLiteral("org.bluez.Device1")))
+        return;
+
+    QVariantMap properties =
+            objectTree->properties(devicePath, QStringLiteral("org.bluez.Device1"));
+    for (const QString &name : invalidatedProperties)
+        properties.remove(name);
+    properties.insert(changedProperties);
+    deviceFound(devicePath, properties);
+}
+
 void QBluetoothDeviceDiscoveryAgentPrivate::_q_discoveryFinished()
 {
     Q_Q(QBluetoothDeviceDiscoveryAgent);
@@ -327,11 +536,18 @@ void QBluetoothDeviceDiscoveryAgentPrivate::_q_discoveryFinished()
     if (discoveryTimer)
         discoveryTimer->stop();
 
-    QtBluezDiscoveryManager::instance()->disconnect(q);
-    QtBluezDiscoveryManager::instance()->unregisterDiscoveryInterest(adapter->path());
+    if (filterWatcher) {
+        // stopped before the discovery was started, the reply is dropped
+        delete filterWatcher;
+        filterWatcher = nullptr;
+    } else {
+        QtBluezDiscoveryManager::instance()->disconnect(q);
+        QtBluezDiscoveryManager::instance()->unregisterDiscoveryInterest(adapter->path());
+    }
 
     qDeleteAll(propertyMonitors);
     propertyMonitors.clear();
+    QObject::disconnect(objectTreeConnection);
 
     delete adapter;
     adapter = nullptr;
@@ -365,6 +581,7 @@ void QBluetoothDeviceDiscoveryAgentPrivate::_q_discoveryInterrupted(const QStrin
         QtBluezDiscoveryManager::instance()->disconnect(q);
         // no need to call unregisterDiscoveryInterest since QtBluezDiscoveryManager
         // does this automatically when emitting discoveryInterrupted(QString) signal
+        QObject::disconnect(objectTreeConnection);
 
         delete adapter;
         adapter = nullptr;
@@ -384,21 +601,21 @@ void QBluetoothDeviceDiscoveryAgentPrivate::_q_PropertiesChanged(const QString &
     if (interface != QStringLiteral("org.bluez.Device1"))
         return;
 
-    if (!devicesProperties.contains(path))
+    const auto cached = devicesProperties.find(path);
+    if (cached == devicesProperties.end()) {
+        // The device was dropped by pruneDevices() and is seen again
+        if (q->isActive())
+            rediscoverDevice(path, changed_properties, invalidated_properties);
         return;
+    }
 
     // Update the cached properties before checking changed_properties for RSSI and ManufacturerData
     // so the cached properties are always up to date.
-    QVariantMap & properties = devicesProperties[path];
-    for (QVariantMap::const_iterator it = changed_properties.constBegin();
-         it != changed_properties.constEnd(); ++it) {
-        properties[it.key()] = it.value();
-    }
-
-    for (const QString & property : invalidated_properties)
-        properties.remove(property);
+    updateDeviceProperties(*cached, changed_properties);
+    invalidateDeviceProperties(*cached, invalidated_properties);
+    markSeen(path, *cached);
 
-    const auto info = createDeviceInfoFromBluez5Device(properties);
+    const auto info = createDeviceInfoFromBluez5Device(*cached);
     if (!info.isValid())
         return;
 
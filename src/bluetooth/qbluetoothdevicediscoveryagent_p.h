@@ -28,6 +28,7 @@
 #include "darwin/btraii_p.h"
 #endif // Q_OS_DARWIN
 
+#include <QtCore/QHash>
 #include <QtCore/QVariantMap>
 
 #include <QtBluetooth/QBluetoothAddress>
@@ -90,12 +91,26 @@ public:
 #if QT_CONFIG(bluez)
     void _q_InterfacesAdded(const QDBusObjectPath &object_path,
                             InterfaceList interfaces_and_properties);
+    void _q_InterfacesRemoved(const QDBusObjectPath &object_path, const QStringList &interfaces);
     void _q_discoveryFinished();
     void _q_discoveryInterrupted(const QString &path);
     void _q_PropertiesChanged(const QString &interface,
                               const QString &path,
                               const QVariantMap &changed_properties,
                               const QStringList &invalidated_properties);
+
+    // The Device1 properties the device information is created from
+    struct DeviceProperties
+    {
+        QBluetoothAddress address;
+        QString alias;
+        quint32 deviceClass = 0;
+        qint16 rssi = 0;
+        QList<QBluetoothUuid> uuids;
+        QMap<quint16, QByteArray> manufacturerData;
+        QMap<QString, QByteArray> serviceData;
+        quint64 lastSeen = 0; // key in recentlySeen
+    };
 #endif
 
 private:
@@ -134,10 +149,26 @@ private:
     OrgBluezAdapter1Interface *adapter = nullptr;
     QTimer *discoveryTimer = nullptr;
     QList<OrgFreedesktopDBusPropertiesInterfaceBluetooth *> propertyMonitors;
+    QDBusPendingCallWatcher *filterWatcher = nullptr;
+    // Waits for the object tree if it was not loaded when the discovery started
+    QMetaObject::Connection objectTreeConnection;
 
+    void startDiscovery(const QDBusPendingReply<> &filterReply,
+                        QBluetoothDeviceDiscoveryAgent::DiscoveryMethods methods);
+    bool reportKnownDevices();
     void deviceFound(const QString &devicePath, const QVariantMap &properties);
-
-    QMap<QString, QVariantMap> devicesProperties;
+    void reportDevice(const QBluetoothDeviceInfo &deviceInfo);
+    void markSeen(const QString &devicePath, DeviceProperties &device);
+    QBluetoothAddress forgetDevice(const QString &devicePath);
+    void removeLostDevice(const QString &devicePath);
+    void pruneDevices();
+    void rediscoverDevice(const QString &devicePath, const QVariantMap &changedProperties,
+                          const QStringList &invalidatedProperties);
+
+    QHash<QString, DeviceProperties> devicesProperties;
+    // Paths of the devices in devicesProperties, least recently seen first
+    QMap<quint64, QString> recentlySeen;
+    quint64 seenCount = 0;
 #endif
 
 #ifdef QT_WINRT_BLUETOOTH
@@ -203,6 +234,8 @@ private:
 #endif // Q_OS_DARWIN
 
     int lowEnergySearchTimeout = 40000;
+    // 0 keeps all devices, -1 if the backend cannot bound them
+    int maximumDevices = -1;
     QBluetoothDeviceDiscoveryAgent::DiscoveryMethods requestedMethods;
     QBluetoothDeviceDiscoveryAgent *q_ptr;
 };
@@ -4,8 +4,104 @@
 #include "qbluetoothdeviceinfo.h"
 #include "qbluetoothdeviceinfo_p.h"
 
+#include <QtCore/QGlobalStatic>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+/*
+    A scan decodes the name of every device into a string of its own,
+    although many devices of the same kind advertise the same name. The
+    pool hands out one string per name. Names nobody else refers to any
+    more are dropped once the pool has doubled since the last sweep.
+*/
+class NamePool
+{
+public:
+    QString intern(const QString &name)
+    {
+        QMutexLocker locker(&mutex);
+        const auto it = names.constFind(name);
+        if (it != names.cend())
+            return *it;
+
+        if (names.size() >= sweepSize) {
+            names.removeIf([](const QString &pooled) { return pooled.isDetached(); });
+            sweepSize = std::max(MinimumSweepSize, 2 * names.size());
+        }
+        names.insert(name);
+        return name;
+    }
+
+private:
+    static constexpr qsizetype MinimumSweepSize = 64;
+
+    QMutex mutex;
+    QSet<QString> names;
+    qsizetype sweepSize = MinimumSweepSize;
+};
+
+Q_GLOBAL_STATIC(NamePool, namePool)
+
+template <typename Key>
+using AdvertisementData = QBluetoothDeviceInfoPrivate::AdvertisementData<Key>;
+
+template <typename Key>
+bool containsEntry(const AdvertisementData<Key> &entries, const Key &key, const QByteArray &data)
+{
+    return std::any_of(entries.cbegin(), entries.cend(), [&](const auto &entry) {
+        return entry.first == key && entry.second == data;
+    });
+}
+
+// The entries are unique, the order of insertion does not matter
+template <typename Key>
+bool sameEntries(const AdvertisementData<Key> &a, const AdvertisementData<Key> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    return std::all_of(a.cbegin(), a.cend(), [&](const auto &entry) {
+        return containsEntry(b, entry.first, entry.second);
+    });
+}
+
+template <typename Key>
+QList<Key> entryKeys(const AdvertisementData<Key> &entries)
+{
+    QList<Key> keys;
+    keys.reserve(entries.size());
+    for (const auto &entry : entries)
+        keys.append(entry.first);
+    return keys;
+}
+
+// The most recently inserted data for key, like QMultiHash::value()
+template <typename Key>
+QByteArray latestEntry(const AdvertisementData<Key> &entries, const Key &key)
+{
+    const auto it = std::find_if(entries.crbegin(), entries.crend(), [&](const auto &entry) {
+        return entry.first == key;
+    });
+    return it != entries.crend() ? it->second : QByteArray();
+}
+
+template <typename Key>
+QMultiHash<Key, QByteArray> toMultiHash(const AdvertisementData<Key> &entries)
+{
+    QMultiHash<Key, QByteArray> hash;
+    hash.reserve(entries.size());
+    for (const auto &entry : entries)
+        hash.insert(entry.first, entry.second);
+    return hash;
+}
+
+} // unnamed namespace
+
 QT_IMPL_METATYPE_EXTERN(QBluetoothDeviceInfo)
 #ifdef QT_WINRT_BLUETOOTH
 QT_IMPL_METATYPE_EXTERN_TAGGED(QBluetoothDeviceInfo::Fields, QBluetoothDeviceInfo__Fields)
@@ -232,7 +328,34 @@ QT_IMPL_METATYPE_EXTERN_TAGGED(QBluetoothDeviceInfo::Fields, QBluetoothDeviceInf
     \value LowEnergyCoreConfiguration           The device is a Bluetooth Low Energy device.
 */
 QBluetoothDeviceInfoPrivate::QBluetoothDeviceInfoPrivate()
+    : valid(false),
+      cached(false),
+      deviceCoreConfiguration(QBluetoothDeviceInfo::UnknownCoreConfiguration),
+      majorDeviceClass(QBluetoothDeviceInfo::MiscellaneousDevice),
+      serviceClasses(QBluetoothDeviceInfo::NoService)
+{
+    ref.ref();
+}
+
+QBluetoothDeviceInfoPrivate *QBluetoothDeviceInfoPrivate::detach(QBluetoothDeviceInfoPrivate *&d)
+{
+    if (d->ref.loadRelaxed() != 1) {
+        QBluetoothDeviceInfoPrivate *copy = new QBluetoothDeviceInfoPrivate(*d);
+        copy->ref.ref();
+        if (!d->ref.deref())
+            delete d;
+        d = copy;
+    }
+    return d;
+}
+
+QString QBluetoothDeviceInfoPrivate::internedName(const QString &name)
 {
+    if (name.isEmpty())
+        return name;
+    // Devices may still be created while the application shuts down
+    NamePool *pool = namePool();
+    return pool ? pool->intern(name) : name;
 }
 
 /*!
@@ -264,11 +387,11 @@ QBluetoothDeviceInfo::QBluetoothDeviceInfo(const QBluetoothAddress &address, con
     Q_D(QBluetoothDeviceInfo);
 
     d->address = address;
-    d->name = name;
+    d->name = QBluetoothDeviceInfoPrivate::internedName(name);
 
     d->minorDeviceClass = static_cast<quint8>((classOfDevice >> 2) & 0x3f);
-    d->majorDeviceClass = static_cast<MajorDeviceClass>((classOfDevice >> 8) & 0x1f);
-    d->serviceClasses = static_cast<ServiceClasses>((classOfDevice >> 13) & 0x7ff);
+    d->majorDeviceClass = (classOfDevice >> 8) & 0x1f;
+    d->serviceClasses = (classOfDevice >> 13) & 0x7ff;
 
     d->valid = true;
     d->cached = false;
@@ -292,12 +415,12 @@ QBluetoothDeviceInfo::QBluetoothDeviceInfo(const QBluetoothUuid &uuid, const QSt
 {
     Q_D(QBluetoothDeviceInfo);
 
-    d->name = name;
+    d->name = QBluetoothDeviceInfoPrivate::internedName(name);
     d->deviceUuid = uuid;
 
     d->minorDeviceClass = static_cast<quint8>((classOfDevice >> 2) & 0x3f);
-    d->majorDeviceClass = static_cast<MajorDeviceClass>((classOfDevice >> 8) & 0x1f);
-    d->serviceClasses = static_cast<ServiceClasses>((classOfDevice >> 13) & 0x7ff);
+    d->majorDeviceClass = (classOfDevice >> 8) & 0x1f;
+    d->serviceClasses = (classOfDevice >> 13) & 0x7ff;
 
     d->valid = true;
     d->cached = false;
@@ -308,9 +431,9 @@ QBluetoothDeviceInfo::QBluetoothDeviceInfo(const QBluetoothUuid &uuid, const QSt
     Constructs a QBluetoothDeviceInfo that is a copy of \a other.
 */
 QBluetoothDeviceInfo::QBluetoothDeviceInfo(const QBluetoothDeviceInfo &other) :
-    d_ptr(new QBluetoothDeviceInfoPrivate)
+    d_ptr(other.d_ptr)
 {
-    *this = other;
+    d_ptr->ref.ref();
 }
 
 /*!
@@ -318,7 +441,8 @@ QBluetoothDeviceInfo::QBluetoothDeviceInfo(const QBluetoothDeviceInfo &other) :
 */
 QBluetoothDeviceInfo::~QBluetoothDeviceInfo()
 {
-    delete d_ptr;
+    if (!d_ptr->ref.deref())
+        delete d_ptr;
 }
 
 /*!
@@ -346,7 +470,9 @@ qint16 QBluetoothDeviceInfo::rssi() const
   */
 void QBluetoothDeviceInfo::setRssi(qint16 signal)
 {
-    Q_D(QBluetoothDeviceInfo);
+    if (d_ptr->rssi == signal)
+        return;
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
     d->rssi = signal;
 }
 
@@ -355,21 +481,12 @@ void QBluetoothDeviceInfo::setRssi(qint16 signal)
 */
 QBluetoothDeviceInfo &QBluetoothDeviceInfo::operator=(const QBluetoothDeviceInfo &other)
 {
-    Q_D(QBluetoothDeviceInfo);
-
-    d->address = other.d_func()->address;
-    d->name = other.d_func()->name;
-    d->minorDeviceClass = other.d_func()->minorDeviceClass;
-    d->majorDeviceClass = other.d_func()->majorDeviceClass;
-    d->serviceClasses = other.d_func()->serviceClasses;
-    d->valid = other.d_func()->valid;
-    d->cached = other.d_func()->cached;
-    d->serviceUuids = other.d_func()->serviceUuids;
-    d->manufacturerData = other.d_func()->manufacturerData;
-    d->serviceData = other.d_func()->serviceData;
-    d->rssi = other.d_func()->rssi;
-    d->deviceCoreConfiguration = other.d_func()->deviceCoreConfiguration;
-    d->deviceUuid = other.d_func()->deviceUuid;
+    if (d_ptr != other.d_ptr) {
+        other.d_ptr->ref.ref();
+        if (!d_ptr->ref.deref())
+            delete d_ptr;
+        d_ptr = other.d_ptr;
+    }
 
     return *this;
 }
@@ -392,6 +509,8 @@ QBluetoothDeviceInfo &QBluetoothDeviceInfo::operator=(const QBluetoothDeviceInfo
 
 bool QBluetoothDeviceInfo::equals(const QBluetoothDeviceInfo &a, const QBluetoothDeviceInfo &b)
 {
+    if (a.d_ptr == b.d_ptr)
+        return true;
     if (a.d_func()->cached != b.d_func()->cached)
         return false;
     if (a.d_func()->valid != b.d_func()->valid)
@@ -410,9 +529,9 @@ bool QBluetoothDeviceInfo::equals(const QBluetoothDeviceInfo &a, const QBluetoot
         return false;
     if (a.d_func()->serviceUuids != b.d_func()->serviceUuids)
         return false;
-    if (a.d_func()->manufacturerData != b.d_func()->manufacturerData)
+    if (!sameEntries(a.d_func()->manufacturerData, b.d_func()->manufacturerData))
         return false;
-    if (a.d_func()->serviceData != b.d_func()->serviceData)
+    if (!sameEntries(a.d_func()->serviceData, b.d_func()->serviceData))
         return false;
     if (a.d_func()->deviceCoreConfiguration != b.d_func()->deviceCoreConfiguration)
         return false;
@@ -455,9 +574,9 @@ QString QBluetoothDeviceInfo::name() const
  */
 void QBluetoothDeviceInfo::setName(const QString &name)
 {
-    Q_D(QBluetoothDeviceInfo);
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
 
-    d->name = name;
+    d->name = QBluetoothDeviceInfoPrivate::internedName(name);
 }
 
 /*!
@@ -467,7 +586,7 @@ QBluetoothDeviceInfo::ServiceClasses QBluetoothDeviceInfo::serviceClasses() cons
 {
     Q_D(const QBluetoothDeviceInfo);
 
-    return d->serviceClasses;
+    return ServiceClasses::fromInt(d->serviceClasses);
 }
 
 /*!
@@ -477,7 +596,7 @@ QBluetoothDeviceInfo::MajorDeviceClass QBluetoothDeviceInfo::majorDeviceClass()
 {
     Q_D(const QBluetoothDeviceInfo);
 
-    return d->majorDeviceClass;
+    return MajorDeviceClass(d->majorDeviceClass);
 }
 
 /*!
@@ -501,7 +620,7 @@ quint8 QBluetoothDeviceInfo::minorDeviceClass() const
  */
 void QBluetoothDeviceInfo::setServiceUuids(const QList<QBluetoothUuid> &uuids)
 {
-    Q_D(QBluetoothDeviceInfo);
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
     d->serviceUuids = uuids;
 }
 
@@ -529,7 +648,7 @@ QList<QBluetoothUuid> QBluetoothDeviceInfo::serviceUuids() const
 QList<quint16> QBluetoothDeviceInfo::manufacturerIds() const
 {
     Q_D(const QBluetoothDeviceInfo);
-    return d->manufacturerData.keys().toList();
+    return entryKeys(d->manufacturerData);
 }
 
 /*!
@@ -558,7 +677,7 @@ QList<quint16> QBluetoothDeviceInfo::manufacturerIds() const
 QByteArray QBluetoothDeviceInfo::manufacturerData(quint16 manufacturerId) const
 {
     Q_D(const QBluetoothDeviceInfo);
-    return d->manufacturerData.value(manufacturerId);
+    return latestEntry(d->manufacturerData, manufacturerId);
 }
 
 /*!
@@ -573,15 +692,11 @@ QByteArray QBluetoothDeviceInfo::manufacturerData(quint16 manufacturerId) const
 */
 bool QBluetoothDeviceInfo::setManufacturerData(quint16 manufacturerId, const QByteArray &data)
 {
-    Q_D(QBluetoothDeviceInfo);
-    auto it = d->manufacturerData.constFind(manufacturerId);
-    while (it != d->manufacturerData.cend() && it.key() == manufacturerId) {
-        if (*it == data)
-            return false;
-        it++;
-    }
+    if (containsEntry(d_ptr->manufacturerData, manufacturerId, data))
+        return false;
 
-    d->manufacturerData.insert(manufacturerId, data);
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
+    d->manufacturerData.append({manufacturerId, data});
     return true;
 }
 
@@ -599,7 +714,7 @@ bool QBluetoothDeviceInfo::setManufacturerData(quint16 manufacturerId, const QBy
 QMultiHash<quint16, QByteArray> QBluetoothDeviceInfo::manufacturerData() const
 {
     Q_D(const QBluetoothDeviceInfo);
-    return d->manufacturerData;
+    return toMultiHash(d->manufacturerData);
 }
 
 /*!
@@ -611,7 +726,7 @@ QMultiHash<quint16, QByteArray> QBluetoothDeviceInfo::manufacturerData() const
 QList<QBluetoothUuid> QBluetoothDeviceInfo::serviceIds() const
 {
     Q_D(const QBluetoothDeviceInfo);
-    return d->serviceData.keys().toList();
+    return entryKeys(d->serviceData);
 }
 
 /*!
@@ -635,7 +750,7 @@ QList<QBluetoothUuid> QBluetoothDeviceInfo::serviceIds() const
 QByteArray QBluetoothDeviceInfo::serviceData(const QBluetoothUuid &serviceId) const
 {
     Q_D(const QBluetoothDeviceInfo);
-    return d->serviceData.value(serviceId);
+    return latestEntry(d->serviceData, serviceId);
 }
 
 /*!
@@ -647,15 +762,11 @@ QByteArray QBluetoothDeviceInfo::serviceData(const QBluetoothUuid &serviceId) co
 */
 bool QBluetoothDeviceInfo::setServiceData(const QBluetoothUuid &serviceId, const QByteArray &data)
 {
-    Q_D(QBluetoothDeviceInfo);
-    auto it = d->serviceData.constFind(serviceId);
-    while (it != d->serviceData.cend() && it.key() == serviceId) {
-        if (*it == data)
-            return false;
-        it++;
-    }
+    if (containsEntry(d_ptr->serviceData, serviceId, data))
+        return false;
 
-    d->serviceData.insert(serviceId, data);
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
+    d->serviceData.append({serviceId, data});
     return true;
 }
 
@@ -673,7 +784,7 @@ bool QBluetoothDeviceInfo::setServiceData(const QBluetoothUuid &serviceId, const
 QMultiHash<QBluetoothUuid, QByteArray> QBluetoothDeviceInfo::serviceData() const
 {
     Q_D(const QBluetoothDeviceInfo);
-    return d->serviceData;
+    return toMultiHash(d->serviceData);
 }
 
 /*!
@@ -685,9 +796,9 @@ QMultiHash<QBluetoothUuid, QByteArray> QBluetoothDeviceInfo::serviceData() const
 */
 void QBluetoothDeviceInfo::setCoreConfigurations(QBluetoothDeviceInfo::CoreConfigurations coreConfigs)
 {
-    Q_D(QBluetoothDeviceInfo);
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
 
-    d->deviceCoreConfiguration = coreConfigs;
+    d->deviceCoreConfiguration = coreConfigs.toInt();
 }
 
 /*!
@@ -702,7 +813,7 @@ QBluetoothDeviceInfo::CoreConfigurations QBluetoothDeviceInfo::coreConfiguration
 {
     Q_D(const QBluetoothDeviceInfo);
 
-    return d->deviceCoreConfiguration;
+    return CoreConfigurations::fromInt(d->deviceCoreConfiguration);
 }
 
 /*!
@@ -721,7 +832,7 @@ bool QBluetoothDeviceInfo::isCached() const
   */
 void QBluetoothDeviceInfo::setCached(bool cached)
 {
-    Q_D(QBluetoothDeviceInfo);
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
 
     d->cached = cached;
 }
@@ -738,7 +849,7 @@ void QBluetoothDeviceInfo::setCached(bool cached)
   */
 void QBluetoothDeviceInfo::setDeviceUuid(const QBluetoothUuid &uuid)
 {
-    Q_D(QBluetoothDeviceInfo);
+    QBluetoothDeviceInfoPrivate *d = QBluetoothDeviceInfoPrivate::detach(d_ptr);
 
     d->deviceUuid = uuid;
 }
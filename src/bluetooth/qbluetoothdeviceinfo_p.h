@@ -21,30 +21,56 @@
 
 #include <QString>
 #include <QtCore/qhash.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtCore/private/qglobal_p.h>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
-class QBluetoothDeviceInfoPrivate
+/*
+    Shared between the copies of a QBluetoothDeviceInfo, the setters detach.
+    Scans keep one entry per device for their whole duration, the layout is
+    kept small for that: the classes and flags are packed, most devices
+    advertise at most one manufacturer and one service data entry, which
+    are stored inline, and equal names share one string.
+*/
+class QBluetoothDeviceInfoPrivate : public QSharedData
 {
 public:
+    // The new private belongs to the QBluetoothDeviceInfo creating it
     QBluetoothDeviceInfoPrivate();
 
-    bool valid = false;
-    bool cached = false;
+    // Makes d unshared, returns the private the caller may modify
+    static QBluetoothDeviceInfoPrivate *detach(QBluetoothDeviceInfoPrivate *&d);
+    static const QBluetoothDeviceInfoPrivate *get(const QBluetoothDeviceInfo &info)
+    {
+        return info.d_ptr;
+    }
+
+    // Returns a string equal to name that shares the data of other names
+    // equal to it
+    static QString internedName(const QString &name);
+
+    // Entries in order of insertion, without duplicates
+    template <typename Key>
+    using AdvertisementData = QVarLengthArray<std::pair<Key, QByteArray>, 1>;
+
     qint16 rssi = 1;
     quint8 minorDeviceClass = 0;
+    quint8 valid : 1;
+    quint8 cached : 1;
+    quint8 deviceCoreConfiguration : 2;     // QBluetoothDeviceInfo::CoreConfigurations
+    quint16 majorDeviceClass : 5;           // QBluetoothDeviceInfo::MajorDeviceClass
+    quint16 serviceClasses : 11;            // QBluetoothDeviceInfo::ServiceClasses
 
     QBluetoothAddress address;
     QString name;
-    QBluetoothDeviceInfo::MajorDeviceClass majorDeviceClass = QBluetoothDeviceInfo::MiscellaneousDevice;
-
-    QBluetoothDeviceInfo::ServiceClasses serviceClasses = QBluetoothDeviceInfo::NoService;
 
     QList<QBluetoothUuid> serviceUuids;
-    QMultiHash<quint16, QByteArray> manufacturerData;
-    QMultiHash<QBluetoothUuid, QByteArray> serviceData;
-    QBluetoothDeviceInfo::CoreConfigurations deviceCoreConfiguration = QBluetoothDeviceInfo::UnknownCoreConfiguration;
+    AdvertisementData<quint16> manufacturerData;
+    AdvertisementData<QBluetoothUuid> serviceData;
 
     QBluetoothUuid deviceUuid;
 };
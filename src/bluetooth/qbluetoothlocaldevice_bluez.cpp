@@ -10,6 +10,7 @@
 #include "qbluetoothlocaldevice_p.h"
 
 #include "bluez/bluez5_helper_p.h"
+#include "bluez/bluezobjecttree_p.h"
 #include "bluez/objectmanager_p.h"
 #include "bluez/properties_p.h"
 #include "bluez/adapter1_bluez5_p.h"
@@ -117,34 +118,23 @@ QList<QBluetoothHostInfo> QBluetoothLocalDevice::allDevices()
     QList<QBluetoothHostInfo> localDevices;
 
     initializeBluez5();
-    OrgFreedesktopDBusObjectManagerInterface manager(
-            QStringLiteral("org.bluez"), QStringLiteral("/"), QDBusConnection::systemBus());
-    QDBusPendingReply<ManagedObjectList> reply = manager.GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError())
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    if (!objectTree->ensureLoaded())
         return localDevices;
 
-    ManagedObjectList managedObjectList = reply.value();
-    for (ManagedObjectList::const_iterator it = managedObjectList.constBegin();
-         it != managedObjectList.constEnd(); ++it) {
-        const InterfaceList &ifaceList = it.value();
-
-        for (InterfaceList::const_iterator jt = ifaceList.constBegin(); jt != ifaceList.constEnd();
-             ++jt) {
-            const QString &iface = jt.key();
-            const QVariantMap &ifaceValues = jt.value();
+    const QStringList adapterPaths = objectTree->adapterPaths();
+    for (const QString &path : adapterPaths) {
+        const QVariantMap ifaceValues =
+                objectTree->properties(path, QStringLiteral("org.bluez.Adapter1"));
 
-            if (iface == QStringLiteral("org.bluez.Adapter1")) {
-                QBluetoothHostInfo hostInfo;
-                const QString temp = ifaceValues.value(QStringLiteral("Address")).toString();
+        QBluetoothHostInfo hostInfo;
+        const QString temp = ifaceValues.value(QStringLiteral("Address")).toString();
 
-                hostInfo.setAddress(QBluetoothAddress(temp));
-                if (hostInfo.address().isNull())
-                    continue;
-                hostInfo.setName(ifaceValues.value(QStringLiteral("Name")).toString());
-                localDevices.append(hostInfo);
-            }
-        }
+        hostInfo.setAddress(QBluetoothAddress(temp));
+        if (hostInfo.address().isNull())
+            continue;
+        hostInfo.setName(ifaceValues.value(QStringLiteral("Name")).toString());
+        localDevices.append(hostInfo);
     }
     return localDevices;
 }
@@ -222,10 +212,7 @@ void QBluetoothLocalDevicePrivate::requestPairing(const QBluetoothAddress &targe
 
             if (iface == QStringLiteral("org.bluez.Device1")) {
 
-                OrgBluezDevice1Interface device(QStringLiteral("org.bluez"),
-                                                path.path(),
-                                                QDBusConnection::systemBus());
-                if (targetAddress == QBluetoothAddress(device.address())) {
+                if (targetAddress == addressFromDevicePath(path.path())) {
                     qCDebug(QT_BT_BLUEZ) << "Initiating direct pair to" << targetAddress.toString();
                     //device exist -> directly work with it
                     processPairing(path.path(), targetPairing);
@@ -358,20 +345,18 @@ QBluetoothLocalDevice::Pairing QBluetoothLocalDevice::pairingStatus(
             for (InterfaceList::const_iterator jt = ifaceList.constBegin(); jt != ifaceList.constEnd(); ++jt) {
                 const QString &iface = jt.key();
 
-                if (iface == QStringLiteral("org.bluez.Device1")) {
+                if (iface == QStringLiteral("org.bluez.Device1")
+                        && address == addressFromDevicePath(path.path())) {
 
                     OrgBluezDevice1Interface device(QStringLiteral("org.bluez"),
                                                     path.path(),
                                                     QDBusConnection::systemBus());
-
-                    if (address == QBluetoothAddress(device.address())) {
-                        if (device.trusted() && device.paired())
-                            return AuthorizedPaired;
-                        else if (device.paired())
-                            return Paired;
-                        else
-                            return Unpaired;
-                    }
+                    if (device.trusted() && device.paired())
+                        return AuthorizedPaired;
+                    else if (device.paired())
+                        return Paired;
+                    else
+                        return Unpaired;
                 }
             }
         }
@@ -535,9 +520,7 @@ void QBluetoothLocalDevicePrivate::PropertiesChanged(const QString &interface,
 
         const QString currentPath = senderIface->path();
         bool isConnected = changed_properties.value(QStringLiteral("Connected"), false).toBool();
-        OrgBluezDevice1Interface device(QStringLiteral("org.bluez"), currentPath,
-                                        QDBusConnection::systemBus());
-        const QBluetoothAddress changedAddress(device.address());
+        const QBluetoothAddress changedAddress = addressFromDevicePath(currentPath);
         bool isInSet = connectedDevicesSet.contains(changedAddress);
         if (isConnected && !isInSet) {
             connectedDevicesSet.insert(changedAddress);
@@ -576,9 +559,7 @@ void QBluetoothLocalDevicePrivate::InterfacesAdded(const QDBusObjectPath &object
     if (pairingDiscoveryTimer && pairingDiscoveryTimer->isActive()
         && interfaces_and_properties.contains(QStringLiteral("org.bluez.Device1"))) {
         //device discovery for pairing found new remote device
-        OrgBluezDevice1Interface device(QStringLiteral("org.bluez"),
-                                        object_path.path(), QDBusConnection::systemBus());
-        if (!address.isNull() && address == QBluetoothAddress(device.address()))
+        if (!address.isNull() && address == addressFromDevicePath(object_path.path()))
             processPairing(object_path.path(), pairing);
     }
 }
@@ -595,9 +576,7 @@ void QBluetoothLocalDevicePrivate::InterfacesRemoved(const QDBusObjectPath &obje
 
             //the path contains the address (e.g.: /org/bluez/hci0/dev_XX_XX_XX_XX_XX_XX)
             //-> use it to update current list of connected devices
-            QString addressString = object_path.path().right(17);
-            addressString.replace(QStringLiteral("_"), QStringLiteral(":"));
-            const QBluetoothAddress address(addressString);
+            const QBluetoothAddress address = addressFromDevicePath(object_path.path());
             bool found = connectedDevicesSet.remove(address);
             if (found)
                 emit q_ptr->deviceDisconnected(address);
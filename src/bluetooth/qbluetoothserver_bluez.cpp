@@ -9,14 +9,22 @@
 #include "bluez/bluez_data_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QPointer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTimer>
+#include <QtNetwork/private/qnet_unix_p.h>
 
 #include <errno.h>
+#include <fcntl.h>
 
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_BT_BLUEZ)
 
+// After accept() failed, the next attempt is delayed by up to this long
+static constexpr int MinAcceptRetryIntervalMs = 50;
+static constexpr int MaxAcceptRetryIntervalMs = 2000;
+
 QBluetoothSocket *QBluetoothServerPrivate::createSocketForServer(
                         QBluetoothServiceInfo::Protocol socketType)
 {
@@ -44,17 +52,101 @@ QBluetoothServerPrivate::QBluetoothServerPrivate(QBluetoothServiceInfo::Protocol
 
 QBluetoothServerPrivate::~QBluetoothServerPrivate()
 {
+    delete acceptRetryTimer;
     delete socketNotifier;
+    clearPendingConnections();
 
     delete socket;
 }
 
+void QBluetoothServerPrivate::startAccepting(int listeningDescriptor)
+{
+    if (socketNotifier)
+        return;
+
+    // accept() must not block once the backlog is drained
+    const int flags = fcntl(listeningDescriptor, F_GETFL, 0);
+    if (!(flags & O_NONBLOCK))
+        fcntl(listeningDescriptor, F_SETFL, flags | O_NONBLOCK);
+
+    socketNotifier = new QSocketNotifier(listeningDescriptor, QSocketNotifier::Read);
+    QObject::connect(socketNotifier, &QSocketNotifier::activated, q_ptr, [this]() {
+        _q_newConnection();
+    });
+}
+
 void QBluetoothServerPrivate::_q_newConnection()
 {
-    // disable socket notifier until application calls nextPendingConnection().
-    socketNotifier->setEnabled(false);
+    // Take all connections the kernel has queued, instead of one per
+    // event loop iteration
+    const qsizetype maxQueued = qMax(1, maxPendingConnections);
+    const int listeningDescriptor = int(socketNotifier->socket());
+    qsizetype accepted = 0;
+    bool acceptFailed = false;
+    bool outOfDescriptors = false;
+    while (pendingDescriptors.size() < maxQueued) {
+        const int pending = qt_safe_accept(listeningDescriptor, nullptr, nullptr);
+        if (pending < 0) {
+            // The peer gave up while the connection was queued
+            if (errno == ECONNABORTED)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                qCWarning(QT_BT_BLUEZ) << "Failed to accept connection" << qt_error_string(errno);
+                acceptFailed = true;
+                outOfDescriptors = errno == EMFILE || errno == ENFILE;
+            }
+            break;
+        }
+        pendingDescriptors.append(pending);
+        ++accepted;
+        acceptRetryIntervalMs = 0;
+    }
 
-    emit q_ptr->newConnection();
+    // A full queue leaves further connections in the kernel backlog until
+    // nextPendingConnection() makes room. After a failed accept() the
+    // connection stays in the backlog as well, and the notifier would fire
+    // again right away. It is enabled again after a delay, which grows as
+    // long as accept() keeps failing.
+    if (acceptFailed) {
+        socketNotifier->setEnabled(false);
+        scheduleAcceptRetry();
+    } else if (pendingDescriptors.size() >= maxQueued) {
+        socketNotifier->setEnabled(false);
+    }
+
+    // The slots may delete the server
+    const QPointer<QBluetoothServer> server = q_ptr;
+    for (qsizetype i = 0; i < accepted && server; ++i)
+        emit server->newConnection();
+
+    if (outOfDescriptors && server) {
+        m_lastError = QBluetoothServer::InputOutputError;
+        emit server->errorOccurred(m_lastError);
+    }
+}
+
+void QBluetoothServerPrivate::scheduleAcceptRetry()
+{
+    acceptRetryIntervalMs = acceptRetryIntervalMs == 0
+            ? MinAcceptRetryIntervalMs
+            : qMin(2 * acceptRetryIntervalMs, MaxAcceptRetryIntervalMs);
+
+    if (!acceptRetryTimer) {
+        acceptRetryTimer = new QTimer;
+        acceptRetryTimer->setSingleShot(true);
+        QObject::connect(acceptRetryTimer, &QTimer::timeout, q_ptr, [this]() {
+            if (socketNotifier && pendingDescriptors.size() < qMax(1, maxPendingConnections))
+                socketNotifier->setEnabled(true);
+        });
+    }
+    acceptRetryTimer->start(acceptRetryIntervalMs);
+}
+
+void QBluetoothServerPrivate::clearPendingConnections()
+{
+    for (int pending : std::as_const(pendingDescriptors))
+        qt_safe_close(pending);
+    pendingDescriptors.clear();
 }
 
 void QBluetoothServerPrivate::setSocketSecurityLevel(
@@ -112,8 +204,12 @@ void QBluetoothServer::close()
 {
     Q_D(QBluetoothServer);
 
+    delete d->acceptRetryTimer;
+    d->acceptRetryTimer = nullptr;
+    d->acceptRetryIntervalMs = 0;
     delete d->socketNotifier;
     d->socketNotifier = nullptr;
+    d->clearPendingConnections();
 
     d->socket->close();
 }
@@ -215,14 +311,7 @@ bool QBluetoothServer::listen(const QBluetoothAddress &address, quint16 port)
 
     d->socket->setSocketState(QBluetoothSocket::SocketState::ListeningState);
 
-    if (!d->socketNotifier) {
-        d->socketNotifier = new QSocketNotifier(d->socket->socketDescriptor(),
-                                                QSocketNotifier::Read);
-        connect(d->socketNotifier, &QSocketNotifier::activated,
-                this, [d](){
-            d->_q_newConnection();
-        });
-    }
+    d->startAccepting(d->socket->socketDescriptor());
 
     return true;
 }
@@ -239,11 +328,7 @@ bool QBluetoothServer::hasPendingConnections() const
 {
     Q_D(const QBluetoothServer);
 
-    if (!d || !d->socketNotifier)
-        return false;
-
-    // if the socket notifier is disabled there is a pending connection waiting for us to accept.
-    return !d->socketNotifier->isEnabled();
+    return d && !d->pendingDescriptors.isEmpty();
 }
 
 QBluetoothSocket *QBluetoothServer::nextPendingConnection()
@@ -253,34 +338,19 @@ QBluetoothSocket *QBluetoothServer::nextPendingConnection()
     if (!hasPendingConnections())
         return nullptr;
 
-    int pending;
-    if (d->serverType == QBluetoothServiceInfo::RfcommProtocol) {
-        sockaddr_rc addr;
-        socklen_t length = sizeof(sockaddr_rc);
-        pending = ::accept(d->socket->socketDescriptor(),
-                               reinterpret_cast<sockaddr *>(&addr), &length);
-    } else {
-        sockaddr_l2 addr;
-        socklen_t length = sizeof(sockaddr_l2);
-        pending = ::accept(d->socket->socketDescriptor(),
-                               reinterpret_cast<sockaddr *>(&addr), &length);
-    }
-
-    if (pending >= 0) {
-        QBluetoothSocket *newSocket = QBluetoothServerPrivate::createSocketForServer();
-        if (d->serverType == QBluetoothServiceInfo::RfcommProtocol)
-            newSocket->setSocketDescriptor(pending, QBluetoothServiceInfo::RfcommProtocol);
-        else
-            newSocket->setSocketDescriptor(pending, QBluetoothServiceInfo::L2capProtocol);
-
-        d->socketNotifier->setEnabled(true);
+    // The socket objects are only created for the connections taken
+    const int pending = d->pendingDescriptors.takeFirst();
+    QBluetoothSocket *newSocket = QBluetoothServerPrivate::createSocketForServer();
+    if (d->serverType == QBluetoothServiceInfo::RfcommProtocol)
+        newSocket->setSocketDescriptor(pending, QBluetoothServiceInfo::RfcommProtocol);
+    else
+        newSocket->setSocketDescriptor(pending, QBluetoothServiceInfo::L2capProtocol);
 
-        return newSocket;
-    } else {
+    // There is room in the queue again
+    if (d->socketNotifier)
         d->socketNotifier->setEnabled(true);
-    }
 
-    return nullptr;
+    return newSocket;
 }
 
 QBluetoothAddress QBluetoothServer::serverAddress() const
@@ -23,6 +23,7 @@
 
 #if QT_CONFIG(bluez)
 QT_FORWARD_DECLARE_CLASS(QSocketNotifier)
+QT_FORWARD_DECLARE_CLASS(QTimer)
 #endif
 
 #ifdef QT_ANDROID_BLUETOOTH
@@ -56,7 +57,7 @@ class QBluetoothAddress;
 class QBluetoothSocket;
 class QBluetoothServer;
 
-class QBluetoothServerPrivate
+class Q_AUTOTEST_EXPORT QBluetoothServerPrivate
 #ifdef QT_OSX_BLUETOOTH
         : public DarwinBluetooth::SocketListener
 #endif
@@ -68,7 +69,10 @@ public:
     ~QBluetoothServerPrivate();
 
 #if QT_CONFIG(bluez)
+    void startAccepting(int listeningDescriptor);
     void _q_newConnection();
+    void scheduleAcceptRetry();
+    void clearPendingConnections();
     void setSocketSecurityLevel(QBluetooth::SecurityFlags requestedSecLevel, int *errnoCode);
     QBluetooth::SecurityFlags socketSecurityLevel() const;
     static QBluetoothSocket *createSocketForServer(
@@ -89,6 +93,11 @@ private:
     QBluetoothServer::Error m_lastError = QBluetoothServer::NoError;
 #if QT_CONFIG(bluez)
     QSocketNotifier *socketNotifier = nullptr;
+    // Accepted connections waiting for nextPendingConnection(), oldest first
+    QList<int> pendingDescriptors;
+    // Enables the notifier again after accept() failed
+    QTimer *acceptRetryTimer = nullptr;
+    int acceptRetryIntervalMs = 0;
 #elif defined(QT_ANDROID_BLUETOOTH)
     ServerAcceptanceThread *thread;
     QString m_serviceName;
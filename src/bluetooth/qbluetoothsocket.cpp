@@ -293,6 +293,22 @@ QBluetoothSocket::QBluetoothSocket(QBluetoothSocketBasePrivate *dPrivate,
     setOpenMode(QIODevice::NotOpen);
 }
 
+/*!
+  \internal
+
+  Enables or disables the notifications of incoming data. While they are
+  disabled, the socket neither reads its descriptor nor emits readyRead(),
+  so that its owner can read the descriptor on its own. The owner then also
+  notices when the remote side closes the connection.
+*/
+void QBluetoothSocket::setReadNotificationEnabled(bool enabled)
+{
+    Q_D(QBluetoothSocketBase);
+    d->readNotificationEnabled = enabled;
+    if (d->readNotifier)
+        d->readNotifier->setEnabled(enabled && state() == SocketState::ConnectedState);
+}
+
 #endif
 
 /*!
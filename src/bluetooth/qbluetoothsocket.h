@@ -149,6 +149,9 @@ protected:
 
 private:
     friend class QLowEnergyControllerPrivateBluez;
+#if QT_CONFIG(bluez)
+    void setReadNotificationEnabled(bool enabled);
+#endif
 };
 
 
@@ -129,7 +129,7 @@ void QBluetoothSocketPrivateBluez::connectToServiceHelper(const QBluetoothAddres
         convertAddress(address.toUInt64(), addr.rc_bdaddr.b);
 
         connectWriteNotifier->setEnabled(true);
-        readNotifier->setEnabled(true);
+        readNotifier->setEnabled(readNotificationEnabled);
 
         result = ::connect(socket, (sockaddr *)&addr, sizeof(addr));
     } else if (socketType == QBluetoothServiceInfo::L2capProtocol) {
@@ -157,7 +157,7 @@ void QBluetoothSocketPrivateBluez::connectToServiceHelper(const QBluetoothAddres
         convertAddress(address.toUInt64(), addr.l2_bdaddr.b);
 
         connectWriteNotifier->setEnabled(true);
-        readNotifier->setEnabled(true);
+        readNotifier->setEnabled(readNotificationEnabled);
 
         result = ::connect(socket, (sockaddr *)&addr, sizeof(addr));
     }
@@ -614,6 +614,7 @@ bool QBluetoothSocketPrivateBluez::setSocketDescriptor(int socketDescriptor, QBl
         fcntl(socket, F_SETFL, flags | O_NONBLOCK);
 
     readNotifier = new QSocketNotifier(socket, QSocketNotifier::Read);
+    readNotifier->setEnabled(readNotificationEnabled);
     QObject::connect(readNotifier, SIGNAL(activated(QSocketDescriptor)), this, SLOT(_q_readNotify()));
     connectWriteNotifier = new QSocketNotifier(socket, QSocketNotifier::Write, q);
     QObject::connect(connectWriteNotifier, SIGNAL(activated(QSocketDescriptor)), this, SLOT(_q_writeNotify()));
@@ -6,18 +6,15 @@
 
 #include "bluez/bluez_data_p.h"
 #include "bluez/bluez5_helper_p.h"
+#include "bluez/bluezobjecttree_p.h"
+#include "bluez/bluezprofileregistry_p.h"
 #include "bluez/adapter1_bluez5_p.h"
 #include "bluez/device1_bluez5_p.h"
-#include "bluez/objectmanager_p.h"
-#include "bluez/profile1_p.h"
-#include "bluez/profile1context_p.h"
-#include "bluez/profilemanager1_p.h"
 
 #include <QtBluetooth/qbluetoothdeviceinfo.h>
 #include <QtBluetooth/qbluetoothserviceinfo.h>
 
 #include <QtCore/qloggingcategory.h>
-#include <QtCore/qrandom.h>
 
 #include <QtNetwork/qlocalsocket.h>
 
@@ -64,47 +61,13 @@ void QBluetoothSocketPrivateBluezDBus::connectToServiceHelper(
 
 static QString findRemoteDevicePath(const QBluetoothAddress &address)
 {
-    OrgFreedesktopDBusObjectManagerInterface manager(QStringLiteral("org.bluez"),
-                                                     QStringLiteral("/"),
-                                                     QDBusConnection::systemBus());
-
     bool ok = false;
     const QString adapterPath = findAdapterForAddress(QBluetoothAddress(), &ok);
-    if (!ok)
+    if (!ok || address.isNull())
         return QString();
 
-    auto reply = manager.GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError())
-        return QString();
-
-    ManagedObjectList objectList = reply.value();
-    for (ManagedObjectList::const_iterator it = objectList.constBegin();
-                                           it != objectList.constEnd(); ++it) {
-        const QDBusObjectPath &path = it.key();
-        const InterfaceList &ifaceList = it.value();
-
-        for (InterfaceList::const_iterator ifaceIter = ifaceList.constBegin();
-                                           ifaceIter != ifaceList.constEnd(); ++ifaceIter) {
-            if (ifaceIter.key() == QStringLiteral("org.bluez.Device1")) {
-                if (path.path().indexOf(adapterPath) != 0)
-                    continue; // devices whose path does not start with same path we skip
-
-                OrgBluezDevice1Interface device(QStringLiteral("org.bluez"),
-                                                path.path(), QDBusConnection::systemBus());
-                if (device.adapter().path() != adapterPath)
-                    continue;
-
-                const QBluetoothAddress btAddress(device.address());
-                if (btAddress.isNull() || btAddress != address)
-                    continue;
-
-                return path.path();
-            }
-        }
-    }
-
-    return QString();
+    // findAdapterForAddress() has loaded the object tree
+    return QtBluezObjectTree::instance()->devicePath(adapterPath, address);
 }
 
 void QBluetoothSocketPrivateBluezDBus::connectToServiceHelper(
@@ -113,101 +76,86 @@ void QBluetoothSocketPrivateBluezDBus::connectToServiceHelper(
 {
     Q_Q(QBluetoothSocket);
 
-    int i = 0;
-    bool success = false;
-    profileUuid = uuid.toString(QUuid::WithoutBraces);
-
-    if (!profileManager) {
-        profileManager = new OrgBluezProfileManager1Interface(
-                                QStringLiteral("org.bluez"),
-                                QStringLiteral("/org/bluez"),
-                                QDBusConnection::systemBus(),
-                                this);
-    }
-
-    if (profileContext) {
+    if (profileClient) {
         qCDebug(QT_BT_BLUEZ) << "Profile context still active. close socket first.";
         q->setSocketError(QBluetoothSocket::SocketError::UnknownSocketError);
         return;
     }
 
+    profileUuid = uuid.toString(QUuid::WithoutBraces);
 
-    profileContext = new OrgBluezProfile1ContextInterface(this);
-    connect(profileContext, &OrgBluezProfile1ContextInterface::newConnection,
-            this, &QBluetoothSocketPrivateBluezDBus::remoteConnected);
-
-    for (i = 0; i < 10 && !success; i++) {
-        // profile registration might fail in case other service uses same path
-        // try 10 times and otherwise abort
-
-        profilePath = u"/qt/btsocket/%1%2/%3"_s.
-                                  arg(sanitizeNameForDBus(QCoreApplication::applicationName())).
-                                  arg(QCoreApplication::applicationPid()).
-                                  arg(QRandomGenerator::global()->generate());
+    remoteDevicePath = findRemoteDevicePath(address);
+    if (remoteDevicePath.isEmpty()) {
+        qCWarning(QT_BT_BLUEZ) << "Unknown remote device:" << address
+                               << "Try device discovery first";
+        profileUuid.clear();
 
-        success = QDBusConnection::systemBus().registerObject(
-                                    profilePath, profileContext, QDBusConnection::ExportAllSlots);
+        errorString = QBluetoothSocket::tr("Cannot find remote device");
+        q->setSocketError(QBluetoothSocket::SocketError::HostNotFoundError);
+        return;
     }
 
-    if (!success) {
-        // we could not register the profile
-        qCWarning(QT_BT_BLUEZ) << "Cannot export serial client profile on DBus";
-
-        delete profileContext;
-        profileContext = nullptr;
+    // The client profile of the UUID is shared with the other sockets of
+    // the process and stays registered while one of them uses it
+    profileClient = QtBluezProfileRegistry::instance()->acquire(profileUuid, remoteDevicePath,
+                                                                this);
+    if (!profileClient) {
+        remoteDevicePath.clear();
+        profileUuid.clear();
 
         errorString = QBluetoothSocket::tr("Cannot export profile on DBus");
         q->setSocketError(QBluetoothSocket::SocketError::UnknownSocketError);
-
         return;
     }
+    connect(profileClient, &QtBluezProfileClient::newConnection,
+            this, &QBluetoothSocketPrivateBluezDBus::remoteConnected);
 
-    QVariantMap profileOptions;
-    profileOptions.insert(QStringLiteral("Role"), QStringLiteral("client"));
-    profileOptions.insert(QStringLiteral("Service"), profileUuid);
-    profileOptions.insert(QStringLiteral("Name"),
-                          QStringLiteral("QBluetoothSocket-%1").arg(QCoreApplication::applicationPid()));
-
-    // TODO support more profile parameter
-    // profileOptions.insert(QStringLiteral("Channel"), 0);
-
-    qCDebug(QT_BT_BLUEZ) << "Registering client profile on" << profilePath << "with options:";
-    qCDebug(QT_BT_BLUEZ) << profileOptions;
-    QDBusPendingReply<> reply = profileManager->RegisterProfile(
-                                    QDBusObjectPath(profilePath),
-                                    profileUuid,
-                                    profileOptions);
-    reply.waitForFinished();
-    if (reply.isError()) {
-        qCWarning(QT_BT_BLUEZ) << "Client profile registration failed:"
-                               << reply.error().message();
+    // The socket stays in ConnectingState until bluetoothd has registered
+    // the profile and hands over the connection. The registration may finish
+    // in another thread, so connect before checking it.
+    connect(profileClient, &QtBluezProfileClient::registrationFinished,
+            this, &QBluetoothSocketPrivateBluezDBus::profileRegistrationFinished);
 
-        QDBusConnection::systemBus().unregisterObject(profilePath);
-        errorString = QBluetoothSocket::tr("Cannot register profile on DBus");
-        q->setSocketError(QBluetoothSocket::SocketError::UnknownSocketError);
+    q->setOpenMode(openMode);
+    q->setSocketState(QBluetoothSocket::SocketState::ConnectingState);
+
+    if (profileClient->isRegistered())
+        connectProfile();
+}
+
+void QBluetoothSocketPrivateBluezDBus::profileRegistrationFinished(bool registered,
+                                                                   const QString &errorMessage)
+{
+    Q_Q(QBluetoothSocket);
+
+    if (registered) {
+        connectProfile();
         return;
     }
 
-    remoteDevicePath = findRemoteDevicePath(address);
-    if (remoteDevicePath.isEmpty()) {
-        qCWarning(QT_BT_BLUEZ) << "Unknown remote device:" << address
-                               << "Try device discovery first";
-        clearSocket();
+    qCWarning(QT_BT_BLUEZ) << "Client profile registration failed:" << errorMessage;
 
-        errorString = QBluetoothSocket::tr("Cannot find remote device");
-        q->setSocketError(QBluetoothSocket::SocketError::HostNotFoundError);
+    clearSocket();
+
+    q->setOpenMode(QIODevice::NotOpen);
+    q->setSocketState(QBluetoothSocket::SocketState::UnconnectedState);
+    errorString = QBluetoothSocket::tr("Cannot register profile on DBus");
+    q->setSocketError(QBluetoothSocket::SocketError::UnknownSocketError);
+}
+
+void QBluetoothSocketPrivateBluezDBus::connectProfile()
+{
+    // Both the registration check and registrationFinished() may get here
+    if (profileConnectRequested)
         return;
-    }
+    profileConnectRequested = true;
 
     OrgBluezDevice1Interface device(QStringLiteral("org.bluez"), remoteDevicePath,
                                     QDBusConnection::systemBus());
-    reply = device.ConnectProfile(profileUuid);
-    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
+    QDBusPendingCallWatcher *watcher =
+            new QDBusPendingCallWatcher(device.ConnectProfile(profileUuid), this);
     connect(watcher, &QDBusPendingCallWatcher::finished,
             this, &QBluetoothSocketPrivateBluezDBus::connectToServiceReplyHandler);
-
-    q->setOpenMode(openMode);
-    q->setSocketState(QBluetoothSocket::SocketState::ConnectingState);
 }
 
 void QBluetoothSocketPrivateBluezDBus::connectToServiceReplyHandler(
@@ -225,23 +173,6 @@ void QBluetoothSocketPrivateBluezDBus::connectToServiceReplyHandler(
         q->setSocketError(QBluetoothSocket::SocketError::HostNotFoundError);
     }
     watcher->deleteLater();
-
-    // QTBUG-82413, unregisterProfile at profileUuid,
-    // so it can be registered for new devices connecting to the same profile UUID.
-    if (profileManager) {
-        qCDebug(QT_BT_BLUEZ) << "Unregistering client profile on" << profilePath
-                             << "in connectToServiceReplyHandler() callback.";
-
-        QDBusPendingReply<> reply = profileManager->UnregisterProfile(QDBusObjectPath(profilePath));
-        reply.waitForFinished();
-        if (reply.isError())
-            qCWarning(QT_BT_BLUEZ) << "Unregister profile:" << reply.error().message();
-
-        QDBusConnection::systemBus().unregisterObject(profilePath);
-
-        delete profileManager;
-        profileManager = nullptr;
-    }
 }
 
 void QBluetoothSocketPrivateBluezDBus::connectToService(
@@ -409,9 +340,7 @@ QBluetoothAddress QBluetoothSocketPrivateBluezDBus::peerAddress() const
     if (remoteDevicePath.isEmpty())
         return QBluetoothAddress();
 
-    OrgBluezDevice1Interface device(QStringLiteral("org.bluez"), remoteDevicePath,
-                                            QDBusConnection::systemBus());
-    return QBluetoothAddress(device.address());
+    return addressFromDevicePath(remoteDevicePath);
 }
 
 quint16 QBluetoothSocketPrivateBluezDBus::peerPort() const
@@ -567,10 +496,10 @@ void QBluetoothSocketPrivateBluezDBus::clearSocket()
 {
     Q_Q(QBluetoothSocket);
 
-    if (profilePath.isEmpty())
+    if (!profileClient)
         return;
 
-    qCDebug(QT_BT_BLUEZ) << "Clearing profile called for" << profilePath;
+    qCDebug(QT_BT_BLUEZ) << "Clearing profile called for" << profileUuid;
 
     if (localSocket) {
         localSocket->close();
@@ -591,29 +520,13 @@ void QBluetoothSocketPrivateBluezDBus::clearSocket()
         }
     }
 
-    if (profileContext) {
-        delete profileContext;
-        profileContext = nullptr;
-    }
-
-    if (profileManager) {
-        qCDebug(QT_BT_BLUEZ) << "Unregistering client profile on" << profilePath
-                             << "in clearSocket().";
-
-        QDBusPendingReply<> reply = profileManager->UnregisterProfile(QDBusObjectPath(profilePath));
-        reply.waitForFinished();
-        if (reply.isError())
-            qCWarning(QT_BT_BLUEZ) << "Unregister profile:" << reply.error().message();
-
-        QDBusConnection::systemBus().unregisterObject(profilePath);
-
-        delete profileManager;
-        profileManager = nullptr;
-    }
+    // Unregisters the profile if no other socket uses it
+    delete profileClient;
+    profileClient = nullptr;
 
     remoteDevicePath.clear();
     profileUuid.clear();
-    profilePath.clear();
+    profileConnectRequested = false;
 }
 QT_END_NAMESPACE
 
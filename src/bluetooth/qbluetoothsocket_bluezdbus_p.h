@@ -22,12 +22,10 @@
 #include <QtNetwork/qlocalsocket.h>
 #include <QDBusPendingCallWatcher>
 
-class OrgBluezProfileManager1Interface;
-
 QT_BEGIN_NAMESPACE
 
 class QLocalSocket;
-class OrgBluezProfile1ContextInterface;
+class QtBluezProfileClient;
 
 class QBluetoothSocketPrivateBluezDBus final: public QBluetoothSocketBasePrivate
 {
@@ -79,17 +77,18 @@ public slots:
     void connectToServiceReplyHandler(QDBusPendingCallWatcher *);
 
 private:
+    void profileRegistrationFinished(bool registered, const QString &errorMessage);
+    void connectProfile();
     void remoteConnected(const QDBusUnixFileDescriptor &fd);
     void socketStateChanged(QLocalSocket::LocalSocketState newState);
 
     void clearSocket();
 
 private:
-    OrgBluezProfileManager1Interface *profileManager = nullptr;
-    OrgBluezProfile1ContextInterface *profileContext = nullptr;
+    QtBluezProfileClient *profileClient = nullptr;
     QString remoteDevicePath;
     QString profileUuid;
-    QString profilePath;
+    bool profileConnectRequested = false;
     QLocalSocket *localSocket = nullptr;
 };
 
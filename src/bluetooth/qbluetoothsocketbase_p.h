@@ -135,6 +135,8 @@ protected:
 #if QT_CONFIG(bluez)
 public:
     quint8 lowEnergySocketType = 0;
+    // false while the owner reads the descriptor itself
+    bool readNotificationEnabled = true;
 #endif
 };
 
@@ -2,10 +2,19 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qbluetoothuuid.h"
-#include "qbluetoothservicediscoveryagent.h"
+#include "qbluetoothuuid_p.h"
 
-#include <QStringList>
-#include <QtEndian>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
 
 #include <string.h>
 
@@ -631,6 +640,812 @@ quint32 QBluetoothUuid::toUInt32(bool *ok) const
     return data1;
 }
 
+namespace {
+
+template <typename Enum>
+struct AssignedName
+{
+    Enum value;
+    // Translated in the context of QBluetoothServiceDiscoveryAgent
+    const char *name;
+};
+
+// The tables are sorted by value, which is verified at compile time below
+constexpr AssignedName<QBluetoothUuid::ProtocolUuid> protocolNames[] = {
+    { QBluetoothUuid::ProtocolUuid::Sdp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Service Discovery Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Udp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "User Datagram Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Rfcomm,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Radio Frequency Communication") },
+    { QBluetoothUuid::ProtocolUuid::Tcp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Transmission Control Protocol") },
+    { QBluetoothUuid::ProtocolUuid::TcsBin,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Telephony Control Specification - Binary") },
+    { QBluetoothUuid::ProtocolUuid::TcsAt,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Telephony Control Specification - AT") },
+    { QBluetoothUuid::ProtocolUuid::Att,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Attribute Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Obex,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Object Exchange Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Ip,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Internet Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Ftp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "File Transfer Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Http,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hypertext Transfer Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Wsp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Wireless Short Packet Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Bnep,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Bluetooth Network Encapsulation Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Upnp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Extended Service Discovery Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Hidp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Human Interface Device Protocol") },
+    { QBluetoothUuid::ProtocolUuid::HardcopyControlChannel,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hardcopy Control Channel") },
+    { QBluetoothUuid::ProtocolUuid::HardcopyDataChannel,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hardcopy Data Channel") },
+    { QBluetoothUuid::ProtocolUuid::HardcopyNotification,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hardcopy Notification") },
+    { QBluetoothUuid::ProtocolUuid::Avctp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Audio/Video Control Transport Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Avdtp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Audio/Video Distribution Transport Protocol") },
+    { QBluetoothUuid::ProtocolUuid::Cmtp,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Common ISDN Access Protocol") },
+    { QBluetoothUuid::ProtocolUuid::UdiCPlain,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "UdiCPlain") },
+    { QBluetoothUuid::ProtocolUuid::McapControlChannel,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Multi-Channel Adaptation Protocol - Control") },
+    { QBluetoothUuid::ProtocolUuid::McapDataChannel,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Multi-Channel Adaptation Protocol - Data") },
+    { QBluetoothUuid::ProtocolUuid::L2cap,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Layer 2 Control Protocol") },
+};
+
+constexpr AssignedName<QBluetoothUuid::ServiceClassUuid> serviceClassNames[] = {
+    { QBluetoothUuid::ServiceClassUuid::ServiceDiscoveryServer,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Service Discovery") },
+    { QBluetoothUuid::ServiceClassUuid::BrowseGroupDescriptor,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Browse Group Descriptor") },
+    { QBluetoothUuid::ServiceClassUuid::PublicBrowseGroup,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Public Browse Group") },
+    { QBluetoothUuid::ServiceClassUuid::SerialPort,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Serial Port Profile") },
+    { QBluetoothUuid::ServiceClassUuid::LANAccessUsingPPP,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "LAN Access Profile") },
+    { QBluetoothUuid::ServiceClassUuid::DialupNetworking,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Dial-Up Networking") },
+    { QBluetoothUuid::ServiceClassUuid::IrMCSync,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Synchronization") },
+    { QBluetoothUuid::ServiceClassUuid::ObexObjectPush,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Object Push") },
+    { QBluetoothUuid::ServiceClassUuid::OBEXFileTransfer,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "File Transfer") },
+    { QBluetoothUuid::ServiceClassUuid::IrMCSyncCommand,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Synchronization Command") },
+    { QBluetoothUuid::ServiceClassUuid::Headset,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Headset") },
+    { QBluetoothUuid::ServiceClassUuid::AudioSource,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Audio Source") },
+    { QBluetoothUuid::ServiceClassUuid::AudioSink,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Audio Sink") },
+    { QBluetoothUuid::ServiceClassUuid::AV_RemoteControlTarget,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Audio/Video Remote Control Target") },
+    { QBluetoothUuid::ServiceClassUuid::AdvancedAudioDistribution,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Advanced Audio Distribution") },
+    { QBluetoothUuid::ServiceClassUuid::AV_RemoteControl,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Audio/Video Remote Control") },
+    { QBluetoothUuid::ServiceClassUuid::AV_RemoteControlController,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Audio/Video Remote Control Controller") },
+    { QBluetoothUuid::ServiceClassUuid::HeadsetAG,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Headset AG") },
+    { QBluetoothUuid::ServiceClassUuid::PANU,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Personal Area Networking (PANU)") },
+    { QBluetoothUuid::ServiceClassUuid::NAP,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Personal Area Networking (NAP)") },
+    { QBluetoothUuid::ServiceClassUuid::GN,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Personal Area Networking (GN)") },
+    { QBluetoothUuid::ServiceClassUuid::DirectPrinting,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Direct Printing (BPP)") },
+    { QBluetoothUuid::ServiceClassUuid::ReferencePrinting,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Reference Printing (BPP)") },
+    { QBluetoothUuid::ServiceClassUuid::BasicImage,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Imaging Profile") },
+    { QBluetoothUuid::ServiceClassUuid::ImagingResponder,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Imaging Responder") },
+    { QBluetoothUuid::ServiceClassUuid::ImagingAutomaticArchive,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Imaging Archive") },
+    { QBluetoothUuid::ServiceClassUuid::ImagingReferenceObjects,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Imaging Ref Objects") },
+    { QBluetoothUuid::ServiceClassUuid::Handsfree,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hands-Free") },
+    { QBluetoothUuid::ServiceClassUuid::HandsfreeAudioGateway,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hands-Free AG") },
+    { QBluetoothUuid::ServiceClassUuid::DirectPrintingReferenceObjectsService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Printing RefObject Service") },
+    { QBluetoothUuid::ServiceClassUuid::ReflectedUI,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Printing Reflected UI") },
+    { QBluetoothUuid::ServiceClassUuid::BasicPrinting,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Printing") },
+    { QBluetoothUuid::ServiceClassUuid::PrintingStatus,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Basic Printing Status") },
+    { QBluetoothUuid::ServiceClassUuid::HumanInterfaceDeviceService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Human Interface Device") },
+    { QBluetoothUuid::ServiceClassUuid::HardcopyCableReplacement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hardcopy Cable Replacement") },
+    { QBluetoothUuid::ServiceClassUuid::HCRPrint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hardcopy Cable Replacement Print") },
+    { QBluetoothUuid::ServiceClassUuid::HCRScan,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hardcopy Cable Replacement Scan") },
+    { QBluetoothUuid::ServiceClassUuid::SIMAccess,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "SIM Access Server") },
+    { QBluetoothUuid::ServiceClassUuid::PhonebookAccessPCE,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Phonebook Access PCE") },
+    { QBluetoothUuid::ServiceClassUuid::PhonebookAccessPSE,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Phonebook Access PSE") },
+    { QBluetoothUuid::ServiceClassUuid::PhonebookAccess,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Phonebook Access") },
+    { QBluetoothUuid::ServiceClassUuid::HeadsetHS,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Headset HS") },
+    { QBluetoothUuid::ServiceClassUuid::MessageAccessServer,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Message Access Server") },
+    { QBluetoothUuid::ServiceClassUuid::MessageNotificationServer,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Message Notification Server") },
+    { QBluetoothUuid::ServiceClassUuid::MessageAccessProfile,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Message Access") },
+    { QBluetoothUuid::ServiceClassUuid::GNSS,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Global Navigation Satellite System") },
+    { QBluetoothUuid::ServiceClassUuid::GNSSServer,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Global Navigation Satellite System Server") },
+    { QBluetoothUuid::ServiceClassUuid::Display3D,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "3D Synchronization Display") },
+    { QBluetoothUuid::ServiceClassUuid::Glasses3D,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "3D Synchronization Glasses") },
+    { QBluetoothUuid::ServiceClassUuid::Synchronization3D,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "3D Synchronization") },
+    { QBluetoothUuid::ServiceClassUuid::MPSProfile,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Multi-Profile Specification (Profile)") },
+    { QBluetoothUuid::ServiceClassUuid::MPSService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Multi-Profile Specification") },
+    { QBluetoothUuid::ServiceClassUuid::PnPInformation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Device Identification") },
+    { QBluetoothUuid::ServiceClassUuid::GenericNetworking,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Generic Networking") },
+    { QBluetoothUuid::ServiceClassUuid::GenericFileTransfer,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Generic File Transfer") },
+    { QBluetoothUuid::ServiceClassUuid::GenericAudio,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Generic Audio") },
+    { QBluetoothUuid::ServiceClassUuid::GenericTelephony,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Generic Telephony") },
+    { QBluetoothUuid::ServiceClassUuid::VideoSource,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Video Source") },
+    { QBluetoothUuid::ServiceClassUuid::VideoSink,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Video Sink") },
+    { QBluetoothUuid::ServiceClassUuid::VideoDistribution,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Video Distribution") },
+    { QBluetoothUuid::ServiceClassUuid::HDP,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Health Device") },
+    { QBluetoothUuid::ServiceClassUuid::HDPSource,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Health Device Source") },
+    { QBluetoothUuid::ServiceClassUuid::HDPSink,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Health Device Sink") },
+    { QBluetoothUuid::ServiceClassUuid::GenericAccess,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Generic Access") },
+    { QBluetoothUuid::ServiceClassUuid::GenericAttribute,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Generic Attribute") },
+    { QBluetoothUuid::ServiceClassUuid::ImmediateAlert,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Immediate Alert") },
+    { QBluetoothUuid::ServiceClassUuid::LinkLoss,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Link Loss") },
+    { QBluetoothUuid::ServiceClassUuid::TxPower,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Tx Power") },
+    { QBluetoothUuid::ServiceClassUuid::CurrentTimeService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Current Time Service") },
+    { QBluetoothUuid::ServiceClassUuid::ReferenceTimeUpdateService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Reference Time Update Service") },
+    { QBluetoothUuid::ServiceClassUuid::NextDSTChangeService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Next DST Change Service") },
+    { QBluetoothUuid::ServiceClassUuid::Glucose,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Glucose") },
+    { QBluetoothUuid::ServiceClassUuid::HealthThermometer,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Health Thermometer") },
+    { QBluetoothUuid::ServiceClassUuid::DeviceInformation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Device Information") },
+    { QBluetoothUuid::ServiceClassUuid::HeartRate,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Heart Rate") },
+    { QBluetoothUuid::ServiceClassUuid::PhoneAlertStatusService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Phone Alert Status Service") },
+    { QBluetoothUuid::ServiceClassUuid::BatteryService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Battery Service") },
+    { QBluetoothUuid::ServiceClassUuid::BloodPressure,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Blood Pressure") },
+    { QBluetoothUuid::ServiceClassUuid::AlertNotificationService,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Alert Notification Service") },
+    { QBluetoothUuid::ServiceClassUuid::HumanInterfaceDevice,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Human Interface Device") },
+    { QBluetoothUuid::ServiceClassUuid::ScanParameters,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Scan Parameters") },
+    { QBluetoothUuid::ServiceClassUuid::RunningSpeedAndCadence,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Running Speed and Cadence") },
+    { QBluetoothUuid::ServiceClassUuid::CyclingSpeedAndCadence,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Cycling Speed and Cadence") },
+    { QBluetoothUuid::ServiceClassUuid::CyclingPower,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Cycling Power") },
+    { QBluetoothUuid::ServiceClassUuid::LocationAndNavigation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Location and Navigation") },
+    { QBluetoothUuid::ServiceClassUuid::EnvironmentalSensing,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Environmental Sensing") },
+    { QBluetoothUuid::ServiceClassUuid::BodyComposition,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Body Composition") },
+    { QBluetoothUuid::ServiceClassUuid::UserData,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "User Data") },
+    { QBluetoothUuid::ServiceClassUuid::WeightScale,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Weight Scale") },
+    //: Connection management (Bluetooth)
+    { QBluetoothUuid::ServiceClassUuid::BondManagement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Bond Management") },
+    { QBluetoothUuid::ServiceClassUuid::ContinuousGlucoseMonitoring,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Continuous Glucose Monitoring") },
+};
+
+constexpr AssignedName<QBluetoothUuid::CharacteristicType> characteristicNames[] = {
+    //: GAP:  Generic Access Profile (Bluetooth)
+    { QBluetoothUuid::CharacteristicType::DeviceName,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "GAP Device Name") },
+    //: GAP:  Generic Access Profile (Bluetooth)
+    { QBluetoothUuid::CharacteristicType::Appearance,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "GAP Appearance") },
+    //: GAP:  Generic Access Profile (Bluetooth)
+    { QBluetoothUuid::CharacteristicType::PeripheralPrivacyFlag,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "GAP Peripheral Privacy Flag") },
+    //: GAP:  Generic Access Profile (Bluetooth)
+    { QBluetoothUuid::CharacteristicType::ReconnectionAddress,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "GAP Reconnection Address") },
+    { QBluetoothUuid::CharacteristicType::PeripheralPreferredConnectionParameters,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "GAP Peripheral Preferred Connection Parameters") },
+    //: GATT: _G_eneric _Att_ribute Profile (Bluetooth)
+    { QBluetoothUuid::CharacteristicType::ServiceChanged,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "GATT Service Changed") },
+    { QBluetoothUuid::CharacteristicType::AlertLevel,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Alert Level") },
+    { QBluetoothUuid::CharacteristicType::TxPowerLevel,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "TX Power") },
+    { QBluetoothUuid::CharacteristicType::DateTime,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Date Time") },
+    { QBluetoothUuid::CharacteristicType::DayOfWeek,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Day Of Week") },
+    { QBluetoothUuid::CharacteristicType::DayDateTime,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Day Date Time") },
+    { QBluetoothUuid::CharacteristicType::ExactTime256,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Exact Time 256") },
+    { QBluetoothUuid::CharacteristicType::DSTOffset,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "DST Offset") },
+    { QBluetoothUuid::CharacteristicType::TimeZone,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Time Zone") },
+    { QBluetoothUuid::CharacteristicType::LocalTimeInformation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Local Time Information") },
+    { QBluetoothUuid::CharacteristicType::TimeWithDST,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Time With DST") },
+    { QBluetoothUuid::CharacteristicType::TimeAccuracy,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Time Accuracy") },
+    { QBluetoothUuid::CharacteristicType::TimeSource,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Time Source") },
+    { QBluetoothUuid::CharacteristicType::ReferenceTimeInformation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Reference Time Information") },
+    { QBluetoothUuid::CharacteristicType::TimeUpdateControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Time Update Control Point") },
+    { QBluetoothUuid::CharacteristicType::TimeUpdateState,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Time Update State") },
+    { QBluetoothUuid::CharacteristicType::GlucoseMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Glucose Measurement") },
+    { QBluetoothUuid::CharacteristicType::BatteryLevel,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Battery Level") },
+    { QBluetoothUuid::CharacteristicType::TemperatureMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Temperature Measurement") },
+    { QBluetoothUuid::CharacteristicType::TemperatureType,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Temperature Type") },
+    { QBluetoothUuid::CharacteristicType::IntermediateTemperature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Intermediate Temperature") },
+    { QBluetoothUuid::CharacteristicType::MeasurementInterval,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Measurement Interval") },
+    { QBluetoothUuid::CharacteristicType::BootKeyboardInputReport,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Boot Keyboard Input Report") },
+    { QBluetoothUuid::CharacteristicType::SystemID,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "System ID") },
+    { QBluetoothUuid::CharacteristicType::ModelNumberString,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Model Number String") },
+    { QBluetoothUuid::CharacteristicType::SerialNumberString,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Serial Number String") },
+    { QBluetoothUuid::CharacteristicType::FirmwareRevisionString,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Firmware Revision String") },
+    { QBluetoothUuid::CharacteristicType::HardwareRevisionString,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hardware Revision String") },
+    { QBluetoothUuid::CharacteristicType::SoftwareRevisionString,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Software Revision String") },
+    { QBluetoothUuid::CharacteristicType::ManufacturerNameString,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Manufacturer Name String") },
+    { QBluetoothUuid::CharacteristicType::IEEE1107320601RegulatoryCertificationDataList,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "IEEE 11073 20601 Regulatory Certification Data List") },
+    { QBluetoothUuid::CharacteristicType::CurrentTime,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Current Time") },
+    //: Angle between geographic and magnetic north
+    { QBluetoothUuid::CharacteristicType::MagneticDeclination,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Magnetic Declination") },
+    { QBluetoothUuid::CharacteristicType::ScanRefresh,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Scan Refresh") },
+    { QBluetoothUuid::CharacteristicType::BootKeyboardOutputReport,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Boot Keyboard Output Report") },
+    { QBluetoothUuid::CharacteristicType::BootMouseInputReport,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Boot Mouse Input Report") },
+    { QBluetoothUuid::CharacteristicType::GlucoseMeasurementContext,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Glucose Measurement Context") },
+    { QBluetoothUuid::CharacteristicType::BloodPressureMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Blood Pressure Measurement") },
+    { QBluetoothUuid::CharacteristicType::IntermediateCuffPressure,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Intermediate Cuff Pressure") },
+    { QBluetoothUuid::CharacteristicType::HeartRateMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Heart Rate Measurement") },
+    { QBluetoothUuid::CharacteristicType::BodySensorLocation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Body Sensor Location") },
+    { QBluetoothUuid::CharacteristicType::HeartRateControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Heart Rate Control Point") },
+    { QBluetoothUuid::CharacteristicType::AlertStatus,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Alert Status") },
+    { QBluetoothUuid::CharacteristicType::RingerControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Ringer Control Point") },
+    { QBluetoothUuid::CharacteristicType::RingerSetting,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Ringer Setting") },
+    { QBluetoothUuid::CharacteristicType::AlertCategoryIDBitMask,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Alert Category ID Bit Mask") },
+    { QBluetoothUuid::CharacteristicType::AlertCategoryID,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Alert Category ID") },
+    { QBluetoothUuid::CharacteristicType::AlertNotificationControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Alert Notification Control Point") },
+    { QBluetoothUuid::CharacteristicType::UnreadAlertStatus,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Unread Alert Status") },
+    { QBluetoothUuid::CharacteristicType::NewAlert,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "New Alert") },
+    { QBluetoothUuid::CharacteristicType::SupportedNewAlertCategory,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Supported New Alert Category") },
+    { QBluetoothUuid::CharacteristicType::SupportedUnreadAlertCategory,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Supported Unread Alert Category") },
+    { QBluetoothUuid::CharacteristicType::BloodPressureFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Blood Pressure Feature") },
+    //: HID: Human Interface Device Profile (Bluetooth)
+    { QBluetoothUuid::CharacteristicType::HIDInformation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "HID Information") },
+    { QBluetoothUuid::CharacteristicType::ReportMap,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Report Map") },
+    //: HID: Human Interface Device Profile (Bluetooth)
+    { QBluetoothUuid::CharacteristicType::HIDControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "HID Control Point") },
+    { QBluetoothUuid::CharacteristicType::Report,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Report") },
+    { QBluetoothUuid::CharacteristicType::ProtocolMode,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Protocol Mode") },
+    { QBluetoothUuid::CharacteristicType::ScanIntervalWindow,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Scan Interval Window") },
+    { QBluetoothUuid::CharacteristicType::PnPID,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "PnP ID") },
+    { QBluetoothUuid::CharacteristicType::GlucoseFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Glucose Feature") },
+    //: Glucose Sensor patient record database.
+    { QBluetoothUuid::CharacteristicType::RecordAccessControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Record Access Control Point") },
+    //: RSC: Running Speed and Cadence
+    { QBluetoothUuid::CharacteristicType::RSCMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "RSC Measurement") },
+    //: RSC: Running Speed and Cadence
+    { QBluetoothUuid::CharacteristicType::RSCFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "RSC Feature") },
+    { QBluetoothUuid::CharacteristicType::SCControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "SC Control Point") },
+    //: CSC: Cycling Speed and Cadence
+    { QBluetoothUuid::CharacteristicType::CSCMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "CSC Measurement") },
+    //: CSC: Cycling Speed and Cadence
+    { QBluetoothUuid::CharacteristicType::CSCFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "CSC Feature") },
+    { QBluetoothUuid::CharacteristicType::SensorLocation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Sensor Location") },
+    { QBluetoothUuid::CharacteristicType::CyclingPowerMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Cycling Power Measurement") },
+    { QBluetoothUuid::CharacteristicType::CyclingPowerVector,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Cycling Power Vector") },
+    { QBluetoothUuid::CharacteristicType::CyclingPowerFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Cycling Power Feature") },
+    { QBluetoothUuid::CharacteristicType::CyclingPowerControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Cycling Power Control Point") },
+    { QBluetoothUuid::CharacteristicType::LocationAndSpeed,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Location And Speed") },
+    { QBluetoothUuid::CharacteristicType::Navigation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Navigation") },
+    { QBluetoothUuid::CharacteristicType::PositionQuality,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Position Quality") },
+    { QBluetoothUuid::CharacteristicType::LNFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "LN Feature") },
+    { QBluetoothUuid::CharacteristicType::LNControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "LN Control Point") },
+    //: Above/below sea level
+    { QBluetoothUuid::CharacteristicType::Elevation,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Elevation") },
+    { QBluetoothUuid::CharacteristicType::Pressure,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Pressure") },
+    { QBluetoothUuid::CharacteristicType::Temperature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Temperature") },
+    { QBluetoothUuid::CharacteristicType::Humidity,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Humidity") },
+    //: Wind speed while standing
+    { QBluetoothUuid::CharacteristicType::TrueWindSpeed,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "True Wind Speed") },
+    { QBluetoothUuid::CharacteristicType::TrueWindDirection,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "True Wind Direction") },
+    //: Wind speed while observer is moving
+    { QBluetoothUuid::CharacteristicType::ApparentWindSpeed,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Apparent Wind Speed") },
+    { QBluetoothUuid::CharacteristicType::ApparentWindDirection,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Apparent Wind Direction") },
+    //: Factor by which wind gust is stronger than average wind
+    { QBluetoothUuid::CharacteristicType::GustFactor,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Gust Factor") },
+    { QBluetoothUuid::CharacteristicType::PollenConcentration,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Pollen Concentration") },
+    { QBluetoothUuid::CharacteristicType::UVIndex,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "UV Index") },
+    { QBluetoothUuid::CharacteristicType::Irradiance,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Irradiance") },
+    { QBluetoothUuid::CharacteristicType::Rainfall,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Rainfall") },
+    { QBluetoothUuid::CharacteristicType::WindChill,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Wind Chill") },
+    { QBluetoothUuid::CharacteristicType::HeatIndex,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Heat Index") },
+    { QBluetoothUuid::CharacteristicType::DewPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Dew Point") },
+    //: Environmental sensing related
+    { QBluetoothUuid::CharacteristicType::DescriptorValueChanged,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Descriptor Value Changed") },
+    { QBluetoothUuid::CharacteristicType::AerobicHeartRateLowerLimit,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Aerobic Heart Rate Lower Limit") },
+    { QBluetoothUuid::CharacteristicType::AerobicThreshold,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Aerobic Threshold") },
+    //: Age of person
+    { QBluetoothUuid::CharacteristicType::Age,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Age") },
+    { QBluetoothUuid::CharacteristicType::AnaerobicHeartRateLowerLimit,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Anaerobic Heart Rate Lower Limit") },
+    { QBluetoothUuid::CharacteristicType::AnaerobicHeartRateUpperLimit,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Anaerobic Heart Rate Upper Limit") },
+    { QBluetoothUuid::CharacteristicType::AnaerobicThreshold,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Anaerobic Threshold") },
+    { QBluetoothUuid::CharacteristicType::AerobicHeartRateUpperLimit,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Aerobic Heart Rate Upper Limit") },
+    { QBluetoothUuid::CharacteristicType::DateOfBirth,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Date Of Birth") },
+    { QBluetoothUuid::CharacteristicType::DateOfThresholdAssessment,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Date Of Threshold Assessment") },
+    { QBluetoothUuid::CharacteristicType::EmailAddress,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Email Address") },
+    { QBluetoothUuid::CharacteristicType::FatBurnHeartRateLowerLimit,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Fat Burn Heart Rate Lower Limit") },
+    { QBluetoothUuid::CharacteristicType::FatBurnHeartRateUpperLimit,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Fat Burn Heart Rate Upper Limit") },
+    { QBluetoothUuid::CharacteristicType::FirstName,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "First Name") },
+    { QBluetoothUuid::CharacteristicType::FiveZoneHeartRateLimits,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "5-Zone Heart Rate Limits") },
+    { QBluetoothUuid::CharacteristicType::Gender,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Gender") },
+    { QBluetoothUuid::CharacteristicType::HeartRateMax,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Heart Rate Maximum") },
+    //: Height of a person
+    { QBluetoothUuid::CharacteristicType::Height,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Height") },
+    { QBluetoothUuid::CharacteristicType::HipCircumference,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Hip Circumference") },
+    { QBluetoothUuid::CharacteristicType::LastName,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Last Name") },
+    { QBluetoothUuid::CharacteristicType::MaximumRecommendedHeartRate,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Maximum Recommended Heart Rate") },
+    { QBluetoothUuid::CharacteristicType::RestingHeartRate,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Resting Heart Rate") },
+    { QBluetoothUuid::CharacteristicType::SportTypeForAerobicAnaerobicThresholds,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Sport Type For Aerobic/Anaerobic Thresholds") },
+    { QBluetoothUuid::CharacteristicType::ThreeZoneHeartRateLimits,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "3-Zone Heart Rate Limits") },
+    { QBluetoothUuid::CharacteristicType::TwoZoneHeartRateLimits,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "2-Zone Heart Rate Limits") },
+    { QBluetoothUuid::CharacteristicType::VO2Max,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Oxygen Uptake") },
+    { QBluetoothUuid::CharacteristicType::WaistCircumference,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Waist Circumference") },
+    { QBluetoothUuid::CharacteristicType::Weight,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Weight") },
+    //: Environmental sensing related
+    { QBluetoothUuid::CharacteristicType::DatabaseChangeIncrement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Database Change Increment") },
+    { QBluetoothUuid::CharacteristicType::UserIndex,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "User Index") },
+    { QBluetoothUuid::CharacteristicType::BodyCompositionFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Body Composition Feature") },
+    { QBluetoothUuid::CharacteristicType::BodyCompositionMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Body Composition Measurement") },
+    { QBluetoothUuid::CharacteristicType::WeightMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Weight Measurement") },
+    { QBluetoothUuid::CharacteristicType::WeightScaleFeature,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Weight Scale Feature") },
+    { QBluetoothUuid::CharacteristicType::UserControlPoint,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "User Control Point") },
+    { QBluetoothUuid::CharacteristicType::MagneticFluxDensity2D,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Magnetic Flux Density 2D") },
+    { QBluetoothUuid::CharacteristicType::MagneticFluxDensity3D,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Magnetic Flux Density 3D") },
+    { QBluetoothUuid::CharacteristicType::Language,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Language") },
+    { QBluetoothUuid::CharacteristicType::BarometricPressureTrend,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Barometric Pressure Trend") },
+};
+
+constexpr AssignedName<QBluetoothUuid::DescriptorType> descriptorNames[] = {
+    { QBluetoothUuid::DescriptorType::CharacteristicExtendedProperties,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Characteristic Extended Properties") },
+    { QBluetoothUuid::DescriptorType::CharacteristicUserDescription,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Characteristic User Description") },
+    { QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Client Characteristic Configuration") },
+    { QBluetoothUuid::DescriptorType::ServerCharacteristicConfiguration,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Server Characteristic Configuration") },
+    { QBluetoothUuid::DescriptorType::CharacteristicPresentationFormat,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Characteristic Presentation Format") },
+    { QBluetoothUuid::DescriptorType::CharacteristicAggregateFormat,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Characteristic Aggregate Format") },
+    { QBluetoothUuid::DescriptorType::ValidRange,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Valid Range") },
+    { QBluetoothUuid::DescriptorType::ExternalReportReference,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "External Report Reference") },
+    { QBluetoothUuid::DescriptorType::ReportReference,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Report Reference") },
+    { QBluetoothUuid::DescriptorType::EnvironmentalSensingConfiguration,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Environmental Sensing Configuration") },
+    { QBluetoothUuid::DescriptorType::EnvironmentalSensingMeasurement,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Environmental Sensing Measurement") },
+    { QBluetoothUuid::DescriptorType::EnvironmentalSensingTriggerSetting,
+      QT_TRANSLATE_NOOP("QBluetoothServiceDiscoveryAgent", "Environmental Sensing Trigger Setting") },
+};
+template <typename Enum, size_t N>
+constexpr bool isSortedByValue(const AssignedName<Enum> (&table)[N])
+{
+    for (size_t i = 1; i < N; ++i) {
+        if (!(table[i - 1].value < table[i].value))
+            return false;
+    }
+    return true;
+}
+
+static_assert(isSortedByValue(protocolNames));
+static_assert(isSortedByValue(serviceClassNames));
+static_assert(isSortedByValue(characteristicNames));
+static_assert(isSortedByValue(descriptorNames));
+
+constexpr int compareNames(const char *a, const char *b)
+{
+    for (; *a && *a == *b; ++a, ++b) {}
+    return int(uchar(*a)) - int(uchar(*b));
+}
+
+// Indexes into the table ordered by name, std::sort is not constexpr before C++20.
+// The insertion sort is stable, the lowest value comes first for shared names.
+template <typename Enum, size_t N>
+constexpr std::array<quint16, N> sortedByName(const AssignedName<Enum> (&table)[N])
+{
+    std::array<quint16, N> order = {};
+    for (size_t i = 0; i < N; ++i) {
+        size_t j = i;
+        for (; j > 0 && compareNames(table[i].name, table[order[j - 1]].name) < 0; --j)
+            order[j] = order[j - 1];
+        order[j] = quint16(i);
+    }
+    return order;
+}
+
+constexpr auto protocolsByName = sortedByName(protocolNames);
+constexpr auto serviceClassesByName = sortedByName(serviceClassNames);
+constexpr auto characteristicsByName = sortedByName(characteristicNames);
+constexpr auto descriptorsByName = sortedByName(descriptorNames);
+
+template <typename Enum, size_t N>
+const AssignedName<Enum> *findByValue(const AssignedName<Enum> (&table)[N], quint16 value)
+{
+    const auto it = std::lower_bound(std::begin(table), std::end(table), value,
+                                     [](const AssignedName<Enum> &entry, quint16 value) {
+        return quint16(entry.value) < value;
+    });
+    return it != std::end(table) && quint16(it->value) == value ? it : nullptr;
+}
+
+template <typename Enum, size_t N>
+const AssignedName<Enum> *findByName(const AssignedName<Enum> (&table)[N],
+                                     const std::array<quint16, N> &byName, QAnyStringView name)
+{
+    const auto compare = [&table](quint16 index, QAnyStringView name) {
+        return QAnyStringView::compare(QLatin1StringView(table[index].name), name);
+    };
+    const auto it = std::lower_bound(byName.begin(), byName.end(), name,
+                                     [&compare](quint16 index, QAnyStringView name) {
+        return compare(index, name) < 0;
+    });
+    return it != byName.end() && compare(*it, name) == 0 ? &table[*it] : nullptr;
+}
+
+/*
+    QCoreApplication::translate() searches all installed translators and
+    allocates the result, scanners labeling many UUIDs pay for that on every
+    call. The translations are cached until the application announces a
+    change of its translators with QEvent::LanguageChange, which also covers
+    loading another file into an installed translator. Nothing is cached
+    until the application thread has started watching for that, lookups
+    from other threads ask it to.
+*/
+class AssignedNameCache
+{
+public:
+    QString translate(const char *name)
+    {
+        quint64 translatedGeneration;
+        {
+            QReadLocker locker(&lock);
+            const auto it = names.constFind(name);
+            if (it != names.cend())
+                return *it;
+            translatedGeneration = generation;
+        }
+
+        const QString translated =
+                QCoreApplication::translate("QBluetoothServiceDiscoveryAgent", name);
+        QWriteLocker locker(&lock);
+        // The translators may have changed while translating
+        if (translatedGeneration == generation && watchLanguageChanges())
+            names.insert(name, translated);
+        return translated;
+    }
+
+    void clear(bool stopWatching)
+    {
+        QWriteLocker locker(&lock);
+        names.clear();
+        ++generation;
+        if (stopWatching)
+            watching = watchRequested = false;
+    }
+
+    void startWatching();
+
+private:
+    bool watchLanguageChanges();
+
+    QReadWriteLock lock;
+    QHash<const char *, QString> names;
+    quint64 generation = 0;
+    bool watching = false;
+    bool watchRequested = false;
+};
+
+Q_GLOBAL_STATIC(AssignedNameCache, assignedNameCache)
+
+// Translator changes are only announced to the application object
+class LanguageChangeWatcher : public QObject
+{
+public:
+    using QObject::QObject;
+    ~LanguageChangeWatcher() override
+    {
+        if (!assignedNameCache.isDestroyed())
+            assignedNameCache->clear(true);
+    }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::LanguageChange && watched == parent())
+            assignedNameCache->clear(false);
+        return false;
+    }
+};
+
+// Called with the lock held for writing
+bool AssignedNameCache::watchLanguageChanges()
+{
+    if (watching)
+        return true;
+
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app)
+        return false;
+
+    if (app->thread() != QThread::currentThread()) {
+        if (!watchRequested) {
+            watchRequested = true;
+            QMetaObject::invokeMethod(app, [] {
+                if (!assignedNameCache.isDestroyed())
+                    assignedNameCache->startWatching();
+            }, Qt::QueuedConnection);
+        }
+        return false;
+    }
+
+    // The watcher goes away with the application
+    app->installEventFilter(new LanguageChangeWatcher(app));
+    watching = watchRequested = true;
+    return true;
+}
+
+void AssignedNameCache::startWatching()
+{
+    QWriteLocker locker(&lock);
+    watchLanguageChanges();
+}
+
+template <typename Enum, size_t N>
+QString translatedName(const AssignedName<Enum> (&table)[N], Enum value)
+{
+    const AssignedName<Enum> *entry = findByValue(table, quint16(value));
+    return entry ? assignedNameCache()->translate(entry->name) : QString();
+}
+
+} // unnamed namespace
+
+namespace QtBluetoothPrivate {
+
+const char *assignedNumberName(AssignedNumberType type, quint16 value) noexcept
+{
+    switch (type) {
+    case AssignedNumberType::Protocol:
+        if (const auto *entry = findByValue(protocolNames, value))
+            return entry->name;
+        break;
+    case AssignedNumberType::ServiceClass:
+        if (const auto *entry = findByValue(serviceClassNames, value))
+            return entry->name;
+        break;
+    case AssignedNumberType::Characteristic:
+        if (const auto *entry = findByValue(characteristicNames, value))
+            return entry->name;
+        break;
+    case AssignedNumberType::Descriptor:
+        if (const auto *entry = findByValue(descriptorNames, value))
+            return entry->name;
+        break;
+    }
+    return nullptr;
+}
+
+std::optional<quint16> assignedNumber(AssignedNumberType type, QAnyStringView name) noexcept
+{
+    switch (type) {
+    case AssignedNumberType::Protocol:
+        if (const auto *entry = findByName(protocolNames, protocolsByName, name))
+            return quint16(entry->value);
+        break;
+    case AssignedNumberType::ServiceClass:
+        if (const auto *entry = findByName(serviceClassNames, serviceClassesByName, name))
+            return quint16(entry->value);
+        break;
+    case AssignedNumberType::Characteristic:
+        if (const auto *entry = findByName(characteristicNames, characteristicsByName, name))
+            return quint16(entry->value);
+        break;
+    case AssignedNumberType::Descriptor:
+        if (const auto *entry = findByName(descriptorNames, descriptorsByName, name))
+            return quint16(entry->value);
+        break;
+    }
+    return std::nullopt;
+}
+
+} // namespace QtBluetoothPrivate
+
 /*!
     Returns a human-readable and translated name for the given service class
     represented by \a uuid.
@@ -640,102 +1455,7 @@ quint32 QBluetoothUuid::toUInt32(bool *ok) const
  */
 QString QBluetoothUuid::serviceClassToString(QBluetoothUuid::ServiceClassUuid uuid)
 {
-    switch (uuid) {
-    case QBluetoothUuid::ServiceClassUuid::ServiceDiscoveryServer: return QBluetoothServiceDiscoveryAgent::tr("Service Discovery");
-    case QBluetoothUuid::ServiceClassUuid::BrowseGroupDescriptor: return QBluetoothServiceDiscoveryAgent::tr("Browse Group Descriptor");
-    case QBluetoothUuid::ServiceClassUuid::PublicBrowseGroup: return QBluetoothServiceDiscoveryAgent::tr("Public Browse Group");
-    case QBluetoothUuid::ServiceClassUuid::SerialPort: return QBluetoothServiceDiscoveryAgent::tr("Serial Port Profile");
-    case QBluetoothUuid::ServiceClassUuid::LANAccessUsingPPP: return QBluetoothServiceDiscoveryAgent::tr("LAN Access Profile");
-    case QBluetoothUuid::ServiceClassUuid::DialupNetworking: return QBluetoothServiceDiscoveryAgent::tr("Dial-Up Networking");
-    case QBluetoothUuid::ServiceClassUuid::IrMCSync: return QBluetoothServiceDiscoveryAgent::tr("Synchronization");
-    case QBluetoothUuid::ServiceClassUuid::ObexObjectPush: return QBluetoothServiceDiscoveryAgent::tr("Object Push");
-    case QBluetoothUuid::ServiceClassUuid::OBEXFileTransfer: return QBluetoothServiceDiscoveryAgent::tr("File Transfer");
-    case QBluetoothUuid::ServiceClassUuid::IrMCSyncCommand: return QBluetoothServiceDiscoveryAgent::tr("Synchronization Command");
-    case QBluetoothUuid::ServiceClassUuid::Headset: return QBluetoothServiceDiscoveryAgent::tr("Headset");
-    case QBluetoothUuid::ServiceClassUuid::AudioSource: return QBluetoothServiceDiscoveryAgent::tr("Audio Source");
-    case QBluetoothUuid::ServiceClassUuid::AudioSink: return QBluetoothServiceDiscoveryAgent::tr("Audio Sink");
-    case QBluetoothUuid::ServiceClassUuid::AV_RemoteControlTarget: return QBluetoothServiceDiscoveryAgent::tr("Audio/Video Remote Control Target");
-    case QBluetoothUuid::ServiceClassUuid::AdvancedAudioDistribution: return QBluetoothServiceDiscoveryAgent::tr("Advanced Audio Distribution");
-    case QBluetoothUuid::ServiceClassUuid::AV_RemoteControl: return QBluetoothServiceDiscoveryAgent::tr("Audio/Video Remote Control");
-    case QBluetoothUuid::ServiceClassUuid::AV_RemoteControlController: return QBluetoothServiceDiscoveryAgent::tr("Audio/Video Remote Control Controller");
-    case QBluetoothUuid::ServiceClassUuid::HeadsetAG: return QBluetoothServiceDiscoveryAgent::tr("Headset AG");
-    case QBluetoothUuid::ServiceClassUuid::PANU: return QBluetoothServiceDiscoveryAgent::tr("Personal Area Networking (PANU)");
-    case QBluetoothUuid::ServiceClassUuid::NAP: return QBluetoothServiceDiscoveryAgent::tr("Personal Area Networking (NAP)");
-    case QBluetoothUuid::ServiceClassUuid::GN: return QBluetoothServiceDiscoveryAgent::tr("Personal Area Networking (GN)");
-    case QBluetoothUuid::ServiceClassUuid::DirectPrinting: return QBluetoothServiceDiscoveryAgent::tr("Basic Direct Printing (BPP)");
-    case QBluetoothUuid::ServiceClassUuid::ReferencePrinting: return QBluetoothServiceDiscoveryAgent::tr("Basic Reference Printing (BPP)");
-    case QBluetoothUuid::ServiceClassUuid::BasicImage: return QBluetoothServiceDiscoveryAgent::tr("Basic Imaging Profile");
-    case QBluetoothUuid::ServiceClassUuid::ImagingResponder: return QBluetoothServiceDiscoveryAgent::tr("Basic Imaging Responder");
-    case QBluetoothUuid::ServiceClassUuid::ImagingAutomaticArchive: return QBluetoothServiceDiscoveryAgent::tr("Basic Imaging Archive");
-    case QBluetoothUuid::ServiceClassUuid::ImagingReferenceObjects: return QBluetoothServiceDiscoveryAgent::tr("Basic Imaging Ref Objects");
-    case QBluetoothUuid::ServiceClassUuid::Handsfree: return QBluetoothServiceDiscoveryAgent::tr("Hands-Free");
-    case QBluetoothUuid::ServiceClassUuid::HandsfreeAudioGateway: return QBluetoothServiceDiscoveryAgent::tr("Hands-Free AG");
-    case QBluetoothUuid::ServiceClassUuid::DirectPrintingReferenceObjectsService: return QBluetoothServiceDiscoveryAgent::tr("Basic Printing RefObject Service");
-    case QBluetoothUuid::ServiceClassUuid::ReflectedUI: return QBluetoothServiceDiscoveryAgent::tr("Basic Printing Reflected UI");
-    case QBluetoothUuid::ServiceClassUuid::BasicPrinting: return QBluetoothServiceDiscoveryAgent::tr("Basic Printing");
-    case QBluetoothUuid::ServiceClassUuid::PrintingStatus: return QBluetoothServiceDiscoveryAgent::tr("Basic Printing Status");
-    case QBluetoothUuid::ServiceClassUuid::HumanInterfaceDeviceService: return QBluetoothServiceDiscoveryAgent::tr("Human Interface Device");
-    case QBluetoothUuid::ServiceClassUuid::HardcopyCableReplacement: return QBluetoothServiceDiscoveryAgent::tr("Hardcopy Cable Replacement");
-    case QBluetoothUuid::ServiceClassUuid::HCRPrint: return QBluetoothServiceDiscoveryAgent::tr("Hardcopy Cable Replacement Print");
-    case QBluetoothUuid::ServiceClassUuid::HCRScan: return QBluetoothServiceDiscoveryAgent::tr("Hardcopy Cable Replacement Scan");
-    case QBluetoothUuid::ServiceClassUuid::SIMAccess: return QBluetoothServiceDiscoveryAgent::tr("SIM Access Server");
-    case QBluetoothUuid::ServiceClassUuid::PhonebookAccessPCE: return QBluetoothServiceDiscoveryAgent::tr("Phonebook Access PCE");
-    case QBluetoothUuid::ServiceClassUuid::PhonebookAccessPSE: return QBluetoothServiceDiscoveryAgent::tr("Phonebook Access PSE");
-    case QBluetoothUuid::ServiceClassUuid::PhonebookAccess: return QBluetoothServiceDiscoveryAgent::tr("Phonebook Access");
-    case QBluetoothUuid::ServiceClassUuid::HeadsetHS: return QBluetoothServiceDiscoveryAgent::tr("Headset HS");
-    case QBluetoothUuid::ServiceClassUuid::MessageAccessServer: return QBluetoothServiceDiscoveryAgent::tr("Message Access Server");
-    case QBluetoothUuid::ServiceClassUuid::MessageNotificationServer: return QBluetoothServiceDiscoveryAgent::tr("Message Notification Server");
-    case QBluetoothUuid::ServiceClassUuid::MessageAccessProfile: return QBluetoothServiceDiscoveryAgent::tr("Message Access");
-    case QBluetoothUuid::ServiceClassUuid::GNSS: return QBluetoothServiceDiscoveryAgent::tr("Global Navigation Satellite System");
-    case QBluetoothUuid::ServiceClassUuid::GNSSServer: return QBluetoothServiceDiscoveryAgent::tr("Global Navigation Satellite System Server");
-    case QBluetoothUuid::ServiceClassUuid::Display3D: return QBluetoothServiceDiscoveryAgent::tr("3D Synchronization Display");
-    case QBluetoothUuid::ServiceClassUuid::Glasses3D: return QBluetoothServiceDiscoveryAgent::tr("3D Synchronization Glasses");
-    case QBluetoothUuid::ServiceClassUuid::Synchronization3D: return QBluetoothServiceDiscoveryAgent::tr("3D Synchronization");
-    case QBluetoothUuid::ServiceClassUuid::MPSProfile: return QBluetoothServiceDiscoveryAgent::tr("Multi-Profile Specification (Profile)");
-    case QBluetoothUuid::ServiceClassUuid::MPSService: return QBluetoothServiceDiscoveryAgent::tr("Multi-Profile Specification");
-    case QBluetoothUuid::ServiceClassUuid::PnPInformation: return QBluetoothServiceDiscoveryAgent::tr("Device Identification");
-    case QBluetoothUuid::ServiceClassUuid::GenericNetworking: return QBluetoothServiceDiscoveryAgent::tr("Generic Networking");
-    case QBluetoothUuid::ServiceClassUuid::GenericFileTransfer: return QBluetoothServiceDiscoveryAgent::tr("Generic File Transfer");
-    case QBluetoothUuid::ServiceClassUuid::GenericAudio: return QBluetoothServiceDiscoveryAgent::tr("Generic Audio");
-    case QBluetoothUuid::ServiceClassUuid::GenericTelephony: return QBluetoothServiceDiscoveryAgent::tr("Generic Telephony");
-    case QBluetoothUuid::ServiceClassUuid::VideoSource: return QBluetoothServiceDiscoveryAgent::tr("Video Source");
-    case QBluetoothUuid::ServiceClassUuid::VideoSink: return QBluetoothServiceDiscoveryAgent::tr("Video Sink");
-    case QBluetoothUuid::ServiceClassUuid::VideoDistribution: return QBluetoothServiceDiscoveryAgent::tr("Video Distribution");
-    case QBluetoothUuid::ServiceClassUuid::HDP: return QBluetoothServiceDiscoveryAgent::tr("Health Device");
-    case QBluetoothUuid::ServiceClassUuid::HDPSource: return QBluetoothServiceDiscoveryAgent::tr("Health Device Source");
-    case QBluetoothUuid::ServiceClassUuid::HDPSink: return QBluetoothServiceDiscoveryAgent::tr("Health Device Sink");
-    case QBluetoothUuid::ServiceClassUuid::GenericAccess: return QBluetoothServiceDiscoveryAgent::tr("Generic Access");
-    case QBluetoothUuid::ServiceClassUuid::GenericAttribute: return QBluetoothServiceDiscoveryAgent::tr("Generic Attribute");
-    case QBluetoothUuid::ServiceClassUuid::ImmediateAlert: return QBluetoothServiceDiscoveryAgent::tr("Immediate Alert");
-    case QBluetoothUuid::ServiceClassUuid::LinkLoss: return QBluetoothServiceDiscoveryAgent::tr("Link Loss");
-    case QBluetoothUuid::ServiceClassUuid::TxPower: return QBluetoothServiceDiscoveryAgent::tr("Tx Power");
-    case QBluetoothUuid::ServiceClassUuid::CurrentTimeService: return QBluetoothServiceDiscoveryAgent::tr("Current Time Service");
-    case QBluetoothUuid::ServiceClassUuid::ReferenceTimeUpdateService: return QBluetoothServiceDiscoveryAgent::tr("Reference Time Update Service");
-    case QBluetoothUuid::ServiceClassUuid::NextDSTChangeService: return QBluetoothServiceDiscoveryAgent::tr("Next DST Change Service");
-    case QBluetoothUuid::ServiceClassUuid::Glucose: return QBluetoothServiceDiscoveryAgent::tr("Glucose");
-    case QBluetoothUuid::ServiceClassUuid::HealthThermometer: return QBluetoothServiceDiscoveryAgent::tr("Health Thermometer");
-    case QBluetoothUuid::ServiceClassUuid::DeviceInformation: return QBluetoothServiceDiscoveryAgent::tr("Device Information");
-    case QBluetoothUuid::ServiceClassUuid::HeartRate: return QBluetoothServiceDiscoveryAgent::tr("Heart Rate");
-    case QBluetoothUuid::ServiceClassUuid::PhoneAlertStatusService: return QBluetoothServiceDiscoveryAgent::tr("Phone Alert Status Service");
-    case QBluetoothUuid::ServiceClassUuid::BatteryService: return QBluetoothServiceDiscoveryAgent::tr("Battery Service");
-    case QBluetoothUuid::ServiceClassUuid::BloodPressure: return QBluetoothServiceDiscoveryAgent::tr("Blood Pressure");
-    case QBluetoothUuid::ServiceClassUuid::AlertNotificationService: return QBluetoothServiceDiscoveryAgent::tr("Alert Notification Service");
-    case QBluetoothUuid::ServiceClassUuid::HumanInterfaceDevice: return QBluetoothServiceDiscoveryAgent::tr("Human Interface Device");
-    case QBluetoothUuid::ServiceClassUuid::ScanParameters: return QBluetoothServiceDiscoveryAgent::tr("Scan Parameters");
-    case QBluetoothUuid::ServiceClassUuid::RunningSpeedAndCadence: return QBluetoothServiceDiscoveryAgent::tr("Running Speed and Cadence");
-    case QBluetoothUuid::ServiceClassUuid::CyclingSpeedAndCadence: return QBluetoothServiceDiscoveryAgent::tr("Cycling Speed and Cadence");
-    case QBluetoothUuid::ServiceClassUuid::CyclingPower: return QBluetoothServiceDiscoveryAgent::tr("Cycling Power");
-    case QBluetoothUuid::ServiceClassUuid::LocationAndNavigation: return QBluetoothServiceDiscoveryAgent::tr("Location and Navigation");
-    case QBluetoothUuid::ServiceClassUuid::EnvironmentalSensing: return QBluetoothServiceDiscoveryAgent::tr("Environmental Sensing");
-    case QBluetoothUuid::ServiceClassUuid::BodyComposition: return QBluetoothServiceDiscoveryAgent::tr("Body Composition");
-    case QBluetoothUuid::ServiceClassUuid::UserData: return QBluetoothServiceDiscoveryAgent::tr("User Data");
-    case QBluetoothUuid::ServiceClassUuid::WeightScale: return QBluetoothServiceDiscoveryAgent::tr("Weight Scale");
-    //: Connection management (Bluetooth)
-    case QBluetoothUuid::ServiceClassUuid::BondManagement: return QBluetoothServiceDiscoveryAgent::tr("Bond Management");
-    case QBluetoothUuid::ServiceClassUuid::ContinuousGlucoseMonitoring: return QBluetoothServiceDiscoveryAgent::tr("Continuous Glucose Monitoring");
-    }
-
-    return QString();
+    return translatedName(serviceClassNames, uuid);
 }
 
 
@@ -749,35 +1469,7 @@ QString QBluetoothUuid::serviceClassToString(QBluetoothUuid::ServiceClassUuid uu
  */
 QString QBluetoothUuid::protocolToString(QBluetoothUuid::ProtocolUuid uuid)
 {
-    switch (uuid) {
-    case QBluetoothUuid::ProtocolUuid::Sdp: return QBluetoothServiceDiscoveryAgent::tr("Service Discovery Protocol");
-    case QBluetoothUuid::ProtocolUuid::Udp: return QBluetoothServiceDiscoveryAgent::tr("User Datagram Protocol");
-    case QBluetoothUuid::ProtocolUuid::Rfcomm: return QBluetoothServiceDiscoveryAgent::tr("Radio Frequency Communication");
-    case QBluetoothUuid::ProtocolUuid::Tcp: return QBluetoothServiceDiscoveryAgent::tr("Transmission Control Protocol");
-    case QBluetoothUuid::ProtocolUuid::TcsBin: return QBluetoothServiceDiscoveryAgent::tr("Telephony Control Specification - Binary");
-    case QBluetoothUuid::ProtocolUuid::TcsAt: return QBluetoothServiceDiscoveryAgent::tr("Telephony Control Specification - AT");
-    case QBluetoothUuid::ProtocolUuid::Att: return QBluetoothServiceDiscoveryAgent::tr("Attribute Protocol");
-    case QBluetoothUuid::ProtocolUuid::Obex: return QBluetoothServiceDiscoveryAgent::tr("Object Exchange Protocol");
-    case QBluetoothUuid::ProtocolUuid::Ip: return QBluetoothServiceDiscoveryAgent::tr("Internet Protocol");
-    case QBluetoothUuid::ProtocolUuid::Ftp: return QBluetoothServiceDiscoveryAgent::tr("File Transfer Protocol");
-    case QBluetoothUuid::ProtocolUuid::Http: return QBluetoothServiceDiscoveryAgent::tr("Hypertext Transfer Protocol");
-    case QBluetoothUuid::ProtocolUuid::Wsp: return QBluetoothServiceDiscoveryAgent::tr("Wireless Short Packet Protocol");
-    case QBluetoothUuid::ProtocolUuid::Bnep: return QBluetoothServiceDiscoveryAgent::tr("Bluetooth Network Encapsulation Protocol");
-    case QBluetoothUuid::ProtocolUuid::Upnp: return QBluetoothServiceDiscoveryAgent::tr("Extended Service Discovery Protocol");
-    case QBluetoothUuid::ProtocolUuid::Hidp: return QBluetoothServiceDiscoveryAgent::tr("Human Interface Device Protocol");
-    case QBluetoothUuid::ProtocolUuid::HardcopyControlChannel: return QBluetoothServiceDiscoveryAgent::tr("Hardcopy Control Channel");
-    case QBluetoothUuid::ProtocolUuid::HardcopyDataChannel: return QBluetoothServiceDiscoveryAgent::tr("Hardcopy Data Channel");
-    case QBluetoothUuid::ProtocolUuid::HardcopyNotification: return QBluetoothServiceDiscoveryAgent::tr("Hardcopy Notification");
-    case QBluetoothUuid::ProtocolUuid::Avctp: return QBluetoothServiceDiscoveryAgent::tr("Audio/Video Control Transport Protocol");
-    case QBluetoothUuid::ProtocolUuid::Avdtp: return QBluetoothServiceDiscoveryAgent::tr("Audio/Video Distribution Transport Protocol");
-    case QBluetoothUuid::ProtocolUuid::Cmtp: return QBluetoothServiceDiscoveryAgent::tr("Common ISDN Access Protocol");
-    case QBluetoothUuid::ProtocolUuid::UdiCPlain: return QBluetoothServiceDiscoveryAgent::tr("UdiCPlain");
-    case QBluetoothUuid::ProtocolUuid::McapControlChannel: return QBluetoothServiceDiscoveryAgent::tr("Multi-Channel Adaptation Protocol - Control");
-    case QBluetoothUuid::ProtocolUuid::McapDataChannel: return QBluetoothServiceDiscoveryAgent::tr("Multi-Channel Adaptation Protocol - Data");
-    case QBluetoothUuid::ProtocolUuid::L2cap: return QBluetoothServiceDiscoveryAgent::tr("Layer 2 Control Protocol");
-    }
-
-    return QString();
+    return translatedName(protocolNames, uuid);
 }
 
 /*!
@@ -790,202 +1482,7 @@ QString QBluetoothUuid::protocolToString(QBluetoothUuid::ProtocolUuid uuid)
 */
 QString QBluetoothUuid::characteristicToString(CharacteristicType uuid)
 {
-    switch (uuid) {
-    //: GAP:  Generic Access Profile (Bluetooth)
-    case QBluetoothUuid::CharacteristicType::DeviceName: return QBluetoothServiceDiscoveryAgent::tr("GAP Device Name");
-    //: GAP:  Generic Access Profile (Bluetooth)
-    case QBluetoothUuid::CharacteristicType::Appearance: return QBluetoothServiceDiscoveryAgent::tr("GAP Appearance");
-    case QBluetoothUuid::CharacteristicType::PeripheralPrivacyFlag:
-        //: GAP:  Generic Access Profile (Bluetooth)
-        return QBluetoothServiceDiscoveryAgent::tr("GAP Peripheral Privacy Flag");
-    case QBluetoothUuid::CharacteristicType::ReconnectionAddress:
-        //: GAP:  Generic Access Profile (Bluetooth)
-        return QBluetoothServiceDiscoveryAgent::tr("GAP Reconnection Address");
-    case QBluetoothUuid::CharacteristicType::PeripheralPreferredConnectionParameters:
-        return QBluetoothServiceDiscoveryAgent::tr("GAP Peripheral Preferred Connection Parameters");
-    //: GATT: _G_eneric _Att_ribute Profile (Bluetooth)
-    case QBluetoothUuid::CharacteristicType::ServiceChanged: return QBluetoothServiceDiscoveryAgent::tr("GATT Service Changed");
-    case QBluetoothUuid::CharacteristicType::AlertLevel: return QBluetoothServiceDiscoveryAgent::tr("Alert Level");
-    case QBluetoothUuid::CharacteristicType::TxPowerLevel: return QBluetoothServiceDiscoveryAgent::tr("TX Power");
-    case QBluetoothUuid::CharacteristicType::DateTime: return QBluetoothServiceDiscoveryAgent::tr("Date Time");
-    case QBluetoothUuid::CharacteristicType::DayOfWeek: return QBluetoothServiceDiscoveryAgent::tr("Day Of Week");
-    case QBluetoothUuid::CharacteristicType::DayDateTime: return QBluetoothServiceDiscoveryAgent::tr("Day Date Time");
-    case QBluetoothUuid::CharacteristicType::ExactTime256: return QBluetoothServiceDiscoveryAgent::tr("Exact Time 256");
-    case QBluetoothUuid::CharacteristicType::DSTOffset: return QBluetoothServiceDiscoveryAgent::tr("DST Offset");
-    case QBluetoothUuid::CharacteristicType::TimeZone: return QBluetoothServiceDiscoveryAgent::tr("Time Zone");
-    case QBluetoothUuid::CharacteristicType::LocalTimeInformation:
-        return QBluetoothServiceDiscoveryAgent::tr("Local Time Information");
-    case QBluetoothUuid::CharacteristicType::TimeWithDST: return QBluetoothServiceDiscoveryAgent::tr("Time With DST");
-    case QBluetoothUuid::CharacteristicType::TimeAccuracy: return QBluetoothServiceDiscoveryAgent::tr("Time Accuracy");
-    case QBluetoothUuid::CharacteristicType::TimeSource: return QBluetoothServiceDiscoveryAgent::tr("Time Source");
-    case QBluetoothUuid::CharacteristicType::ReferenceTimeInformation:
-        return QBluetoothServiceDiscoveryAgent::tr("Reference Time Information");
-    case QBluetoothUuid::CharacteristicType::TimeUpdateControlPoint:
-        return QBluetoothServiceDiscoveryAgent::tr("Time Update Control Point");
-    case QBluetoothUuid::CharacteristicType::TimeUpdateState: return QBluetoothServiceDiscoveryAgent::tr("Time Update State");
-    case QBluetoothUuid::CharacteristicType::GlucoseMeasurement: return QBluetoothServiceDiscoveryAgent::tr("Glucose Measurement");
-    case QBluetoothUuid::CharacteristicType::BatteryLevel: return QBluetoothServiceDiscoveryAgent::tr("Battery Level");
-    case QBluetoothUuid::CharacteristicType::TemperatureMeasurement:
-        return QBluetoothServiceDiscoveryAgent::tr("Temperature Measurement");
-    case QBluetoothUuid::CharacteristicType::TemperatureType: return QBluetoothServiceDiscoveryAgent::tr("Temperature Type");
-    case QBluetoothUuid::CharacteristicType::IntermediateTemperature:
-        return QBluetoothServiceDiscoveryAgent::tr("Intermediate Temperature");
-    case QBluetoothUuid::CharacteristicType::MeasurementInterval: return QBluetoothServiceDiscoveryAgent::tr("Measurement Interval");
-    case QBluetoothUuid::CharacteristicType::BootKeyboardInputReport: return QBluetoothServiceDiscoveryAgent::tr("Boot Keyboard Input Report");
-    case QBluetoothUuid::CharacteristicType::SystemID: return QBluetoothServiceDiscoveryAgent::tr("System ID");
-    case QBluetoothUuid::CharacteristicType::ModelNumberString: return QBluetoothServiceDiscoveryAgent::tr("Model Number String");
-    case QBluetoothUuid::CharacteristicType::SerialNumberString: return QBluetoothServiceDiscoveryAgent::tr("Serial Number String");
-    case QBluetoothUuid::CharacteristicType::FirmwareRevisionString: return QBluetoothServiceDiscoveryAgent::tr("Firmware Revision String");
-    case QBluetoothUuid::CharacteristicType::HardwareRevisionString: return QBluetoothServiceDiscoveryAgent::tr("Hardware Revision String");
-    case QBluetoothUuid::CharacteristicType::SoftwareRevisionString: return QBluetoothServiceDiscoveryAgent::tr("Software Revision String");
-    case QBluetoothUuid::CharacteristicType::ManufacturerNameString: return QBluetoothServiceDiscoveryAgent::tr("Manufacturer Name String");
-    case QBluetoothUuid::CharacteristicType::IEEE1107320601RegulatoryCertificationDataList:
-        return QBluetoothServiceDiscoveryAgent::tr("IEEE 11073 20601 Regulatory Certification Data List");
-    case QBluetoothUuid::CharacteristicType::CurrentTime: return QBluetoothServiceDiscoveryAgent::tr("Current Time");
-    case QBluetoothUuid::CharacteristicType::ScanRefresh: return QBluetoothServiceDiscoveryAgent::tr("Scan Refresh");
-    case QBluetoothUuid::CharacteristicType::BootKeyboardOutputReport:
-        return QBluetoothServiceDiscoveryAgent::tr("Boot Keyboard Output Report");
-    case QBluetoothUuid::CharacteristicType::BootMouseInputReport: return QBluetoothServiceDiscoveryAgent::tr("Boot Mouse Input Report");
-    case QBluetoothUuid::CharacteristicType::GlucoseMeasurementContext:
-        return QBluetoothServiceDiscoveryAgent::tr("Glucose Measurement Context");
-    case QBluetoothUuid::CharacteristicType::BloodPressureMeasurement:
-        return QBluetoothServiceDiscoveryAgent::tr("Blood Pressure Measurement");
-    case QBluetoothUuid::CharacteristicType::IntermediateCuffPressure:
-        return QBluetoothServiceDiscoveryAgent::tr("Intermediate Cuff Pressure");
-    case QBluetoothUuid::CharacteristicType::HeartRateMeasurement: return QBluetoothServiceDiscoveryAgent::tr("Heart Rate Measurement");
-    case QBluetoothUuid::CharacteristicType::BodySensorLocation: return QBluetoothServiceDiscoveryAgent::tr("Body Sensor Location");
-    case QBluetoothUuid::CharacteristicType::HeartRateControlPoint: return QBluetoothServiceDiscoveryAgent::tr("Heart Rate Control Point");
-    case QBluetoothUuid::CharacteristicType::AlertStatus: return QBluetoothServiceDiscoveryAgent::tr("Alert Status");
-    case QBluetoothUuid::CharacteristicType::RingerControlPoint: return QBluetoothServiceDiscoveryAgent::tr("Ringer Control Point");
-    case QBluetoothUuid::CharacteristicType::RingerSetting: return QBluetoothServiceDiscoveryAgent::tr("Ringer Setting");
-    case QBluetoothUuid::CharacteristicType::AlertCategoryIDBitMask:
-        return QBluetoothServiceDiscoveryAgent::tr("Alert Category ID Bit Mask");
-    case QBluetoothUuid::CharacteristicType::AlertCategoryID: return QBluetoothServiceDiscoveryAgent::tr("Alert Category ID");
-    case QBluetoothUuid::CharacteristicType::AlertNotificationControlPoint:
-        return QBluetoothServiceDiscoveryAgent::tr("Alert Notification Control Point");
-    case QBluetoothUuid::CharacteristicType::UnreadAlertStatus: return QBluetoothServiceDiscoveryAgent::tr("Unread Alert Status");
-    case QBluetoothUuid::CharacteristicType::NewAlert: return QBluetoothServiceDiscoveryAgent::tr("New Alert");
-    case QBluetoothUuid::CharacteristicType::SupportedNewAlertCategory:
-        return QBluetoothServiceDiscoveryAgent::tr("Supported New Alert Category");
-    case QBluetoothUuid::CharacteristicType::SupportedUnreadAlertCategory:
-        return QBluetoothServiceDiscoveryAgent::tr("Supported Unread Alert Category");
-    case QBluetoothUuid::CharacteristicType::BloodPressureFeature: return QBluetoothServiceDiscoveryAgent::tr("Blood Pressure Feature");
-        //: HID: Human Interface Device Profile (Bluetooth)
-    case QBluetoothUuid::CharacteristicType::HIDInformation: return QBluetoothServiceDiscoveryAgent::tr("HID Information");
-    case QBluetoothUuid::CharacteristicType::ReportMap: return QBluetoothServiceDiscoveryAgent::tr("Report Map");
-        //: HID: Human Interface Device Profile (Bluetooth)
-    case QBluetoothUuid::CharacteristicType::HIDControlPoint: return QBluetoothServiceDiscoveryAgent::tr("HID Control Point");
-    case QBluetoothUuid::CharacteristicType::Report: return QBluetoothServiceDiscoveryAgent::tr("Report");
-    case QBluetoothUuid::CharacteristicType::ProtocolMode: return QBluetoothServiceDiscoveryAgent::tr("Protocol Mode");
-    case QBluetoothUuid::CharacteristicType::ScanIntervalWindow: return QBluetoothServiceDiscoveryAgent::tr("Scan Interval Window");
-    case QBluetoothUuid::CharacteristicType::PnPID: return QBluetoothServiceDiscoveryAgent::tr("PnP ID");
-    case QBluetoothUuid::CharacteristicType::GlucoseFeature: return QBluetoothServiceDiscoveryAgent::tr("Glucose Feature");
-    case QBluetoothUuid::CharacteristicType::RecordAccessControlPoint:
-        //: Glucose Sensor patient record database.
-        return QBluetoothServiceDiscoveryAgent::tr("Record Access Control Point");
-    //: RSC: Running Speed and Cadence
-    case QBluetoothUuid::CharacteristicType::RSCMeasurement: return QBluetoothServiceDiscoveryAgent::tr("RSC Measurement");
-    //: RSC: Running Speed and Cadence
-    case QBluetoothUuid::CharacteristicType::RSCFeature: return QBluetoothServiceDiscoveryAgent::tr("RSC Feature");
-    case QBluetoothUuid::CharacteristicType::SCControlPoint: return QBluetoothServiceDiscoveryAgent::tr("SC Control Point");
-    //: CSC: Cycling Speed and Cadence
-    case QBluetoothUuid::CharacteristicType::CSCMeasurement: return QBluetoothServiceDiscoveryAgent::tr("CSC Measurement");
-    //: CSC: Cycling Speed and Cadence
-    case QBluetoothUuid::CharacteristicType::CSCFeature: return QBluetoothServiceDiscoveryAgent::tr("CSC Feature");
-    case QBluetoothUuid::CharacteristicType::SensorLocation: return QBluetoothServiceDiscoveryAgent::tr("Sensor Location");
-    case QBluetoothUuid::CharacteristicType::CyclingPowerMeasurement:
-        return QBluetoothServiceDiscoveryAgent::tr("Cycling Power Measurement");
-    case QBluetoothUuid::CharacteristicType::CyclingPowerVector: return QBluetoothServiceDiscoveryAgent::tr("Cycling Power Vector");
-    case QBluetoothUuid::CharacteristicType::CyclingPowerFeature: return QBluetoothServiceDiscoveryAgent::tr("Cycling Power Feature");
-    case QBluetoothUuid::CharacteristicType::CyclingPowerControlPoint:
-        return QBluetoothServiceDiscoveryAgent::tr("Cycling Power Control Point");
-    case QBluetoothUuid::CharacteristicType::LocationAndSpeed: return QBluetoothServiceDiscoveryAgent::tr("Location And Speed");
-    case QBluetoothUuid::CharacteristicType::Navigation: return QBluetoothServiceDiscoveryAgent::tr("Navigation");
-    case QBluetoothUuid::CharacteristicType::PositionQuality: return QBluetoothServiceDiscoveryAgent::tr("Position Quality");
-    case QBluetoothUuid::CharacteristicType::LNFeature: return QBluetoothServiceDiscoveryAgent::tr("LN Feature");
-    case QBluetoothUuid::CharacteristicType::LNControlPoint: return QBluetoothServiceDiscoveryAgent::tr("LN Control Point");
-    case QBluetoothUuid::CharacteristicType::MagneticDeclination:
-        //: Angle between geographic and magnetic north
-        return QBluetoothServiceDiscoveryAgent::tr("Magnetic Declination");
-    //: Above/below sea level
-    case QBluetoothUuid::CharacteristicType::Elevation: return QBluetoothServiceDiscoveryAgent::tr("Elevation");
-    case QBluetoothUuid::CharacteristicType::Pressure: return QBluetoothServiceDiscoveryAgent::tr("Pressure");
-    case QBluetoothUuid::CharacteristicType::Temperature: return QBluetoothServiceDiscoveryAgent::tr("Temperature");
-    case QBluetoothUuid::CharacteristicType::Humidity: return QBluetoothServiceDiscoveryAgent::tr("Humidity");
-    //: Wind speed while standing
-    case QBluetoothUuid::CharacteristicType::TrueWindSpeed: return QBluetoothServiceDiscoveryAgent::tr("True Wind Speed");
-    case QBluetoothUuid::CharacteristicType::TrueWindDirection : return QBluetoothServiceDiscoveryAgent::tr("True Wind Direction");
-    case QBluetoothUuid::CharacteristicType::ApparentWindSpeed:
-        //: Wind speed while observer is moving
-        return QBluetoothServiceDiscoveryAgent::tr("Apparent Wind Speed");
-    case QBluetoothUuid::CharacteristicType::ApparentWindDirection: return QBluetoothServiceDiscoveryAgent::tr("Apparent Wind Direction");
-    case QBluetoothUuid::CharacteristicType::GustFactor:
-        //: Factor by which wind gust is stronger than average wind
-        return QBluetoothServiceDiscoveryAgent::tr("Gust Factor");
-    case QBluetoothUuid::CharacteristicType::PollenConcentration: return QBluetoothServiceDiscoveryAgent::tr("Pollen Concentration");
-    case QBluetoothUuid::CharacteristicType::UVIndex: return QBluetoothServiceDiscoveryAgent::tr("UV Index");
-    case QBluetoothUuid::CharacteristicType::Irradiance: return QBluetoothServiceDiscoveryAgent::tr("Irradiance");
-    case QBluetoothUuid::CharacteristicType::Rainfall: return QBluetoothServiceDiscoveryAgent::tr("Rainfall");
-    case QBluetoothUuid::CharacteristicType::WindChill: return QBluetoothServiceDiscoveryAgent::tr("Wind Chill");
-    case QBluetoothUuid::CharacteristicType::HeatIndex: return QBluetoothServiceDiscoveryAgent::tr("Heat Index");
-    case QBluetoothUuid::CharacteristicType::DewPoint: return QBluetoothServiceDiscoveryAgent::tr("Dew Point");
-    case QBluetoothUuid::CharacteristicType::DescriptorValueChanged:
-        //: Environmental sensing related
-        return QBluetoothServiceDiscoveryAgent::tr("Descriptor Value Changed");
-    case QBluetoothUuid::CharacteristicType::AerobicHeartRateLowerLimit:
-        return QBluetoothServiceDiscoveryAgent::tr("Aerobic Heart Rate Lower Limit");
-    case QBluetoothUuid::CharacteristicType::AerobicHeartRateUpperLimit:
-        return QBluetoothServiceDiscoveryAgent::tr("Aerobic Heart Rate Upper Limit");
-    case QBluetoothUuid::CharacteristicType::AerobicThreshold: return QBluetoothServiceDiscoveryAgent::tr("Aerobic Threshold");
-    //: Age of person
-    case QBluetoothUuid::CharacteristicType::Age: return QBluetoothServiceDiscoveryAgent::tr("Age");
-    case QBluetoothUuid::CharacteristicType::AnaerobicHeartRateLowerLimit:
-        return QBluetoothServiceDiscoveryAgent::tr("Anaerobic Heart Rate Lower Limit");
-    case QBluetoothUuid::CharacteristicType::AnaerobicHeartRateUpperLimit:
-        return QBluetoothServiceDiscoveryAgent::tr("Anaerobic Heart Rate Upper Limit");
-    case QBluetoothUuid::CharacteristicType::AnaerobicThreshold: return QBluetoothServiceDiscoveryAgent::tr("Anaerobic Threshold");
-    case QBluetoothUuid::CharacteristicType::DateOfBirth: return QBluetoothServiceDiscoveryAgent::tr("Date Of Birth");
-    case QBluetoothUuid::CharacteristicType::DateOfThresholdAssessment: return QBluetoothServiceDiscoveryAgent::tr("Date Of Threshold Assessment");
-    case QBluetoothUuid::CharacteristicType::EmailAddress: return QBluetoothServiceDiscoveryAgent::tr("Email Address");
-    case QBluetoothUuid::CharacteristicType::FatBurnHeartRateLowerLimit:
-        return QBluetoothServiceDiscoveryAgent::tr("Fat Burn Heart Rate Lower Limit");
-    case QBluetoothUuid::CharacteristicType::FatBurnHeartRateUpperLimit:
-        return QBluetoothServiceDiscoveryAgent::tr("Fat Burn Heart Rate Upper Limit");
-    case QBluetoothUuid::CharacteristicType::FirstName: return QBluetoothServiceDiscoveryAgent::tr("First Name");
-    case QBluetoothUuid::CharacteristicType::FiveZoneHeartRateLimits: return QBluetoothServiceDiscoveryAgent::tr("5-Zone Heart Rate Limits");
-    case QBluetoothUuid::CharacteristicType::Gender: return QBluetoothServiceDiscoveryAgent::tr("Gender");
-    case QBluetoothUuid::CharacteristicType::HeartRateMax: return QBluetoothServiceDiscoveryAgent::tr("Heart Rate Maximum");
-    //: Height of a person
-    case QBluetoothUuid::CharacteristicType::Height: return QBluetoothServiceDiscoveryAgent::tr("Height");
-    case QBluetoothUuid::CharacteristicType::HipCircumference: return QBluetoothServiceDiscoveryAgent::tr("Hip Circumference");
-    case QBluetoothUuid::CharacteristicType::LastName: return QBluetoothServiceDiscoveryAgent::tr("Last Name");
-    case QBluetoothUuid::CharacteristicType::MaximumRecommendedHeartRate:
-        return QBluetoothServiceDiscoveryAgent::tr("Maximum Recommended Heart Rate");
-    case QBluetoothUuid::CharacteristicType::RestingHeartRate: return QBluetoothServiceDiscoveryAgent::tr("Resting Heart Rate");
-    case QBluetoothUuid::CharacteristicType::SportTypeForAerobicAnaerobicThresholds:
-          return QBluetoothServiceDiscoveryAgent::tr("Sport Type For Aerobic/Anaerobic Thresholds");
-    case QBluetoothUuid::CharacteristicType::ThreeZoneHeartRateLimits: return QBluetoothServiceDiscoveryAgent::tr("3-Zone Heart Rate Limits");
-    case QBluetoothUuid::CharacteristicType::TwoZoneHeartRateLimits: return QBluetoothServiceDiscoveryAgent::tr("2-Zone Heart Rate Limits");
-    case QBluetoothUuid::CharacteristicType::VO2Max: return QBluetoothServiceDiscoveryAgent::tr("Oxygen Uptake");
-    case QBluetoothUuid::CharacteristicType::WaistCircumference: return QBluetoothServiceDiscoveryAgent::tr("Waist Circumference");
-    case QBluetoothUuid::CharacteristicType::Weight: return QBluetoothServiceDiscoveryAgent::tr("Weight");
-    case QBluetoothUuid::CharacteristicType::DatabaseChangeIncrement:
-        //: Environmental sensing related
-        return QBluetoothServiceDiscoveryAgent::tr("Database Change Increment");
-    case QBluetoothUuid::CharacteristicType::UserIndex: return QBluetoothServiceDiscoveryAgent::tr("User Index");
-    case QBluetoothUuid::CharacteristicType::BodyCompositionFeature: return QBluetoothServiceDiscoveryAgent::tr("Body Composition Feature");
-    case QBluetoothUuid::CharacteristicType::BodyCompositionMeasurement: return QBluetoothServiceDiscoveryAgent::tr("Body Composition Measurement");
-    case QBluetoothUuid::CharacteristicType::WeightMeasurement: return QBluetoothServiceDiscoveryAgent::tr("Weight Measurement");
-    case QBluetoothUuid::CharacteristicType::WeightScaleFeature:
-        return QBluetoothServiceDiscoveryAgent::tr("Weight Scale Feature");
-    case QBluetoothUuid::CharacteristicType::UserControlPoint: return QBluetoothServiceDiscoveryAgent::tr("User Control Point");
-    case QBluetoothUuid::CharacteristicType::MagneticFluxDensity2D: return QBluetoothServiceDiscoveryAgent::tr("Magnetic Flux Density 2D");
-    case QBluetoothUuid::CharacteristicType::MagneticFluxDensity3D: return QBluetoothServiceDiscoveryAgent::tr("Magnetic Flux Density 3D");
-    case QBluetoothUuid::CharacteristicType::Language: return QBluetoothServiceDiscoveryAgent::tr("Language");
-    case QBluetoothUuid::CharacteristicType::BarometricPressureTrend: return QBluetoothServiceDiscoveryAgent::tr("Barometric Pressure Trend");
-    }
-
-    return QString();
+    return translatedName(characteristicNames, uuid);
 }
 
 /*!
@@ -998,36 +1495,7 @@ QString QBluetoothUuid::characteristicToString(CharacteristicType uuid)
 */
 QString QBluetoothUuid::descriptorToString(QBluetoothUuid::DescriptorType uuid)
 {
-    switch (uuid) {
-    case QBluetoothUuid::DescriptorType::UnknownDescriptorType:
-        break; // returns {} below
-    case QBluetoothUuid::DescriptorType::CharacteristicExtendedProperties:
-        return QBluetoothServiceDiscoveryAgent::tr("Characteristic Extended Properties");
-    case QBluetoothUuid::DescriptorType::CharacteristicUserDescription:
-        return QBluetoothServiceDiscoveryAgent::tr("Characteristic User Description");
-    case QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration:
-        return QBluetoothServiceDiscoveryAgent::tr("Client Characteristic Configuration");
-    case QBluetoothUuid::DescriptorType::ServerCharacteristicConfiguration:
-        return QBluetoothServiceDiscoveryAgent::tr("Server Characteristic Configuration");
-    case QBluetoothUuid::DescriptorType::CharacteristicPresentationFormat:
-        return QBluetoothServiceDiscoveryAgent::tr("Characteristic Presentation Format");
-    case QBluetoothUuid::DescriptorType::CharacteristicAggregateFormat:
-        return QBluetoothServiceDiscoveryAgent::tr("Characteristic Aggregate Format");
-    case QBluetoothUuid::DescriptorType::ValidRange:
-        return QBluetoothServiceDiscoveryAgent::tr("Valid Range");
-    case QBluetoothUuid::DescriptorType::ExternalReportReference:
-        return QBluetoothServiceDiscoveryAgent::tr("External Report Reference");
-    case QBluetoothUuid::DescriptorType::ReportReference:
-        return QBluetoothServiceDiscoveryAgent::tr("Report Reference");
-    case QBluetoothUuid::DescriptorType::EnvironmentalSensingConfiguration:
-        return QBluetoothServiceDiscoveryAgent::tr("Environmental Sensing Configuration");
-    case QBluetoothUuid::DescriptorType::EnvironmentalSensingMeasurement:
-        return QBluetoothServiceDiscoveryAgent::tr("Environmental Sensing Measurement");
-    case QBluetoothUuid::DescriptorType::EnvironmentalSensingTriggerSetting:
-        return QBluetoothServiceDiscoveryAgent::tr("Environmental Sensing Trigger Setting");
-    }
-
-    return QString();
+    return translatedName(descriptorNames, uuid);
 }
 
 /*!
@@ -1043,7 +1511,10 @@ QString QBluetoothUuid::descriptorToString(QBluetoothUuid::DescriptorType uuid)
 #ifndef QT_NO_DEBUG_STREAM
 QDebug operator<<(QDebug debug, const QBluetoothUuid &uuid)
 {
-    debug << uuid.toString();
+    char buffer[QtBluetoothPrivate::UuidStringLength + 2];
+    buffer[0] = '{';
+    *QtBluetoothPrivate::toUuidString(uuid, buffer + 1) = '}';
+    debug << QLatin1StringView(buffer, sizeof(buffer));
     return debug;
 }
 #endif
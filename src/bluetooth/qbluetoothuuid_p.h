@@ -0,0 +1,152 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QBLUETOOTHUUID_P_H
+#define QBLUETOOTHUUID_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtBluetooth/qbluetoothuuid.h>
+#include <QtBluetooth/private/qtbluetoothglobal_p.h>
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlatin1stringview.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <optional>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtBluetoothPrivate {
+
+// Characters of the xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx form used by BlueZ
+constexpr qsizetype UuidStringLength = 36;
+
+/*
+    Writes the UUID in lower case and without braces to out, which must
+    have room for UuidStringLength characters. This is the form of
+    QUuid::toString(QUuid::WithoutBraces). Returns the position after the
+    last written character.
+*/
+template <typename Char>
+Char *toUuidString(const QUuid &uuid, Char *out) noexcept
+{
+    const QUuid::Id128Bytes bytes = uuid.toBytes(QSysInfo::BigEndian);
+    for (int i = 0; i < 16; ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10)
+            *out++ = Char('-');
+        *out++ = Char(QtMiscUtils::toHexLower(bytes.data[i] >> 4));
+        *out++ = Char(QtMiscUtils::toHexLower(bytes.data[i]));
+    }
+    return out;
+}
+
+/*
+    Parses the 36 character form with or without braces, in either case.
+    Returns a null UUID if chars is in neither form.
+*/
+template <typename Char>
+QBluetoothUuid uuidFromString(const Char *chars, qsizetype size) noexcept
+{
+    if (size == UuidStringLength + 2) {
+        if (chars[0] != Char('{') || chars[size - 1] != Char('}'))
+            return QBluetoothUuid();
+        ++chars;
+        size -= 2;
+    }
+    if (size != UuidStringLength)
+        return QBluetoothUuid();
+
+    QUuid::Id128Bytes bytes;
+    qsizetype pos = 0;
+    for (quint8 &byte : bytes.data) {
+        if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+            if (chars[pos] != Char('-'))
+                return QBluetoothUuid();
+            ++pos;
+        }
+        const int high = QtMiscUtils::fromHex(char32_t(std::make_unsigned_t<Char>(chars[pos])));
+        const int low = QtMiscUtils::fromHex(char32_t(std::make_unsigned_t<Char>(chars[pos + 1])));
+        if (high < 0 || low < 0)
+            return QBluetoothUuid();
+        byte = quint8((high << 4) | low);
+        pos += 2;
+    }
+    return QBluetoothUuid(bytes, QSysInfo::BigEndian);
+}
+
+inline QBluetoothUuid uuidFromString(QStringView uuid) noexcept
+{
+    return uuidFromString(uuid.utf16(), uuid.size());
+}
+
+inline QBluetoothUuid uuidFromString(QLatin1StringView uuid) noexcept
+{
+    return uuidFromString(uuid.data(), uuid.size());
+}
+
+inline QBluetoothUuid uuidFromString(QByteArrayView uuid) noexcept
+{
+    return uuidFromString(uuid.data(), uuid.size());
+}
+
+/*
+    The assigned numbers known to QBluetoothUuid. Each enum is backed by a
+    table sorted by number and an index sorted by the untranslated names,
+    both built at compile time.
+*/
+enum class AssignedNumberType {
+    Protocol,
+    ServiceClass,
+    Characteristic,
+    Descriptor
+};
+
+constexpr AssignedNumberType assignedNumberType(QBluetoothUuid::ProtocolUuid) noexcept
+{ return AssignedNumberType::Protocol; }
+constexpr AssignedNumberType assignedNumberType(QBluetoothUuid::ServiceClassUuid) noexcept
+{ return AssignedNumberType::ServiceClass; }
+constexpr AssignedNumberType assignedNumberType(QBluetoothUuid::CharacteristicType) noexcept
+{ return AssignedNumberType::Characteristic; }
+constexpr AssignedNumberType assignedNumberType(QBluetoothUuid::DescriptorType) noexcept
+{ return AssignedNumberType::Descriptor; }
+
+// The untranslated name of value, nullptr if value has no name
+Q_BLUETOOTH_EXPORT const char *assignedNumberName(AssignedNumberType type, quint16 value) noexcept;
+
+// The number whose untranslated name is name. Names are compared case
+// sensitively, the lowest number wins if several numbers share a name.
+Q_BLUETOOTH_EXPORT std::optional<quint16> assignedNumber(AssignedNumberType type,
+                                                         QAnyStringView name) noexcept;
+
+template <typename Enum>
+std::optional<Enum> toAssignedNumber(quint16 value) noexcept
+{
+    if (!assignedNumberName(assignedNumberType(Enum{}), value))
+        return std::nullopt;
+    return Enum(value);
+}
+
+inline QBluetoothUuid uuidForAssignedName(AssignedNumberType type, QAnyStringView name) noexcept
+{
+    const std::optional<quint16> value = assignedNumber(type, name);
+    return value ? QBluetoothUuid(*value) : QBluetoothUuid();
+}
+
+} // namespace QtBluetoothPrivate
+
+QT_END_NAMESPACE
+
+#endif // QBLUETOOTHUUID_P_H
@@ -748,12 +748,7 @@ void QLowEnergyControllerPrivateAndroid::characteristicChanged(
         return;
     }
 
-    // only update cache when property is readable. Otherwise it remains
-    // empty.
-    if (characteristic.properties() & QLowEnergyCharacteristic::Read)
-        updateValueOfCharacteristic(characteristic.attributeHandle(),
-                                data, false);
-    emit service->characteristicChanged(characteristic, data);
+    remoteCharacteristicChanged(characteristic, data);
 }
 
 void QLowEnergyControllerPrivateAndroid::serverCharacteristicChanged(
@@ -7,6 +7,7 @@
 #include "qbluetoothsocketbase_p.h"
 #include "qbluetoothsocket_bluez_p.h"
 #include "qleadvertiser_bluez_p.h"
+#include "bluez/attioreader_p.h"
 #include "bluez/bluez_data_p.h"
 #include "bluez/hcimanager_p.h"
 #include "bluez/objectmanager_p.h"
@@ -165,6 +166,7 @@ QLowEnergyControllerPrivateBluez::QLowEnergyControllerPrivateBluez()
     : QLowEnergyControllerPrivate(),
       requestPending(false),
       mtuSize(ATT_DEFAULT_LE_MTU),
+      maxMtuSize(ATT_MAX_LE_MTU),
       securityLevelValue(-1),
       encryptionChangePending(false)
 {
@@ -212,6 +214,10 @@ void QLowEnergyControllerPrivateBluez::init()
         }
     );
 
+    // Opt-in: read the ATT socket on a dedicated I/O thread so that a busy
+    // owner thread does not delay indication confirmations
+    useIoThread = qEnvironmentVariableIntValue("QT_BLUETOOTH_LE_IO_THREAD") != 0;
+
     if (role == QLowEnergyController::CentralRole) {
         if (Q_UNLIKELY(!qEnvironmentVariableIsEmpty("BLUETOOTH_GATT_TIMEOUT"))) {
             bool ok = false;
@@ -318,6 +324,7 @@ void QLowEnergyControllerPrivateBluez::handleGattRequestTimeout()
 
 QLowEnergyControllerPrivateBluez::~QLowEnergyControllerPrivateBluez()
 {
+    stopIoReader();
     closeServerSocket();
     delete cmacCalculator;
     cmacCalculator = nullptr;
@@ -433,6 +440,7 @@ void QLowEnergyControllerPrivateBluez::connectToDevice()
     }
 
     setState(QLowEnergyController::ConnectingState);
+    stopIoReader();
     if (l2cpSocket) {
         delete l2cpSocket;
         l2cpSocket = nullptr;
@@ -618,6 +626,7 @@ void QLowEnergyControllerPrivateBluez::l2cpConnected()
 {
     Q_Q(QLowEnergyController);
 
+    startIoReader();
     securityLevelValue = securityLevel();
     exchangeMTU();
 
@@ -625,9 +634,41 @@ void QLowEnergyControllerPrivateBluez::l2cpConnected()
     emit q->connected();
 }
 
+#ifdef QT_BUILD_INTERNAL
+void QLowEnergyControllerPrivateBluez::connectToAttSocket(int socketDescriptor, quint16 maxMtu)
+{
+    Q_Q(QLowEnergyController);
+
+    stopIoReader();
+    delete l2cpSocket;
+    maxMtuSize = std::clamp(maxMtu, ATT_DEFAULT_LE_MTU, ATT_MAX_LE_MTU);
+
+    QBluetoothSocketPrivateBluez *rawSocketPrivate = new QBluetoothSocketPrivateBluez();
+    l2cpSocket = new QBluetoothSocket(
+                rawSocketPrivate, QBluetoothServiceInfo::L2capProtocol, this);
+    connect(l2cpSocket, &QBluetoothSocket::disconnected,
+            this, &QLowEnergyControllerPrivateBluez::l2cpDisconnected);
+    connect(l2cpSocket, &QBluetoothSocket::errorOccurred, this,
+            &QLowEnergyControllerPrivateBluez::l2cpErrorChanged);
+    connect(l2cpSocket, &QIODevice::readyRead, this, &QLowEnergyControllerPrivateBluez::l2cpReadyRead);
+    l2cpSocket->setSocketDescriptor(socketDescriptor, QBluetoothServiceInfo::L2capProtocol,
+            QBluetoothSocket::SocketState::ConnectedState, QIODevice::ReadWrite | QIODevice::Unbuffered);
+    startIoReader();
+
+    if (role == QLowEnergyController::CentralRole) {
+        createServicesForCentralIfRequired();
+        exchangeMTU();
+    }
+
+    setState(QLowEnergyController::ConnectedState);
+    emit q->connected();
+}
+#endif
+
 void QLowEnergyControllerPrivateBluez::disconnectFromDevice()
 {
     setState(QLowEnergyController::ClosingState);
+    stopIoReader();
     if (l2cpSocket)
         l2cpSocket->close();
     resetController();
@@ -690,6 +731,7 @@ void QLowEnergyControllerPrivateBluez::l2cpErrorChanged(QBluetoothSocket::Socket
 
 void QLowEnergyControllerPrivateBluez::resetController()
 {
+    stopIoReader();
     openRequests.clear();
     openPrepareWriteRequests.clear();
     scheduledIndications.clear();
@@ -721,9 +763,80 @@ void QLowEnergyControllerPrivateBluez::restartRequestTimer()
         requestTimer->start(gattRequestTimeout);
 }
 
+/*!
+ * Moves the reading of the ATT socket to the shared I/O thread. The I/O
+ * thread confirms indications right away and forwards every PDU to
+ * processIncomingPacket(). Requests, responses and API signals remain
+ * on the thread owning the controller.
+ *
+ * In the peripheral role this does not help: the ATT requests of the remote
+ * client are answered from the local attribute database, which belongs to
+ * the owner thread, so they still wait for that thread.
+ */
+void QLowEnergyControllerPrivateBluez::startIoReader()
+{
+    if (!useIoThread || !l2cpSocket || l2cpSocket->socketDescriptor() == -1)
+        return;
+
+    stopIoReader();
+    ioReader = AttIoReader::start(l2cpSocket->socketDescriptor());
+    if (!ioReader)
+        return; // keep reading on this thread
+
+    l2cpSocket->setReadNotificationEnabled(false);
+
+    // Packets queued by a previous reader must not leak into a new connection
+    const quint32 generation = ++ioReaderGeneration;
+    connect(ioReader, &AttIoReader::packetReceived, this,
+            [this, generation](const QByteArray &packet, bool indicationConfirmed) {
+                if (generation == ioReaderGeneration)
+                    processIncomingPacket(packet, indicationConfirmed);
+            });
+    connect(ioReader, &AttIoReader::socketClosed, this,
+            [this, generation](int error) {
+                if (generation == ioReaderGeneration)
+                    ioReaderSocketClosed(error);
+            });
+}
+
+void QLowEnergyControllerPrivateBluez::stopIoReader()
+{
+    if (!ioReader)
+        return;
+
+    ++ioReaderGeneration;
+    ioReader->stop();
+    ioReader = nullptr;
+    if (l2cpSocket)
+        l2cpSocket->setReadNotificationEnabled(true);
+}
+
+void QLowEnergyControllerPrivateBluez::ioReaderSocketClosed(int error)
+{
+    stopIoReader();
+    if (!l2cpSocket)
+        return;
+
+    // mirrors QBluetoothSocketPrivateBluez::_q_readNotify()
+    l2cpSocket->d_ptr->errorString = qt_error_string(error);
+    if (error == EHOSTDOWN)
+        l2cpSocket->setSocketError(QBluetoothSocket::SocketError::HostNotFoundError);
+    else if (error == ECONNRESET || error == 0)
+        l2cpSocket->setSocketError(QBluetoothSocket::SocketError::RemoteHostClosedError);
+    else
+        l2cpSocket->setSocketError(QBluetoothSocket::SocketError::UnknownSocketError);
+
+    l2cpSocket->disconnectFromService();
+}
+
 void QLowEnergyControllerPrivateBluez::l2cpReadyRead()
 {
-    const QByteArray incomingPacket = l2cpSocket->readAll();
+    processIncomingPacket(l2cpSocket->readAll(), false);
+}
+
+void QLowEnergyControllerPrivateBluez::processIncomingPacket(const QByteArray &incomingPacket,
+                                                             bool indicationConfirmed)
+{
     qCDebug(QT_BT_BLUEZ) << "Received size:" << incomingPacket.size() << "data:"
                          << incomingPacket.toHex();
     if (incomingPacket.isEmpty())
@@ -737,10 +850,12 @@ void QLowEnergyControllerPrivateBluez::l2cpReadyRead()
         return;
     }
     case QBluezConst::AttCommand::ATT_OP_HANDLE_VAL_INDICATION: {
-        //send confirmation
-        QByteArray packet;
-        packet.append(static_cast<quint8>(QBluezConst::AttCommand::ATT_OP_HANDLE_VAL_CONFIRMATION));
-        sendPacket(packet);
+        //send confirmation, unless the I/O thread did already
+        if (!indicationConfirmed) {
+            QByteArray packet;
+            packet.append(static_cast<quint8>(QBluezConst::AttCommand::ATT_OP_HANDLE_VAL_CONFIRMATION));
+            sendPacket(packet);
+        }
 
         processUnsolicitedReply(incomingPacket);
         return;
@@ -1000,9 +1115,7 @@ void QLowEnergyControllerPrivateBluez::processReply(
             }
             const char *data = response.constData();
             quint16 mtu = bt_get_le16(&data[1]);
-            mtuSize = mtu;
-            if (mtuSize < ATT_DEFAULT_LE_MTU)
-                mtuSize = ATT_DEFAULT_LE_MTU;
+            mtuSize = std::clamp(mtu, ATT_DEFAULT_LE_MTU, maxMtuSize);
 
             qCDebug(QT_BT_BLUEZ) << "Server MTU:" << mtu << "resulting mtu:" << mtuSize;
         }
@@ -1791,9 +1904,7 @@ void QLowEnergyControllerPrivateBluez::processUnsolicitedReply(const QByteArray
 
     const QLowEnergyCharacteristic ch = characteristicForHandle(changedHandle);
     if (ch.isValid() && ch.handle() == changedHandle) {
-        if (ch.properties() & QLowEnergyCharacteristic::Read)
-            updateValueOfCharacteristic(ch.attributeHandle(), payload.mid(3), NEW_VALUE);
-        emit ch.d_ptr->characteristicChanged(ch, payload.mid(3));
+        remoteCharacteristicChanged(ch, QByteArrayView(payload).sliced(3));
     } else {
         qCWarning(QT_BT_BLUEZ) << "Cannot find matching characteristic for "
                                   "notification/indication";
@@ -1806,7 +1917,7 @@ void QLowEnergyControllerPrivateBluez::exchangeMTU()
 
     quint8 packet[MTU_EXCHANGE_HEADER_SIZE];
     packet[0] = static_cast<quint8>(QBluezConst::AttCommand::ATT_OP_EXCHANGE_MTU_REQUEST);
-    putBtData(ATT_MAX_LE_MTU, &packet[1]);
+    putBtData(maxMtuSize, &packet[1]);
 
     QByteArray data(MTU_EXCHANGE_HEADER_SIZE, Qt::Uninitialized);
     memcpy(data.data(), packet, MTU_EXCHANGE_HEADER_SIZE);
@@ -2231,15 +2342,15 @@ void QLowEnergyControllerPrivateBluez::handleExchangeMtuRequest(const QByteArray
     // Send reply.
     QByteArray reply(MTU_EXCHANGE_HEADER_SIZE, Qt::Uninitialized);
     reply[0] = static_cast<quint8>(QBluezConst::AttCommand::ATT_OP_EXCHANGE_MTU_RESPONSE);
-    putBtData(ATT_MAX_LE_MTU, reply.data() + 1);
+    putBtData(maxMtuSize, reply.data() + 1);
     sendPacket(reply);
 
     // Apply requested MTU.
     const quint16 clientRxMtu = bt_get_le16(packet.constData() + 1);
-    mtuSize = std::clamp(clientRxMtu, ATT_DEFAULT_LE_MTU, ATT_MAX_LE_MTU);
+    mtuSize = std::clamp(clientRxMtu, ATT_DEFAULT_LE_MTU, maxMtuSize);
     qCDebug(QT_BT_BLUEZ) << "MTU request from client:" << clientRxMtu
                          << "effective client RX MTU:" << mtuSize;
-    qCDebug(QT_BT_BLUEZ) << "Sending server RX MTU" << ATT_MAX_LE_MTU;
+    qCDebug(QT_BT_BLUEZ) << "Sending server RX MTU" << maxMtuSize;
 }
 
 void QLowEnergyControllerPrivateBluez::handleFindInformationRequest(const QByteArray &packet)
@@ -3074,6 +3185,7 @@ void QLowEnergyControllerPrivateBluez::handleConnectionRequest()
     if (connectionHandle == 0)
         qCWarning(QT_BT_BLUEZ) << "Received client connection, but no connection complete event";
 
+    stopIoReader();
     if (l2cpSocket) {
         disconnect(l2cpSocket);
         if (l2cpSocket->isOpen())
@@ -3096,6 +3208,7 @@ void QLowEnergyControllerPrivateBluez::handleConnectionRequest()
             ? BDADDR_LE_PUBLIC : BDADDR_LE_RANDOM;
     l2cpSocket->setSocketDescriptor(clientSocket, QBluetoothServiceInfo::L2capProtocol,
             QBluetoothSocket::SocketState::ConnectedState, QIODevice::ReadWrite | QIODevice::Unbuffered);
+    startIoReader();
     restoreClientConfigurations();
     loadSigningDataIfNecessary(RemoteSigningKey);
 
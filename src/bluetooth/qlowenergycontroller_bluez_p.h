@@ -32,6 +32,7 @@ QT_BEGIN_NAMESPACE
 class QLowEnergyServiceData;
 class QTimer;
 
+class AttIoReader;
 class HciManager;
 class LeCmacCalculator;
 class QSocketNotifier;
@@ -41,7 +42,7 @@ extern void registerQLowEnergyControllerMetaType();
 
 class QLeAdvertiser;
 
-class QLowEnergyControllerPrivateBluez final: public QLowEnergyControllerPrivate
+class Q_AUTOTEST_EXPORT QLowEnergyControllerPrivateBluez final: public QLowEnergyControllerPrivate
 {
     Q_OBJECT
 public:
@@ -85,6 +86,12 @@ public:
 
     int mtu() const override;
 
+#ifdef QT_BUILD_INTERNAL
+    // Runs the ATT protocol over an already connected SOCK_SEQPACKET socket,
+    // bypassing HCI and L2CAP. Used by the loopback GATT benchmarks.
+    void connectToAttSocket(int socketDescriptor, quint16 maxMtu);
+#endif
+
     struct Attribute {
         Attribute() : handle(0) {}
 
@@ -103,6 +110,10 @@ public:
 private:
     quint16 connectionHandle = 0;
     QBluetoothSocket *l2cpSocket = nullptr;
+    // Reads the ATT socket on the shared I/O thread, see QT_BLUETOOTH_LE_IO_THREAD
+    AttIoReader *ioReader = nullptr;
+    quint32 ioReaderGeneration = 0;
+    bool useIoThread = false;
     struct Request {
         QBluezConst::AttCommand command;
         QByteArray payload;
@@ -162,6 +173,7 @@ private:
 
     bool requestPending;
     quint16 mtuSize;
+    quint16 maxMtuSize;
     int securityLevelValue;
     bool encryptionChangePending;
     bool receivedMtuExchangeRequest = false;
@@ -311,6 +323,10 @@ private:
     void restartRequestTimer();
     void establishL2cpClientSocket();
     void createServicesForCentralIfRequired();
+    void processIncomingPacket(const QByteArray &incomingPacket, bool indicationConfirmed);
+    void startIoReader();
+    void stopIoReader();
+    void ioReaderSocketClosed(int error);
 
 private slots:
     void l2cpConnected();
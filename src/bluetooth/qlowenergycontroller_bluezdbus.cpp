@@ -2,18 +2,22 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qlowenergycontroller_bluezdbus_p.h"
+#include "qbluetoothuuid_p.h"
 #include "bluez/adapter1_bluez5_p.h"
 #include "bluez/bluez5_helper_p.h"
+#include "bluez/bluezobjecttree_p.h"
 #include "bluez/device1_bluez5_p.h"
-#include "bluez/gattservice1_p.h"
 #include "bluez/gattchar1_p.h"
 #include "bluez/gattdesc1_p.h"
 #include "bluez/battery1_p.h"
-#include "bluez/objectmanager_p.h"
 #include "bluez/properties_p.h"
 #include "bluez/bluezperipheralapplication_p.h"
 #include "bluez/bluezperipheralconnectionmanager_p.h"
 
+#include <QtCore/QScopedValueRollback>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_BT_BLUEZ)
@@ -23,6 +27,14 @@ QLowEnergyControllerPrivateBluezDBus::QLowEnergyControllerPrivateBluezDBus(
     : QLowEnergyControllerPrivate(),
       adapterPathWithPeripheralSupport(adapterPathWithPeripheralSupport)
 {
+    // bluetoothd queues the ATT requests itself, the limit only bounds how many
+    // reads and writes wait for it at the same time
+    if (Q_UNLIKELY(!qEnvironmentVariableIsEmpty("QT_BLUETOOTH_GATT_CONCURRENCY"))) {
+        bool ok = false;
+        const int value = qEnvironmentVariableIntValue("QT_BLUETOOTH_GATT_CONCURRENCY", &ok);
+        if (ok && value > 0)
+            maxRunningJobs = value;
+    }
 }
 
 QLowEnergyControllerPrivateBluezDBus::~QLowEnergyControllerPrivateBluezDBus()
@@ -206,13 +218,7 @@ void QLowEnergyControllerPrivateBluezDBus::characteristicPropertiesChanged(
         return;
 
     const QByteArray newValue = changedProperties.value(QStringLiteral("Value")).toByteArray();
-    if (changedChar.properties() & QLowEnergyCharacteristic::Read)
-        updateValueOfCharacteristic(charHandle, newValue, false); //TODO upgrade to NEW_VALUE/APPEND_VALUE
-
-    auto service = serviceForHandle(charHandle);
-
-    if (!service.isNull())
-        emit service->characteristicChanged(changedChar, newValue);
+    remoteCharacteristicChanged(changedChar, newValue);
 }
 
 void QLowEnergyControllerPrivateBluezDBus::interfacesRemoved(const QDBusObjectPath &objectPath,
@@ -234,10 +240,7 @@ void QLowEnergyControllerPrivateBluezDBus::interfacesRemoved(const QDBusObjectPa
 
 void QLowEnergyControllerPrivateBluezDBus::resetController()
 {
-    if (managerBluez) {
-        delete managerBluez;
-        managerBluez = nullptr;
-    }
+    QObject::disconnect(objectTreeConnection);
 
     if (adapter) {
         delete adapter;
@@ -270,70 +273,40 @@ void QLowEnergyControllerPrivateBluezDBus::resetController()
 
     dbusServices.clear();
     jobs.clear();
+    // deleting the watchers drops the replies still to come
+    qDeleteAll(runningJobs.keyBegin(), runningJobs.keyEnd());
+    runningJobs.clear();
+    discoveryReadCharacteristics.clear();
+    exclusiveCharacteristics.clear();
+    jobStatistics = {};
     invalidateServices();
 
     pendingConnect = disconnectSignalRequired = false;
-    jobPending = false;
 }
 
-void QLowEnergyControllerPrivateBluezDBus::connectToDeviceHelper()
+QLowEnergyController::Error QLowEnergyControllerPrivateBluezDBus::connectToDeviceHelper()
 {
-    resetController();
-
     bool ok = false;
     const QString hostAdapterPath = findAdapterForAddress(localAdapter, &ok);
-    if (!ok || hostAdapterPath.isEmpty()) {
-        qCWarning(QT_BT_BLUEZ) << "Cannot find suitable bluetooth adapter";
-        setError(QLowEnergyController::InvalidBluetoothAdapterError);
-        return;
-    }
-
-    auto manager = std::make_unique<OrgFreedesktopDBusObjectManagerInterface>(
-            QStringLiteral("org.bluez"), QStringLiteral("/"), QDBusConnection::systemBus());
-
-    QDBusPendingReply<ManagedObjectList> reply = manager->GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError()) {
+    if (!ok) {
         qCWarning(QT_BT_BLUEZ) << "Cannot enumerate Bluetooth devices for GATT connect";
-        setError(QLowEnergyController::ConnectionError);
-        return;
+        return QLowEnergyController::ConnectionError;
     }
-
-    QString devicePath;
-    ManagedObjectList managedObjectList = reply.value();
-    for (ManagedObjectList::const_iterator it = managedObjectList.constBegin(); it != managedObjectList.constEnd(); ++it) {
-        const InterfaceList &ifaceList = it.value();
-
-        for (InterfaceList::const_iterator jt = ifaceList.constBegin(); jt != ifaceList.constEnd(); ++jt) {
-            const QString &iface = jt.key();
-            const QVariantMap &ifaceValues = jt.value();
-
-            if (iface == QStringLiteral("org.bluez.Device1")) {
-                if (remoteDevice.toString() == ifaceValues.value(QStringLiteral("Address")).toString())
-                {
-                    const QVariant adapterForCurrentDevice = ifaceValues.value(QStringLiteral("Adapter"));
-                    if (qvariant_cast<QDBusObjectPath>(adapterForCurrentDevice).path() == hostAdapterPath) {
-                        devicePath = it.key().path();
-                        break;
-                    }
-                }
-            }
-        }
-
-        if (!devicePath.isEmpty())
-            break;
+    if (hostAdapterPath.isEmpty()) {
+        qCWarning(QT_BT_BLUEZ) << "Cannot find suitable bluetooth adapter";
+        return QLowEnergyController::InvalidBluetoothAdapterError;
     }
 
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    const QString devicePath = objectTree->devicePath(hostAdapterPath, remoteDevice);
     if (devicePath.isEmpty()) {
         qCDebug(QT_BT_BLUEZ) << "Cannot find targeted remote device. "
                                 "Re-running device discovery might help";
-        setError(QLowEnergyController::UnknownRemoteDeviceError);
-        return;
+        return QLowEnergyController::UnknownRemoteDeviceError;
     }
 
-    managerBluez = manager.release();
-    connect(managerBluez, &OrgFreedesktopDBusObjectManagerInterface::InterfacesRemoved,
-            this, &QLowEnergyControllerPrivateBluezDBus::interfacesRemoved);
+    objectTreeConnection = connect(objectTree, &QtBluezObjectTree::interfacesRemoved,
+                                   this, &QLowEnergyControllerPrivateBluezDBus::interfacesRemoved);
     adapter = new OrgBluezAdapter1Interface(
                                 QStringLiteral("org.bluez"), hostAdapterPath,
                                 QDBusConnection::systemBus(), this);
@@ -345,28 +318,74 @@ void QLowEnergyControllerPrivateBluezDBus::connectToDeviceHelper()
                                 QDBusConnection::systemBus(), this);
     connect(deviceMonitor, &OrgFreedesktopDBusPropertiesInterfaceBluetooth::PropertiesChanged,
             this, &QLowEnergyControllerPrivateBluezDBus::devicePropertiesChanged);
+
+    const QVariantMap adapterProperties =
+            objectTree->properties(hostAdapterPath, QStringLiteral("org.bluez.Adapter1"));
+    if (!adapterProperties.value(QStringLiteral("Powered")).toBool()) {
+        qCWarning(QT_BT_BLUEZ) << "Error: Local adapter is powered off";
+        return QLowEnergyController::ConnectionError;
+    }
+
+    return QLowEnergyController::NoError;
 }
 
 void QLowEnergyControllerPrivateBluezDBus::connectToDevice()
 {
     qCDebug(QT_BT_BLUEZ) << "QLowEnergyControllerPrivateBluezDBus::connectToDevice()";
 
-    connectToDeviceHelper();
+    resetController();
 
-    if (!adapter || !device)
+    // Invalid input is reported right away, without entering ConnectingState
+    if (remoteDevice.isNull()) {
+        qCWarning(QT_BT_BLUEZ) << "Invalid/null remote device address";
+        setError(QLowEnergyController::UnknownRemoteDeviceError);
         return;
+    }
 
-    if (!adapter->powered()) {
-        qCWarning(QT_BT_BLUEZ) << "Error: Local adapter is powered off";
-        setError(QLowEnergyController::ConnectionError);
+    // Nothing below waits for bluetoothd, many controllers can connect at the same time
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    if (objectTree->isLoaded()) {
+        // The adapter and the device are looked up in the cached tree
+        const QLowEnergyController::Error error = connectToDeviceHelper();
+        if (error != QLowEnergyController::NoError) {
+            resetController();
+            setError(error);
+            return;
+        }
+        setState(QLowEnergyController::ConnectingState);
+        connectToLoadedDevice();
         return;
     }
 
     setState(QLowEnergyController::ConnectingState);
+    objectTreeConnection = connect(objectTree, &QtBluezObjectTree::loadFinished,
+                                   this, [this](bool loaded) {
+        // The tree may report more than one load
+        if (!QObject::disconnect(objectTreeConnection))
+            return;
+        if (!loaded) {
+            qCWarning(QT_BT_BLUEZ) << "Cannot enumerate Bluetooth devices for GATT connect";
+            executeClose(QLowEnergyController::ConnectionError);
+            return;
+        }
+        const QLowEnergyController::Error error = connectToDeviceHelper();
+        if (error != QLowEnergyController::NoError) {
+            executeClose(error);
+            return;
+        }
+        connectToLoadedDevice();
+    });
+    objectTree->load();
+}
 
+void QLowEnergyControllerPrivateBluezDBus::connectToLoadedDevice()
+{
     //Bluez interface is shared among all platform processes
     //and hence we might be connected already
-    if (device->connected() && device->servicesResolved()) {
+    const QVariantMap deviceProperties = QtBluezObjectTree::instance()->properties(
+            device->path(), QStringLiteral("org.bluez.Device1"));
+    if (deviceProperties.value(QStringLiteral("Connected")).toBool()
+            && deviceProperties.value(QStringLiteral("ServicesResolved")).toBool()) {
         //connectToDevice is noop
         disconnectSignalRequired = true;
 
@@ -396,8 +415,12 @@ void QLowEnergyControllerPrivateBluezDBus::connectToDevice()
 void QLowEnergyControllerPrivateBluezDBus::disconnectFromDevice()
 {
     if (role == QLowEnergyController::CentralRole) {
-        if (!device)
+        if (!device) {
+            // still waiting for the object tree
+            if (state == QLowEnergyController::ConnectingState)
+                executeClose(QLowEnergyController::NoError);
             return;
+        }
 
         setState(QLowEnergyController::ClosingState);
 
@@ -428,11 +451,52 @@ void QLowEnergyControllerPrivateBluezDBus::disconnectFromDevice()
     }
 }
 
+/*
+    Collects the characteristics and descriptors below \a servicePath from
+    the cached object tree. The characteristics are the children of the
+    service, the descriptors the children of the characteristics.
+*/
+QList<QLowEnergyControllerPrivateBluezDBus::GattCharacteristicInfo>
+QLowEnergyControllerPrivateBluezDBus::characteristicInfos(const QString &servicePath)
+{
+    const QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    const QString characteristicInterface = QStringLiteral("org.bluez.GattCharacteristic1");
+    const QString descriptorInterface = QStringLiteral("org.bluez.GattDescriptor1");
+    const QString uuidProperty = QStringLiteral("UUID");
+
+    QList<GattCharacteristicInfo> result;
+    const QStringList charPaths = objectTree->childPaths(servicePath);
+    for (const QString &charPath : charPaths) {
+        const InterfaceList charInterfaces = objectTree->interfaces(charPath);
+        const auto charIt = charInterfaces.constFind(characteristicInterface);
+        if (charIt == charInterfaces.cend())
+            continue;
+
+        GattCharacteristicInfo charInfo;
+        charInfo.path = charPath;
+        charInfo.uuid = QtBluetoothPrivate::uuidFromString(charIt->value(uuidProperty).toString());
+        charInfo.flags = charIt->value(QStringLiteral("Flags")).toStringList();
+
+        const QStringList descPaths = objectTree->childPaths(charPath);
+        for (const QString &descPath : descPaths) {
+            const InterfaceList descInterfaces = objectTree->interfaces(descPath);
+            const auto descIt = descInterfaces.constFind(descriptorInterface);
+            if (descIt == descInterfaces.cend())
+                continue;
+            charInfo.descriptors.append(
+                    { descPath,
+                      QtBluetoothPrivate::uuidFromString(descIt->value(uuidProperty).toString()) });
+        }
+
+        result.append(charInfo);
+    }
+    return result;
+}
+
 void QLowEnergyControllerPrivateBluezDBus::discoverServices()
 {
-    QDBusPendingReply<ManagedObjectList> reply = managerBluez->GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError()) {
+    QtBluezObjectTree *objectTree = QtBluezObjectTree::instance();
+    if (!objectTree->ensureLoaded()) {
         qCWarning(QT_BT_BLUEZ) << "Cannot discover services";
         setError(QLowEnergyController::UnknownError);
         setState(QLowEnergyController::DiscoveredState);
@@ -455,6 +519,8 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServices()
         if (battery1Interface) {
             qCDebug(QT_BT_BLUEZ) << "Using Battery1 interface to emulate generic interface";
             serviceContainer.hasBatteryService = true;
+        } else {
+            serviceContainer.characteristicInfos = characteristicInfos(path);
         }
 
         serviceList.insert(priv->uuid, priv);
@@ -463,7 +529,6 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServices()
         emit q->serviceDiscovered(priv->uuid);
     };
 
-    const ManagedObjectList managedObjectList = reply.value();
     const QString servicePathPrefix = device->path().append(QStringLiteral("/service"));
 
     // The Bluez battery service (0x180f) support has evolved over time and needs additional logic:
@@ -485,56 +550,46 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServices()
     bool gattBatteryService{false};
     QString batteryServicePath;
 
-    for (ManagedObjectList::const_iterator it = managedObjectList.constBegin(); it != managedObjectList.constEnd(); ++it) {
-        const InterfaceList &ifaceList = it.value();
-
-        if (!it.key().path().startsWith(device->path()))
-            continue;
-
-        if (it.key().path() == device->path())  {
-            // See if the battery service is available or is assumed to be available later
-            for (InterfaceList::const_iterator battIter = ifaceList.constBegin(); battIter != ifaceList.constEnd(); ++battIter) {
-                const QString &iface = battIter.key();
-                if (iface == QStringLiteral("org.bluez.Battery1")) {
-                    qCDebug(QT_BT_BLUEZ) << "Dedicated Battery1 service available";
-                    batteryServicePath = it.key().path();
+    // See if the battery service is available or is assumed to be available later
+    const InterfaceList deviceInterfaces = objectTree->interfaces(device->path());
+    for (InterfaceList::const_iterator battIter = deviceInterfaces.constBegin(); battIter != deviceInterfaces.constEnd(); ++battIter) {
+        const QString &iface = battIter.key();
+        if (iface == QStringLiteral("org.bluez.Battery1")) {
+            qCDebug(QT_BT_BLUEZ) << "Dedicated Battery1 service available";
+            batteryServicePath = device->path();
+            break;
+        } else if (iface == QStringLiteral("org.bluez.Device1")) {
+            for (auto const& uuid :
+                 battIter.value()[QStringLiteral("UUIDs")].toStringList()) {
+                if (QBluetoothUuid(uuid) ==
+                        QBluetoothUuid::ServiceClassUuid::BatteryService) {
+                    qCDebug(QT_BT_BLUEZ) << "Battery service listed as available service";
+                    batteryServicePath = device->path();
                     break;
-                } else if (iface == QStringLiteral("org.bluez.Device1")) {
-                    for (auto const& uuid :
-                         battIter.value()[QStringLiteral("UUIDs")].toStringList()) {
-                        if (QBluetoothUuid(uuid) ==
-                                QBluetoothUuid::ServiceClassUuid::BatteryService) {
-                            qCDebug(QT_BT_BLUEZ) << "Battery service listed as available service";
-                            batteryServicePath = it.key().path();
-                            break;
-                        }
-                    }
                 }
             }
-            continue;
         }
+    }
 
-        if (!it.key().path().startsWith(servicePathPrefix))
+    // The services are the children of the device
+    const QStringList childPaths = objectTree->childPaths(device->path());
+    for (const QString &path : childPaths) {
+        if (!path.startsWith(servicePathPrefix)
+            || !objectTree->hasInterface(path, QStringLiteral("org.bluez.GattService1"))) {
             continue;
+        }
 
-        for (InterfaceList::const_iterator jt = ifaceList.constBegin(); jt != ifaceList.constEnd(); ++jt) {
-            const QString &iface = jt.key();
-
-            if (iface == QStringLiteral("org.bluez.GattService1")) {
-                QScopedPointer<OrgBluezGattService1Interface> service(new OrgBluezGattService1Interface(
-                                    QStringLiteral("org.bluez"),it.key().path(),
-                                    QDBusConnection::systemBus(), this));
-                if (QBluetoothUuid(service->uUID()) ==
-                        QBluetoothUuid::ServiceClassUuid::BatteryService) {
-                    qCDebug(QT_BT_BLUEZ) << "Using battery service via GattService1 interface";
-                    gattBatteryService = true;
-                }
-                setupServicePrivate(service->primary()
-                                    ? QLowEnergyService::PrimaryService
-                                    : QLowEnergyService::IncludedService,
-                                    QBluetoothUuid(service->uUID()), it.key().path());
-            }
+        const QVariantMap service =
+                objectTree->properties(path, QStringLiteral("org.bluez.GattService1"));
+        const QBluetoothUuid uuid(service.value(QStringLiteral("UUID")).toString());
+        if (uuid == QBluetoothUuid::ServiceClassUuid::BatteryService) {
+            qCDebug(QT_BT_BLUEZ) << "Using battery service via GattService1 interface";
+            gattBatteryService = true;
         }
+        setupServicePrivate(service.value(QStringLiteral("Primary")).toBool()
+                            ? QLowEnergyService::PrimaryService
+                            : QLowEnergyService::IncludedService,
+                            uuid, path);
     }
 
     if (!gattBatteryService && !batteryServicePath.isEmpty()) {
@@ -635,63 +690,44 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServiceDetails(
         return;
     }
 
-    QDBusPendingReply<ManagedObjectList> reply = managerBluez->GetManagedObjects();
-    reply.waitForFinished();
-    if (reply.isError()) {
-        qCWarning(QT_BT_BLUEZ) << "Cannot discover services";
-        setError(QLowEnergyController::UnknownError);
-        setState(QLowEnergyController::DiscoveredState);
-        return;
-    }
-
-    const ManagedObjectList managedObjectList = reply.value();
-    for (ManagedObjectList::const_iterator it = managedObjectList.constBegin(); it != managedObjectList.constEnd(); ++it) {
-        const InterfaceList &ifaceList = it.value();
-        if (!it.key().path().startsWith(dbusData.servicePath))
-            continue;
-
-        for (InterfaceList::const_iterator jt = ifaceList.constBegin(); jt != ifaceList.constEnd(); ++jt) {
-            const QString &iface = jt.key();
-            if (iface == QStringLiteral("org.bluez.GattCharacteristic1")) {
-                auto charInterface = QSharedPointer<OrgBluezGattCharacteristic1Interface>::create(
-                                            QStringLiteral("org.bluez"), it.key().path(),
+    // The hierarchy was collected by discoverServices(), no need to ask bluetoothd again
+    dbusData.characteristics.reserve(dbusData.characteristicInfos.size());
+    for (const GattCharacteristicInfo &charInfo : std::as_const(dbusData.characteristicInfos)) {
+        GattCharacteristic dbusCharData;
+        dbusCharData.characteristic = QSharedPointer<OrgBluezGattCharacteristic1Interface>::create(
+                                            QStringLiteral("org.bluez"), charInfo.path,
                                             QDBusConnection::systemBus());
-                GattCharacteristic dbusCharData;
-                dbusCharData.characteristic = charInterface;
-                dbusData.characteristics.append(dbusCharData);
-            } else if (iface == QStringLiteral("org.bluez.GattDescriptor1")) {
-                auto descInterface = QSharedPointer<OrgBluezGattDescriptor1Interface>::create(
-                                            QStringLiteral("org.bluez"), it.key().path(),
+        for (const GattDescriptorInfo &descInfo : charInfo.descriptors) {
+            GattDescriptor dbusDescData;
+            dbusDescData.descriptor = QSharedPointer<OrgBluezGattDescriptor1Interface>::create(
+                                            QStringLiteral("org.bluez"), descInfo.path,
                                             QDBusConnection::systemBus());
-                bool found = false;
-                for (GattCharacteristic &dbusCharData : dbusData.characteristics) {
-                    if (!descInterface->path().startsWith(
-                                dbusCharData.characteristic->path()))
-                        continue;
-
-                    found = true;
-                    dbusCharData.descriptors.append(descInterface);
-                    break;
-                }
-
-                Q_ASSERT(found);
-                if (!found)
-                    qCWarning(QT_BT_BLUEZ) << "Descriptor discovery error";
-            }
+            dbusCharData.descriptors.append(dbusDescData);
         }
+        dbusData.characteristics.append(dbusCharData);
     }
 
+    // The reads of an earlier discovery of the service refer to the old
+    // handles. Drop the queued ones, the running ones are ignored once they
+    // finish.
+    jobs.removeIf([&serviceData](const GattJob &job) {
+        return job.flags.testFlag(GattJob::ServiceDiscovery) && job.service == serviceData;
+    });
+    dbusData.discoveryGeneration = ++lastDiscoveryGeneration;
+
     //populate servicePrivate based on dbus data
+    dbusData.pendingDiscoveryJobs = 0;
     serviceData->startHandle = runningHandle++;
-    for (GattCharacteristic &dbusChar : dbusData.characteristics) {
+    for (qsizetype i = 0; i < dbusData.characteristics.size(); ++i) {
+        GattCharacteristic &dbusChar = dbusData.characteristics[i];
+        const GattCharacteristicInfo &charInfo = dbusData.characteristicInfos.at(i);
         const QLowEnergyHandle indexHandle = runningHandle++;
+        dbusChar.handle = indexHandle;
         QLowEnergyServicePrivate::CharData charData;
 
         // characteristic data
         charData.valueHandle = runningHandle++;
-        const QStringList properties = dbusChar.characteristic->flags();
-
-        for (const auto &entry : properties) {
+        for (const auto &entry : charInfo.flags) {
             if (entry == QStringLiteral("broadcast"))
                 charData.properties.setFlag(QLowEnergyCharacteristic::Broadcasting, true);
             else if (entry == QStringLiteral("read"))
@@ -713,7 +749,7 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServiceDetails(
             //all others ignored - not relevant for this API
         }
 
-        charData.uuid = QBluetoothUuid(dbusChar.characteristic->uUID());
+        charData.uuid = charInfo.uuid;
 
         // schedule read for initial char value
         if (mode == QLowEnergyService::FullDiscovery
@@ -722,14 +758,19 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServiceDetails(
             job.flags = GattJob::JobFlags({GattJob::CharRead, GattJob::ServiceDiscovery});
             job.service = serviceData;
             job.handle = indexHandle;
+            job.charHandle = indexHandle;
+            job.discoveryGeneration = dbusData.discoveryGeneration;
             jobs.append(job);
+            ++dbusData.pendingDiscoveryJobs;
         }
 
         // descriptor data
-        for (const auto &descEntry : std::as_const(dbusChar.descriptors)) {
+        for (qsizetype j = 0; j < charInfo.descriptors.size(); ++j) {
+            const GattDescriptorInfo &descInfo = charInfo.descriptors.at(j);
             const QLowEnergyHandle descriptorHandle = runningHandle++;
+            dbusChar.descriptors[j].handle = descriptorHandle;
             QLowEnergyServicePrivate::DescData descData;
-            descData.uuid = QBluetoothUuid(descEntry->uUID());
+            descData.uuid = descInfo.uuid;
             charData.descriptorList.insert(descriptorHandle, descData);
 
 
@@ -755,7 +796,10 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServiceDetails(
                 job.flags = GattJob::JobFlags({ GattJob::DescRead, GattJob::ServiceDiscovery });
                 job.service = serviceData;
                 job.handle = descriptorHandle;
+                job.charHandle = indexHandle;
+                job.discoveryGeneration = dbusData.discoveryGeneration;
                 jobs.append(job);
+                ++dbusData.pendingDiscoveryJobs;
             }
         }
 
@@ -764,48 +808,67 @@ void QLowEnergyControllerPrivateBluezDBus::discoverServiceDetails(
 
     serviceData->endHandle = runningHandle++;
 
-    // last job is last step of service discovery
-    if (!jobs.isEmpty()) {
-        GattJob &lastJob = jobs.last();
-        lastJob.flags.setFlag(GattJob::LastServiceDiscovery, true);
-    } else {
+    // the service is discovered once all initial reads are done
+    if (dbusData.pendingDiscoveryJobs == 0)
         serviceData->setState(QLowEnergyService::RemoteServiceDiscovered);
-    }
 
     scheduleNextJob();
 }
 
-void QLowEnergyControllerPrivateBluezDBus::prepareNextJob()
+/*
+    Takes the job of a finished D-Bus call. Returns \c false if the job is
+    gone because the controller was reset while the call was running.
+*/
+bool QLowEnergyControllerPrivateBluezDBus::takeRunningJob(QDBusPendingCallWatcher *call,
+                                                          GattJob *job)
+{
+    call->deleteLater();
+
+    const auto it = runningJobs.constFind(call);
+    if (it == runningJobs.cend())
+        return false;
+
+    *job = it.value();
+    runningJobs.erase(it);
+    unmarkJobRunning(*job);
+    return true;
+}
+
+void QLowEnergyControllerPrivateBluezDBus::finishJob(const GattJob &job)
 {
-    jobs.takeFirst(); // finish last job
-    jobPending = false;
+    ++jobStatistics.finishedJobs;
+
+    if (job.flags.testFlag(GattJob::ServiceDiscovery) && job.service) {
+        const auto it = dbusServices.find(job.service->uuid);
+        if (it != dbusServices.end() && it->discoveryGeneration == job.discoveryGeneration
+            && it->pendingDiscoveryJobs > 0 && --it->pendingDiscoveryJobs == 0) {
+            job.service->setState(QLowEnergyService::RemoteServiceDiscovered);
+        }
+    }
 
     scheduleNextJob(); // continue with next job - if available
 }
 
 void QLowEnergyControllerPrivateBluezDBus::onCharReadFinished(QDBusPendingCallWatcher *call)
 {
-    if (!jobPending || jobs.isEmpty()) {
+    GattJob job;
+    if (!takeRunningJob(call, &job)) {
         // this may happen when service disconnects before dbus watcher returns later on
         qCWarning(QT_BT_BLUEZ) << "Aborting onCharReadFinished due to disconnect";
-        Q_ASSERT(state == QLowEnergyController::UnconnectedState);
         return;
     }
+    Q_ASSERT(job.flags.testFlag(GattJob::CharRead));
 
-    const GattJob nextJob = jobs.constFirst();
-    Q_ASSERT(nextJob.flags.testFlag(GattJob::CharRead));
-
-    QSharedPointer<QLowEnergyServicePrivate> service = serviceForHandle(nextJob.handle);
+    QSharedPointer<QLowEnergyServicePrivate> service = serviceForHandle(job.handle);
     if (service.isNull() || !dbusServices.contains(service->uuid)) {
         qCWarning(QT_BT_BLUEZ) << "onCharReadFinished: Invalid GATT job. Skipping.";
-        call->deleteLater();
-        prepareNextJob();
+        finishJob(job);
         return;
     }
     const QLowEnergyServicePrivate::CharData &charData =
-                        service->characteristicList.value(nextJob.handle);
+                        service->characteristicList.value(job.handle);
 
-    bool isServiceDiscovery = nextJob.flags.testFlag(GattJob::ServiceDiscovery);
+    bool isServiceDiscovery = job.flags.testFlag(GattJob::ServiceDiscovery);
     QDBusPendingReply<QByteArray> reply = *call;
     if (reply.isError()) {
         qCWarning(QT_BT_BLUEZ) << "Cannot initiate reading of" << charData.uuid
@@ -816,108 +879,92 @@ void QLowEnergyControllerPrivateBluezDBus::onCharReadFinished(QDBusPendingCallWa
     } else {
         qCDebug(QT_BT_BLUEZ) << "Read Char:" << charData.uuid << reply.value().toHex();
         if (charData.properties.testFlag(QLowEnergyCharacteristic::Read))
-            updateValueOfCharacteristic(nextJob.handle, reply.value(), false);
+            updateValueOfCharacteristic(job.handle, reply.value(), false);
 
-        if (isServiceDiscovery) {
-            if (nextJob.flags.testFlag(GattJob::LastServiceDiscovery))
-                service->setState(QLowEnergyService::RemoteServiceDiscovered);
-        } else {
-            QLowEnergyCharacteristic ch(service, nextJob.handle);
+        if (!isServiceDiscovery) {
+            QLowEnergyCharacteristic ch(service, job.handle);
             emit service->characteristicRead(ch, reply.value());
         }
     }
 
-    call->deleteLater();
-    prepareNextJob();
+    finishJob(job);
 }
 
 void QLowEnergyControllerPrivateBluezDBus::onDescReadFinished(QDBusPendingCallWatcher *call)
 {
-    if (!jobPending || jobs.isEmpty()) {
+    GattJob job;
+    if (!takeRunningJob(call, &job)) {
         // this may happen when service disconnects before dbus watcher returns later on
         qCWarning(QT_BT_BLUEZ) << "Aborting onDescReadFinished due to disconnect";
-        Q_ASSERT(state == QLowEnergyController::UnconnectedState);
         return;
     }
+    Q_ASSERT(job.flags.testFlag(GattJob::DescRead));
 
-    const GattJob nextJob = jobs.constFirst();
-    Q_ASSERT(nextJob.flags.testFlag(GattJob::DescRead));
-
-    QSharedPointer<QLowEnergyServicePrivate> service = serviceForHandle(nextJob.handle);
+    QSharedPointer<QLowEnergyServicePrivate> service = serviceForHandle(job.handle);
     if (service.isNull() || !dbusServices.contains(service->uuid)) {
         qCWarning(QT_BT_BLUEZ) << "onDescReadFinished: Invalid GATT job. Skipping.";
-        call->deleteLater();
-        prepareNextJob();
+        finishJob(job);
         return;
     }
 
-    QLowEnergyCharacteristic ch = characteristicForHandle(nextJob.handle);
+    QLowEnergyCharacteristic ch = characteristicForHandle(job.handle);
     if (!ch.isValid()) {
         qCWarning(QT_BT_BLUEZ) << "Cannot find char for desc read (onDescReadFinished 1).";
-        call->deleteLater();
-        prepareNextJob();
+        finishJob(job);
         return;
     }
 
     const QLowEnergyServicePrivate::CharData &charData =
                         service->characteristicList.value(ch.attributeHandle());
 
-    if (!charData.descriptorList.contains(nextJob.handle)) {
+    if (!charData.descriptorList.contains(job.handle)) {
         qCWarning(QT_BT_BLUEZ) << "Cannot find descriptor (onDescReadFinished 2).";
-        call->deleteLater();
-        prepareNextJob();
+        finishJob(job);
         return;
     }
 
-    bool isServiceDiscovery = nextJob.flags.testFlag(GattJob::ServiceDiscovery);
+    bool isServiceDiscovery = job.flags.testFlag(GattJob::ServiceDiscovery);
 
     QDBusPendingReply<QByteArray> reply = *call;
     if (reply.isError()) {
         qCWarning(QT_BT_BLUEZ) << "Cannot read descriptor (onDescReadFinished 3): "
-                             << charData.descriptorList[nextJob.handle].uuid
+                             << charData.descriptorList[job.handle].uuid
                              << charData.uuid
                              << reply.error().name() << reply.error().message();
         if (!isServiceDiscovery)
             service->setError(QLowEnergyService::DescriptorReadError);
     } else {
         qCDebug(QT_BT_BLUEZ) << "Read Desc:" << reply.value();
-        updateValueOfDescriptor(ch.attributeHandle(), nextJob.handle, reply.value(), false);
+        updateValueOfDescriptor(ch.attributeHandle(), job.handle, reply.value(), false);
 
-        if (isServiceDiscovery) {
-            if (nextJob.flags.testFlag(GattJob::LastServiceDiscovery))
-                service->setState(QLowEnergyService::RemoteServiceDiscovered);
-        } else {
-            QLowEnergyDescriptor desc(service, ch.attributeHandle(), nextJob.handle);
+        if (!isServiceDiscovery) {
+            QLowEnergyDescriptor desc(service, ch.attributeHandle(), job.handle);
             emit service->descriptorRead(desc, reply.value());
         }
     }
 
-    call->deleteLater();
-    prepareNextJob();
+    finishJob(job);
 }
 
 void QLowEnergyControllerPrivateBluezDBus::onCharWriteFinished(QDBusPendingCallWatcher *call)
 {
-    if (!jobPending || jobs.isEmpty()) {
+    GattJob job;
+    if (!takeRunningJob(call, &job)) {
         // this may happen when service disconnects before dbus watcher returns later on
         qCWarning(QT_BT_BLUEZ) << "Aborting onCharWriteFinished due to disconnect";
-        Q_ASSERT(state == QLowEnergyController::UnconnectedState);
         return;
     }
+    Q_ASSERT(job.flags.testFlag(GattJob::CharWrite));
 
-    const GattJob nextJob = jobs.constFirst();
-    Q_ASSERT(nextJob.flags.testFlag(GattJob::CharWrite));
-
-    QSharedPointer<QLowEnergyServicePrivate> service = nextJob.service;
+    QSharedPointer<QLowEnergyServicePrivate> service = job.service;
     if (!dbusServices.contains(service->uuid)) {
         qCWarning(QT_BT_BLUEZ) << "onCharWriteFinished: Invalid GATT job. Skipping.";
-        call->deleteLater();
-        prepareNextJob();
+        finishJob(job);
         return;
     }
 
     const QLowEnergyServicePrivate::CharData &charData =
-                        service->characteristicList.value(nextJob.handle);
+                        service->characteristicList.value(job.handle);
 
     QDBusPendingReply<> reply = *call;
     if (reply.isError()) {
@@ -927,47 +974,42 @@ void QLowEnergyControllerPrivateBluezDBus::onCharWriteFinished(QDBusPendingCallW
         service->setError(QLowEnergyService::CharacteristicWriteError);
     } else {
         if (charData.properties.testFlag(QLowEnergyCharacteristic::Read))
-            updateValueOfCharacteristic(nextJob.handle, nextJob.value, false);
+            updateValueOfCharacteristic(job.handle, job.value, false);
 
-        QLowEnergyCharacteristic ch(service, nextJob.handle);
+        QLowEnergyCharacteristic ch(service, job.handle);
         // write without response implies zero feedback
-        if (nextJob.writeMode == QLowEnergyService::WriteWithResponse) {
-            qCDebug(QT_BT_BLUEZ) << "Written Char:" << charData.uuid << nextJob.value.toHex();
-            emit service->characteristicWritten(ch, nextJob.value);
+        if (job.writeMode == QLowEnergyService::WriteWithResponse) {
+            qCDebug(QT_BT_BLUEZ) << "Written Char:" << charData.uuid << job.value.toHex();
+            emit service->characteristicWritten(ch, job.value);
         }
     }
 
-    call->deleteLater();
-    prepareNextJob();
+    finishJob(job);
 }
 
 void QLowEnergyControllerPrivateBluezDBus::onDescWriteFinished(QDBusPendingCallWatcher *call)
 {
-    if (!jobPending || jobs.isEmpty()) {
+    GattJob job;
+    if (!takeRunningJob(call, &job)) {
         // this may happen when service disconnects before dbus watcher returns later on
         qCWarning(QT_BT_BLUEZ) << "Aborting onDescWriteFinished due to disconnect";
-        Q_ASSERT(state == QLowEnergyController::UnconnectedState);
         return;
     }
+    Q_ASSERT(job.flags.testFlag(GattJob::DescWrite));
 
-    const GattJob nextJob = jobs.constFirst();
-    Q_ASSERT(nextJob.flags.testFlag(GattJob::DescWrite));
-
-    QSharedPointer<QLowEnergyServicePrivate> service = nextJob.service;
+    QSharedPointer<QLowEnergyServicePrivate> service = job.service;
     if (!dbusServices.contains(service->uuid)) {
         qCWarning(QT_BT_BLUEZ) << "onDescWriteFinished: Invalid GATT job. Skipping.";
-        call->deleteLater();
-        prepareNextJob();
+        finishJob(job);
         return;
     }
 
-    const QLowEnergyCharacteristic associatedChar = characteristicForHandle(nextJob.handle);
-    const QLowEnergyDescriptor descriptor = descriptorForHandle(nextJob.handle);
+    const QLowEnergyCharacteristic associatedChar = characteristicForHandle(job.handle);
+    const QLowEnergyDescriptor descriptor = descriptorForHandle(job.handle);
     if (!associatedChar.isValid() || !descriptor.isValid()) {
         qCWarning(QT_BT_BLUEZ) << "onDescWriteFinished: Cannot find associated char/desc: "
                                << associatedChar.isValid();
-        call->deleteLater();
-        prepareNextJob();
+        finishJob(job);
         return;
     }
 
@@ -979,207 +1021,178 @@ void QLowEnergyControllerPrivateBluezDBus::onDescWriteFinished(QDBusPendingCallW
                                << reply.error().name() << reply.error().message();
         service->setError(QLowEnergyService::DescriptorWriteError);
     } else {
-        qCDebug(QT_BT_BLUEZ) << "Write Desc:" << descriptor.uuid() << nextJob.value.toHex();
-        updateValueOfDescriptor(associatedChar.attributeHandle(), nextJob.handle,
-                                nextJob.value, false);
-        emit service->descriptorWritten(descriptor, nextJob.value);
+        qCDebug(QT_BT_BLUEZ) << "Write Desc:" << descriptor.uuid() << job.value.toHex();
+        updateValueOfDescriptor(associatedChar.attributeHandle(), job.handle,
+                                job.value, false);
+        emit service->descriptorWritten(descriptor, job.value);
     }
 
-    call->deleteLater();
-    prepareNextJob();
+    finishJob(job);
 }
 
-void QLowEnergyControllerPrivateBluezDBus::scheduleNextJob()
+void QLowEnergyControllerPrivateBluezDBus::markJobRunning(const GattJob &job)
 {
-    if (jobPending || jobs.isEmpty())
-        return;
-
-    jobPending = true;
+    if (job.flags.testFlag(GattJob::ServiceDiscovery))
+        ++discoveryReadCharacteristics[job.charHandle];
+    else
+        exclusiveCharacteristics.insert(job.charHandle);
+}
 
-    const GattJob nextJob = jobs.constFirst();
-    QSharedPointer<QLowEnergyServicePrivate> service = serviceForHandle(nextJob.handle);
-    if (service.isNull() || !dbusServices.contains(service->uuid)) {
-        qCWarning(QT_BT_BLUEZ) << "Invalid GATT job (scheduleNextJob). Skipping.";
-        prepareNextJob();
+void QLowEnergyControllerPrivateBluezDBus::unmarkJobRunning(const GattJob &job)
+{
+    if (!job.flags.testFlag(GattJob::ServiceDiscovery)) {
+        exclusiveCharacteristics.remove(job.charHandle);
         return;
     }
 
-    const GattService &dbusServiceData = dbusServices[service->uuid];
-
-    if (nextJob.flags.testFlag(GattJob::CharRead)) {
-        // characteristic reading ***************************************
-        if (!service->characteristicList.contains(nextJob.handle)) {
-            qCWarning(QT_BT_BLUEZ) << "Invalid Char handle when reading. Skipping.";
-            prepareNextJob();
-            return;
-        }
-
-        const QLowEnergyServicePrivate::CharData &charData =
-                            service->characteristicList.value(nextJob.handle);
-        bool foundChar = false;
-        for (const auto &gattChar : std::as_const(dbusServiceData.characteristics)) {
-            if (charData.uuid != QBluetoothUuid(gattChar.characteristic->uUID()))
-                continue;
-
-            QDBusPendingReply<QByteArray> reply = gattChar.characteristic->ReadValue(QVariantMap());
-            QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(reply, this);
-            connect(watcher, &QDBusPendingCallWatcher::finished,
-                    this, &QLowEnergyControllerPrivateBluezDBus::onCharReadFinished);
-
-            foundChar = true;
-            break;
-        }
-
-        if (!foundChar) {
-            qCWarning(QT_BT_BLUEZ) << "Cannot find char for reading. Skipping.";
-            prepareNextJob();
-            return;
-        }
-    } else if (nextJob.flags.testFlag(GattJob::CharWrite)) {
-        // characteristic writing ***************************************
-        if (!service->characteristicList.contains(nextJob.handle)) {
-            qCWarning(QT_BT_BLUEZ) << "Invalid Char handle when writing. Skipping.";
-            prepareNextJob();
-            return;
-        }
-
-        const QLowEnergyServicePrivate::CharData &charData =
-                            service->characteristicList.value(nextJob.handle);
-        bool foundChar = false;
-        for (const auto &gattChar : std::as_const(dbusServiceData.characteristics)) {
-            if (charData.uuid != QBluetoothUuid(gattChar.characteristic->uUID()))
-                continue;
-
-            QVariantMap options;
-            // The "type" option only works with BlueZ >= 5.50, older versions always write with response
-            options[QStringLiteral("type")] = nextJob.writeMode == QLowEnergyService::WriteWithoutResponse ?
-                QStringLiteral("command") : QStringLiteral("request");
-            QDBusPendingReply<> reply = gattChar.characteristic->WriteValue(nextJob.value, options);
-
-            QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(reply, this);
-            connect(watcher, &QDBusPendingCallWatcher::finished,
-                    this, &QLowEnergyControllerPrivateBluezDBus::onCharWriteFinished);
-
-            foundChar = true;
-            break;
-        }
-
-        if (!foundChar) {
-            qCWarning(QT_BT_BLUEZ) << "Cannot find char for writing. Skipping.";
-            prepareNextJob();
-            return;
-        }
-    } else if (nextJob.flags.testFlag(GattJob::DescRead)) {
-        // descriptor reading ***************************************
-        QLowEnergyCharacteristic ch = characteristicForHandle(nextJob.handle);
-        if (!ch.isValid()) {
-            qCWarning(QT_BT_BLUEZ) << "Invalid GATT job (scheduleReadDesc 1). Skipping.";
-            prepareNextJob();
-            return;
-        }
-
-        const QLowEnergyServicePrivate::CharData &charData =
-                                service->characteristicList.value(ch.attributeHandle());
-        if (!charData.descriptorList.contains(nextJob.handle)) {
-            qCWarning(QT_BT_BLUEZ) << "Invalid GATT job (scheduleReadDesc 2). Skipping.";
-            prepareNextJob();
-            return;
-        }
-
-        const QBluetoothUuid descUuid = charData.descriptorList[nextJob.handle].uuid;
-        bool foundDesc = false;
-        for (const auto &gattChar : std::as_const(dbusServiceData.characteristics)) {
-            if (charData.uuid != QBluetoothUuid(gattChar.characteristic->uUID()))
-                continue;
-
-            for (const auto &gattDesc : std::as_const(gattChar.descriptors)) {
-                if (descUuid != QBluetoothUuid(gattDesc->uUID()))
-                    continue;
-
-                QDBusPendingReply<QByteArray> reply = gattDesc->ReadValue(QVariantMap());
-                QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(reply, this);
-                connect(watcher, &QDBusPendingCallWatcher::finished,
-                        this, &QLowEnergyControllerPrivateBluezDBus::onDescReadFinished);
-                foundDesc = true;
-                break;
-            }
+    const auto it = discoveryReadCharacteristics.find(job.charHandle);
+    if (it != discoveryReadCharacteristics.end() && --it.value() == 0)
+        discoveryReadCharacteristics.erase(it);
+}
 
-            if (foundDesc)
-                break;
+/*
+    Jobs on the same characteristic, including its descriptors, run in the
+    order they were queued. Only the initial reads of a service discovery
+    may overlap, they read different attributes.
+*/
+void QLowEnergyControllerPrivateBluezDBus::scheduleNextJob()
+{
+    // finishing a skipped job emits signals which may queue new jobs
+    if (schedulingJobs)
+        return;
+    const QScopedValueRollback<bool> guard(schedulingJobs, true);
+
+    // The characteristics of the jobs left in the queue by this pass, the
+    // jobs queued after them on the same characteristic have to wait
+    QSet<QLowEnergyHandle> waitingDiscoveryReads;
+    QSet<QLowEnergyHandle> waitingExclusive;
+
+    qsizetype index = 0;
+    while (index < jobs.size()) {
+        const GattJob &candidate = jobs.at(index);
+        const QLowEnergyHandle charHandle = candidate.charHandle;
+        bool blocked;
+        if (candidate.flags.testFlag(GattJob::ServiceDiscovery)) {
+            // the initial reads of a service discovery are started all at once
+            blocked = exclusiveCharacteristics.contains(charHandle)
+                    || waitingExclusive.contains(charHandle);
+        } else {
+            blocked = runningJobs.size() >= maxRunningJobs
+                    || exclusiveCharacteristics.contains(charHandle)
+                    || discoveryReadCharacteristics.contains(charHandle)
+                    || waitingExclusive.contains(charHandle)
+                    || waitingDiscoveryReads.contains(charHandle);
         }
 
-        if (!foundDesc) {
-            qCWarning(QT_BT_BLUEZ) << "Cannot find descriptor for reading. Skipping.";
-            prepareNextJob();
-            return;
-        }
-    } else if (nextJob.flags.testFlag(GattJob::DescWrite)) {
-        // descriptor writing ***************************************
-        const QLowEnergyCharacteristic ch = characteristicForHandle(nextJob.handle);
-        if (!ch.isValid()) {
-            qCWarning(QT_BT_BLUEZ) << "Invalid GATT job (scheduleWriteDesc 1). Skipping.";
-            prepareNextJob();
-            return;
+        if (blocked) {
+            if (candidate.flags.testFlag(GattJob::ServiceDiscovery))
+                waitingDiscoveryReads.insert(charHandle);
+            else
+                waitingExclusive.insert(charHandle);
+            ++index;
+            continue;
         }
 
-        const QLowEnergyServicePrivate::CharData &charData =
-                                service->characteristicList.value(ch.attributeHandle());
-        if (!charData.descriptorList.contains(nextJob.handle)) {
-            qCWarning(QT_BT_BLUEZ) << "Invalid GATT job (scheduleWriteDesc 2). Skipping.";
-            prepareNextJob();
-            return;
+        const GattJob nextJob = jobs.takeAt(index);
+        QDBusPendingCallWatcher *watcher = startJob(nextJob);
+        if (!watcher) {
+            finishJob(nextJob);
+            continue;
         }
 
-        const QBluetoothUuid descUuid = charData.descriptorList[nextJob.handle].uuid;
-        bool foundDesc = false;
-        for (const auto &gattChar : std::as_const(dbusServiceData.characteristics)) {
-            if (charData.uuid != QBluetoothUuid(gattChar.characteristic->uUID()))
-                continue;
+        runningJobs.insert(watcher, nextJob);
+        markJobRunning(nextJob);
+        ++jobStatistics.startedJobs;
+        jobStatistics.peakRunningJobs = qMax(jobStatistics.peakRunningJobs,
+                                             int(runningJobs.size()));
+    }
 
-            for (const auto &gattDesc : std::as_const(gattChar.descriptors)) {
-                if (descUuid != QBluetoothUuid(gattDesc->uUID()))
-                    continue;
+    if (jobs.isEmpty() && runningJobs.isEmpty() && jobStatistics.finishedJobs > 0) {
+        qCDebug(QT_BT_BLUEZ) << "GATT jobs done:" << jobStatistics.finishedJobs
+                             << "finished, up to" << jobStatistics.peakRunningJobs
+                             << "running at the same time, limit" << maxRunningJobs;
+        jobStatistics = {};
+    }
+}
 
-                //notifications enabled via characteristics Start/StopNotify() functions
-                //otherwise regular WriteValue() calls on descriptor interface
-                if (descUuid == QBluetoothUuid(QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration)) {
-                    const QByteArray value = nextJob.value;
+QDBusPendingCallWatcher *QLowEnergyControllerPrivateBluezDBus::startJob(const GattJob &job)
+{
+    QSharedPointer<QLowEnergyServicePrivate> service = serviceForHandle(job.handle);
+    if (service.isNull() || !dbusServices.contains(service->uuid)) {
+        qCWarning(QT_BT_BLUEZ) << "Invalid GATT job (startJob). Skipping.";
+        return nullptr;
+    }
 
-                    QDBusPendingReply<> reply;
-                    qCDebug(QT_BT_BLUEZ) << "Init CCC change to" << value.toHex()
-                                         << charData.uuid << service->uuid;
-                    if (value == QByteArray::fromHex("0100") || value == QByteArray::fromHex("0200"))
-                        reply = gattChar.characteristic->StartNotify();
-                    else
-                        reply = gattChar.characteristic->StopNotify();
-                    QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(reply, this);
-                    connect(watcher, &QDBusPendingCallWatcher::finished,
-                            this, &QLowEnergyControllerPrivateBluezDBus::onDescWriteFinished);
-                } else {
-                    QDBusPendingReply<> reply = gattDesc->WriteValue(nextJob.value, QVariantMap());
-                    QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(reply, this);
-                    connect(watcher, &QDBusPendingCallWatcher::finished,
-                            this, &QLowEnergyControllerPrivateBluezDBus::onDescWriteFinished);
+    const GattService &dbusServiceData = dbusServices[service->uuid];
+    const auto gattChar = std::find_if(dbusServiceData.characteristics.cbegin(),
+                                       dbusServiceData.characteristics.cend(),
+                                       [&job](const GattCharacteristic &characteristic) {
+        return characteristic.handle == job.charHandle;
+    });
+    if (gattChar == dbusServiceData.characteristics.cend()
+        || !service->characteristicList.contains(job.charHandle)) {
+        qCWarning(QT_BT_BLUEZ) << "Cannot find char for GATT job. Skipping.";
+        return nullptr;
+    }
 
-                }
+    const QLowEnergyServicePrivate::CharData &charData =
+                        service->characteristicList.value(job.charHandle);
 
-                foundDesc = true;
-                break;
-            }
+    QDBusPendingCall call = QDBusPendingCall::fromError(QDBusError());
+    void (QLowEnergyControllerPrivateBluezDBus::*onFinished)(QDBusPendingCallWatcher *) = nullptr;
 
-            if (foundDesc)
-                break;
+    if (job.flags.testFlag(GattJob::CharRead)) {
+        // characteristic reading ***************************************
+        call = gattChar->characteristic->ReadValue(QVariantMap());
+        onFinished = &QLowEnergyControllerPrivateBluezDBus::onCharReadFinished;
+    } else if (job.flags.testFlag(GattJob::CharWrite)) {
+        // characteristic writing ***************************************
+        QVariantMap options;
+        // The "type" option only works with BlueZ >= 5.50, older versions always write with response
+        options[QStringLiteral("type")] = job.writeMode == QLowEnergyService::WriteWithoutResponse ?
+            QStringLiteral("command") : QStringLiteral("request");
+        call = gattChar->characteristic->WriteValue(job.value, options);
+        onFinished = &QLowEnergyControllerPrivateBluezDBus::onCharWriteFinished;
+    } else if (job.flags.testFlag(GattJob::DescRead) || job.flags.testFlag(GattJob::DescWrite)) {
+        const auto gattDesc = std::find_if(gattChar->descriptors.cbegin(),
+                                           gattChar->descriptors.cend(),
+                                           [&job](const GattDescriptor &descriptor) {
+            return descriptor.handle == job.handle;
+        });
+        if (gattDesc == gattChar->descriptors.cend()
+            || !charData.descriptorList.contains(job.handle)) {
+            qCWarning(QT_BT_BLUEZ) << "Cannot find descriptor for GATT job. Skipping.";
+            return nullptr;
         }
 
-        if (!foundDesc) {
-            qCWarning(QT_BT_BLUEZ) << "Cannot find descriptor for writing. Skipping.";
-            prepareNextJob();
-            return;
+        const QBluetoothUuid descUuid = charData.descriptorList[job.handle].uuid;
+        if (job.flags.testFlag(GattJob::DescRead)) {
+            // descriptor reading ***************************************
+            call = gattDesc->descriptor->ReadValue(QVariantMap());
+            onFinished = &QLowEnergyControllerPrivateBluezDBus::onDescReadFinished;
+        } else if (descUuid == QBluetoothUuid(QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration)) {
+            // descriptor writing ***************************************
+            //notifications enabled via characteristics Start/StopNotify() functions
+            //otherwise regular WriteValue() calls on descriptor interface
+            qCDebug(QT_BT_BLUEZ) << "Init CCC change to" << job.value.toHex()
+                                 << charData.uuid << service->uuid;
+            if (job.value == QByteArray::fromHex("0100") || job.value == QByteArray::fromHex("0200"))
+                call = gattChar->characteristic->StartNotify();
+            else
+                call = gattChar->characteristic->StopNotify();
+            onFinished = &QLowEnergyControllerPrivateBluezDBus::onDescWriteFinished;
+        } else {
+            call = gattDesc->descriptor->WriteValue(job.value, QVariantMap());
+            onFinished = &QLowEnergyControllerPrivateBluezDBus::onDescWriteFinished;
         }
     } else {
         qCWarning(QT_BT_BLUEZ) << "Unknown gatt job type. Skipping.";
-        prepareNextJob();
+        return nullptr;
     }
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, onFinished);
+    return watcher;
 }
 
 void QLowEnergyControllerPrivateBluezDBus::readCharacteristic(
@@ -1220,6 +1233,7 @@ void QLowEnergyControllerPrivateBluezDBus::readCharacteristic(
     job.flags = GattJob::JobFlags({GattJob::CharRead});
     job.service = service;
     job.handle = charHandle;
+    job.charHandle = charHandle;
     jobs.append(job);
 
     scheduleNextJob();
@@ -1254,6 +1268,7 @@ void QLowEnergyControllerPrivateBluezDBus::readDescriptor(
     job.flags = GattJob::JobFlags({GattJob::DescRead});
     job.service = service;
     job.handle = descriptorHandle;
+    job.charHandle = charHandle;
     jobs.append(job);
 
     scheduleNextJob();
@@ -1285,6 +1300,7 @@ void QLowEnergyControllerPrivateBluezDBus::writeCharacteristic(
         job.flags = GattJob::JobFlags({GattJob::CharWrite});
         job.service = service;
         job.handle = charHandle;
+        job.charHandle = charHandle;
         job.value = newValue;
         job.writeMode = writeMode;
         jobs.append(job);
@@ -1343,6 +1359,7 @@ void QLowEnergyControllerPrivateBluezDBus::writeDescriptor(
         job.flags = GattJob::JobFlags({GattJob::DescWrite});
         job.service = service;
         job.handle = descriptorHandle;
+        job.charHandle = charHandle;
         job.value = newValue;
         jobs.append(job);
 
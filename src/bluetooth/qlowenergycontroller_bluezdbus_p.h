@@ -20,6 +20,8 @@
 #include "qlowenergycontrollerbase_p.h"
 #include "qleadvertiser_bluezdbus_p.h"
 
+#include <QtCore/QSet>
+
 #include <QtDBus/QDBusObjectPath>
 
 class OrgBluezAdapter1Interface;
@@ -27,8 +29,6 @@ class OrgBluezBattery1Interface;
 class OrgBluezDevice1Interface;
 class OrgBluezGattCharacteristic1Interface;
 class OrgBluezGattDescriptor1Interface;
-class OrgBluezGattService1Interface;
-class OrgFreedesktopDBusObjectManagerInterface;
 class OrgFreedesktopDBusPropertiesInterfaceBluetooth;
 
 QT_BEGIN_NAMESPACE
@@ -86,7 +86,8 @@ public:
     int mtu() const override;
 
 private:
-    void connectToDeviceHelper();
+    QLowEnergyController::Error connectToDeviceHelper();
+    void connectToLoadedDevice();
     void resetController();
 
     void scheduleNextJob();
@@ -107,7 +108,7 @@ private:
 
     OrgBluezAdapter1Interface* adapter{};
     OrgBluezDevice1Interface* device{};
-    OrgFreedesktopDBusObjectManagerInterface* managerBluez{};
+    QMetaObject::Connection objectTreeConnection;
     OrgFreedesktopDBusPropertiesInterfaceBluetooth* deviceMonitor{};
     QString adapterPathWithPeripheralSupport;
 
@@ -130,24 +131,55 @@ private:
     bool pendingConnect = false;
     bool disconnectSignalRequired = false;
 
+    struct GattDescriptor
+    {
+        QLowEnergyHandle handle = 0;
+        QSharedPointer<OrgBluezGattDescriptor1Interface> descriptor;
+    };
+
     struct GattCharacteristic
     {
+        QLowEnergyHandle handle = 0;
         QSharedPointer<OrgBluezGattCharacteristic1Interface> characteristic;
         QSharedPointer<OrgFreedesktopDBusPropertiesInterfaceBluetooth> charMonitor;
-        QList<QSharedPointer<OrgBluezGattDescriptor1Interface>> descriptors;
+        QList<GattDescriptor> descriptors;
+    };
+
+    // The GATT hierarchy below a service as found by discoverServices()
+    struct GattDescriptorInfo
+    {
+        QString path;
+        QBluetoothUuid uuid;
+    };
+
+    struct GattCharacteristicInfo
+    {
+        QString path;
+        QBluetoothUuid uuid;
+        QStringList flags;
+        QList<GattDescriptorInfo> descriptors;
     };
 
     struct GattService
     {
         QString servicePath;
+        QList<GattCharacteristicInfo> characteristicInfos;
         QList<GattCharacteristic> characteristics;
+        // The initial value reads of the detail discovery still running
+        int pendingDiscoveryJobs = 0;
+        // Identifies the latest detail discovery, the reads of earlier ones
+        // are ignored
+        quint32 discoveryGeneration = 0;
 
         bool hasBatteryService = false;
         QSharedPointer<OrgBluezBattery1Interface> batteryInterface;
     };
 
+    static QList<GattCharacteristicInfo> characteristicInfos(const QString &servicePath);
+
     QHash<QBluetoothUuid, GattService> dbusServices;
     QLowEnergyHandle runningHandle = 1;
+    quint32 lastDiscoveryGeneration = 0;
 
     struct GattJob {
         enum JobFlag {
@@ -156,22 +188,47 @@ private:
             CharWrite               = 0x02,
             DescRead                = 0x04,
             DescWrite               = 0x08,
-            ServiceDiscovery        = 0x10,
-            LastServiceDiscovery    = 0x20
+            ServiceDiscovery        = 0x10
         };
         Q_DECLARE_FLAGS(JobFlags, JobFlag)
 
         JobFlags flags = GattJob::Unset;
         QLowEnergyHandle handle;
+        // The characteristic the job operates on, for descriptors the owning one
+        QLowEnergyHandle charHandle = 0;
         QByteArray value;
         QLowEnergyService::WriteMode writeMode = QLowEnergyService::WriteWithResponse;
         QSharedPointer<QLowEnergyServicePrivate> service;
+        // The detail discovery of the service a ServiceDiscovery job belongs to
+        quint32 discoveryGeneration = 0;
     };
 
-    QList<GattJob> jobs;
-    bool jobPending = false;
+    // Debug statistics of the GATT job scheduler, logged and reset when all
+    // jobs are done
+    struct GattJobStatistics
+    {
+        quint64 startedJobs = 0;
+        quint64 finishedJobs = 0;
+        int peakRunningJobs = 0;
+    };
 
-    void prepareNextJob();
+    // The queued jobs in order of submission and the jobs waiting for bluetoothd
+    QList<GattJob> jobs;
+    QHash<QDBusPendingCallWatcher *, GattJob> runningJobs;
+    // The characteristics, including their descriptors, with running jobs.
+    // The initial reads of a service discovery may share a characteristic,
+    // any other job needs it for itself.
+    QHash<QLowEnergyHandle, int> discoveryReadCharacteristics;
+    QSet<QLowEnergyHandle> exclusiveCharacteristics;
+    int maxRunningJobs = 4;
+    bool schedulingJobs = false;
+    GattJobStatistics jobStatistics;
+
+    void markJobRunning(const GattJob &job);
+    void unmarkJobRunning(const GattJob &job);
+    QDBusPendingCallWatcher *startJob(const GattJob &job);
+    void finishJob(const GattJob &job);
+    bool takeRunningJob(QDBusPendingCallWatcher *call, GattJob *job);
     void discoverBatteryServiceDetails(GattService &dbusData,
                                        QSharedPointer<QLowEnergyServicePrivate> serviceData);
     void executeClose(QLowEnergyController::Error newError);
@@ -556,10 +556,7 @@ void QLowEnergyControllerPrivateDarwin::_q_characteristicUpdated(QLowEnergyHandl
         return;
     }
 
-    if (characteristic.properties() & QLowEnergyCharacteristic::Read)
-        updateValueOfCharacteristic(charHandle, value, false);
-
-    emit service->characteristicChanged(characteristic, value);
+    remoteCharacteristicChanged(characteristic, value);
 }
 
 void QLowEnergyControllerPrivateDarwin::_q_descriptorRead(QLowEnergyHandle dHandle,
@@ -1890,12 +1890,7 @@ void QLowEnergyControllerPrivateWinRT::handleCharacteristicChanged(
         return;
     }
 
-    // only update cache when property is readable. Otherwise it remains
-    // empty.
-    if (characteristic.properties() & QLowEnergyCharacteristic::Read)
-        updateValueOfCharacteristic(characteristic.attributeHandle(),
-                                data, false);
-    emit service->characteristicChanged(characteristic, data);
+    remoteCharacteristicChanged(characteristic, data);
 }
 
 void QLowEnergyControllerPrivateWinRT::handleServiceHandlerError(const QString &error)
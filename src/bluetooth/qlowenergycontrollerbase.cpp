@@ -197,6 +197,41 @@ quint16 QLowEnergyControllerPrivate::updateValueOfCharacteristic(
     return 0;
 }
 
+/*!
+    Delivers \a newValue of \a characteristic, which was notified or indicated
+    by the remote device. The value is passed to the notification handler of the
+    characteristic, if any, then the cached value is updated and the
+    characteristicChanged() signal emitted unless the handler's options say otherwise.
+ */
+void QLowEnergyControllerPrivate::remoteCharacteristicChanged(
+        const QLowEnergyCharacteristic &characteristic, QByteArrayView newValue)
+{
+    const QSharedPointer<QLowEnergyServicePrivate> service = characteristic.d_ptr;
+    QLowEnergyService::NotificationHandlingOptions options;
+
+    const auto sink = service->notificationSinks.constFind(characteristic.attributeHandle());
+    if (sink != service->notificationSinks.cend()) {
+        options = sink->options;
+        // Copy, the handler may remove itself while being called
+        const QLowEnergyService::NotificationHandler handler = sink->handler;
+        handler(newValue);
+    }
+
+    const bool updateCache = !options.testFlag(QLowEnergyService::SkipValueCacheUpdate)
+            && (characteristic.properties() & QLowEnergyCharacteristic::Read);
+    const bool emitChanged = !options.testFlag(QLowEnergyService::SkipChangedSignal);
+    if (!updateCache && !emitChanged)
+        return;
+
+    const QByteArray value = newValue.toByteArray();
+    // only update cache when property is readable. Otherwise it remains
+    // empty.
+    if (updateCache)
+        updateValueOfCharacteristic(characteristic.attributeHandle(), value, false);
+    if (emitChanged)
+        emit service->characteristicChanged(characteristic, value);
+}
+
 /*!
     Returns the length of the updated descriptor value.
  */
@@ -38,6 +38,8 @@ public:
     QLowEnergyControllerPrivate();
     virtual ~QLowEnergyControllerPrivate();
 
+    static QLowEnergyControllerPrivate *get(QLowEnergyController *q) { return q->d_func(); }
+
     // interface definition
     virtual void init() = 0;
     virtual void connectToDevice() = 0;
@@ -109,6 +111,8 @@ public:
                                  QLowEnergyHandle descriptorHandle,
                                  const QByteArray &value,
                                  bool appendValue);
+    void remoteCharacteristicChanged(const QLowEnergyCharacteristic &characteristic,
+                                     QByteArrayView newValue);
     void invalidateServices();
 
 protected:
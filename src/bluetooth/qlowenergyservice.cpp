@@ -263,6 +263,32 @@ QT_IMPL_METATYPE_EXTERN_TAGGED(QLowEnergyService::WriteMode, QLowEnergyService__
                                     with BlueZ 5 and a kernel version 3.7 or newer.
  */
 
+/*!
+    \enum QLowEnergyService::NotificationHandlingOption
+
+    This enum describes how a notification or indication is processed once it
+    was passed to the handler set via \l setNotificationHandler().
+
+    \value DefaultNotificationHandling  The cached value of the characteristic is updated
+                                        and the \l characteristicChanged() signal is emitted,
+                                        as if there was no handler.
+    \value SkipValueCacheUpdate         The cached value returned by
+                                        \l QLowEnergyCharacteristic::value() is not updated.
+    \value SkipChangedSignal            The \l characteristicChanged() signal is not emitted.
+
+    \sa setNotificationHandler()
+    \since 6.10
+*/
+
+/*!
+    \typealias QLowEnergyService::NotificationHandler
+
+    Synonym for \c{std::function<void(QByteArrayView newValue)>}, the type of the
+    handlers passed to \l setNotificationHandler().
+
+    \since 6.10
+*/
+
 /*!
     \fn void QLowEnergyService::stateChanged(QLowEnergyService::ServiceState newState)
 
@@ -847,6 +873,70 @@ void QLowEnergyService::writeDescriptor(const QLowEnergyDescriptor &descriptor,
                                    newValue);
 }
 
+/*!
+    Sets \a handler to be called with the new value whenever the remote device
+    notifies or indicates a change of \a characteristic. Returns \c true if
+    the handler was set; otherwise \c false.
+
+    Unlike the service-wide \l characteristicChanged() signal, the handler is
+    invoked directly from the code receiving the notification, without any
+    signal or event loop involvement and without copying the value. This makes it
+    suitable for high-rate characteristics. The handler is called from the thread
+    the associated \l QLowEnergyController lives in. A handler which
+    forwards the data to another thread must copy it, as \c newValue is only
+    valid for the duration of the call.
+
+    By default the value is still cached and the \l characteristicChanged() signal
+    is emitted after the handler returns. The \a options can be used to skip either
+    or both of these steps.
+
+    Setting a handler replaces the previously set handler of \a characteristic.
+    A handler can only be set on a remote service whose details have been
+    discovered, and if \a characteristic belongs to this service. Notifications still
+    have to be enabled by writing the characteristic's
+    \l {QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration}{ClientCharacteristicConfiguration}
+    descriptor.
+
+    The handler is removed when the service becomes invalid, for example
+    because the controller disconnected from the remote device.
+
+    \note The handler is shared by all QLowEnergyService instances of the same service.
+
+    \sa removeNotificationHandler(), characteristicChanged()
+    \since 6.10
+ */
+bool QLowEnergyService::setNotificationHandler(const QLowEnergyCharacteristic &characteristic,
+                                               NotificationHandler handler,
+                                               NotificationHandlingOptions options)
+{
+    Q_D(QLowEnergyService);
+
+    if (d->controller == nullptr
+            || d->controller->role != QLowEnergyController::CentralRole
+            || state() != RemoteServiceDiscovered
+            || !contains(characteristic) || !handler) {
+        return false;
+    }
+
+    d->notificationSinks.insert(characteristic.attributeHandle(),
+                                { std::move(handler), options });
+    return true;
+}
+
+/*!
+    Removes the notification handler previously set for \a characteristic.
+
+    \sa setNotificationHandler()
+    \since 6.10
+ */
+void QLowEnergyService::removeNotificationHandler(const QLowEnergyCharacteristic &characteristic)
+{
+    Q_D(QLowEnergyService);
+
+    if (contains(characteristic))
+        d->notificationSinks.remove(characteristic.attributeHandle());
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qlowenergyservice.cpp"
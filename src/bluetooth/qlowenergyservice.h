@@ -8,6 +8,10 @@
 #include <QtBluetooth/QBluetoothUuid>
 #include <QtBluetooth/QLowEnergyCharacteristic>
 
+#include <QtCore/qbytearrayview.h>
+
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class QLowEnergyServicePrivate;
@@ -71,6 +75,16 @@ public:
     };
     Q_ENUM(WriteMode)
 
+    enum NotificationHandlingOption {
+        DefaultNotificationHandling = 0x0,
+        SkipValueCacheUpdate = 0x1,
+        SkipChangedSignal = 0x2
+    };
+    Q_ENUM(NotificationHandlingOption)
+    Q_DECLARE_FLAGS(NotificationHandlingOptions, NotificationHandlingOption)
+
+    using NotificationHandler = std::function<void(QByteArrayView newValue)>;
+
     ~QLowEnergyService();
 
     QList<QBluetoothUuid> includedServices() const;
@@ -98,6 +112,11 @@ public:
     void writeDescriptor(const QLowEnergyDescriptor &descriptor,
                          const QByteArray &newValue);
 
+    bool setNotificationHandler(const QLowEnergyCharacteristic &characteristic,
+                                NotificationHandler handler,
+                                NotificationHandlingOptions options = DefaultNotificationHandling);
+    void removeNotificationHandler(const QLowEnergyCharacteristic &characteristic);
+
 Q_SIGNALS:
     void stateChanged(QLowEnergyService::ServiceState newState);
     void characteristicChanged(const QLowEnergyCharacteristic &info,
@@ -127,6 +146,7 @@ private:
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QLowEnergyService::ServiceTypes)
+Q_DECLARE_OPERATORS_FOR_FLAGS(QLowEnergyService::NotificationHandlingOptions)
 
 QT_END_NAMESPACE
 
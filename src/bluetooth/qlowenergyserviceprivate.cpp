@@ -20,10 +20,13 @@ void QLowEnergyServicePrivate::setController(QLowEnergyControllerPrivate *contro
 {
     controller = control;
 
-    if (control)
+    if (control) {
         setState(QLowEnergyService::RemoteService);
-    else
+    } else {
+        // the handlers belong to the connection which is gone
+        notificationSinks.clear();
         setState(QLowEnergyService::InvalidService);
+    }
 }
 
 void QLowEnergyServicePrivate::setError(QLowEnergyService::ServiceError newError)
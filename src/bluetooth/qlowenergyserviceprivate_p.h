@@ -50,6 +50,11 @@ public:
         QHash<QLowEnergyHandle, DescData> descriptorList;
     };
 
+    struct NotificationSink {
+        QLowEnergyService::NotificationHandler handler;
+        QLowEnergyService::NotificationHandlingOptions options;
+    };
+
     enum GattAttributeTypes {
         PrimaryService = 0x2800,
         SecondaryService = 0x2801,
@@ -87,6 +92,8 @@ public:
     QLowEnergyService::DiscoveryMode mode = QLowEnergyService::FullDiscovery;
 
     QHash<QLowEnergyHandle, CharData> characteristicList;
+    // Per-characteristic notification handlers, keyed by characteristic handle
+    QHash<QLowEnergyHandle, NotificationSink> notificationSinks;
 
     QPointer<QLowEnergyControllerPrivate> controller;
 
@@ -96,6 +96,23 @@ public:
         This call also performs NDEF detection if is was not performed earlier.
     */
     virtual Action writeMessages(const QList<QNdefMessage> &messages) = 0;
+
+    /*
+        Forget any state of the card kept from earlier tasks.
+
+        The user must call this method after sending commands to the card
+        outside of the FSM, or after the card has been reset.
+    */
+    virtual void invalidateCache() { }
+
+    /*
+        Forget the selections made on the card by earlier tasks.
+
+        The user must call this method when a new transaction is started on a
+        card shared with other applications, which may have sent their own
+        commands in between.
+    */
+    virtual void invalidateSelection() { }
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,590 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qnfctagtype2ndeffsm_p.h"
+#include "qndefmessageview_p.h"
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QVarLengthArray>
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_LOGGING_CATEGORY(QT_NFC_T2T, "qt.nfc.t2t")
+
+/*
+    NDEF support for NFC Type 2 tags, such as NTAG21x and MIFARE Ultralight.
+
+    Based on Type 2 Tag Operation Specification, Version 1.1 (T2TOP 1.1).
+
+    The tag is accessed with the storage card commands of PC/SC Part 3:
+    READ BINARY reads from the page given in P1-P2 and UPDATE BINARY writes
+    a single page. A plain READ returns 16 bytes. Readers supporting NTAG
+    FAST_READ accept larger reads, these are sized to the maximum response
+    size and dropped in favor of 16-byte reads if the reader rejects them.
+*/
+
+static constexpr qsizetype PageSize = 4;
+// The size of a plain READ response, four pages
+static constexpr qsizetype ReadSize = 16;
+// The largest read possible with a short APDU
+static constexpr qsizetype MaxReadSize = 256;
+// The data area starts after the UID, the static lock bytes and the
+// capability container
+static constexpr qsizetype DataAreaStart = 16;
+
+static constexpr uint8_t NdefMagicNumber = 0xE1;
+
+// TLV block tags
+static constexpr uint8_t NullTlv = 0x00;
+static constexpr uint8_t LockControlTlv = 0x01;
+static constexpr uint8_t MemoryControlTlv = 0x02;
+static constexpr uint8_t NdefMessageTlv = 0x03;
+static constexpr uint8_t TerminatorTlv = 0xFE;
+
+// Special values returned by byteAt()
+static constexpr int NotRead = -1;
+static constexpr int EndOfDataArea = -2;
+
+/*
+    maxResponseSize is the largest response APDU the reader can return,
+    including the status word.
+*/
+QNfcTagType2NdefFsm::QNfcTagType2NdefFsm(int maxResponseSize)
+    : m_maxReadSize(qBound(ReadSize, qsizetype(maxResponseSize - 2) / PageSize * PageSize,
+                           MaxReadSize))
+{
+}
+
+QByteArray QNfcTagType2NdefFsm::getCommand(QNdefAccessFsm::Action &nextAction)
+{
+    nextAction = ProvideResponse;
+
+    switch (m_currentState) {
+    case ReadCapabilityContainer:
+        return QCommandApdu::build(0xFF, QCommandApdu::ReadBinary, 0x00, 0x00, {}, ReadSize);
+    case ReadMemory: {
+        const qsizetype page = m_memory.size() / PageSize;
+        return QCommandApdu::build(0xFF, QCommandApdu::ReadBinary, page >> 8, page & 0xFF, {},
+                                   m_readSize);
+    }
+    case WritePage: {
+        const auto &write = m_pageWrites.at(m_nextPageWrite);
+        return QCommandApdu::build(0xFF, QCommandApdu::UpdateBinary, write.page >> 8,
+                                   write.page & 0xFF, write.data);
+    }
+    default:
+        nextAction = Unexpected;
+        return {};
+    }
+}
+
+QNdefMessage QNfcTagType2NdefFsm::getMessage(QNdefAccessFsm::Action &nextAction)
+{
+    if (m_currentState == NdefMessageRead) {
+        auto message = QNdefMessageView(m_ndefData).toMessage();
+        m_ndefData.clear();
+        m_currentState = NdefSupportDetected;
+        nextAction = Done;
+        return message;
+    }
+
+    nextAction = Unexpected;
+    return {};
+}
+
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::detectNdefSupport()
+{
+    switch (m_currentState) {
+    case ReadCapabilityContainer:
+        m_targetState = NdefSupportDetected;
+        return SendCommand;
+    case NdefSupportDetected:
+        return Done;
+    case NdefNotSupported:
+        return Failed;
+    default:
+        return Unexpected;
+    }
+}
+
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::readMessages()
+{
+    switch (m_currentState) {
+    case ReadCapabilityContainer:
+        m_targetState = NdefMessageRead;
+        return SendCommand;
+    case NdefSupportDetected:
+        return startOperation(NdefMessageRead);
+    case NdefNotSupported:
+        return Failed;
+    default:
+        return Unexpected;
+    }
+}
+
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::writeMessages(const QList<QNdefMessage> &messages)
+{
+    // Only one message per tag is supported
+    if (messages.size() != 1)
+        return Failed;
+
+    switch (m_currentState) {
+    case ReadCapabilityContainer:
+        m_ndefData = messages.first().toByteArray();
+        m_targetState = NdefMessageWritten;
+        return SendCommand;
+
+    case NdefNotSupported:
+        return Failed;
+
+    case NdefSupportDetected:
+        if (!m_writable)
+            return Failed;
+
+        m_ndefData = messages.first().toByteArray();
+        return startOperation(NdefMessageWritten);
+
+    default:
+        return Unexpected;
+    }
+}
+
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::provideResponse(const QByteArray &response)
+{
+    QResponseApdu apdu(response);
+
+    switch (m_currentState) {
+    case ReadCapabilityContainer:
+        return handleReadCCResponse(apdu);
+    case ReadMemory:
+        return handleReadMemoryResponse(apdu);
+    case WritePage:
+        return handleWritePageResponse(apdu);
+    default:
+        return Unexpected;
+    }
+}
+
+/*
+    Returns the address of the byte at the given offset of the data area, or
+    -1 if the offset lies beyond the data area.
+*/
+qsizetype QNfcTagType2NdefFsm::addressOf(qsizetype offset) const
+{
+    qsizetype address = DataAreaStart + offset;
+
+    // The areas are sorted by their start address
+    for (const auto &area : m_reservedAreas) {
+        if (area.start > address)
+            break;
+        address += area.size;
+    }
+
+    return address < m_dataAreaEnd ? address : -1;
+}
+
+/*
+    Returns the byte at the given offset of the data area, or NotRead or
+    EndOfDataArea if it is not available.
+*/
+int QNfcTagType2NdefFsm::byteAt(qsizetype offset) const
+{
+    const qsizetype address = addressOf(offset);
+    if (address < 0)
+        return EndOfDataArea;
+    if (address >= m_memory.size())
+        return NotRead;
+    return static_cast<uint8_t>(m_memory.at(address));
+}
+
+/*
+    Adds the area described by a Lock Control TLV or a Memory Control TLV.
+
+    The reserved area must be located after the TLV itself, which ends before
+    tlvEnd, as the offsets of the preceding bytes must not change.
+*/
+bool QNfcTagType2NdefFsm::addReservedArea(uint8_t tag, const uint8_t *value, qsizetype tlvEnd)
+{
+    const qsizetype pageAddress = value[0] >> 4;
+    const qsizetype byteOffset = value[0] & 0x0F;
+    const qsizetype bytesPerPage = qsizetype(1) << (value[2] & 0x0F);
+    const qsizetype sizeField = value[1] ? value[1] : 256;
+
+    ReservedArea area;
+    area.start = pageAddress * bytesPerPage + byteOffset;
+    // The size of a Lock Control TLV is given in bits
+    area.size = tag == LockControlTlv ? (sizeField + 7) / 8 : sizeField;
+
+    // Areas outside of the data area do not affect it
+    if (area.start >= m_dataAreaEnd)
+        return true;
+
+    if (area.start < tlvEnd) {
+        qCDebug(QT_NFC_T2T) << "Reserved area at" << area.start << "overlaps the TLV blocks";
+        return false;
+    }
+
+    auto it = m_reservedAreas.begin();
+    while (it != m_reservedAreas.end() && it->start < area.start)
+        ++it;
+    if ((it != m_reservedAreas.end() && area.start + area.size > it->start)
+        || (it != m_reservedAreas.begin()
+            && std::prev(it)->start + std::prev(it)->size > area.start)) {
+        qCDebug(QT_NFC_T2T) << "Reserved area at" << area.start << "overlaps another one";
+        return false;
+    }
+    m_reservedAreas.insert(it, area);
+
+    return true;
+}
+
+void QNfcTagType2NdefFsm::resetOperation()
+{
+    m_memory.clear();
+    m_reservedAreas.clear();
+    m_tlvSearchDone = false;
+    m_tlvOffset = 0;
+    m_freeOffset = 0;
+    m_ndefTlvOffset = -1;
+    m_ndefValueOffset = -1;
+    m_ndefLength = -1;
+    m_pageWrites.clear();
+    m_nextPageWrite = 0;
+}
+
+/*
+    Starts reading the tag memory from its beginning. Nothing is kept from
+    earlier operations, the tag may have been modified in the meantime.
+*/
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::startOperation(State targetState)
+{
+    resetOperation();
+    m_targetState = targetState;
+    return requestRead(m_dataAreaEnd);
+}
+
+/*
+    Requests reading the tag memory following the bytes already read, at
+    least up to endAddress if the reader allows it.
+*/
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::requestRead(qsizetype endAddress)
+{
+    const qsizetype alignedEnd = (endAddress + PageSize - 1) / PageSize * PageSize;
+    if (m_memory.size() >= alignedEnd) {
+        m_currentState = NdefSupportDetected;
+        return Failed;
+    }
+
+    m_readSize = qMax(ReadSize, qMin(m_maxReadSize, alignedEnd - m_memory.size()));
+    m_currentState = ReadMemory;
+    return SendCommand;
+}
+
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::continueOperation()
+{
+    if (!m_tlvSearchDone) {
+        switch (findNdefTlv()) {
+        case NeedMoreData:
+            return requestRead(m_dataAreaEnd);
+        case InvalidTlv:
+            m_currentState = NdefSupportDetected;
+            return Failed;
+        case NdefTlvFound:
+        case NoNdefTlv:
+            m_tlvSearchDone = true;
+            break;
+        }
+    }
+
+    if (m_targetState == NdefMessageRead)
+        return continueRead();
+
+    return continueWrite();
+}
+
+/*
+    Parses the TLV blocks of the data area until the NDEF Message TLV, the
+    Terminator TLV or the end of the data area is found.
+
+    The parsing resumes from where it stopped if more data needs to be read.
+    Afterwards m_ndefTlvOffset tells where a new NDEF Message TLV should be
+    written.
+*/
+QNfcTagType2NdefFsm::TlvSearchResult QNfcTagType2NdefFsm::findNdefTlv()
+{
+    while (true) {
+        const int tag = byteAt(m_tlvOffset);
+        if (tag == NotRead)
+            return NeedMoreData;
+
+        if (tag == EndOfDataArea || tag == TerminatorTlv) {
+            m_ndefTlvOffset = tag == TerminatorTlv ? m_tlvOffset : m_freeOffset;
+            return NoNdefTlv;
+        }
+
+        if (tag == NullTlv) {
+            ++m_tlvOffset;
+            continue;
+        }
+
+        int length = byteAt(m_tlvOffset + 1);
+        qsizetype headerSize = 2;
+        if (length == NotRead)
+            return NeedMoreData;
+        if (length == EndOfDataArea)
+            return InvalidTlv;
+
+        if (length == 0xFF) {
+            const int high = byteAt(m_tlvOffset + 2);
+            const int low = byteAt(m_tlvOffset + 3);
+            if (high == NotRead || low == NotRead)
+                return NeedMoreData;
+            if (high == EndOfDataArea || low == EndOfDataArea)
+                return InvalidTlv;
+            length = (high << 8) | low;
+            headerSize = 4;
+        }
+
+        if (tag == NdefMessageTlv) {
+            m_ndefTlvOffset = m_tlvOffset;
+            m_ndefValueOffset = m_tlvOffset + headerSize;
+            m_ndefLength = length;
+            return NdefTlvFound;
+        }
+
+        if (tag == LockControlTlv || tag == MemoryControlTlv) {
+            if (length != 3)
+                return InvalidTlv;
+
+            uint8_t value[3];
+            for (qsizetype i = 0; i < 3; ++i) {
+                const int byte = byteAt(m_tlvOffset + headerSize + i);
+                if (byte == NotRead)
+                    return NeedMoreData;
+                if (byte == EndOfDataArea)
+                    return InvalidTlv;
+                value[i] = static_cast<uint8_t>(byte);
+            }
+
+            const qsizetype tlvEnd = addressOf(m_tlvOffset + headerSize + 2) + 1;
+            if (!addReservedArea(tag, value, tlvEnd))
+                return InvalidTlv;
+        }
+
+        m_tlvOffset += headerSize + length;
+        m_freeOffset = m_tlvOffset;
+    }
+}
+
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::continueRead()
+{
+    if (m_ndefLength < 0) {
+        qCDebug(QT_NFC_T2T) << "No NDEF Message TLV";
+        m_currentState = NdefSupportDetected;
+        return Failed;
+    }
+
+    if (m_ndefLength > 0) {
+        const qsizetype lastAddress = addressOf(m_ndefValueOffset + m_ndefLength - 1);
+        if (lastAddress < 0) {
+            qCDebug(QT_NFC_T2T) << "NDEF message exceeds the data area";
+            m_currentState = NdefSupportDetected;
+            return Failed;
+        }
+
+        if (lastAddress >= m_memory.size())
+            return requestRead(lastAddress + 1);
+    }
+
+    m_ndefData.resize(m_ndefLength);
+    for (qsizetype i = 0; i < m_ndefLength; ++i)
+        m_ndefData[i] = m_memory.at(addressOf(m_ndefValueOffset + i));
+
+    m_currentState = NdefMessageRead;
+    return GetMessage;
+}
+
+/*
+    Writes the new NDEF Message TLV in place of the current one, keeping the
+    TLV blocks before it. Only the pages that change are written.
+
+    As recommended by T2TOP, the length of the message is first set to zero
+    and the final length is written after the message.
+*/
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::continueWrite()
+{
+    const qsizetype messageSize = m_ndefData.size();
+
+    QByteArray tlv;
+    tlv.append(static_cast<char>(NdefMessageTlv));
+    if (messageSize < 0xFF) {
+        tlv.append(static_cast<char>(messageSize));
+    } else {
+        tlv.append(static_cast<char>(0xFF));
+        tlv.append(static_cast<char>(messageSize >> 8));
+        tlv.append(static_cast<char>(messageSize & 0xFF));
+    }
+    const qsizetype headerSize = tlv.size();
+    tlv.append(m_ndefData);
+
+    if (messageSize > 0xFFFE || addressOf(m_ndefTlvOffset + tlv.size() - 1) < 0) {
+        qCDebug(QT_NFC_T2T) << "Message is too large";
+        m_currentState = NdefSupportDetected;
+        return Failed;
+    }
+
+    if (addressOf(m_ndefTlvOffset + tlv.size()) >= 0)
+        tlv.append(static_cast<char>(TerminatorTlv));
+
+    // Pages are written as a whole, so their current contents must be known
+    const qsizetype endAddress = addressOf(m_ndefTlvOffset + tlv.size() - 1) + 1;
+    if (endAddress > m_memory.size())
+        return requestRead(endAddress);
+
+    QByteArray image = m_memory;
+    for (qsizetype i = 0; i < tlv.size(); ++i)
+        image[addressOf(m_ndefTlvOffset + i)] = tlv.at(i);
+
+    m_pageWrites.clear();
+    m_nextPageWrite = 0;
+
+    if (image == m_memory) {
+        qCDebug(QT_NFC_T2T) << "The tag already contains the message";
+        m_currentState = NdefSupportDetected;
+        return Done;
+    }
+
+    // The TLV announces an empty message until everything else is written
+    QByteArray clearedImage = m_memory;
+    clearedImage[addressOf(m_ndefTlvOffset)] = static_cast<char>(NdefMessageTlv);
+    clearedImage[addressOf(m_ndefTlvOffset + 1)] = 0;
+
+    QVarLengthArray<qsizetype, 2> headerPages;
+    for (qsizetype i = 0; i < headerSize; ++i) {
+        const qsizetype page = addressOf(m_ndefTlvOffset + i) / PageSize;
+        if (!headerPages.contains(page))
+            headerPages.append(page);
+    }
+
+    auto addPageWrite = [this](const QByteArray &from, const QByteArray &to, qsizetype page) {
+        const auto data = to.sliced(page * PageSize, PageSize);
+        if (data != from.sliced(page * PageSize, PageSize))
+            m_pageWrites.append(PageWrite{ page, data });
+    };
+
+    for (qsizetype page : std::as_const(headerPages))
+        addPageWrite(m_memory, clearedImage, page);
+
+    const qsizetype firstPage = addressOf(m_ndefTlvOffset) / PageSize;
+    const qsizetype lastPage = (endAddress - 1) / PageSize;
+    for (qsizetype page = firstPage; page <= lastPage; ++page) {
+        if (!headerPages.contains(page))
+            addPageWrite(m_memory, image, page);
+    }
+
+    for (qsizetype page : std::as_const(headerPages))
+        addPageWrite(clearedImage, image, page);
+
+    qCDebug(QT_NFC_T2T) << "Writing" << m_pageWrites.size() << "pages";
+
+    m_currentState = WritePage;
+    return SendCommand;
+}
+
+QNdefAccessFsm::Action QNfcTagType2NdefFsm::handleReadCCResponse(const QResponseApdu &response)
+{
+    m_currentState = NdefNotSupported;
+
+    if (!response.isOk())
+        return Failed;
+
+    const auto &data = response.data();
+    if (data.size() < ReadSize) {
+        qCDebug(QT_NFC_T2T) << "Invalid response size";
+        return Failed;
+    }
+
+    // The capability container is stored in page 3
+    const auto magic = static_cast<uint8_t>(data.at(12));
+    const auto version = static_cast<uint8_t>(data.at(13));
+    const auto size = static_cast<uint8_t>(data.at(14));
+    const auto access = static_cast<uint8_t>(data.at(15));
+
+    if (magic != NdefMagicNumber) {
+        qCDebug(QT_NFC_T2T) << "No NDEF capability container";
+        return Failed;
+    }
+    if ((version >> 4) != 1) {
+        qCDebug(QT_NFC_T2T) << "Unsupported mapping version:" << Qt::hex << version;
+        return Failed;
+    }
+    if ((access >> 4) != 0) {
+        qCDebug(QT_NFC_T2T) << "No read access";
+        return Failed;
+    }
+
+    m_dataAreaEnd = DataAreaStart + size * 8;
+    m_writable = (access & 0x0F) == 0;
+
+    m_currentState = NdefSupportDetected;
+
+    if (m_targetState == NdefSupportDetected)
+        return Done;
+
+    if (m_targetState == NdefMessageWritten && !m_writable)
+        return Failed;
+
+    // Continue from the pages that have already been read
+    resetOperation();
+    m_memory = data.first(ReadSize);
+    return continueOperation();
+}
+
+QNdefAccessFsm::Action
+QNfcTagType2NdefFsm::handleReadMemoryResponse(const QResponseApdu &response)
+{
+    const auto &data = response.data();
+
+    if (!response.isOk() || data.size() < PageSize) {
+        if (m_readSize > ReadSize) {
+            qCDebug(QT_NFC_T2T) << "Reader does not support reading" << m_readSize << "bytes";
+            m_maxReadSize = ReadSize;
+            m_readSize = ReadSize;
+            return SendCommand;
+        }
+
+        m_currentState = NdefSupportDetected;
+        return Failed;
+    }
+
+    if (data.size() < m_readSize && m_readSize > ReadSize) {
+        qCDebug(QT_NFC_T2T) << "Reader returned" << data.size() << "bytes instead of" << m_readSize;
+        m_maxReadSize = ReadSize;
+    }
+
+    // A READ near the end of the memory rolls over, the extra bytes are only
+    // kept to complete the pages.
+    const qsizetype readSize = qMin<qsizetype>(data.size(), m_readSize);
+    m_memory.append(data.first(readSize / PageSize * PageSize));
+
+    return continueOperation();
+}
+
+QNdefAccessFsm::Action
+QNfcTagType2NdefFsm::handleWritePageResponse(const QResponseApdu &response)
+{
+    if (!response.isOk()) {
+        m_currentState = NdefSupportDetected;
+        return Failed;
+    }
+
+    if (++m_nextPageWrite < m_pageWrites.size())
+        return SendCommand;
+
+    m_pageWrites.clear();
+    m_currentState = NdefSupportDetected;
+    return Done;
+}
+
+QT_END_NAMESPACE
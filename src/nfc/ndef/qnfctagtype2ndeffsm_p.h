@@ -0,0 +1,107 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNFCTAGTYPE2NDEFFSM_P_H
+#define QNFCTAGTYPE2NDEFFSM_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qndefaccessfsm_p.h"
+#include "qapduutils_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QNfcTagType2NdefFsm : public QNdefAccessFsm
+{
+public:
+    explicit QNfcTagType2NdefFsm(int maxResponseSize = 0);
+
+    QByteArray getCommand(Action &nextAction) override;
+    QNdefMessage getMessage(Action &nextAction) override;
+    Action provideResponse(const QByteArray &response) override;
+
+    Action detectNdefSupport() override;
+    Action readMessages() override;
+    Action writeMessages(const QList<QNdefMessage> &messages) override;
+
+private:
+    enum State {
+        ReadCapabilityContainer,
+        NdefSupportDetected,
+        NdefNotSupported,
+
+        ReadMemory,
+        NdefMessageRead,
+
+        WritePage,
+        NdefMessageWritten // Only for target state, it is never actually reached
+    };
+
+    enum TlvSearchResult { NeedMoreData, NdefTlvFound, NoNdefTlv, InvalidTlv };
+
+    struct ReservedArea
+    {
+        qsizetype start;
+        qsizetype size;
+    };
+
+    struct PageWrite
+    {
+        qsizetype page;
+        QByteArray data;
+    };
+
+    State m_currentState = ReadCapabilityContainer;
+    State m_targetState = ReadCapabilityContainer;
+
+    // Reads larger than 16 bytes are disabled if the reader rejects them
+    qsizetype m_maxReadSize;
+
+    // Initialized during the detection phase
+    qsizetype m_dataAreaEnd = 0;
+    bool m_writable = false;
+
+    // Used during the read and write operations. Offsets are counted in the
+    // data area without the reserved areas, addresses in the tag memory.
+    QByteArray m_memory;
+    qsizetype m_readSize = 0;
+    QList<ReservedArea> m_reservedAreas;
+    bool m_tlvSearchDone = false;
+    qsizetype m_tlvOffset = 0;
+    qsizetype m_freeOffset = 0;
+    qsizetype m_ndefTlvOffset = -1;
+    qsizetype m_ndefValueOffset = -1;
+    qsizetype m_ndefLength = -1;
+    QByteArray m_ndefData;
+    QList<PageWrite> m_pageWrites;
+    qsizetype m_nextPageWrite = 0;
+
+    qsizetype addressOf(qsizetype offset) const;
+    int byteAt(qsizetype offset) const;
+    bool addReservedArea(uint8_t tag, const uint8_t *value, qsizetype tlvEnd);
+
+    void resetOperation();
+    Action startOperation(State targetState);
+    Action continueOperation();
+    Action continueRead();
+    Action continueWrite();
+    Action requestRead(qsizetype endAddress);
+    TlvSearchResult findNdefTlv();
+
+    Action handleReadCCResponse(const QResponseApdu &response);
+    Action handleReadMemoryResponse(const QResponseApdu &response);
+    Action handleWritePageResponse(const QResponseApdu &response);
+};
+
+QT_END_NAMESPACE
+
+#endif // QNFCTAGTYPE2NDEFFSM_P_H
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qnfctagtype4ndeffsm_p.h"
+#include "qndefmessageview_p.h"
 #include <QtCore/QtEndian>
 #include <QtCore/QLoggingCategory>
 
@@ -13,8 +14,22 @@ Q_STATIC_LOGGING_CATEGORY(QT_NFC_T4T, "qt.nfc.t4t")
     NDEF support for NFC Type 4 tags.
 
     Based on Type 4 Tag Operation Specification, Version 2.0 (T4TOP 2.0).
+
+    The capability container is read once. The NDEF file remains selected
+    between tasks, so repeated reads and writes do not select it again
+    unless the card reports an error, or invalidateCache() has been called
+    because other commands have been sent to the card. On a card shared with
+    other applications, the selection only lasts for one card transaction,
+    invalidateSelection() is called when the next one starts.
+
+    With differential writes enabled, the message last read or written in
+    the same session is compared against the new one, and only the changed
+    ranges are updated. This assumes that no other application modifies
+    the tag while it is in the field.
 */
 
+QNfcTagType4NdefFsm::QNfcTagType4NdefFsm(int maxApduSize) : m_maxApduSize(maxApduSize) { }
+
 QByteArray QNfcTagType4NdefFsm::getCommand(QNdefAccessFsm::Action &nextAction)
 {
     // ID of the NDEF Tag Application
@@ -49,19 +64,17 @@ QByteArray QNfcTagType4NdefFsm::getCommand(QNdefAccessFsm::Action &nextAction)
                                    m_fileOffset & 0xFF, {}, readSize);
     }
     case ClearNdefLength:
-        m_fileOffset = 2;
-        m_fileSize = m_ndefData.size();
+        prepareFileUpdates();
         return QCommandApdu::build(0x00, QCommandApdu::UpdateBinary, 0x00, 0x00,
                                    QByteArrayView::fromArray(ZeroLength));
     case WriteNdefFile: {
-        uint16_t updateSize = qMin(m_fileSize, m_maxUpdateSize);
-        uint16_t fileOffset = m_fileOffset;
-
-        m_fileOffset += updateSize;
-        m_fileSize -= updateSize;
+        // The update is advanced once it has succeeded
+        const FileUpdate &update = m_fileUpdates.first();
+        uint16_t updateSize = qMin(update.size, m_maxUpdateSize);
 
-        return QCommandApdu::build(0x00, QCommandApdu::UpdateBinary, fileOffset >> 8,
-                                   fileOffset & 0xFF, m_ndefData.mid(fileOffset - 2, updateSize));
+        return QCommandApdu::build(
+                0x00, QCommandApdu::UpdateBinary, update.offset >> 8, update.offset & 0xFF,
+                QByteArrayView(m_ndefData).sliced(update.offset - 2, updateSize));
     }
     case WriteNdefLength: {
         QByteArray data(2, Qt::Uninitialized);
@@ -78,7 +91,7 @@ QByteArray QNfcTagType4NdefFsm::getCommand(QNdefAccessFsm::Action &nextAction)
 QNdefMessage QNfcTagType4NdefFsm::getMessage(QNdefAccessFsm::Action &nextAction)
 {
     if (m_currentState == NdefMessageRead) {
-        auto message = QNdefMessage::fromByteArray(m_ndefData);
+        auto message = QNdefMessageView(m_ndefData).toMessage();
         m_ndefData.clear();
         m_currentState = NdefSupportDetected;
         nextAction = Done;
@@ -111,8 +124,13 @@ QNdefAccessFsm::Action QNfcTagType4NdefFsm::readMessages()
         m_targetState = NdefMessageRead;
         return SendCommand;
     case NdefSupportDetected:
-        m_currentState = SelectApplicationForRead;
         m_targetState = NdefMessageRead;
+        if (m_ndefFileSelected) {
+            m_currentState = ReadNdefMessageLength;
+            m_usingCachedSelection = true;
+        } else {
+            m_currentState = SelectApplicationForRead;
+        }
         return SendCommand;
     case NdefNotSupported:
         return Failed;
@@ -146,7 +164,17 @@ QNdefAccessFsm::Action QNfcTagType4NdefFsm::writeMessages(const QList<QNdefMessa
         if (!m_writable)
             return Failed;
 
-        m_currentState = SelectApplicationForWrite;
+        if (m_differentialWrites && m_fileContentValid && m_fileContent == m_ndefData) {
+            qCDebug(QT_NFC_T4T) << "NDEF message is already on the card";
+            return Done;
+        }
+
+        if (m_ndefFileSelected) {
+            m_currentState = ClearNdefLength;
+            m_usingCachedSelection = true;
+        } else {
+            m_currentState = SelectApplicationForWrite;
+        }
         return SendCommand;
 
     default:
@@ -154,21 +182,97 @@ QNdefAccessFsm::Action QNfcTagType4NdefFsm::writeMessages(const QList<QNdefMessa
     };
 }
 
+void QNfcTagType4NdefFsm::invalidateCache()
+{
+    m_ndefFileSelected = false;
+    m_fileContentValid = false;
+}
+
+void QNfcTagType4NdefFsm::invalidateSelection()
+{
+    m_ndefFileSelected = false;
+}
+
+/*
+    Splits the NDEF message into the ranges that need to be written.
+
+    In the differential mode, the message is compared against the one known
+    to be on the card. The NLEN field is cleared during the write as usual,
+    so a partial write never results in a valid but corrupted message.
+*/
+void QNfcTagType4NdefFsm::prepareFileUpdates()
+{
+    // Writing a few unchanged bytes is cheaper than another command
+    static constexpr qsizetype MergeDistance = 16;
+
+    m_fileUpdates.clear();
+
+    const qsizetype size = m_ndefData.size();
+    if (!m_differentialWrites || !m_fileContentValid) {
+        if (size > 0)
+            m_fileUpdates.append({ 2, uint16_t(size) });
+    } else {
+        const qsizetype commonSize = qMin(size, m_fileContent.size());
+        qsizetype start = -1;
+        qsizetype end = -1;
+        for (qsizetype i = 0; i < size; ++i) {
+            if (i < commonSize && m_ndefData.at(i) == m_fileContent.at(i))
+                continue;
+            if (start >= 0 && i - end >= MergeDistance) {
+                m_fileUpdates.append({ uint16_t(start + 2), uint16_t(end - start) });
+                start = -1;
+            }
+            if (start < 0)
+                start = i;
+            end = i + 1;
+        }
+        if (start >= 0)
+            m_fileUpdates.append({ uint16_t(start + 2), uint16_t(end - start) });
+
+        qCDebug(QT_NFC_T4T) << "Writing" << m_fileUpdates.size() << "changed ranges";
+    }
+
+    // The file content is unknown until the write completes
+    m_fileContentValid = false;
+}
+
 QNdefAccessFsm::Action QNfcTagType4NdefFsm::provideResponse(const QByteArray &response)
 {
     QResponseApdu apdu(response);
 
+    if (!apdu.isOk()) {
+        m_ndefFileSelected = false;
+        m_fileContentValid = false;
+    }
+
+    if (m_usingCachedSelection) {
+        // The first command of the task relied on the selection made by an
+        // earlier task. The card may have been reset since, so start over
+        // with a fresh selection if the command has failed.
+        m_usingCachedSelection = false;
+        if (!apdu.isOk() && !response.isEmpty()) {
+            qCDebug(QT_NFC_T4T) << "Cached NDEF file selection is no longer valid";
+            m_currentState = m_targetState == NdefMessageRead ? SelectApplicationForRead
+                                                              : SelectApplicationForWrite;
+            return SendCommand;
+        }
+    }
+
     switch (m_currentState) {
     case SelectApplicationForProbe:
+        m_ndefFileSelected = false;
         return handleSimpleResponse(apdu, SelectCCFile, NdefNotSupported);
     case SelectCCFile:
+        m_ndefFileSelected = false;
         return handleSimpleResponse(apdu, ReadCCFile, NdefNotSupported);
     case ReadCCFile:
         return handleReadCCResponse(apdu);
 
     case SelectApplicationForRead:
+        m_ndefFileSelected = false;
         return handleSimpleResponse(apdu, SelectNdefFileForRead, NdefSupportDetected);
     case SelectNdefFileForRead:
+        m_ndefFileSelected = apdu.isOk();
         return handleSimpleResponse(apdu, ReadNdefMessageLength, NdefSupportDetected);
     case ReadNdefMessageLength:
         return handleReadFileLengthResponse(apdu);
@@ -176,14 +280,21 @@ QNdefAccessFsm::Action QNfcTagType4NdefFsm::provideResponse(const QByteArray &re
         return handleReadFileResponse(apdu);
 
     case SelectApplicationForWrite:
+        m_ndefFileSelected = false;
         return handleSimpleResponse(apdu, SelectNdefFileForWrite, NdefSupportDetected);
     case SelectNdefFileForWrite:
+        m_ndefFileSelected = apdu.isOk();
         return handleSimpleResponse(apdu, ClearNdefLength, NdefSupportDetected);
     case ClearNdefLength:
-        return handleSimpleResponse(apdu, WriteNdefFile, NdefSupportDetected);
+        return handleSimpleResponse(apdu, m_fileUpdates.isEmpty() ? WriteNdefLength : WriteNdefFile,
+                                    NdefSupportDetected);
     case WriteNdefFile:
         return handleWriteNdefFileResponse(apdu);
     case WriteNdefLength:
+        if (apdu.isOk()) {
+            m_fileContent = m_ndefData;
+            m_fileContentValid = true;
+        }
         return handleSimpleResponse(apdu, NdefSupportDetected, NdefSupportDetected, Done);
 
     default:
@@ -248,6 +359,20 @@ QNdefAccessFsm::Action QNfcTagType4NdefFsm::handleReadCCResponse(const QResponse
     }
 
     m_maxUpdateSize = readU16();
+
+    /*
+        MLe and MLc above the short APDU limits mean that the card supports
+        extended length APDUs. Use them only if the reader does as well.
+    */
+    if (m_maxApduSize > QCommandApdu::MaxShortSize) {
+        m_maxReadSize = qMin<qsizetype>(m_maxReadSize, m_maxApduSize - 2);
+        m_maxUpdateSize = qMin<qsizetype>(m_maxUpdateSize, m_maxApduSize - 7);
+    } else {
+        m_maxReadSize = qMin<qsizetype>(m_maxReadSize, QCommandApdu::MaxShortNe);
+        m_maxUpdateSize = qMin<qsizetype>(m_maxUpdateSize, QCommandApdu::MaxShortNc);
+    }
+    qCDebug(QT_NFC_T4T) << "Max read size" << m_maxReadSize << "max update size"
+                        << m_maxUpdateSize;
     auto tlvTag = readU8();
     if (tlvTag != 0x04) {
         qCDebug(QT_NFC_T4T) << "Invalid TLV tag";
@@ -329,6 +454,8 @@ QNfcTagType4NdefFsm::handleReadFileLengthResponse(const QResponseApdu &response)
     m_ndefData.clear();
 
     if (m_fileSize == 0) {
+        m_fileContent.clear();
+        m_fileContentValid = true;
         m_currentState = NdefMessageRead;
         return GetMessage;
     }
@@ -340,6 +467,15 @@ QNfcTagType4NdefFsm::handleReadFileLengthResponse(const QResponseApdu &response)
 QNdefAccessFsm::Action QNfcTagType4NdefFsm::handleReadFileResponse(const QResponseApdu &response)
 {
     if (!response.isOk() || response.data().size() == 0) {
+        // Some readers fail to pass extended length APDUs through, retry
+        // with short ones
+        if (qMin(m_fileSize, m_maxReadSize) > QCommandApdu::MaxShortNe
+            && response.status() != QResponseApdu::Empty) {
+            qCDebug(QT_NFC_T4T) << "Extended READ BINARY failed, falling back to short APDUs";
+            m_maxReadSize = QCommandApdu::MaxShortNe;
+            return SendCommand;
+        }
+
         m_currentState = NdefSupportDetected;
         return Failed;
     }
@@ -350,6 +486,8 @@ QNdefAccessFsm::Action QNfcTagType4NdefFsm::handleReadFileResponse(const QRespon
     m_fileSize -= readSize;
 
     if (m_fileSize == 0) {
+        m_fileContent = m_ndefData;
+        m_fileContentValid = true;
         m_currentState = NdefMessageRead;
         return GetMessage;
     }
@@ -360,12 +498,28 @@ QNdefAccessFsm::Action QNfcTagType4NdefFsm::handleReadFileResponse(const QRespon
 QNdefAccessFsm::Action
 QNfcTagType4NdefFsm::handleWriteNdefFileResponse(const QResponseApdu &response)
 {
+    FileUpdate &update = m_fileUpdates.first();
+    const uint16_t updateSize = qMin(update.size, m_maxUpdateSize);
+
     if (!response.isOk()) {
+        // The length is still zero, so the update can be retried with short
+        // APDUs
+        if (updateSize > QCommandApdu::MaxShortNc && response.status() != QResponseApdu::Empty) {
+            qCDebug(QT_NFC_T4T) << "Extended UPDATE BINARY failed, falling back to short APDUs";
+            m_maxUpdateSize = QCommandApdu::MaxShortNc;
+            return SendCommand;
+        }
+
         m_currentState = NdefSupportDetected;
         return Failed;
     }
 
-    if (m_fileSize == 0)
+    update.offset += updateSize;
+    update.size -= updateSize;
+    if (update.size == 0)
+        m_fileUpdates.removeFirst();
+
+    if (m_fileUpdates.isEmpty())
         m_currentState = WriteNdefLength;
 
     return SendCommand;
@@ -23,6 +23,10 @@ QT_BEGIN_NAMESPACE
 class QNfcTagType4NdefFsm : public QNdefAccessFsm
 {
 public:
+    explicit QNfcTagType4NdefFsm(int maxApduSize = 0);
+
+    void setDifferentialWrites(bool enabled) { m_differentialWrites = enabled; }
+
     QByteArray getCommand(Action &nextAction) override;
     QNdefMessage getMessage(Action &nextAction) override;
     Action provideResponse(const QByteArray &response) override;
@@ -30,6 +34,8 @@ public:
     Action detectNdefSupport() override;
     Action readMessages() override;
     Action writeMessages(const QList<QNdefMessage> &messages) override;
+    void invalidateCache() override;
+    void invalidateSelection() override;
 
 private:
     enum State {
@@ -53,9 +59,19 @@ private:
         NdefMessageWritten // Only for target state, it is never actually reached
     };
 
+    struct FileUpdate
+    {
+        uint16_t offset;
+        uint16_t size;
+    };
+
     State m_currentState = SelectApplicationForProbe;
     State m_targetState = SelectApplicationForProbe;
 
+    // Extended length APDUs are used only if the reader accepts APDUs
+    // larger than QCommandApdu::MaxShortSize
+    qsizetype m_maxApduSize;
+
     // Initialized during the detection phase
     uint16_t m_maxReadSize;
     uint16_t m_maxUpdateSize;
@@ -63,10 +79,24 @@ private:
     uint16_t m_maxNdefSize = 0xFFFF;
     bool m_writable;
 
+    // The NDEF file remains selected after a successful read or write, so
+    // the next task in the same card transaction can skip the selection
+    bool m_ndefFileSelected = false;
+    bool m_usingCachedSelection = false;
+
+    // The NDEF message last read from or written to the card. In the
+    // differential mode only the bytes differing from it are written.
+    bool m_differentialWrites = false;
+    bool m_fileContentValid = false;
+    QByteArray m_fileContent;
+
     // Used during the read and write operations
     uint16_t m_fileSize;
     uint16_t m_fileOffset;
     QByteArray m_ndefData;
+    QList<FileUpdate> m_fileUpdates;
+
+    void prepareFileUpdates();
 
     Action handleSimpleResponse(const QResponseApdu &response, State okState, State failedState,
                                 Action okAction = SendCommand);
@@ -26,6 +26,7 @@
 #    include <winscard.h>
 #endif
 #include <QtCore/QByteArray>
+#include <QtCore/QList>
 #include <QtCore/QString>
 
 QT_BEGIN_NAMESPACE
@@ -67,6 +68,12 @@ public:
     static qsizetype nameSize(CPtr p);
 };
 
+namespace QPcsc {
+
+LONG listReaders(SCARDCONTEXT context, QList<QPcscSlotName> *readers);
+
+} // namespace QPcsc
+
 QT_END_NAMESPACE
 
 #endif // QPCSC_P_H
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qpcsccard_p.h"
+#include "ndef/qnfctagtype2ndeffsm_p.h"
 #include "ndef/qnfctagtype4ndeffsm_p.h"
 #include "qapduutils_p.h"
 #include <QtCore/QLoggingCategory>
@@ -30,6 +31,12 @@ Q_DECLARE_LOGGING_CATEGORY(QT_NFC_PCSC)
 */
 static constexpr int KeepAliveIntervalMs = 2500;
 
+/*
+    Write only the changed parts of NDEF messages on Type 4 tags. This is
+    only safe if no other application writes to the tags.
+*/
+static constexpr auto DifferentialWriteEnvVar = "QT_NFC_DIFFERENTIAL_NDEF_WRITES";
+
 /*
     Start a temporary transaction if a persistent transaction was not already
     started due to call to onSendCommandRequest().
@@ -51,6 +58,10 @@ QPcscCard::Transaction::Transaction(QPcscCard *card) : m_card(card)
     }
 
     m_initiated = true;
+
+    // Other applications may have used the card since our last transaction
+    if (m_card->m_tagDetectionFsm)
+        m_card->m_tagDetectionFsm->invalidateSelection();
 }
 
 QPcscCard::Transaction::~Transaction()
@@ -79,9 +90,6 @@ QPcscCard::QPcscCard(SCARDHANDLE handle, DWORD protocol, QObject *parent)
     m_ioPci.dwProtocol = protocol;
     m_ioPci.cbPciLength = sizeof(m_ioPci);
 
-    // Assume that everything is NFC Tag Type 4 for now
-    m_tagDetectionFsm = std::make_unique<QNfcTagType4NdefFsm>();
-
     performNdefDetection();
 }
 
@@ -91,6 +99,11 @@ QPcscCard::~QPcscCard()
     invalidate();
 }
 
+/*
+    Find out which kind of NFC tag the card is, if any. The NDEF access FSMs
+    of the supported tag types are tried in turn, and the first one detecting
+    NDEF support is kept for the NDEF requests.
+*/
 void QPcscCard::performNdefDetection()
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
@@ -100,6 +113,25 @@ void QPcscCard::performNdefDetection()
 
     Transaction transaction(this);
 
+    auto type4Fsm = std::make_unique<QNfcTagType4NdefFsm>(readMaxInputLength());
+    type4Fsm->setDifferentialWrites(qEnvironmentVariableIntValue(DifferentialWriteEnvVar) > 0);
+    m_tagDetectionFsm = std::move(type4Fsm);
+    if (detectNdefSupport()) {
+        m_tagType = QNearFieldTarget::NfcTagType4;
+    } else if (m_isValid) {
+        // The reader does not report the maximum size of its responses, the
+        // maximum size of commands is used as an estimate.
+        m_tagDetectionFsm = std::make_unique<QNfcTagType2NdefFsm>(readMaxInputLength());
+        if (detectNdefSupport())
+            m_tagType = QNearFieldTarget::NfcTagType2;
+    }
+
+    m_supportsNdef = m_tagType != QNearFieldTarget::ProprietaryTag;
+    qCDebug(QT_NFC_PCSC) << "NDEF supported:" << m_supportsNdef;
+}
+
+bool QPcscCard::detectNdefSupport()
+{
     auto action = m_tagDetectionFsm->detectNdefSupport();
 
     while (action == QNdefAccessFsm::SendCommand) {
@@ -113,8 +145,7 @@ void QPcscCard::performNdefDetection()
 
     qCDebug(QT_NFC_PCSC) << "NDEF detection result" << action;
 
-    m_supportsNdef = action == QNdefAccessFsm::Done;
-    qCDebug(QT_NFC_PCSC) << "NDEF supported:" << m_supportsNdef;
+    return action == QNdefAccessFsm::Done;
 }
 
 /*
@@ -282,6 +313,9 @@ void QPcscCard::onDisconnectRequest()
         m_inAutoTransaction = false;
     }
 
+    if (m_tagDetectionFsm)
+        m_tagDetectionFsm->invalidateCache();
+
     DWORD activeProtocol;
     ret = SCardReconnect(m_handle, SCARD_SHARE_SHARED, SCARD_PROTOCOL_T0 | SCARD_PROTOCOL_T1,
                          SCARD_LEAVE_CARD, &activeProtocol);
@@ -310,6 +344,10 @@ void QPcscCard::onSendCommandRequest(const QNearFieldTarget::RequestId &request,
         return;
     }
 
+    // The command may change the state of the card
+    if (m_tagDetectionFsm)
+        m_tagDetectionFsm->invalidateCache();
+
     auto result = sendCommand(command, StartAutoTransaction);
     if (result.isOk())
         Q_EMIT requestCompleted(request, QNearFieldTarget::NoError, result.response);
@@ -317,6 +355,54 @@ void QPcscCard::onSendCommandRequest(const QNearFieldTarget::RequestId &request,
         Q_EMIT requestCompleted(request, QNearFieldTarget::CommandError, {});
 }
 
+/*
+    Sends the commands one after another and reports all responses with a
+    single requestCompleted() signal.
+
+    The first command starts the same automatic transaction that
+    onSendCommandRequest() uses, so the whole script runs in one transaction
+    that also protects the card state for the commands sent afterwards.
+    The script stops after the first response with a status word contained
+    in stopStatusWords, or after the first command that could not be sent.
+*/
+void QPcscCard::onSendCommandsRequest(const QNearFieldTarget::RequestId &request,
+                                      const QList<QByteArray> &commands,
+                                      const QList<quint16> &stopStatusWords)
+{
+    qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
+
+    if (!m_isValid) {
+        Q_EMIT requestCompleted(request, QNearFieldTarget::ConnectionError, {});
+        return;
+    }
+
+    if (m_tagDetectionFsm)
+        m_tagDetectionFsm->invalidateCache();
+
+    QList<QByteArray> responses;
+    responses.reserve(commands.size());
+
+    for (const auto &command : commands) {
+        auto result = sendCommand(command, StartAutoTransaction);
+        if (!result.isOk()) {
+            // The responses received so far are reported along with the error
+            Q_EMIT requestCompleted(request, QNearFieldTarget::CommandError,
+                                    QVariant::fromValue(responses));
+            return;
+        }
+
+        const auto status = QResponseApdu(result.response).status();
+        responses.append(std::move(result.response));
+
+        if (stopStatusWords.contains(status)) {
+            qCDebug(QT_NFC_PCSC) << "Stopping after status word" << Qt::hex << status;
+            break;
+        }
+    }
+
+    Q_EMIT requestCompleted(request, QNearFieldTarget::NoError, QVariant::fromValue(responses));
+}
+
 void QPcscCard::onWriteNdefMessagesRequest(const QNearFieldTarget::RequestId &request,
                                            const QList<QNdefMessage> &messages)
 {
@@ -41,12 +41,14 @@ public:
     int readMaxInputLength();
 
     bool supportsNdef() const { return m_supportsNdef; }
+    QNearFieldTarget::Type tagType() const { return m_tagType; }
 
 private:
     SCARDHANDLE m_handle;
     SCARD_IO_REQUEST m_ioPci;
     bool m_isValid = true;
-    bool m_supportsNdef;
+    bool m_supportsNdef = false;
+    QNearFieldTarget::Type m_tagType = QNearFieldTarget::ProprietaryTag;
     bool m_autodelete = false;
     // Indicates that an _automatic_ transaction was started
     bool m_inAutoTransaction = false;
@@ -58,6 +60,7 @@ private:
 
     QPcsc::RawCommandResult sendCommand(const QByteArray &command, AutoTransaction autoTransaction);
     void performNdefDetection();
+    bool detectNdefSupport();
 
     class Transaction
     {
@@ -75,6 +78,9 @@ public Q_SLOTS:
     void onTargetDestroyed();
     void onSendCommandRequest(const QNearFieldTarget::RequestId &request,
                               const QByteArray &command);
+    void onSendCommandsRequest(const QNearFieldTarget::RequestId &request,
+                               const QList<QByteArray> &commands,
+                               const QList<quint16> &stopStatusWords);
     void onReadNdefMessagesRequest(const QNearFieldTarget::RequestId &request);
     void onWriteNdefMessagesRequest(const QNearFieldTarget::RequestId &request,
                                     const QList<QNdefMessage> &messages);
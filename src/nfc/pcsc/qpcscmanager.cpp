@@ -3,23 +3,31 @@
 
 #include "qpcscmanager_p.h"
 #include "qpcscslot_p.h"
-#include "qpcsccard_p.h"
+#include "qpcscslotworker_p.h"
+#include "qpcscstatusmonitor_p.h"
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 Q_DECLARE_LOGGING_CATEGORY(QT_NFC_PCSC)
 
 static constexpr auto PollIntervalEnvVar = "QT_NFC_POLL_INTERVAL_MS";
 static constexpr int DefaultPollIntervalMs = 100;
 
+// Delay before retrying a failed operation when not polling
+static constexpr int RetryIntervalMs = DefaultPollIntervalMs;
+
 QPcscManager::QPcscManager(QObject *parent) : QObject(parent)
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
 
-    int pollInterval = DefaultPollIntervalMs;
+    int pollInterval = 0;
     QByteArray intervalEnv = qgetenv(PollIntervalEnvVar);
     if (!intervalEnv.isEmpty()) {
         if (int intervalFromEnv = intervalEnv.toInt(); intervalFromEnv > 0)
@@ -28,20 +36,37 @@ QPcscManager::QPcscManager(QObject *parent) : QObject(parent)
             qCWarning(QT_NFC_PCSC) << PollIntervalEnvVar << "set to an invalid value";
     }
 
-    m_stateUpdateTimer = new QTimer(this);
-    m_stateUpdateTimer->setInterval(pollInterval);
-    connect(m_stateUpdateTimer, &QTimer::timeout, this, &QPcscManager::onStateUpdate);
+#ifdef Q_OS_DARWIN
+    // The macOS PC/SC service does not report changes of the reader list
+    if (pollInterval == 0)
+        pollInterval = DefaultPollIntervalMs;
+#endif
+
+    if (pollInterval > 0) {
+        m_stateUpdateTimer = new QTimer(this);
+        m_stateUpdateTimer->setInterval(pollInterval);
+        connect(m_stateUpdateTimer, &QTimer::timeout, this, &QPcscManager::onStateUpdate);
+    } else {
+        m_statusMonitor = new QPcscStatusMonitor(this);
+        connect(m_statusMonitor, &QPcscStatusMonitor::statusChanged, this,
+                &QPcscManager::onStateUpdate, Qt::QueuedConnection);
+    }
 }
 
 QPcscManager::~QPcscManager()
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
-    if (m_hasContext) {
-        // Destroy all card handles before destroying the PCSC context.
-        for (auto slot : std::as_const(m_slots))
-            slot->invalidateInsertedCard();
+    stopStateTracking();
+
+    qDeleteAll(m_slots);
+    m_slots.clear();
+    m_slotStates.clear();
+
+    // Destroys the cards, they use the contexts of the workers
+    stopSlotWorkers();
+
+    if (m_hasContext)
         SCardReleaseContext(m_context);
-    }
 
     // Stop the worker thread.
     thread()->quit();
@@ -63,7 +88,7 @@ void QPcscManager::processSlotUpdates()
                              << slot->name();
 
         state.dwCurrentState = state.dwEventState;
-        slot->processStateChange(state.dwEventState, m_targetDetectionRunning);
+        slot->processStateChange(state.dwEventState, m_targetDetectionRunning, m_requestedMethod);
     }
 }
 
@@ -77,14 +102,15 @@ void QPcscManager::removeSlots()
         Q_ASSERT(slot != nullptr);
 
         // Remove slots that no longer exist, or all slots without cards if
-        // target detection is stopped.
+        // target detection is stopped. The worker of a slot may still be
+        // about to report a card, such slots are kept until it answered.
         if ((state.dwEventState & SCARD_STATE_UNKNOWN) != 0
-            || !(m_targetDetectionRunning || slot->hasCard())) {
+            || !(m_targetDetectionRunning || slot->hasCard()
+                 || slot->hasPendingStateChanges())) {
             qCDebug(QT_NFC_PCSC) << "Removing slot:" << slot;
             state.dwEventState = SCARD_STATE_UNKNOWN;
-            slot->invalidateInsertedCard();
             m_slots.remove(slot->name());
-            slot->deleteLater();
+            removeSlot(slot);
             state.pvUserData = nullptr;
         }
     }
@@ -102,65 +128,14 @@ void QPcscManager::updateSlotList()
 {
     Q_ASSERT(m_hasContext);
 
-#ifndef SCARD_AUTOALLOCATE
-    // macOS does not support automatic allocation. Try using a fixed-size
-    // buffer first, extending it if it is not sufficient.
-#define LIST_READER_BUFFER_EXTRA 1024
-    QPcscSlotName buf(nullptr);
-    DWORD listSize = LIST_READER_BUFFER_EXTRA;
-    buf.resize(listSize);
-    QPcscSlotName::Ptr list = buf.ptr();
-
-    auto ret = SCardListReaders(m_context, nullptr, list, &listSize);
-#else
-    QPcscSlotName::Ptr list;
-    DWORD listSize = SCARD_AUTOALLOCATE;
-    auto ret = SCardListReaders(m_context, nullptr, reinterpret_cast<QPcscSlotName::Ptr>(&list),
-                                &listSize);
-#endif
-
-    if (ret == LONG(SCARD_E_NO_READERS_AVAILABLE)) {
-        list = nullptr;
-        ret = SCARD_S_SUCCESS;
-    }
-#ifndef SCARD_AUTOALLOCATE
-    else if (ret == LONG(SCARD_E_INSUFFICIENT_BUFFER)) {
-        // SCardListReaders() has set listSize to the required size. We add
-        // extra space to reduce possibility of failure if the reader list has
-        // changed since the last call.
-        listSize += LIST_READER_BUFFER_EXTRA;
-        buf.resize(listSize);
-        list = buf.ptr();
-
-        ret = SCardListReaders(m_context, nullptr, list, &listSize);
-        if (ret == LONG(SCARD_E_NO_READERS_AVAILABLE)) {
-            list = nullptr;
-            ret = SCARD_S_SUCCESS;
-        }
-    }
-#undef LIST_READER_BUFFER_EXTRA
-#endif
-
+    QList<QPcscSlotName> readers;
+    auto ret = QPcsc::listReaders(m_context, &readers);
     if (ret != SCARD_S_SUCCESS) {
         qCDebug(QT_NFC_PCSC) << "Failed to list readers:" << QPcsc::errorMessage(ret);
         return;
     }
 
-#ifdef SCARD_AUTOALLOCATE
-    auto freeList = qScopeGuard([this, list] {
-        if (list) {
-            Q_ASSERT(m_hasContext);
-            SCardFreeMemory(m_context, list);
-        }
-    });
-#endif
-
-    QSet<QPcscSlotName> presentSlots;
-
-    if (list != nullptr) {
-        for (const auto *p = list; *p; p += QPcscSlotName::nameSize(p) + 1)
-            presentSlots.insert(QPcscSlotName(p));
-    }
+    QSet<QPcscSlotName> presentSlots(readers.cbegin(), readers.cend());
 
     // Check current state list and mark slots that are not present anymore to
     // be removed later.
@@ -179,9 +154,18 @@ void QPcscManager::updateSlotList()
 
     // Add new slots
     for (auto &&slotName : std::as_const(presentSlots)) {
-        QPcscSlot *slot = new QPcscSlot(slotName, this);
+        QPcscSlotWorker *worker = slotWorker(slotName);
+        QPcscSlot *slot = new QPcscSlot(slotName, worker, this);
         qCDebug(QT_NFC_PCSC) << "New slot:" << slot;
 
+        connect(worker, &QPcscSlotWorker::retryRequested, slot,
+                [this, slot] { retryCardDetection(slot); });
+        // Release the slot once it is idle, it may not change again
+        connect(slot, &QPcscSlot::becameIdle, this, [this] {
+            if (!m_targetDetectionRunning)
+                onStateUpdate();
+        }, Qt::QueuedConnection);
+
         m_slots[slotName] = slot;
 
         SCARD_READERSTATE state {};
@@ -209,16 +193,51 @@ bool QPcscManager::establishContext()
     return true;
 }
 
+/*
+    Starts tracking the status of the readers, either by polling or by waiting
+    for notifications from the status monitor.
+*/
+void QPcscManager::startStateTracking()
+{
+    if (m_statusMonitor) {
+        m_statusMonitor->startMonitoring();
+        // Pick up the current state right away
+        QMetaObject::invokeMethod(this, &QPcscManager::onStateUpdate, Qt::QueuedConnection);
+    } else {
+        m_stateUpdateTimer->start();
+    }
+}
+
+void QPcscManager::stopStateTracking()
+{
+    if (m_statusMonitor)
+        m_statusMonitor->stopMonitoring();
+    else
+        m_stateUpdateTimer->stop();
+}
+
+/*
+    Makes sure that onStateUpdate() is called again even if nothing changes.
+    When polling, this happens anyway at the next timeout.
+*/
+void QPcscManager::scheduleStateUpdate()
+{
+    if (m_statusMonitor)
+        QTimer::singleShot(RetryIntervalMs, this, &QPcscManager::onStateUpdate);
+}
+
 void QPcscManager::onStateUpdate()
 {
     if (!m_hasContext) {
         if (!m_targetDetectionRunning) {
-            m_stateUpdateTimer->stop();
+            stopStateTracking();
             return;
         }
 
-        if (!establishContext())
+        if (!establishContext()) {
+            scheduleStateUpdate();
             return;
+        }
     }
 
     updateSlotList();
@@ -230,21 +249,16 @@ void QPcscManager::onStateUpdate()
             SCardReleaseContext(m_context);
             m_hasContext = false;
 
-            m_stateUpdateTimer->stop();
+            stopStateTracking();
         }
         return;
     }
 
-    // Both Windows and PCSCLite support interruptable continuos state detection
-    // where SCardCancel() can be used to abort it from another thread.
-    // But that introduces a problem of reliable cancelling of the status change
-    // call and no other. Reliable use of SCardCancel() would probably require
-    // some form of synchronization and polling, and would make the code much
-    // more complicated.
-    // Alternatively, the state detection code could run in a yet another thread
-    // that will not need to be cancelled too often.
-    // For simplicity, the current code just checks for status changes every
-    // second.
+    // This thread must stay responsive to the requests for the cards, so the
+    // status is only checked here without waiting. Waiting for a change with
+    // an infinite timeout is done by QPcscStatusMonitor in its own thread,
+    // which then triggers this function. Without the monitor, the status is
+    // polled at a fixed interval.
     LONG ret = SCardGetStatusChange(m_context, 0, m_slotStates.data(), m_slotStates.size());
 
     if (ret == SCARD_S_SUCCESS || ret == LONG(SCARD_E_UNKNOWN_READER)) {
@@ -261,13 +275,13 @@ void QPcscManager::onStateUpdate()
         // next iteration.
         Q_ASSERT(m_hasContext);
         m_hasContext = false;
-        for (auto slot : std::as_const(m_slots)) {
-            slot->invalidateInsertedCard();
-            slot->deleteLater();
-        }
+        for (auto slot : std::as_const(m_slots))
+            removeSlot(slot);
         SCardReleaseContext(m_context);
         m_slots.clear();
         m_slotStates.clear();
+
+        scheduleStateUpdate();
     }
 }
 
@@ -281,59 +295,85 @@ void QPcscManager::onStartTargetDetectionRequest(QNearFieldTarget::AccessMethod
         return;
 
     m_targetDetectionRunning = true;
-    m_stateUpdateTimer->start();
+    startStateTracking();
 }
 
 void QPcscManager::onStopTargetDetectionRequest()
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
     m_targetDetectionRunning = false;
+
+    // Release the slots without cards now instead of at the next change
+    if (m_statusMonitor)
+        QMetaObject::invokeMethod(this, &QPcscManager::onStateUpdate, Qt::QueuedConnection);
 }
 
-QPcscCard *QPcscManager::connectToCard(QPcscSlot *slot)
+/*
+    Returns the worker for the slot with the given name, starting it in a new
+    thread if needed.
+*/
+QPcscSlotWorker *QPcscManager::slotWorker(const QPcscSlotName &name)
 {
-    qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
-    Q_ASSERT(slot != nullptr);
-    Q_ASSERT(m_hasContext);
-
-    SCARDHANDLE cardHandle;
-    DWORD activeProtocol;
+    if (auto worker = m_slotWorkers.value(name))
+        return worker;
 
-    LONG ret = SCardConnect(m_context, slot->name().ptr(), SCARD_SHARE_SHARED,
-                            SCARD_PROTOCOL_T0 | SCARD_PROTOCOL_T1, &cardHandle, &activeProtocol);
-    if (ret != SCARD_S_SUCCESS) {
-        qCDebug(QT_NFC_PCSC) << "Failed to connect to card:" << QPcsc::errorMessage(ret);
-        retryCardDetection(slot);
-        return nullptr;
-    }
+    auto thread = new QThread(this);
+    thread->setObjectName(u"QtNfcSlotThread"_s);
 
-    auto card = new QPcscCard(cardHandle, activeProtocol, this);
-    auto uid = card->readUid();
-    auto maxInputLength = card->readMaxInputLength();
+    auto worker = new QPcscSlotWorker(name);
+    worker->moveToThread(thread);
+    connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+    // Forwarded from the thread of the worker
+    connect(worker, &QPcscSlotWorker::cardInserted, this, &QPcscManager::cardInserted,
+            Qt::DirectConnection);
 
-    QNearFieldTarget::AccessMethods accessMethods = QNearFieldTarget::TagTypeSpecificAccess;
-    if (card->supportsNdef())
-        accessMethods |= QNearFieldTarget::NdefAccess;
+    thread->start();
+    m_slotWorkers.insert(name, worker);
 
-    if (m_requestedMethod != QNearFieldTarget::UnknownAccess
-        && (accessMethods & m_requestedMethod) == 0) {
-        qCDebug(QT_NFC_PCSC) << "Dropping card without required access support";
-        card->deleteLater();
-        return nullptr;
-    }
+    return worker;
+}
 
-    if (!card->isValid()) {
-        qCDebug(QT_NFC_PCSC) << "Card became invalid";
-        card->deleteLater();
+/*
+    Invalidates the card of the slot and stops the worker of the slot. The
+    worker may still be busy with the card, so its thread is not waited for
+    here but once it finished.
+*/
+void QPcscManager::removeSlot(QPcscSlot *slot)
+{
+    slot->invalidateInsertedCard();
+    slot->deleteLater();
 
-        retryCardDetection(slot);
+    QPcscSlotWorker *worker = m_slotWorkers.take(slot->name());
+    if (!worker)
+        return;
 
-        return nullptr;
-    }
+    QThread *thread = worker->thread();
+    m_stoppingThreads.append(thread);
+    connect(thread, &QThread::finished, this, [this, thread] {
+        m_stoppingThreads.removeOne(thread);
+        thread->wait();
+        delete thread;
+    }, Qt::QueuedConnection);
 
-    Q_EMIT cardInserted(card, uid, accessMethods, maxInputLength);
+    // Queued after the invalidation of the card
+    QMetaObject::invokeMethod(worker, [thread] { thread->quit(); }, Qt::QueuedConnection);
+}
 
-    return card;
+void QPcscManager::stopSlotWorkers()
+{
+    QList<QThread *> threads = std::exchange(m_stoppingThreads, {});
+    threads.reserve(threads.size() + m_slotWorkers.size());
+    for (auto worker : std::as_const(m_slotWorkers))
+        threads.append(worker->thread());
+    m_slotWorkers.clear();
+
+    // The workers are deleted when their threads finish
+    for (auto thread : std::as_const(threads))
+        thread->quit();
+    for (auto thread : std::as_const(threads)) {
+        thread->wait();
+        delete thread;
+    }
 }
 
 /*
@@ -352,6 +392,8 @@ void QPcscManager::retryCardDetection(const QPcscSlot *slot)
             break;
         }
     }
+
+    scheduleStateUpdate();
 }
 
 QT_END_NAMESPACE
@@ -17,11 +17,15 @@
 
 #include "qpcsc_p.h"
 #include "qnearfieldtarget.h"
+#include <QtCore/QHash>
 
 QT_BEGIN_NAMESPACE
 
 class QPcscSlot;
+class QPcscSlotWorker;
 class QPcscCard;
+class QPcscStatusMonitor;
+class QThread;
 class QTimer;
 
 class QPcscManager : public QObject
@@ -31,21 +35,31 @@ public:
     explicit QPcscManager(QObject *parent = nullptr);
     ~QPcscManager() override;
 
-    QPcscCard *connectToCard(QPcscSlot *slot);
-
 private:
-    QTimer *m_stateUpdateTimer;
+    // Exactly one of these is used for tracking status changes
+    QTimer *m_stateUpdateTimer = nullptr;
+    QPcscStatusMonitor *m_statusMonitor = nullptr;
     bool m_targetDetectionRunning = false;
     bool m_hasContext = false;
     SCARDCONTEXT m_context;
     QMap<QPcscSlotName, QPcscSlot *> m_slots;
+    // One for each tracked slot, each in its own thread
+    QHash<QPcscSlotName, QPcscSlotWorker *> m_slotWorkers;
+    // The threads of the workers of removed slots until they finished
+    QList<QThread *> m_stoppingThreads;
     QList<SCARD_READERSTATE> m_slotStates;
     QNearFieldTarget::AccessMethod m_requestedMethod;
 
     [[nodiscard]] bool establishContext();
+    void startStateTracking();
+    void stopStateTracking();
+    void scheduleStateUpdate();
     void processSlotUpdates();
     void updateSlotList();
     void removeSlots();
+    QPcscSlotWorker *slotWorker(const QPcscSlotName &name);
+    void removeSlot(QPcscSlot *slot);
+    void stopSlotWorkers();
     void retryCardDetection(const QPcscSlot *slot);
 
 public Q_SLOTS:
@@ -56,7 +70,7 @@ private Q_SLOTS:
     void onStateUpdate();
 
 Q_SIGNALS:
-    void cardInserted(QPcscCard *card, const QByteArray &uid,
+    void cardInserted(QPcscCard *card, const QByteArray &uid, QNearFieldTarget::Type type,
                       QNearFieldTarget::AccessMethods accessMethods, int maxInputLength);
 };
 
@@ -3,55 +3,72 @@
 
 #include "qpcscslot_p.h"
 #include "qpcscmanager_p.h"
-#include "qpcsccard_p.h"
+#include "qpcscslotworker_p.h"
 #include <QtCore/QLoggingCategory>
 
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(QT_NFC_PCSC)
 
-QPcscSlot::QPcscSlot(const QPcscSlotName &name, QPcscManager *manager)
-    : QObject(manager), m_name(name)
+/*
+    Tracks a slot in the thread of QPcscManager. The cards are handled by the
+    worker of the slot, in the thread of the worker.
+*/
+QPcscSlot::QPcscSlot(const QPcscSlotName &name, QPcscSlotWorker *worker, QPcscManager *manager)
+    : QObject(manager), m_name(name), m_worker(worker)
 {
+    Q_ASSERT(m_worker != nullptr);
+
+    // Queued from the thread of the worker, in the order of the events there
+    connect(m_worker, &QPcscSlotWorker::stateChangeProcessed, this,
+            &QPcscSlot::onStateChangeProcessed);
+    connect(m_worker, &QPcscSlotWorker::cardRemoved, this, &QPcscSlot::onCardRemoved);
 }
 
+/*
+    The card is not invalidated here, a deferred deletion would reach the
+    worker too late. QPcscManager invalidates the card and stops the worker
+    when removing the slot.
+*/
 QPcscSlot::~QPcscSlot()
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO << this;
-    if (m_insertedCard)
-        m_insertedCard->invalidate();
 }
 
-void QPcscSlot::processStateChange(DWORD eventId, bool createCards)
+void QPcscSlot::processStateChange(DWORD eventId, bool createCards,
+                                   QNearFieldTarget::AccessMethod requestedMethod)
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
 
-    // Check if the currently inserted card is still valid
-    if (!m_insertedCard.isNull()) {
-        if (m_insertedCard->checkCardPresent())
-            return;
-        qCDebug(QT_NFC_PCSC) << "Removing card from slot" << m_name;
-        m_insertedCard->invalidate();
-        m_insertedCard.clear();
-    }
-
-    auto manager = qobject_cast<QPcscManager *>(parent());
-
-    if (manager != nullptr && createCards
-        && (eventId
-            & (SCARD_STATE_PRESENT | SCARD_STATE_MUTE | SCARD_STATE_UNPOWERED
-               | SCARD_STATE_EXCLUSIVE))
-                == SCARD_STATE_PRESENT) {
-        qCDebug(QT_NFC_PCSC) << "New card in slot" << m_name;
-
-        m_insertedCard = manager->connectToCard(this);
-    }
+    ++m_pendingStateChanges;
+    QMetaObject::invokeMethod(
+            m_worker,
+            [worker = m_worker, eventId, createCards, requestedMethod] {
+                worker->processStateChange(eventId, createCards, requestedMethod);
+            },
+            Qt::QueuedConnection);
+}
+
+void QPcscSlot::onStateChangeProcessed(bool hasCard)
+{
+    Q_ASSERT(m_pendingStateChanges > 0);
+    --m_pendingStateChanges;
+    m_hasCard = hasCard;
+    if (!m_hasCard && m_pendingStateChanges == 0)
+        Q_EMIT becameIdle();
+}
+
+void QPcscSlot::onCardRemoved()
+{
+    m_hasCard = false;
+    if (m_pendingStateChanges == 0)
+        Q_EMIT becameIdle();
 }
 
 void QPcscSlot::invalidateInsertedCard()
 {
-    if (m_insertedCard)
-        m_insertedCard->invalidate();
+    QMetaObject::invokeMethod(m_worker, &QPcscSlotWorker::invalidateInsertedCard,
+                              Qt::QueuedConnection);
 }
 
 QT_END_NAMESPACE
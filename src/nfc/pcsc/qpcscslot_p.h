@@ -16,29 +16,41 @@
 //
 
 #include "qpcsc_p.h"
+#include "qnearfieldtarget.h"
 #include <QtCore/QObject>
-#include <QtCore/QPointer>
 
 QT_BEGIN_NAMESPACE
 
 class QPcscManager;
-class QPcscCard;
+class QPcscSlotWorker;
 
 class QPcscSlot : public QObject
 {
     Q_OBJECT
 public:
-    QPcscSlot(const QPcscSlotName &name, QPcscManager *manager);
+    QPcscSlot(const QPcscSlotName &name, QPcscSlotWorker *worker, QPcscManager *manager);
     ~QPcscSlot() override;
 
     const QPcscSlotName &name() const { return m_name; }
-    void processStateChange(DWORD eventId, bool createCards);
-    bool hasCard() const { return !m_insertedCard.isNull(); }
+    void processStateChange(DWORD eventId, bool createCards,
+                            QNearFieldTarget::AccessMethod requestedMethod);
+    // As last reported by the worker
+    bool hasCard() const { return m_hasCard; }
+    bool hasPendingStateChanges() const { return m_pendingStateChanges > 0; }
     void invalidateInsertedCard();
 
+Q_SIGNALS:
+    // The slot has neither a card nor state changes the worker is still busy with
+    void becameIdle();
+
 private:
+    void onStateChangeProcessed(bool hasCard);
+    void onCardRemoved();
+
     const QPcscSlotName m_name;
-    QPointer<QPcscCard> m_insertedCard;
+    QPcscSlotWorker *m_worker;
+    bool m_hasCard = false;
+    int m_pendingStateChanges = 0;
 };
 
 QT_END_NAMESPACE
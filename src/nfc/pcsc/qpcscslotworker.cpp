@@ -0,0 +1,167 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qpcscslotworker_p.h"
+#include "qpcsccard_p.h"
+#include <QtCore/QLoggingCategory>
+
+QT_BEGIN_NAMESPACE
+
+Q_DECLARE_LOGGING_CATEGORY(QT_NFC_PCSC)
+
+/*
+    Services the cards inserted into one slot.
+
+    Each worker lives in its own thread and uses its own PC/SC context, so
+    that a slow card in one reader does not delay the cards in other readers.
+    PCSCLite serializes all calls made on the same context.
+
+    The cards are children of the worker. QPcscManager creates one worker per
+    slot and stops it once the slot is removed, after the card of the slot
+    was invalidated. The cards are destroyed along with the worker.
+*/
+QPcscSlotWorker::QPcscSlotWorker(const QPcscSlotName &name) : m_name(name) { }
+
+QPcscSlotWorker::~QPcscSlotWorker()
+{
+    qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
+
+    // Destroy all card handles before destroying the PCSC context.
+    const auto cards = findChildren<QPcscCard *>(Qt::FindDirectChildrenOnly);
+    qDeleteAll(cards);
+
+    releaseContext();
+}
+
+bool QPcscSlotWorker::establishContext()
+{
+    Q_ASSERT(!m_hasContext);
+
+    LONG ret = SCardEstablishContext(SCARD_SCOPE_USER, nullptr, nullptr, &m_context);
+    if (ret != SCARD_S_SUCCESS) {
+        qCWarning(QT_NFC_PCSC) << "Failed to establish context:" << QPcsc::errorMessage(ret);
+        return false;
+    }
+    m_hasContext = true;
+
+    return true;
+}
+
+void QPcscSlotWorker::releaseContext()
+{
+    if (!m_hasContext)
+        return;
+
+    SCardReleaseContext(m_context);
+    m_hasContext = false;
+}
+
+void QPcscSlotWorker::setInsertedCard(QPcscCard *card)
+{
+    m_insertedCard = card;
+
+    if (card) {
+        connect(card, &QObject::destroyed, this, [this] {
+            if (m_insertedCard.isNull())
+                Q_EMIT cardRemoved();
+        });
+    }
+}
+
+/*
+    Handles a state change of the slot reported by QPcscSlot, and answers
+    with whether the slot has a card now. QPcscManager relies on the answers
+    rather than on its own view of the slot, which may be behind.
+*/
+void QPcscSlotWorker::processStateChange(DWORD eventId, bool createCards,
+                                         QNearFieldTarget::AccessMethod requestedMethod)
+{
+    qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
+
+    updateInsertedCard(eventId, createCards, requestedMethod);
+    Q_EMIT stateChangeProcessed(!m_insertedCard.isNull());
+}
+
+void QPcscSlotWorker::updateInsertedCard(DWORD eventId, bool createCards,
+                                         QNearFieldTarget::AccessMethod requestedMethod)
+{
+    // Check if the currently inserted card is still valid
+    if (!m_insertedCard.isNull()) {
+        if (m_insertedCard->checkCardPresent())
+            return;
+        qCDebug(QT_NFC_PCSC) << "Removing card from slot" << m_name;
+        m_insertedCard->invalidate();
+        setInsertedCard(nullptr);
+    }
+
+    if (createCards
+        && (eventId
+            & (SCARD_STATE_PRESENT | SCARD_STATE_MUTE | SCARD_STATE_UNPOWERED
+               | SCARD_STATE_EXCLUSIVE))
+                == SCARD_STATE_PRESENT) {
+        qCDebug(QT_NFC_PCSC) << "New card in slot" << m_name;
+
+        setInsertedCard(connectToCard(requestedMethod));
+    }
+}
+
+void QPcscSlotWorker::invalidateInsertedCard()
+{
+    if (m_insertedCard)
+        m_insertedCard->invalidate();
+    setInsertedCard(nullptr);
+}
+
+QPcscCard *QPcscSlotWorker::connectToCard(QNearFieldTarget::AccessMethod requestedMethod)
+{
+    qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
+
+    if (!m_hasContext && !establishContext()) {
+        Q_EMIT retryRequested();
+        return nullptr;
+    }
+
+    SCARDHANDLE cardHandle;
+    DWORD activeProtocol;
+
+    LONG ret = SCardConnect(m_context, m_name.ptr(), SCARD_SHARE_SHARED,
+                            SCARD_PROTOCOL_T0 | SCARD_PROTOCOL_T1, &cardHandle, &activeProtocol);
+    if (ret != SCARD_S_SUCCESS) {
+        qCDebug(QT_NFC_PCSC) << "Failed to connect to card:" << QPcsc::errorMessage(ret);
+        // Start with a new context next time if this one is broken
+        if (ret == LONG(SCARD_E_INVALID_HANDLE) || ret == LONG(SCARD_E_NO_SERVICE))
+            releaseContext();
+        Q_EMIT retryRequested();
+        return nullptr;
+    }
+
+    auto card = new QPcscCard(cardHandle, activeProtocol, this);
+    auto uid = card->readUid();
+    auto maxInputLength = card->readMaxInputLength();
+
+    QNearFieldTarget::AccessMethods accessMethods = QNearFieldTarget::TagTypeSpecificAccess;
+    if (card->supportsNdef())
+        accessMethods |= QNearFieldTarget::NdefAccess;
+
+    if (requestedMethod != QNearFieldTarget::UnknownAccess
+        && (accessMethods & requestedMethod) == 0) {
+        qCDebug(QT_NFC_PCSC) << "Dropping card without required access support";
+        card->deleteLater();
+        return nullptr;
+    }
+
+    if (!card->isValid()) {
+        qCDebug(QT_NFC_PCSC) << "Card became invalid";
+        card->deleteLater();
+
+        Q_EMIT retryRequested();
+
+        return nullptr;
+    }
+
+    Q_EMIT cardInserted(card, uid, card->tagType(), accessMethods, maxInputLength);
+
+    return card;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,62 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPCSCSLOTWORKER_P_H
+#define QPCSCSLOTWORKER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qpcsc_p.h"
+#include "qnearfieldtarget.h"
+#include <QtCore/QPointer>
+
+QT_BEGIN_NAMESPACE
+
+class QPcscCard;
+
+class QPcscSlotWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QPcscSlotWorker(const QPcscSlotName &name);
+    ~QPcscSlotWorker() override;
+
+    void processStateChange(DWORD eventId, bool createCards,
+                            QNearFieldTarget::AccessMethod requestedMethod);
+    void invalidateInsertedCard();
+
+private:
+    const QPcscSlotName m_name;
+    bool m_hasContext = false;
+    SCARDCONTEXT m_context;
+    QPointer<QPcscCard> m_insertedCard;
+
+    [[nodiscard]] bool establishContext();
+    void releaseContext();
+    void updateInsertedCard(DWORD eventId, bool createCards,
+                            QNearFieldTarget::AccessMethod requestedMethod);
+    QPcscCard *connectToCard(QNearFieldTarget::AccessMethod requestedMethod);
+    void setInsertedCard(QPcscCard *card);
+
+Q_SIGNALS:
+    void cardInserted(QPcscCard *card, const QByteArray &uid, QNearFieldTarget::Type type,
+                      QNearFieldTarget::AccessMethods accessMethods, int maxInputLength);
+    void retryRequested();
+    // The answer to each processStateChange() call
+    void stateChangeProcessed(bool hasCard);
+    // The inserted card was destroyed outside of processStateChange()
+    void cardRemoved();
+};
+
+QT_END_NAMESPACE
+
+#endif // QPCSCSLOTWORKER_P_H
@@ -0,0 +1,211 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qpcscstatusmonitor_p.h"
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+Q_DECLARE_LOGGING_CATEGORY(QT_NFC_PCSC)
+
+// Pseudo reader that reports changes of the reader list
+#ifdef Q_OS_WIN
+static constexpr auto PnpNotificationReader = L"\\\\?PnP?\\Notification";
+#else
+static constexpr auto PnpNotificationReader = "\\\\?PnP?\\Notification";
+#endif
+
+// Delay before trying again after a PC/SC failure, also used as the wait
+// timeout if the PC/SC service cannot report reader list changes.
+static constexpr int RetryIntervalMs = 1000;
+
+// SCardCancel() only interrupts a call that is already blocking. It is
+// repeated with this interval until the monitoring thread has finished.
+static constexpr int CancelRetryIntervalMs = 10;
+
+/*
+    Blocks in SCardGetStatusChange() on its own PC/SC context, watching all
+    readers and the reader list, and emits statusChanged() whenever something
+    has changed. QPcscManager uses it instead of polling for status changes.
+
+    The manager does its own status tracking when it is notified, the monitor
+    is only a source of wake-ups. Keeping the blocking call in a separate
+    thread means that it only needs to be cancelled when the monitoring stops,
+    and not for every request the manager's thread has to process.
+*/
+QPcscStatusMonitor::QPcscStatusMonitor(QObject *parent) : QThread(parent)
+{
+    setObjectName(u"QtNfcStatusMonitor"_s);
+}
+
+QPcscStatusMonitor::~QPcscStatusMonitor()
+{
+    stopMonitoring();
+}
+
+void QPcscStatusMonitor::startMonitoring()
+{
+    if (isRunning())
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopRequested = false;
+    }
+    start();
+}
+
+/*
+    Stops the monitoring and waits for the thread to finish.
+*/
+void QPcscStatusMonitor::stopMonitoring()
+{
+    if (!isRunning())
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopRequested = true;
+        m_stopCondition.wakeAll();
+    }
+
+    // The thread may be just about to enter SCardGetStatusChange(), in which
+    // case the first SCardCancel() has no effect.
+    do {
+        QMutexLocker locker(&m_mutex);
+        if (m_hasContext)
+            SCardCancel(m_context);
+    } while (!wait(QDeadlineTimer(CancelRetryIntervalMs)));
+}
+
+/*
+    Waits before the next attempt. Returns false if the monitoring has been
+    stopped in the meantime.
+*/
+bool QPcscStatusMonitor::waitForRetry()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_stopRequested)
+        m_stopCondition.wait(&m_mutex, QDeadlineTimer(RetryIntervalMs));
+    return !m_stopRequested;
+}
+
+void QPcscStatusMonitor::run()
+{
+    qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
+
+    const QPcscSlotName pnpReader(PnpNotificationReader);
+    bool pnpSupported = true;
+    DWORD pnpState = SCARD_STATE_UNAWARE;
+    QHash<QPcscSlotName, DWORD> readerStates;
+
+    while (true) {
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_stopRequested)
+                break;
+
+            if (!m_hasContext) {
+                LONG ret = SCardEstablishContext(SCARD_SCOPE_USER, nullptr, nullptr, &m_context);
+                if (ret != SCARD_S_SUCCESS) {
+                    qCWarning(QT_NFC_PCSC)
+                            << "Failed to establish context:" << QPcsc::errorMessage(ret);
+                    locker.unlock();
+                    if (!waitForRetry())
+                        break;
+                    continue;
+                }
+                m_hasContext = true;
+            }
+        }
+
+        QList<QPcscSlotName> readers;
+        LONG ret = QPcsc::listReaders(m_context, &readers);
+
+        if (ret == SCARD_S_SUCCESS) {
+            QList<SCARD_READERSTATE> states;
+            states.reserve(readers.size() + 1);
+
+            if (pnpSupported) {
+                SCARD_READERSTATE state {};
+                state.szReader = pnpReader.ptr();
+                state.dwCurrentState = pnpState;
+                states.append(state);
+            }
+            for (const auto &reader : std::as_const(readers)) {
+                SCARD_READERSTATE state {};
+                state.szReader = reader.ptr();
+                state.dwCurrentState = readerStates.value(reader, SCARD_STATE_UNAWARE);
+                states.append(state);
+            }
+
+            if (states.isEmpty()) {
+                if (!waitForRetry())
+                    break;
+                continue;
+            }
+
+            ret = SCardGetStatusChange(m_context, pnpSupported ? INFINITE : RetryIntervalMs,
+                                       states.data(), states.size());
+
+            if (ret == SCARD_S_SUCCESS || ret == LONG(SCARD_E_UNKNOWN_READER)) {
+                const qsizetype firstReader = pnpSupported ? 1 : 0;
+                if (pnpSupported && (states.first().dwEventState & SCARD_STATE_UNKNOWN) != 0) {
+                    qCDebug(QT_NFC_PCSC) << "Reader list notifications are not supported";
+                    pnpSupported = false;
+                } else if (pnpSupported) {
+                    pnpState = states.first().dwEventState;
+                }
+
+                // The event states are passed back as they are. Keeping
+                // SCARD_STATE_CHANGED also ensures that a reader list with
+                // zero readers is not mistaken for SCARD_STATE_UNAWARE.
+                // Readers no longer listed are forgotten.
+                QHash<QPcscSlotName, DWORD> newStates;
+                for (qsizetype i = 0; i < readers.size(); ++i) {
+                    const auto &state = states.at(firstReader + i);
+                    newStates.insert(readers.at(i),
+                                     (state.dwEventState & SCARD_STATE_CHANGED) != 0
+                                             ? state.dwEventState
+                                             : state.dwCurrentState);
+                }
+                readerStates = std::move(newStates);
+
+                Q_EMIT statusChanged();
+                continue;
+            }
+
+            if (ret == LONG(SCARD_E_CANCELLED) || ret == LONG(SCARD_E_TIMEOUT))
+                continue;
+        }
+
+        qCWarning(QT_NFC_PCSC) << "Status monitoring failed:" << QPcsc::errorMessage(ret);
+
+        // Start over with a new context, as the current one is unlikely to
+        // recover. Let the manager check its own context too.
+        {
+            QMutexLocker locker(&m_mutex);
+            SCardReleaseContext(m_context);
+            m_hasContext = false;
+        }
+        pnpState = SCARD_STATE_UNAWARE;
+        readerStates.clear();
+
+        Q_EMIT statusChanged();
+
+        if (!waitForRetry())
+            break;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_hasContext) {
+        SCardReleaseContext(m_context);
+        m_hasContext = false;
+    }
+}
+
+QT_END_NAMESPACE
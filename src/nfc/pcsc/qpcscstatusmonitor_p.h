@@ -0,0 +1,54 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPCSCSTATUSMONITOR_P_H
+#define QPCSCSTATUSMONITOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qpcsc_p.h"
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+
+QT_BEGIN_NAMESPACE
+
+class QPcscStatusMonitor : public QThread
+{
+    Q_OBJECT
+public:
+    explicit QPcscStatusMonitor(QObject *parent = nullptr);
+    ~QPcscStatusMonitor() override;
+
+    void startMonitoring();
+    void stopMonitoring();
+
+Q_SIGNALS:
+    void statusChanged();
+
+protected:
+    void run() override;
+
+private:
+    bool waitForRetry();
+
+    // Guards the members below, which both threads access
+    QMutex m_mutex;
+    QWaitCondition m_stopCondition;
+    bool m_stopRequested = false;
+    bool m_hasContext = false;
+    SCARDCONTEXT m_context;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPCSCSTATUSMONITOR_P_H
@@ -36,44 +36,44 @@ QResponseApdu::QResponseApdu(const QByteArray &response)
 
 /*
     Builds a command APDU from components according to ISO/IEC 7816.
+
+    Short length fields are used when both the data size and ne fit in them,
+    otherwise both Lc and Le are encoded in extended form as the standard
+    does not allow mixing the two forms. Only cards and readers supporting
+    extended length APDUs accept the latter.
 */
 QByteArray QCommandApdu::build(uint8_t cla, uint8_t ins, uint8_t p1, uint8_t p2,
                                QByteArrayView data, uint16_t ne)
 {
     Q_ASSERT(data.size() <= 0xFFFF);
 
+    const uint16_t nc = data.size();
+    const bool extended = nc > MaxShortNc || ne > MaxShortNe;
+    const qsizetype lengthSize = extended ? 2 : 1;
+
     QByteArray apdu;
+    apdu.reserve(4 + (extended ? 1 : 0) + (nc > 0 ? lengthSize + nc : 0) + (ne ? lengthSize : 0));
     apdu.append(static_cast<char>(cla));
     apdu.append(static_cast<char>(ins));
     apdu.append(static_cast<char>(p1));
     apdu.append(static_cast<char>(p2));
 
-    bool extendedLc = false;
-    uint16_t nc = data.size();
+    // The extended form starts with a zero byte, present only once
+    if (extended && (nc > 0 || ne))
+        apdu.append('\0');
 
     if (nc > 0) {
-        if (nc < 256) {
-            apdu.append(static_cast<char>(nc));
-        } else {
-            extendedLc = true;
-            apdu.append('\0');
+        if (extended)
             apdu.append(static_cast<char>(nc >> 8));
-            apdu.append(static_cast<char>(nc & 0xFF));
-        }
+        apdu.append(static_cast<char>(nc & 0xFF));
         apdu.append(data);
     }
 
     if (ne) {
-        if (ne < 256) {
-            apdu.append(static_cast<char>(ne));
-        } else if (ne == 256) {
-            apdu.append(static_cast<char>('\0'));
-        } else {
-            if (!extendedLc)
-                apdu.append('\0');
+        // Ne of 256 is encoded as zero in the short form
+        if (extended)
             apdu.append(static_cast<char>(ne >> 8));
-            apdu.append(static_cast<char>(ne & 0xFF));
-        }
+        apdu.append(static_cast<char>(ne & 0xFF));
     }
 
     return apdu;
@@ -44,6 +44,12 @@ constexpr uint8_t ReadBinary = 0xB0;
 constexpr uint8_t GetData = 0xCA;
 constexpr uint8_t UpdateBinary = 0xD6;
 
+// Largest Nc and Ne values that can be encoded in a short APDU
+constexpr qsizetype MaxShortNc = 255;
+constexpr qsizetype MaxShortNe = 256;
+// Size of the largest short command APDU: header, Lc, data and Le
+constexpr qsizetype MaxShortSize = 4 + 1 + MaxShortNc + 1;
+
 QByteArray build(uint8_t cla, uint8_t ins, uint8_t p1, uint8_t p2, QByteArrayView data,
                  uint16_t ne = 0);
 };
@@ -2,10 +2,9 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qndeffilter.h"
+#include "qndeffilter_p.h"
 #include "qndefmessage.h"
 
-#include <QtCore/QList>
-#include <QtCore/QMap>
 #include <QtCore/QVarLengthArray>
 
 QT_BEGIN_NAMESPACE
@@ -219,18 +218,111 @@ QT_BEGIN_NAMESPACE
     \c false.
 */
 
-class QNdefFilterPrivate : public QSharedData
-{
-public:
-    QNdefFilterPrivate();
+/*!
+    \internal
 
-    bool orderMatching;
-    QList<QNdefFilter::Record> filterRecords;
-};
+    Prepares the filter records for matching. Equal records are joined as
+    described in \l {Matching Algorithms}, so that match() does not need to
+    do it for every message.
+*/
+void QNdefFilterPrivate::compile()
+{
+    compiledRecords.clear();
+    recordIndex.clear();
+
+    if (filterRecords.isEmpty())
+        return;
+
+    if (!orderMatching) {
+        // Order is not important. Merge all the similar records, matching
+        // then only needs to check the amount of occurrences.
+        for (const auto &rec : std::as_const(filterRecords)) {
+            const QNdefRecordTypeKey key{ rec.typeNameFormat, rec.type };
+            const auto it = recordIndex.constFind(key);
+            if (it != recordIndex.cend()) {
+                QNdefFilter::Record &joined = compiledRecords[it.value()];
+                joined.minimum += rec.minimum;
+                joined.maximum += rec.maximum;
+            } else {
+                recordIndex.insert(key, compiledRecords.size());
+                compiledRecords.append(rec);
+            }
+        }
+    } else {
+        // Order *is* important. Only consecutive records with the same
+        // parameters can be merged.
+        QNdefFilter::Record currentRecord = filterRecords.first();
+        for (qsizetype i = 1; i < filterRecords.size(); ++i) {
+            const auto &rec = filterRecords.at(i);
+            if (rec.typeNameFormat == currentRecord.typeNameFormat
+                && rec.type == currentRecord.type) {
+                currentRecord.minimum += rec.minimum;
+                currentRecord.maximum += rec.maximum;
+            } else {
+                compiledRecords.push_back(currentRecord);
+                currentRecord = rec;
+            }
+        }
+        compiledRecords.push_back(currentRecord);
+    }
+}
 
-QNdefFilterPrivate::QNdefFilterPrivate()
-:   orderMatching(false)
+bool QNdefFilterPrivate::match(const QNdefMessage &message) const
 {
+    // empty filter matches only empty message
+    if (compiledRecords.isEmpty())
+        return message.isEmpty();
+
+    // The current number of occurrences of each compiled record
+    QVarLengthArray<unsigned int> counts(compiledRecords.size(), 0);
+
+    if (!orderMatching) {
+        for (const auto &record : message) {
+            auto it = recordIndex.constFind(QNdefRecordTypeKey{ record.typeNameFormat(),
+                                                                record.type() });
+            // Do not forget that we handle an empty type as "any type".
+            if (it == recordIndex.cend())
+                it = recordIndex.constFind(QNdefRecordTypeKey{ record.typeNameFormat(), {} });
+            // The message has a record that is not covered by the filter
+            if (it == recordIndex.cend())
+                return false;
+            counts[it.value()] += 1;
+        }
+    } else {
+        // Iterate through the messages and calculate the number of occurrences.
+        qsizetype filterIndex = 0;
+        for (const auto &messageRec : message) {
+            // Try to find a filter record that matches the message record.
+            // We start from the last processed filter record, not from the very
+            // beginning (because the order matters).
+            qsizetype idx = filterIndex;
+            for (; idx < compiledRecords.size(); ++idx) {
+                const auto &filterRec = compiledRecords.at(idx);
+                if (filterRec.typeNameFormat == messageRec.typeNameFormat()
+                    && (filterRec.type == messageRec.type() || filterRec.type.isEmpty())) {
+                    counts[idx] += 1;
+                    break;
+                } else if (counts[idx] < filterRec.minimum || counts[idx] > filterRec.maximum) {
+                    // The current message record does not match the current
+                    // filter record, but we didn't get enough records to
+                    // fulfill the filter => that's an error.
+                    return false;
+                }
+            }
+            // The message has a record that is not covered by the filter
+            if (idx == compiledRecords.size())
+                return false;
+            filterIndex = idx;
+        }
+    }
+
+    // Check that the occurrences match [min; max] range.
+    for (qsizetype i = 0; i < compiledRecords.size(); ++i) {
+        const auto &rec = compiledRecords.at(i);
+        if (counts[i] < rec.minimum || counts[i] > rec.maximum)
+            return false;
+    }
+    return true;
 }
 
 /*!
@@ -277,120 +369,7 @@ QNdefFilter &QNdefFilter::operator=(const QNdefFilter &other)
 */
 bool QNdefFilter::match(const QNdefMessage &message) const
 {
-    // empty filter matches only empty message
-    if (d->filterRecords.isEmpty())
-        return message.isEmpty();
-
-    bool matched = true;
-    int totalCount = 0;
-
-    if (!d->orderMatching) {
-        // Order is not important. The most reliable way is to merge all the
-        // similar records, and then simply check the amount of occurrences.
-        using MapKey = QPair<QNdefRecord::TypeNameFormat, QByteArray>;
-
-        // Creating a map from the list of filter records.
-        QMap<MapKey, Record> joinedFilterRecords;
-        for (const auto &rec : d->filterRecords) {
-            const auto key = qMakePair(rec.typeNameFormat, rec.type);
-            if (joinedFilterRecords.contains(key)) {
-                joinedFilterRecords[key].minimum += rec.minimum;
-                joinedFilterRecords[key].maximum += rec.maximum;
-            } else {
-                joinedFilterRecords.insert(key, rec);
-            }
-        }
-        // Checking the message, calculate occurrences.
-        QMap<MapKey, unsigned int> counts; // current number of occurrences
-        for (const auto &record : message) {
-            const auto key = qMakePair(record.typeNameFormat(), record.type());
-            // Do not forget that we handle an empty type as "any type".
-            const auto emptyTypeKey = qMakePair(record.typeNameFormat(), QByteArray());
-
-            if (joinedFilterRecords.contains(key))
-                counts[key] += 1;
-            else if (joinedFilterRecords.contains(emptyTypeKey))
-                counts[emptyTypeKey] += 1;
-        }
-        // Check that the occurrences match [min; max] range.
-        for (auto it = joinedFilterRecords.cbegin(); it != joinedFilterRecords.cend(); ++it) {
-            const auto count = counts.value(it.key(), 0);
-            totalCount += count;
-            if (count < it.value().minimum || count > it.value().maximum) {
-                matched = false;
-                break;
-            }
-        }
-    } else {
-        // Order *is* important. Need to iterate the list.
-
-        // Here we need to merge consecutive records with the same parameters.
-        QList<Record> mergedRecords;
-        // we know that filer is not empty here
-        Record currentRecord = d->filterRecords.first();
-        for (qsizetype i = 1; i < d->filterRecords.size(); ++i) {
-            const auto &rec = d->filterRecords.at(i);
-            if (rec.typeNameFormat == currentRecord.typeNameFormat
-                && rec.type == currentRecord.type) {
-                currentRecord.minimum += rec.minimum;
-                currentRecord.maximum += rec.maximum;
-            } else {
-                mergedRecords.push_back(currentRecord);
-                currentRecord = rec;
-            }
-        }
-        mergedRecords.push_back(currentRecord);
-
-        // The list contains the current number of occurrences of each record.
-        QVarLengthArray<unsigned int> counts(mergedRecords.size(), 0);
-
-        // Iterate through the messages and calculate the number of occurrences.
-        qsizetype filterIndex = 0;
-        for (qsizetype messageIndex = 0; matched && messageIndex < message.size(); ++messageIndex) {
-            const auto &messageRec = message.at(messageIndex);
-            // Try to find a filter record that matches the message record.
-            // We start from the last processed filter record, not from the very
-            // beginning (because the order matters).
-            qsizetype idx = filterIndex;
-            for (; idx < mergedRecords.size(); ++idx) {
-                const auto &filterRec = mergedRecords.at(idx);
-                if (filterRec.typeNameFormat == messageRec.typeNameFormat()
-                    && (filterRec.type == messageRec.type() || filterRec.type.isEmpty())) {
-                    counts[idx] += 1;
-                    break;
-                } else if (counts[idx] < filterRec.minimum || counts[idx] > filterRec.maximum) {
-                    // The current message record does not match the current
-                    // filter record, but we didn't get enough records to
-                    // fulfill the filter => that's an error.
-                    matched = false;
-                    break;
-                }
-            }
-            filterIndex = idx;
-        }
-
-        if (matched) {
-            // Check that the occurrences match [min; max] range.
-            for (qsizetype i = 0; i < mergedRecords.size(); ++i) {
-                const auto &rec = mergedRecords.at(i);
-                totalCount += counts[i];
-                if (counts[i] < rec.minimum || counts[i] > rec.maximum) {
-                    matched = false;
-                    break;
-                }
-            }
-        }
-    }
-
-    // Check if the message has records that do not match any record from the
-    // filter. To do it we just need to compare the total count of records,
-    // detected by filter, with the full message size. If they do not match,
-    // we have some records, that are not covered by the filter.
-    if (matched && (totalCount != message.size())) {
-        matched = false;
-    }
-
-    return matched;
+    return d->match(message);
 }
 
 /*!
@@ -400,6 +379,7 @@ void QNdefFilter::clear()
 {
     d->orderMatching = false;
     d->filterRecords.clear();
+    d->compile();
 }
 
 /*!
@@ -412,7 +392,11 @@ void QNdefFilter::clear()
 */
 void QNdefFilter::setOrderMatch(bool on)
 {
+    if (d->orderMatching == on)
+        return;
+
     d->orderMatching = on;
+    d->compile();
 }
 
 /*!
@@ -460,6 +444,7 @@ bool QNdefFilter::appendRecord(const Record &record)
 {
     if (verifyRecord(record)) {
         d->filterRecords.append(record);
+        d->compile();
         return true;
     }
     return false;
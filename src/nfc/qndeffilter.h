@@ -47,6 +47,7 @@ public:
 
 private:
     QSharedDataPointer<QNdefFilterPrivate> d;
+    friend class QNdefFilterPrivate;
 };
 
 template <typename T>
@@ -0,0 +1,69 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNDEFFILTER_P_H
+#define QNDEFFILTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qndeffilter.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QSharedData>
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QNdefMessage;
+
+struct QNdefRecordTypeKey
+{
+    QNdefRecord::TypeNameFormat typeNameFormat;
+    QByteArray type;
+
+    friend bool operator==(const QNdefRecordTypeKey &lhs, const QNdefRecordTypeKey &rhs) noexcept
+    {
+        return lhs.typeNameFormat == rhs.typeNameFormat && lhs.type == rhs.type;
+    }
+    friend bool operator!=(const QNdefRecordTypeKey &lhs, const QNdefRecordTypeKey &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+    friend size_t qHash(const QNdefRecordTypeKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, int(key.typeNameFormat), key.type);
+    }
+};
+
+class Q_AUTOTEST_EXPORT QNdefFilterPrivate : public QSharedData
+{
+public:
+    static const QNdefFilterPrivate *get(const QNdefFilter &filter) { return filter.d.constData(); }
+
+    void compile();
+    bool match(const QNdefMessage &message) const;
+
+    bool orderMatching = false;
+    QList<QNdefFilter::Record> filterRecords;
+
+    // Built by compile() whenever the filter changes.
+    // Unordered matching: one entry per (typeNameFormat, type) with the
+    // occurrences joined, and recordIndex mapping each key to its entry.
+    // Ordered matching: consecutive equal records joined, no index.
+    QList<QNdefFilter::Record> compiledRecords;
+    QHash<QNdefRecordTypeKey, qsizetype> recordIndex;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNDEFFILTER_P_H
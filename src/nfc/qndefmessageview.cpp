@@ -0,0 +1,240 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qndefmessageview_p.h"
+
+#include <QtCore/QtEndian>
+
+#include <cstring>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+static QByteArray joinedPayload(const QNdefRecordView &record)
+{
+    QByteArray payload(record.payloadSize(), Qt::Uninitialized);
+    char *out = payload.data();
+    record.forEachPayloadChunk([&out](QByteArrayView chunk) {
+        std::memcpy(out, chunk.data(), chunk.size());
+        out += chunk.size();
+    });
+    return payload;
+}
+
+QtNfcPrivate::NdefChunk QtNfcPrivate::readNdefChunk(QByteArrayView message, qsizetype pos)
+{
+    NdefChunk chunk;
+    chunk.flags = quint8(message.at(pos));
+
+    const bool sr = chunk.flags & 0x10;
+    const bool il = chunk.flags & 0x08;
+
+    qsizetype idx = pos + 1;
+    const quint8 typeLength = message.at(idx++);
+    quint32 payloadLength;
+    if (sr) {
+        payloadLength = quint8(message.at(idx++));
+    } else {
+        payloadLength = qFromBigEndian<quint32>(message.data() + idx);
+        idx += 4;
+    }
+    const quint8 idLength = il ? quint8(message.at(idx++)) : 0;
+
+    chunk.type = message.sliced(idx, typeLength);
+    idx += typeLength;
+    chunk.id = message.sliced(idx, idLength);
+    idx += idLength;
+    chunk.payload = message.sliced(idx, payloadLength);
+    idx += payloadLength;
+
+    chunk.size = idx - pos;
+    return chunk;
+}
+
+/*
+    Returns a copy of the record.
+*/
+QNdefRecord QNdefRecordView::toRecord() const
+{
+    QNdefRecord record;
+    record.setTypeNameFormat(m_typeNameFormat);
+    if (!m_type.isEmpty())
+        record.setType(m_type.toByteArray());
+    if (!m_id.isEmpty())
+        record.setId(m_id.toByteArray());
+    if (m_payloadSize > 0)
+        record.setPayload(isChunked() ? joinedPayload(*this) : m_firstChunk.toByteArray());
+    return record;
+}
+
+void QNdefMessageView::const_iterator::read()
+{
+    m_record = QNdefRecordView();
+    if (m_pos >= m_message.size())
+        return;
+
+    auto chunk = QtNfcPrivate::readNdefChunk(m_message, m_pos);
+
+    // A lone record with TNF Unchanged is handled as an empty record
+    const quint8 typeNameFormat = chunk.flags & 0x07;
+    m_record.m_typeNameFormat = typeNameFormat == 0x06
+            ? QNdefRecord::Empty
+            : QNdefRecord::TypeNameFormat(typeNameFormat);
+    m_record.m_type = chunk.type;
+    m_record.m_id = chunk.id;
+    m_record.m_firstChunk = chunk.payload;
+    m_record.m_payloadSize = chunk.payload.size();
+    m_record.m_chunkCount = 1;
+
+    qsizetype size = chunk.size;
+    while (chunk.flags & 0x20) {
+        chunk = QtNfcPrivate::readNdefChunk(m_message, m_pos + size);
+        m_record.m_payloadSize += chunk.payload.size();
+        ++m_record.m_chunkCount;
+        size += chunk.size;
+    }
+
+    m_record.m_encoded = m_message.sliced(m_pos, size);
+}
+
+/*
+    Validates the NDEF message in \a message. The view does not own the data,
+    it must remain valid while the view and its iterators are used.
+
+    If the message is malformed, a warning is printed and the view is empty.
+    Any data after the last record is ignored.
+*/
+QNdefMessageView::QNdefMessageView(QByteArrayView message) : m_message(message)
+{
+    m_valid = validate();
+    if (!m_valid) {
+        m_message = {};
+        m_recordCount = 0;
+    }
+}
+
+bool QNdefMessageView::validate()
+{
+    const QByteArrayView message = m_message;
+
+    bool seenMessageBegin = false;
+    bool seenMessageEnd = false;
+    bool inChunkedRecord = false;
+
+    qsizetype idx = 0;
+    while (idx < message.size()) {
+        quint8 flags = message.at(idx);
+
+        const bool messageBegin = flags & 0x80;
+        const bool messageEnd = flags & 0x40;
+
+        const bool cf = flags & 0x20;
+        const bool sr = flags & 0x10;
+        const bool il = flags & 0x08;
+        const quint8 typeNameFormat = flags & 0x07;
+
+        if (messageBegin && seenMessageBegin) {
+            qWarning("Got message begin but already parsed some records");
+            return false;
+        } else if (!messageBegin && !seenMessageBegin) {
+            qWarning("Haven't got message begin yet");
+            return false;
+        } else if (messageBegin && !seenMessageBegin) {
+            seenMessageBegin = true;
+        }
+        if (messageEnd && seenMessageEnd) {
+            qWarning("Got message end but already parsed final record");
+            return false;
+        } else if (messageEnd && !seenMessageEnd) {
+            seenMessageEnd = true;
+        }
+        // TNF must be 0x06 even for the last chunk, when cf == 0.
+        if ((typeNameFormat != 0x06) && inChunkedRecord) {
+            qWarning("Partial chunk not empty, but TNF not 0x06 as expected");
+            return false;
+        }
+
+        int headerLength = 1;
+        headerLength += (sr) ? 1 : 4;
+        headerLength += (il) ? 1 : 0;
+
+        if (idx + headerLength >= message.size()) {
+            qWarning("Unexpected end of message");
+            return false;
+        }
+
+        const quint8 typeLength = message.at(++idx);
+
+        if ((typeNameFormat == 0x06) && (typeLength != 0)) {
+            qWarning("Invalid chunked data, TYPE_LENGTH != 0");
+            return false;
+        }
+
+        quint32 payloadLength;
+        if (sr) {
+            payloadLength = quint8(message.at(++idx));
+        } else {
+            payloadLength = qFromBigEndian<quint32>(message.data() + idx + 1);
+            idx += 4;
+        }
+
+        const quint8 idLength = il ? quint8(message.at(++idx)) : 0;
+
+        // On 32-bit systems this can overflow
+        const qsizetype convertedPayloadLength = static_cast<qsizetype>(payloadLength);
+        const qsizetype contentLength = convertedPayloadLength + typeLength + idLength;
+
+        // On a 32 bit platform the payload can theoretically exceed the max.
+        // size of a QByteArray. This will never happen in practice with correct
+        // data because there are no NFC tags that can store such data sizes,
+        // but still can be possible if the data is corrupted.
+        if ((contentLength < 0) || (convertedPayloadLength < 0)
+            || ((std::numeric_limits<qsizetype>::max() - idx) < contentLength)) {
+            qWarning("Payload can't fit into QByteArray");
+            return false;
+        }
+
+        if (idx + contentLength >= message.size()) {
+            qWarning("Unexpected end of message");
+            return false;
+        }
+
+        if ((typeNameFormat == 0x06) && il) {
+            qWarning("Invalid chunked data, IL != 0");
+            return false;
+        }
+
+        // move to start of next record
+        idx += contentLength + 1;
+
+        inChunkedRecord = cf;
+        if (!cf) {
+            ++m_recordCount;
+            if (seenMessageEnd)
+                break;
+        }
+    }
+
+    if (!seenMessageBegin || !seenMessageEnd || inChunkedRecord) {
+        qWarning("Malformed NDEF Message, missing begin or end");
+        return false;
+    }
+
+    m_message = message.first(idx);
+    return true;
+}
+
+/*
+    Returns the viewed message with copies of the records, or an empty
+    message if the view is not valid.
+*/
+QNdefMessage QNdefMessageView::toMessage() const
+{
+    QNdefMessage message;
+    message.reserve(m_recordCount);
+    for (const auto &record : *this)
+        message.append(record.toRecord());
+    return message;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,177 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNDEFMESSAGEVIEW_P_H
+#define QNDEFMESSAGEVIEW_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNfc/qndefmessage.h>
+#include <QtNfc/qndefrecord.h>
+
+#include <QtCore/QByteArrayView>
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+class Q_NFC_EXPORT QNdefRecordView
+{
+public:
+    QNdefRecord::TypeNameFormat typeNameFormat() const { return m_typeNameFormat; }
+    QByteArrayView type() const { return m_type; }
+    QByteArrayView id() const { return m_id; }
+
+    // Chunked records carry their payload in several pieces
+    bool isChunked() const { return m_chunkCount > 1; }
+    qsizetype chunkCount() const { return m_chunkCount; }
+    qsizetype payloadSize() const { return m_payloadSize; }
+
+    // The payload of a record that is not chunked
+    QByteArrayView payload() const
+    {
+        Q_ASSERT(!isChunked());
+        return m_firstChunk;
+    }
+
+    template <typename Function>
+    void forEachPayloadChunk(Function function) const;
+
+    // The record as a whole, including all the chunks
+    QByteArrayView encoded() const { return m_encoded; }
+
+    QNdefRecord toRecord() const;
+
+private:
+    friend class QNdefMessageView;
+
+    QNdefRecord::TypeNameFormat m_typeNameFormat = QNdefRecord::Empty;
+    QByteArrayView m_type;
+    QByteArrayView m_id;
+    QByteArrayView m_firstChunk;
+    QByteArrayView m_encoded;
+    qsizetype m_payloadSize = 0;
+    qsizetype m_chunkCount = 0;
+};
+
+/*
+    A validated view of an encoded NDEF message.
+
+    The records can be iterated without creating QNdefRecord objects, the
+    record views point into the viewed data. Converting the view to a
+    QNdefMessage copies each field once.
+*/
+class Q_NFC_EXPORT QNdefMessageView
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = QNdefRecordView;
+        using difference_type = qsizetype;
+        using pointer = const QNdefRecordView *;
+        using reference = const QNdefRecordView &;
+
+        const_iterator() = default;
+
+        reference operator*() const { return m_record; }
+        pointer operator->() const { return &m_record; }
+
+        const_iterator &operator++()
+        {
+            m_pos += m_record.m_encoded.size();
+            read();
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs)
+        {
+            return lhs.m_pos == rhs.m_pos;
+        }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class QNdefMessageView;
+
+        const_iterator(QByteArrayView message, qsizetype pos) : m_message(message), m_pos(pos)
+        {
+            read();
+        }
+
+        void read();
+
+        QByteArrayView m_message;
+        qsizetype m_pos = 0;
+        QNdefRecordView m_record;
+    };
+
+    explicit QNdefMessageView(QByteArrayView message);
+
+    bool isValid() const { return m_valid; }
+    qsizetype size() const { return m_recordCount; }
+    bool isEmpty() const { return m_recordCount == 0; }
+
+    const_iterator begin() const { return { m_message, 0 }; }
+    const_iterator end() const { return { m_message, m_message.size() }; }
+
+    QNdefMessage toMessage() const;
+
+private:
+    bool validate();
+
+    // Limited to the end of the last record
+    QByteArrayView m_message;
+    qsizetype m_recordCount = 0;
+    bool m_valid = false;
+};
+
+namespace QtNfcPrivate {
+
+struct NdefChunk
+{
+    quint8 flags;
+    QByteArrayView type;
+    QByteArrayView id;
+    QByteArrayView payload;
+    qsizetype size;
+};
+
+// Reads the chunk at pos of a validated message
+Q_NFC_EXPORT NdefChunk readNdefChunk(QByteArrayView message, qsizetype pos);
+
+} // namespace QtNfcPrivate
+
+template <typename Function>
+void QNdefRecordView::forEachPayloadChunk(Function function) const
+{
+    qsizetype pos = 0;
+    for (qsizetype i = 0; i < m_chunkCount; ++i) {
+        const auto chunk = QtNfcPrivate::readNdefChunk(m_encoded, pos);
+        if (!chunk.payload.isEmpty())
+            function(chunk.payload);
+        pos += chunk.size;
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif // QNDEFMESSAGEVIEW_P_H
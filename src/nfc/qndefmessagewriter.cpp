@@ -0,0 +1,332 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qndefmessagewriter_p.h"
+
+#include <QtCore/QIODevice>
+#include <QtCore/QtEndian>
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+// Record header flags
+static constexpr quint8 MessageBegin = 0x80;
+static constexpr quint8 MessageEnd = 0x40;
+static constexpr quint8 ChunkFlag = 0x20;
+static constexpr quint8 ShortRecord = 0x10;
+static constexpr quint8 IdLengthPresent = 0x08;
+static constexpr quint8 TnfUnchanged = 0x06;
+
+QNdefMessageWriter::QNdefMessageWriter(const QNdefMessage &message)
+    // An empty message is treated as a message containing a single empty record.
+    : m_message(message.isEmpty() ? QNdefMessage(QNdefRecord()) : message)
+{
+}
+
+template <typename Sink>
+void QNdefMessageWriter::serialize(Sink &sink) const
+{
+    const qsizetype recordCount = m_message.size();
+    for (qsizetype i = 0; i < recordCount; ++i) {
+        const QNdefRecord &record = m_message.at(i);
+        const QByteArray type = record.type();
+        const QByteArray id = record.id();
+        const QByteArray payload = record.payload();
+
+        const qsizetype payloadSize = payload.size();
+        const bool chunked = m_chunkSize > 0 && payloadSize > m_chunkSize;
+
+        qsizetype offset = 0;
+        do {
+            const bool first = offset == 0;
+            const qsizetype size = chunked ? qMin(m_chunkSize, payloadSize - offset) : payloadSize;
+            const bool last = offset + size == payloadSize;
+            const bool hasId = first && !id.isEmpty();
+
+            quint8 flags = first ? quint8(record.typeNameFormat()) : TnfUnchanged;
+            if (i == 0 && first)
+                flags |= MessageBegin;
+            if (i == recordCount - 1 && last)
+                flags |= MessageEnd;
+            if (!last)
+                flags |= ChunkFlag;
+            if (size < 255)
+                flags |= ShortRecord;
+            if (hasId)
+                flags |= IdLengthPresent;
+
+            char header[7];
+            qsizetype headerSize = 0;
+            header[headerSize++] = char(flags);
+            header[headerSize++] = first ? char(type.size()) : '\0';
+            if (flags & ShortRecord) {
+                header[headerSize++] = char(size);
+            } else {
+                qToBigEndian<quint32>(size, header + headerSize);
+                headerSize += 4;
+            }
+            if (hasId)
+                header[headerSize++] = char(id.size());
+
+            sink(QByteArrayView(header, headerSize));
+            if (first) {
+                sink(type);
+                if (hasId)
+                    sink(id);
+            }
+            sink(QByteArrayView(payload).sliced(offset, size));
+
+            offset += size;
+        } while (offset < payloadSize);
+    }
+}
+
+/*
+    Returns the exact size of the encoded message.
+*/
+qsizetype QNdefMessageWriter::encodedSize() const
+{
+    qsizetype size = 0;
+    auto counter = [&size](QByteArrayView data) { size += data.size(); };
+    serialize(counter);
+    return size;
+}
+
+qsizetype QNdefMessageWriter::write(char *buffer, qsizetype size) const
+{
+    const qsizetype required = encodedSize();
+    if (size < required)
+        return -1;
+
+    writeUnchecked(buffer);
+    return required;
+}
+
+/*
+    Writes the encoded message to buffer, which must hold at least
+    encodedSize() bytes.
+*/
+void QNdefMessageWriter::writeUnchecked(char *buffer) const
+{
+    char *out = buffer;
+    auto copier = [&out](QByteArrayView data) {
+        if (!data.isEmpty()) {
+            std::memcpy(out, data.data(), data.size());
+            out += data.size();
+        }
+    };
+    serialize(copier);
+}
+
+/*
+    Writes the encoded message to the device. Returns \c false if the device
+    fails to accept all of the data.
+*/
+bool QNdefMessageWriter::write(QIODevice *device) const
+{
+    Q_ASSERT(device);
+
+    bool ok = true;
+    auto writer = [device, &ok](QByteArrayView data) {
+        if (ok && !data.isEmpty())
+            ok = device->write(data.data(), data.size()) == data.size();
+    };
+    serialize(writer);
+    return ok;
+}
+
+QByteArray QNdefMessageWriter::toByteArray() const
+{
+    // The size is already known, so the message is only serialized twice
+    QByteArray result(encodedSize(), Qt::Uninitialized);
+    writeUnchecked(result.data());
+    return result;
+}
+
+QNdefMessageReader::Status QNdefMessageReader::fail()
+{
+    m_status = Status::Error;
+    m_message.clear();
+    return m_status;
+}
+
+bool QNdefMessageReader::checkFlags()
+{
+    const quint8 flags = m_header[0];
+    const bool messageBegin = flags & MessageBegin;
+    const bool messageEnd = flags & MessageEnd;
+    const quint8 typeNameFormat = flags & 0x07;
+
+    if (messageBegin && m_seenMessageBegin) {
+        qWarning("Got message begin but already parsed some records");
+        return false;
+    } else if (!messageBegin && !m_seenMessageBegin) {
+        qWarning("Haven't got message begin yet");
+        return false;
+    }
+    m_seenMessageBegin = true;
+
+    if (messageEnd && m_seenMessageEnd) {
+        qWarning("Got message end but already parsed final record");
+        return false;
+    }
+    m_seenMessageEnd = m_seenMessageEnd || messageEnd;
+
+    if (typeNameFormat != TnfUnchanged && m_inChunkedRecord) {
+        qWarning("Partial chunk not empty, but TNF not 0x06 as expected");
+        return false;
+    }
+
+    m_headerExpected = 2 + ((flags & ShortRecord) ? 1 : 4) + ((flags & IdLengthPresent) ? 1 : 0);
+    return true;
+}
+
+bool QNdefMessageReader::startChunk()
+{
+    // Memory reserved ahead of the data, limited in case the length is corrupted
+    static constexpr qsizetype MaxReserve = 16 * 1024 * 1024;
+
+    const quint8 flags = m_header[0];
+    const quint8 typeNameFormat = flags & 0x07;
+    const quint8 typeLength = m_header[1];
+
+    if (typeNameFormat == TnfUnchanged && typeLength != 0) {
+        qWarning("Invalid chunked data, TYPE_LENGTH != 0");
+        return false;
+    }
+    if (typeNameFormat == TnfUnchanged && (flags & IdLengthPresent)) {
+        qWarning("Invalid chunked data, IL != 0");
+        return false;
+    }
+
+    quint32 payloadLength;
+    if (flags & ShortRecord)
+        payloadLength = quint8(m_header[2]);
+    else
+        payloadLength = qFromBigEndian<quint32>(m_header + 2);
+
+    const qsizetype convertedPayloadLength = static_cast<qsizetype>(payloadLength);
+    if (convertedPayloadLength < 0
+        || std::numeric_limits<qsizetype>::max() - m_payload.size() < convertedPayloadLength) {
+        qWarning("Payload can't fit into QByteArray");
+        return false;
+    }
+
+    m_typeRemaining = typeLength;
+    m_idRemaining = (flags & IdLengthPresent) ? quint8(m_header[m_headerExpected - 1]) : 0;
+    m_payloadRemaining = convertedPayloadLength;
+
+    if (!m_inChunkedRecord) {
+        // A lone record with TNF Unchanged is handled as an empty record
+        m_record = QNdefRecord();
+        if (typeNameFormat != TnfUnchanged)
+            m_record.setTypeNameFormat(QNdefRecord::TypeNameFormat(typeNameFormat));
+    }
+    // Grow geometrically, many small chunks must not reallocate each time
+    const qsizetype required = m_payload.size() + qMin(convertedPayloadLength, MaxReserve);
+    if (required > m_payload.capacity())
+        m_payload.reserve(qMax(required, 2 * m_payload.capacity()));
+
+    return true;
+}
+
+/*
+    Moves to the next stage that still needs data, finishing the chunk if
+    all of it has arrived.
+*/
+void QNdefMessageReader::advance()
+{
+    if (m_stage == Stage::Header)
+        m_stage = Stage::Type;
+    if (m_stage == Stage::Type && m_typeRemaining == 0) {
+        if (!m_type.isEmpty())
+            m_record.setType(std::exchange(m_type, {}));
+        m_stage = Stage::Id;
+    }
+    if (m_stage == Stage::Id && m_idRemaining == 0) {
+        if (!m_id.isEmpty())
+            m_record.setId(std::exchange(m_id, {}));
+        m_stage = Stage::Payload;
+    }
+    if (m_stage == Stage::Payload && m_payloadRemaining == 0)
+        finishChunk();
+}
+
+void QNdefMessageReader::finishChunk()
+{
+    const quint8 flags = m_header[0];
+
+    m_stage = Stage::Header;
+    m_headerSize = 0;
+    m_inChunkedRecord = flags & ChunkFlag;
+    if (m_inChunkedRecord)
+        return;
+
+    if (!m_payload.isEmpty())
+        m_record.setPayload(std::exchange(m_payload, {}));
+    m_message.append(std::exchange(m_record, {}));
+
+    if (m_seenMessageEnd)
+        m_status = Status::Complete;
+}
+
+QNdefMessageReader::Status QNdefMessageReader::addData(QByteArrayView data)
+{
+    qsizetype pos = 0;
+    while (m_status == Status::NeedMoreData && pos < data.size()) {
+        switch (m_stage) {
+        case Stage::Header:
+            m_header[m_headerSize++] = data.at(pos++);
+            if (m_headerSize == 1 && !checkFlags())
+                return fail();
+            if (m_headerSize == m_headerExpected) {
+                if (!startChunk())
+                    return fail();
+                advance();
+            }
+            break;
+        case Stage::Type: {
+            const qsizetype size = qMin(m_typeRemaining, data.size() - pos);
+            m_type.append(data.sliced(pos, size));
+            pos += size;
+            m_typeRemaining -= size;
+            advance();
+            break;
+        }
+        case Stage::Id: {
+            const qsizetype size = qMin(m_idRemaining, data.size() - pos);
+            m_id.append(data.sliced(pos, size));
+            pos += size;
+            m_idRemaining -= size;
+            advance();
+            break;
+        }
+        case Stage::Payload: {
+            const qsizetype size = qMin(m_payloadRemaining, data.size() - pos);
+            m_payload.append(data.sliced(pos, size));
+            pos += size;
+            m_payloadRemaining -= size;
+            advance();
+            break;
+        }
+        }
+    }
+    return m_status;
+}
+
+QNdefMessage QNdefMessageReader::takeMessage()
+{
+    if (m_status != Status::Complete)
+        return {};
+    return std::exchange(m_message, {});
+}
+
+void QNdefMessageReader::reset()
+{
+    *this = QNdefMessageReader();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,113 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNDEFMESSAGEWRITER_P_H
+#define QNDEFMESSAGEWRITER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNfc/qndefmessage.h>
+#include <QtNfc/qndefrecord.h>
+
+#include <QtCore/QByteArrayView>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+/*
+    Serializes an NDEF message without building intermediate byte arrays.
+
+    The payloads of records are written as they are stored in the records.
+    If a chunk size is set, payloads larger than it are split into chunked
+    records.
+*/
+class Q_NFC_EXPORT QNdefMessageWriter
+{
+public:
+    explicit QNdefMessageWriter(const QNdefMessage &message);
+
+    // Zero disables chunking
+    void setChunkSize(qsizetype chunkSize) { m_chunkSize = chunkSize; }
+    qsizetype chunkSize() const { return m_chunkSize; }
+
+    qsizetype encodedSize() const;
+
+    // Returns the number of bytes written, or -1 if the buffer is too small
+    qsizetype write(char *buffer, qsizetype size) const;
+    bool write(QIODevice *device) const;
+    QByteArray toByteArray() const;
+
+private:
+    template <typename Sink>
+    void serialize(Sink &sink) const;
+    void writeUnchecked(char *buffer) const;
+
+    QNdefMessage m_message;
+    qsizetype m_chunkSize = 0;
+};
+
+/*
+    Parses an NDEF message from data arriving in pieces.
+
+    The data is not required to be kept by the caller: the header of the
+    chunk being parsed, the type, ID and payload of the record being parsed
+    (including all chunks of a chunked payload) and all completed records
+    are buffered until the message is taken.
+*/
+class Q_NFC_EXPORT QNdefMessageReader
+{
+public:
+    enum class Status { NeedMoreData, Complete, Error };
+
+    // Data after the end of the message is ignored
+    Status addData(QByteArrayView data);
+    Status status() const { return m_status; }
+
+    // The message once the status is Complete
+    QNdefMessage takeMessage();
+    void reset();
+
+private:
+    enum class Stage { Header, Type, Id, Payload };
+
+    bool checkFlags();
+    bool startChunk();
+    void advance();
+    void finishChunk();
+    Status fail();
+
+    Status m_status = Status::NeedMoreData;
+    Stage m_stage = Stage::Header;
+
+    bool m_seenMessageBegin = false;
+    bool m_seenMessageEnd = false;
+    bool m_inChunkedRecord = false;
+
+    char m_header[7];
+    qsizetype m_headerSize = 0;
+    qsizetype m_headerExpected = 0;
+
+    qsizetype m_typeRemaining = 0;
+    qsizetype m_idRemaining = 0;
+    qsizetype m_payloadRemaining = 0;
+
+    QNdefRecord m_record;
+    QByteArray m_type;
+    QByteArray m_id;
+    QByteArray m_payload;
+    QNdefMessage m_message;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNDEFMESSAGEWRITER_P_H
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include <qndefnfcsmartposterrecord.h>
+#include "qndefmessageview_p.h"
 #include "qndefnfcsmartposterrecord_p.h"
 #include <qndefmessage.h>
 
@@ -9,6 +10,8 @@
 #include <QtCore/QStringList>
 #include <QtCore/QUrl>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -93,8 +96,10 @@ QNdefNfcSmartPosterRecord::QNdefNfcSmartPosterRecord(const QNdefNfcSmartPosterRe
 */
 QNdefNfcSmartPosterRecord &QNdefNfcSmartPosterRecord::operator=(const QNdefNfcSmartPosterRecord &other)
 {
-    if (this != &other)
+    if (this != &other) {
+        QNdefRecord::operator=(other);
         d = other.d;
+    }
 
     return *this;
 }
@@ -111,11 +116,11 @@ void QNdefNfcSmartPosterRecord::cleanup()
     if (d) {
         // Clean-up existing internal structure
         d->m_titleList.clear();
-        if (d->m_uri) delete d->m_uri;
-        if (d->m_action) delete d->m_action;
+        d->m_uri.reset();
+        d->m_action.reset();
         d->m_iconList.clear();
-        if (d->m_size) delete d->m_size;
-        if (d->m_type) delete d->m_type;
+        d->m_size.reset();
+        d->m_type.reset();
     }
 }
 
@@ -131,7 +136,7 @@ void QNdefNfcSmartPosterRecord::setPayload(const QByteArray &payload)
 
     if (!payload.isEmpty()) {
         // Create new structure
-        const QNdefMessage message = QNdefMessage::fromByteArray(payload);
+        const QNdefMessage message = QNdefMessageView(payload).toMessage();
 
         // Iterate through all the records contained in the payload's message.
         for (const QNdefRecord& record : message) {
@@ -142,12 +147,12 @@ void QNdefNfcSmartPosterRecord::setPayload(const QByteArray &payload)
 
             // URI
             else if (record.isRecordType<QNdefNfcUriRecord>()) {
-                d->m_uri = new QNdefNfcUriRecord(record);
+                d->m_uri = QNdefNfcUriRecord(record);
             }
 
             // Action
             else if (record.isRecordType<QNdefNfcActRecord>()) {
-                d->m_action = new QNdefNfcActRecord(record);
+                d->m_action = QNdefNfcActRecord(record);
             }
 
             // Icon
@@ -157,46 +162,92 @@ void QNdefNfcSmartPosterRecord::setPayload(const QByteArray &payload)
 
             // Size
             else if (record.isRecordType<QNdefNfcSizeRecord>()) {
-                d->m_size = new QNdefNfcSizeRecord(record);
+                d->m_size = QNdefNfcSizeRecord(record);
             }
 
             // Type
             else if (record.isRecordType<QNdefNfcTypeRecord>()) {
-                d->m_type = new QNdefNfcTypeRecord(record);
+                d->m_type = QNdefNfcTypeRecord(record);
             }
         }
     }
 }
 
-void QNdefNfcSmartPosterRecord::convertToPayload()
+QNdefNfcSmartPosterRecordPrivate::QNdefNfcSmartPosterRecordPrivate(
+        const QNdefNfcSmartPosterRecordPrivate &other)
+    : QNdefRecordPayloadSource(other),
+      m_titleList(other.m_titleList),
+      m_uri(other.m_uri),
+      m_action(other.m_action),
+      m_iconList(other.m_iconList),
+      m_size(other.m_size),
+      m_type(other.m_type)
 {
+    // The copy is made to be modified, the cached payload is not needed
+}
+
+QByteArray QNdefNfcSmartPosterRecordPrivate::payload() const
+{
+    QMutexLocker locker(&m_payloadMutex);
+    if (m_payloadValid)
+        return m_payload;
+
     QNdefMessage message;
+    message.reserve(m_titleList.size() + m_iconList.size() + 4);
 
     // Title
-    for (qsizetype t = 0; t < titleCount(); t++)
-        message.append(titleRecord(t));
+    for (const QNdefNfcTextRecord &title : m_titleList)
+        message.append(title);
 
     // URI
-    if (d->m_uri)
-        message.append(*(d->m_uri));
+    if (m_uri)
+        message.append(*m_uri);
 
     // Action
-    if (d->m_action)
-        message.append(*(d->m_action));
+    if (m_action)
+        message.append(*m_action);
 
     // Icon
-    for (qsizetype i = 0; i < iconCount(); i++)
-        message.append(iconRecord(i));
+    for (const QNdefNfcIconRecord &icon : m_iconList)
+        message.append(icon);
 
     // Size
-    if (d->m_size)
-        message.append(*(d->m_size));
+    if (m_size)
+        message.append(*m_size);
 
     // Type
-    if (d->m_type)
-        message.append(*(d->m_type));
+    if (m_type)
+        message.append(*m_type);
+
+    m_payload = message.toByteArray();
+    m_payloadValid = true;
+    return m_payload;
+}
+
+void QNdefNfcSmartPosterRecordPrivate::invalidatePayload()
+{
+    QMutexLocker locker(&m_payloadMutex);
+    m_payloadValid = false;
+    m_payload.clear();
+}
+
+/*
+    Drops the reference the payload holds to the records before they are
+    modified, so that they are only copied if other smart posters share them.
+*/
+void QNdefNfcSmartPosterRecord::releasePayload()
+{
+    QNdefRecordPrivate::setPayloadSource(this, nullptr);
+}
 
-    QNdefRecord::setPayload(message.toByteArray());
+/*
+    Makes the records the source of the payload after they are modified. The
+    payload is serialized when it is requested, rather than on each change.
+*/
+void QNdefNfcSmartPosterRecord::convertToPayload()
+{
+    d->invalidatePayload();
+    QNdefRecordPrivate::setPayloadSource(this, d.data());
 }
 
 /*!
@@ -315,13 +366,16 @@ QList<QNdefNfcTextRecord> QNdefNfcSmartPosterRecord::titleRecords() const
  */
 bool QNdefNfcSmartPosterRecord::addTitle(const QNdefNfcTextRecord &text)
 {
-    const bool status = addTitleInternal(text);
+    for (const QNdefNfcTextRecord &rec : std::as_const(d)->m_titleList) {
+        if (rec.locale() == text.locale())
+            return false;
+    }
 
-    // Convert to payload if the title is added
-    if (status)
-        convertToPayload();
+    releasePayload();
+    d->m_titleList.append(text);
+    convertToPayload();
 
-    return status;
+    return true;
 }
 
 bool QNdefNfcSmartPosterRecord::addTitleInternal(const QNdefNfcTextRecord &text)
@@ -359,23 +413,20 @@ bool QNdefNfcSmartPosterRecord::addTitle(const QString &text, const QString &loc
  */
 bool QNdefNfcSmartPosterRecord::removeTitle(const QNdefNfcTextRecord &text)
 {
-    bool status = false;
-
-    for (qsizetype i = 0; i < d->m_titleList.size(); ++i) {
-        const QNdefNfcTextRecord &rec = d->m_titleList[i];
+    const QList<QNdefNfcTextRecord> &titles = std::as_const(d)->m_titleList;
+    for (qsizetype i = 0; i < titles.size(); ++i) {
+        const QNdefNfcTextRecord &rec = titles[i];
 
         if (rec.text() == text.text() && rec.locale() == text.locale() && rec.encoding() == text.encoding()) {
+            // Convert to payload as the title list has changed
+            releasePayload();
             d->m_titleList.removeAt(i);
-            status = true;
-            break;
+            convertToPayload();
+            return true;
         }
     }
 
-    // Convert to payload if the title list has changed
-    if (status)
-        convertToPayload();
-
-    return status;
+    return false;
 }
 
 /*!
@@ -385,23 +436,20 @@ bool QNdefNfcSmartPosterRecord::removeTitle(const QNdefNfcTextRecord &text)
  */
 bool QNdefNfcSmartPosterRecord::removeTitle(const QString &locale)
 {
-    bool status = false;
-
-    for (qsizetype i = 0; i < d->m_titleList.size(); ++i) {
-        const QNdefNfcTextRecord &rec = d->m_titleList[i];
+    const QList<QNdefNfcTextRecord> &titles = std::as_const(d)->m_titleList;
+    for (qsizetype i = 0; i < titles.size(); ++i) {
+        const QNdefNfcTextRecord &rec = titles[i];
 
         if (rec.locale() == locale) {
+            // Convert to payload as the title list has changed
+            releasePayload();
             d->m_titleList.removeAt(i);
-            status = true;
-            break;
+            convertToPayload();
+            return true;
         }
     }
 
-    // Convert to payload if the title list has changed
-    if (status)
-        convertToPayload();
-
-    return status;
+    return false;
 }
 
 /*!
@@ -409,11 +457,8 @@ bool QNdefNfcSmartPosterRecord::removeTitle(const QString &locale)
  */
 void QNdefNfcSmartPosterRecord::setTitles(const QList<QNdefNfcTextRecord> &titles)
 {
-    d->m_titleList.clear();
-
-    for (qsizetype i = 0; i < titles.size(); ++i) {
-        d->m_titleList.append(titles[i]);
-    }
+    releasePayload();
+    d->m_titleList = titles;
 
     // Convert to payload
     convertToPayload();
@@ -446,10 +491,8 @@ QNdefNfcUriRecord QNdefNfcSmartPosterRecord::uriRecord() const
  */
 void QNdefNfcSmartPosterRecord::setUri(const QNdefNfcUriRecord &url)
 {
-    if (d->m_uri)
-        delete d->m_uri;
-
-    d->m_uri = new QNdefNfcUriRecord(url);
+    releasePayload();
+    d->m_uri = url;
 
     // Convert to payload
     convertToPayload();
@@ -482,8 +525,9 @@ QNdefNfcSmartPosterRecord::Action QNdefNfcSmartPosterRecord::action() const
  */
 void QNdefNfcSmartPosterRecord::setAction(Action act)
 {
+    releasePayload();
     if (!d->m_action)
-        d->m_action = new QNdefNfcActRecord();
+        d->m_action.emplace();
 
     d->m_action->setAction(act);
 
@@ -542,6 +586,7 @@ QList<QNdefNfcIconRecord> QNdefNfcSmartPosterRecord::iconRecords() const
  */
 void QNdefNfcSmartPosterRecord::addIcon(const QNdefNfcIconRecord &icon)
 {
+    releasePayload();
     addIconInternal(icon);
 
     // Convert to payload
@@ -580,23 +625,20 @@ void QNdefNfcSmartPosterRecord::addIcon(const QByteArray &type, const QByteArray
  */
 bool QNdefNfcSmartPosterRecord::removeIcon(const QNdefNfcIconRecord &icon)
 {
-    bool status = false;
-
-    for (qsizetype i = 0; i < d->m_iconList.size(); ++i) {
-        const QNdefNfcIconRecord &rec = d->m_iconList[i];
+    const QList<QNdefNfcIconRecord> &icons = std::as_const(d)->m_iconList;
+    for (qsizetype i = 0; i < icons.size(); ++i) {
+        const QNdefNfcIconRecord &rec = icons[i];
 
         if (rec.type() == icon.type() && rec.data() == icon.data()) {
+            // Convert to payload as the icon list has changed
+            releasePayload();
             d->m_iconList.removeAt(i);
-            status = true;
-            break;
+            convertToPayload();
+            return true;
         }
     }
 
-    // Convert to payload if the icon list has changed
-    if (status)
-        convertToPayload();
-
-    return status;
+    return false;
 }
 
 /*!
@@ -606,23 +648,20 @@ bool QNdefNfcSmartPosterRecord::removeIcon(const QNdefNfcIconRecord &icon)
  */
 bool QNdefNfcSmartPosterRecord::removeIcon(const QByteArray &type)
 {
-    bool status = false;
-
-    for (qsizetype i = 0; i < d->m_iconList.size(); ++i) {
-        const QNdefNfcIconRecord &rec = d->m_iconList[i];
+    const QList<QNdefNfcIconRecord> &icons = std::as_const(d)->m_iconList;
+    for (qsizetype i = 0; i < icons.size(); ++i) {
+        const QNdefNfcIconRecord &rec = icons[i];
 
         if (rec.type() == type) {
+            // Convert to payload as the icon list has changed
+            releasePayload();
             d->m_iconList.removeAt(i);
-            status = true;
-            break;
+            convertToPayload();
+            return true;
         }
     }
 
-    // Convert to payload if the icon list has changed
-    if (status)
-        convertToPayload();
-
-    return status;
+    return false;
 }
 
 /*!
@@ -633,11 +672,8 @@ bool QNdefNfcSmartPosterRecord::removeIcon(const QByteArray &type)
  */
 void QNdefNfcSmartPosterRecord::setIcons(const QList<QNdefNfcIconRecord> &icons)
 {
-    d->m_iconList.clear();
-
-    for (qsizetype i = 0; i < icons.size(); ++i) {
-        d->m_iconList.append(icons[i]);
-    }
+    releasePayload();
+    d->m_iconList = icons;
 
     // Convert to payload
     convertToPayload();
@@ -668,8 +704,9 @@ quint32 QNdefNfcSmartPosterRecord::size() const
  */
 void QNdefNfcSmartPosterRecord::setSize(quint32 size)
 {
+    releasePayload();
     if (!d->m_size)
-        d->m_size = new QNdefNfcSizeRecord();
+        d->m_size.emplace();
 
     d->m_size->setSize(size);
 
@@ -701,10 +738,8 @@ QString QNdefNfcSmartPosterRecord::typeInfo() const
  */
 void QNdefNfcSmartPosterRecord::setTypeInfo(const QString &type)
 {
-    if (d->m_type)
-        delete d->m_type;
-
-    d->m_type = new QNdefNfcTypeRecord();
+    releasePayload();
+    d->m_type.emplace();
     d->m_type->setTypeInfo(type);
 
     // Convert to payload
@@ -103,6 +103,7 @@ private:
     QSharedDataPointer<QNdefNfcSmartPosterRecordPrivate> d;
 
     void cleanup();
+    void releasePayload();
     void convertToPayload();
 
     bool addTitleInternal(const QNdefNfcTextRecord &text);
@@ -15,6 +15,12 @@
 // We mean it.
 //
 
+#include "qndefrecord_p.h"
+
+#include <QtCore/QMutex>
+
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 class QNdefNfcActRecord : public QNdefRecord
@@ -44,18 +50,32 @@ public:
     QString typeInfo() const;
 };
 
-class QNdefNfcSmartPosterRecordPrivate : public QSharedData
+/*
+    The records of a smart poster. The private is also the payload source of
+    the record after it has been modified, the payload is serialized from the
+    records on first use and cached until the next modification.
+*/
+class QNdefNfcSmartPosterRecordPrivate : public QNdefRecordPayloadSource
 {
 public:
     QNdefNfcSmartPosterRecordPrivate() {}
+    QNdefNfcSmartPosterRecordPrivate(const QNdefNfcSmartPosterRecordPrivate &other);
+
+    QByteArray payload() const override;
+    void invalidatePayload();
 
 public:
     QList<QNdefNfcTextRecord> m_titleList;
-    QNdefNfcUriRecord *m_uri = nullptr;
-    QNdefNfcActRecord *m_action = nullptr;
+    std::optional<QNdefNfcUriRecord> m_uri;
+    std::optional<QNdefNfcActRecord> m_action;
     QList<QNdefNfcIconRecord> m_iconList;
-    QNdefNfcSizeRecord *m_size = nullptr;
-    QNdefNfcTypeRecord *m_type = nullptr;
+    std::optional<QNdefNfcSizeRecord> m_size;
+    std::optional<QNdefNfcTypeRecord> m_type;
+
+private:
+    mutable QMutex m_payloadMutex;
+    mutable QByteArray m_payload;
+    mutable bool m_payloadValid = false;
 };
 
 QT_END_NAMESPACE
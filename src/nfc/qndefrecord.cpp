@@ -279,6 +279,7 @@ void QNdefRecord::setPayload(const QByteArray &payload)
         d = new QNdefRecordPrivate;
 
     d->payload = payload;
+    d->payloadSource.reset();
 }
 
 /*!
@@ -289,7 +290,7 @@ QByteArray QNdefRecord::payload() const
     if (!d)
         return QByteArray();
 
-    return d->payload;
+    return d->currentPayload();
 }
 
 /*!
@@ -303,7 +304,7 @@ bool QNdefRecord::isEmpty() const
     if (!d)
         return true;
 
-    return d->payload.isEmpty();
+    return d->currentPayload().isEmpty();
 }
 
 /*!
@@ -327,7 +328,9 @@ bool QNdefRecord::operator==(const QNdefRecord &other) const
     if (d->id != other.d->id)
         return false;
 
-    if (d->payload != other.d->payload)
+    // Records sharing a payload source have the same payload
+    const bool sameSource = d->payloadSource && d->payloadSource == other.d->payloadSource;
+    if (!sameSource && d->currentPayload() != other.d->currentPayload())
         return false;
 
     return true;
@@ -348,7 +351,20 @@ void QNdefRecord::clear()
         d->type.clear();
         d->id.clear();
         d->payload.clear();
+        d->payloadSource.reset();
     }
 }
 
+QNdefRecordPayloadSource::~QNdefRecordPayloadSource() = default;
+
+void QNdefRecordPrivate::setPayloadSource(QNdefRecord *record,
+                                          const QNdefRecordPayloadSource *source)
+{
+    if (!record->d)
+        record->d = new QNdefRecordPrivate;
+
+    record->d->payload.clear();
+    record->d->payloadSource.reset(source);
+}
+
 QT_END_NAMESPACE
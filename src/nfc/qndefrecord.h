@@ -62,6 +62,8 @@ protected:
     QNdefRecord(TypeNameFormat typeNameFormat, const QByteArray &type);
 
 private:
+    friend class QNdefRecordPrivate;
+
     QSharedDataPointer<QNdefRecordPrivate> d;
 };
 
@@ -22,6 +22,21 @@
 
 QT_BEGIN_NAMESPACE
 
+class QNdefRecord;
+
+/*
+    Creates the payload of a record that keeps its content in a structured
+    form, like the smart poster. The payload is only created when it is
+    needed. Copies of the record share the source, so creating the payload
+    must be thread-safe.
+*/
+class QNdefRecordPayloadSource : public QSharedData
+{
+public:
+    virtual ~QNdefRecordPayloadSource();
+    virtual QByteArray payload() const = 0;
+};
+
 class QNdefRecordPrivate : public QSharedData
 {
 public:
@@ -30,11 +45,18 @@ public:
         typeNameFormat = 0; //TypeNameFormat::Empty
     }
 
+    QByteArray currentPayload() const { return payloadSource ? payloadSource->payload() : payload; }
+
+    // Replaces the payload of record with source
+    static void setPayloadSource(QNdefRecord *record, const QNdefRecordPayloadSource *source);
+
     unsigned int typeNameFormat : 3;
 
     QByteArray type;
     QByteArray id;
     QByteArray payload;
+    // The payload is unused while a source is set
+    QExplicitlySharedDataPointer<const QNdefRecordPayloadSource> payloadSource;
 };
 
 QT_END_NAMESPACE
@@ -18,8 +18,14 @@
 #include "qnearfieldmanager_generic_p.h"
 #endif
 
+#include "qndefmessage.h"
+
 #include <QtCore/QMetaType>
 #include <QtCore/QMetaMethod>
+#include <QtCore/QThread>
+#include <QtCore/QVarLengthArray>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -123,6 +129,166 @@ QT_BEGIN_NAMESPACE
     \sa QNearFieldTarget::disconnected()
 */
 
+int QNdefMessageHandlerRegistry::registerHandler(const QNdefFilter &filter,
+                                                 const QObject *receiver,
+                                                 QtPrivate::QSlotObjectBase *slotObj)
+{
+    if (!slotObj)
+        return -1;
+    if (!receiver) {
+        slotObj->destroyIfLastRef();
+        return -1;
+    }
+
+    // the slot object is shared by the copies of the handler list and by
+    // the calls queued to other threads
+    const std::shared_ptr<QtPrivate::QSlotObjectBase> slot(
+            slotObj, [](QtPrivate::QSlotObjectBase *slotObj) { slotObj->destroyIfLastRef(); });
+
+    const int id = m_nextId++;
+    m_handlers.append(Handler{ id, filter, receiver, slot });
+    rebuildIndex();
+    return id;
+}
+
+bool QNdefMessageHandlerRegistry::unregisterHandler(int handlerId)
+{
+    const auto removed = m_handlers.removeIf([handlerId](const Handler &handler) {
+        return handler.id == handlerId;
+    });
+    if (!removed)
+        return false;
+
+    rebuildIndex();
+    return true;
+}
+
+void QNdefMessageHandlerRegistry::rebuildIndex()
+{
+    m_index.clear();
+    m_counterCount = 0;
+
+    for (qsizetype i = 0; i < m_handlers.size(); ++i) {
+        Handler &handler = m_handlers[i];
+        const QNdefFilterPrivate *filter = QNdefFilterPrivate::get(handler.filter);
+        if (filter->orderMatching)
+            continue;
+
+        handler.counterOffset = m_counterCount;
+        for (auto it = filter->recordIndex.cbegin(); it != filter->recordIndex.cend(); ++it)
+            m_index[it.key()].append(IndexEntry{ i, it.value() });
+        m_counterCount += filter->compiledRecords.size();
+    }
+}
+
+/*!
+    \internal
+
+    Returns the ids of the handlers whose filter matches \a message, in
+    registration order. The result is the same as calling QNdefFilter::match()
+    for each handler, but the records of \a message are looked up only once.
+*/
+QList<int> QNdefMessageHandlerRegistry::match(const QNdefMessage &message) const
+{
+    QList<int> matched;
+    if (m_handlers.isEmpty())
+        return matched;
+
+    // occurrences of each compiled record of all unordered filters
+    QVarLengthArray<unsigned int, 64> counts(m_counterCount, 0);
+    // the number of message records covered by each filter, and the last
+    // record counted for it so that an empty type only acts as a fallback
+    QVarLengthArray<qsizetype, 16> covered(m_handlers.size(), 0);
+    QVarLengthArray<qsizetype, 16> lastRecord(m_handlers.size(), -1);
+
+    qsizetype recordNumber = 0;
+    const auto countRecord = [&](const QNdefRecordTypeKey &key) {
+        const auto it = m_index.constFind(key);
+        if (it == m_index.cend())
+            return;
+        for (const IndexEntry &entry : it.value()) {
+            if (lastRecord[entry.handler] == recordNumber)
+                continue;
+            lastRecord[entry.handler] = recordNumber;
+            ++covered[entry.handler];
+            ++counts[m_handlers.at(entry.handler).counterOffset + entry.record];
+        }
+    };
+
+    for (const QNdefRecord &record : message) {
+        const QByteArray type = record.type();
+        countRecord(QNdefRecordTypeKey{ record.typeNameFormat(), type });
+        if (!type.isEmpty())
+            countRecord(QNdefRecordTypeKey{ record.typeNameFormat(), QByteArray() });
+        ++recordNumber;
+    }
+
+    for (qsizetype i = 0; i < m_handlers.size(); ++i) {
+        const Handler &handler = m_handlers.at(i);
+        const QNdefFilterPrivate *filter = QNdefFilterPrivate::get(handler.filter);
+
+        bool ok;
+        if (filter->orderMatching || filter->compiledRecords.isEmpty()) {
+            ok = filter->match(message);
+        } else {
+            ok = covered[i] == message.size();
+            for (qsizetype r = 0; ok && r < filter->compiledRecords.size(); ++r) {
+                const QNdefFilter::Record &rec = filter->compiledRecords.at(r);
+                const unsigned int count = counts[handler.counterOffset + r];
+                ok = count >= rec.minimum && count <= rec.maximum;
+            }
+        }
+        if (ok)
+            matched.append(handler.id);
+    }
+
+    return matched;
+}
+
+void QNdefMessageHandlerRegistry::dispatch(const QNdefMessage &message, QNearFieldTarget *target)
+{
+    const QList<int> matched = match(message);
+    for (int id : matched) {
+        // a handler may unregister itself or others while being called
+        const auto it = std::find_if(m_handlers.cbegin(), m_handlers.cend(),
+                                     [id](const Handler &handler) { return handler.id == id; });
+        if (it == m_handlers.cend())
+            continue;
+
+        const QPointer<const QObject> receiver = it->receiver;
+        const std::shared_ptr<QtPrivate::QSlotObjectBase> slotObj = it->slotObj;
+        if (!receiver)
+            continue;
+
+        QObject *context = const_cast<QObject *>(receiver.data());
+        if (context->thread() == QThread::currentThread()) {
+            void *args[] = { nullptr, const_cast<QNdefMessage *>(&message), &target };
+            slotObj->call(context, args);
+        } else {
+            // like a queued connection, the call is dropped if the
+            // receiver is destroyed before its thread gets to it
+            QMetaObject::invokeMethod(context, [context, slotObj, message, target]() mutable {
+                void *args[] = { nullptr, &message, &target };
+                slotObj->call(context, args);
+            }, Qt::QueuedConnection);
+        }
+    }
+}
+
+void QNearFieldManagerPrivate::watchNdefMessages(QNearFieldTarget *target)
+{
+    connect(target, &QNearFieldTarget::ndefMessageRead,
+            this, &QNearFieldManagerPrivate::dispatchNdefMessage, Qt::UniqueConnection);
+}
+
+void QNearFieldManagerPrivate::dispatchNdefMessage(const QNdefMessage &message)
+{
+    if (ndefMessageHandlers.isEmpty())
+        return;
+
+    ndefMessageHandlers.dispatch(message, qobject_cast<QNearFieldTarget *>(sender()));
+}
+
 /*!
     Constructs a new near field manager with \a parent.
 */
@@ -131,6 +297,8 @@ QNearFieldManager::QNearFieldManager(QObject *parent)
 {
     qRegisterMetaType<AdapterState>();
 
+    connect(d_ptr, &QNearFieldManagerPrivate::targetDetected,
+            d_ptr, &QNearFieldManagerPrivate::watchNdefMessages);
     connect(d_ptr, &QNearFieldManagerPrivate::adapterStateChanged,
             this, &QNearFieldManager::adapterStateChanged);
     connect(d_ptr, &QNearFieldManagerPrivate::targetDetectionStopped,
@@ -154,6 +322,8 @@ QNearFieldManager::QNearFieldManager(QNearFieldManagerPrivate *backend, QObject
 {
     qRegisterMetaType<AdapterState>();
 
+    connect(d_ptr, &QNearFieldManagerPrivate::targetDetected,
+            d_ptr, &QNearFieldManagerPrivate::watchNdefMessages);
     connect(d_ptr, &QNearFieldManagerPrivate::adapterStateChanged,
             this, &QNearFieldManager::adapterStateChanged);
     connect(d_ptr, &QNearFieldManagerPrivate::targetDetectionStopped,
@@ -274,6 +444,68 @@ void QNearFieldManager::setUserInformation(const QString &message)
     d->setUserInformation(message);
 }
 
+/*!
+    \fn template <typename Functor> int QNearFieldManager::registerNdefMessageHandler(const QNdefFilter &filter, const QObject *receiver, Functor &&slot)
+    \since 6.10
+
+    Registers \a slot to be called when an NDEF message that matches
+    \a filter has been read from a target detected by this manager. The
+    message is delivered when the application reads it, for example by
+    calling QNearFieldTarget::readNdefMessages().
+
+    \a slot can be a member function of \a receiver, or a functor or lambda
+    with \a receiver as its context object. It must be callable with the
+    arguments \c{(const QNdefMessage &message, QNearFieldTarget *target)},
+    and it is called in the thread of \a receiver. If \a receiver lives in
+    another thread than this manager, the call is queued to that thread the
+    same way as with a Qt::QueuedConnection. The handler is no longer called
+    once \a receiver is destroyed.
+
+    \code
+    manager->registerNdefMessageHandler(filter, this, &Reader::ndefMessageRead);
+    manager->registerNdefMessageHandler(filter, this,
+            [](const QNdefMessage &message, QNearFieldTarget *target) { ... });
+    \endcode
+
+    All registered filters are compiled when they are registered, and a
+    message is matched against all of them with a single pass over its
+    records. Applications that route messages by their content should prefer
+    this to calling QNdefFilter::match() for each of their filters.
+
+    Returns an identifier, which can be used to unregister the handler, on
+    success; otherwise returns -1.
+
+    \sa unregisterNdefMessageHandler(), QNdefFilter
+*/
+
+/*!
+    \internal
+*/
+int QNearFieldManager::registerNdefMessageHandlerImpl(const QNdefFilter &filter,
+                                                      const QObject *receiver,
+                                                      QtPrivate::QSlotObjectBase *slotObj)
+{
+    Q_D(QNearFieldManager);
+
+    return d->ndefMessageHandlers.registerHandler(filter, receiver, slotObj);
+}
+
+/*!
+    \since 6.10
+
+    Unregisters the NDEF message handler with id \a handlerId.
+
+    Returns \c true on success; otherwise returns \c false.
+
+    \sa registerNdefMessageHandler()
+*/
+bool QNearFieldManager::unregisterNdefMessageHandler(int handlerId)
+{
+    Q_D(QNearFieldManager);
+
+    return d->ndefMessageHandlers.unregisterHandler(handlerId);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qnearfieldmanager_p.cpp"
@@ -8,6 +8,7 @@
 #include <QtNfc/qtnfcglobal.h>
 #include <QtNfc/QNearFieldTarget>
 #include <QtNfc/QNdefRecord>
+#include <QtNfc/QNdefMessage>
 #include <QtNfc/QNdefFilter>
 
 QT_BEGIN_NAMESPACE
@@ -41,6 +42,17 @@ public:
 
     void setUserInformation(const QString &message);
 
+    template <typename Functor>
+    int registerNdefMessageHandler(const QNdefFilter &filter,
+                                   const typename QtPrivate::ContextTypeForFunctor<Functor>::ContextType *receiver,
+                                   Functor &&slot)
+    {
+        using Prototype = void (*)(const QNdefMessage &, QNearFieldTarget *);
+        return registerNdefMessageHandlerImpl(
+                filter, receiver, QtPrivate::makeCallableObject<Prototype>(std::forward<Functor>(slot)));
+    }
+    bool unregisterNdefMessageHandler(int handlerId);
+
 Q_SIGNALS:
     void adapterStateChanged(QNearFieldManager::AdapterState state);
     void targetDetectionStopped();
@@ -48,6 +60,9 @@ Q_SIGNALS:
     void targetLost(QNearFieldTarget *target);
 
 private:
+    int registerNdefMessageHandlerImpl(const QNdefFilter &filter, const QObject *receiver,
+                                       QtPrivate::QSlotObjectBase *slotObj);
+
     QNearFieldManagerPrivate *d_ptr;
 };
 
@@ -17,15 +17,60 @@
 
 #include "qnearfieldmanager.h"
 #include "qnearfieldtarget.h"
+#include "qndeffilter_p.h"
 #include "qndefrecord.h"
 
 #include "qtnfcglobal.h"
 
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
+
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
-class QNdefFilter;
+class QNdefMessage;
+
+// Matches a message against all registered filters in a single pass over its
+// records. The unordered filters share one (typeNameFormat, type) index,
+// ordered filters are matched one by one using their compiled form.
+class Q_AUTOTEST_EXPORT QNdefMessageHandlerRegistry
+{
+public:
+    // Takes ownership of slotObj
+    int registerHandler(const QNdefFilter &filter, const QObject *receiver,
+                        QtPrivate::QSlotObjectBase *slotObj);
+    bool unregisterHandler(int handlerId);
+    bool isEmpty() const { return m_handlers.isEmpty(); }
+
+    QList<int> match(const QNdefMessage &message) const;
+    void dispatch(const QNdefMessage &message, QNearFieldTarget *target);
+
+private:
+    struct Handler
+    {
+        int id;
+        QNdefFilter filter;
+        QPointer<const QObject> receiver;
+        std::shared_ptr<QtPrivate::QSlotObjectBase> slotObj;
+        qsizetype counterOffset = 0;
+    };
+
+    struct IndexEntry
+    {
+        qsizetype handler;
+        qsizetype record;
+    };
+
+    void rebuildIndex();
+
+    QList<Handler> m_handlers;
+    QHash<QNdefRecordTypeKey, QList<IndexEntry>> m_index;
+    qsizetype m_counterCount = 0;
+    int m_nextId = 0;
+};
 
 class Q_AUTOTEST_EXPORT QNearFieldManagerPrivate : public QObject
 {
@@ -64,11 +109,18 @@ public:
     {
     }
 
+    void watchNdefMessages(QNearFieldTarget *target);
+
+    QNdefMessageHandlerRegistry ndefMessageHandlers;
+
 signals:
     void adapterStateChanged(QNearFieldManager::AdapterState state);
     void targetDetectionStopped();
     void targetDetected(QNearFieldTarget *target);
     void targetLost(QNearFieldTarget *target);
+
+private:
+    void dispatchNdefMessage(const QNdefMessage &message);
 };
 
 QT_END_NAMESPACE
@@ -19,7 +19,8 @@ Q_DECLARE_LOGGING_CATEGORY(QT_NFC_PCSC)
 
     This object creates a worker thread with an instance of QPcscManager in
     it. All the communication with QPcscManager is done using signal-slot
-    mechanism.
+    mechanism. QPcscManager only tracks the slots, the cards are handled in a
+    separate thread for each slot, and communicate directly with the targets.
 */
 QNearFieldManagerPrivateImpl::QNearFieldManagerPrivateImpl()
 {
@@ -94,18 +95,21 @@ void QNearFieldManagerPrivateImpl::stopTargetDetection(const QString &errorMessa
     emits targetCreatedForCard() signal.
 */
 void QNearFieldManagerPrivateImpl::onCardInserted(QPcscCard *card, const QByteArray &uid,
+                                                  QNearFieldTarget::Type type,
                                                   QNearFieldTarget::AccessMethods accessMethods,
                                                   int maxInputLength)
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
 
-    auto priv = new QNearFieldTargetPrivateImpl(uid, accessMethods, maxInputLength, this);
+    auto priv = new QNearFieldTargetPrivateImpl(uid, type, accessMethods, maxInputLength, this);
 
     connect(priv, &QNearFieldTargetPrivateImpl::disconnectRequest, card,
             &QPcscCard::onDisconnectRequest);
     connect(priv, &QNearFieldTargetPrivateImpl::destroyed, card, &QPcscCard::onTargetDestroyed);
     connect(priv, &QNearFieldTargetPrivateImpl::sendCommandRequest, card,
             &QPcscCard::onSendCommandRequest);
+    connect(priv, &QNearFieldTargetPrivateImpl::sendCommandsRequest, card,
+            &QPcscCard::onSendCommandsRequest);
     connect(priv, &QNearFieldTargetPrivateImpl::readNdefMessagesRequest, card,
             &QPcscCard::onReadNdefMessagesRequest);
     connect(priv, &QNearFieldTargetPrivateImpl::writeNdefMessagesRequest, card,
@@ -37,7 +37,7 @@ public:
     void stopTargetDetection(const QString &errorMessage) override;
 
 public Q_SLOTS:
-    void onCardInserted(QPcscCard *card, const QByteArray &uid,
+    void onCardInserted(QPcscCard *card, const QByteArray &uid, QNearFieldTarget::Type type,
                         QNearFieldTarget::AccessMethods accessMethods, int maxInputLength);
     void onTargetLost(QNearFieldTargetPrivate *target);
 
@@ -364,6 +364,38 @@ QNearFieldTarget::RequestId QNearFieldTarget::sendCommand(const QByteArray &comm
     return d->sendCommand(command);
 }
 
+/*!
+    \since 6.10
+
+    Sends \a commands to the near field target one after another as a single
+    request. Returns a request id which can be used to track the completion
+    status of the request. An invalid request id will be returned if the target
+    does not support sending tag type specific commands in this way.
+
+    The commands are sent without interruption by other applications using the
+    same target. If \a stopStatusWords is not empty, the remaining commands are
+    skipped as soon as a response ends with one of the given ISO/IEC 7816-4
+    status words, such as \c 0x6A82 (file or application not found).
+
+    The requestCompleted() signal will be emitted once for the whole request;
+    the error() signal is emitted if any of the commands could not be sent.
+    The response of this request will be a QList<QByteArray> holding the
+    responses of the commands that have been sent, in order. If a command
+    could not be sent, the remaining commands are skipped and the response
+    holds the responses received before the failure.
+
+    \note This function is currently only supported by the PC/SC backend.
+
+    \sa sendCommand(), requestCompleted(), waitForRequestCompleted()
+*/
+QNearFieldTarget::RequestId QNearFieldTarget::sendCommands(const QList<QByteArray> &commands,
+                                                           const QList<quint16> &stopStatusWords)
+{
+    Q_D(QNearFieldTarget);
+
+    return d->sendCommands(commands, stopStatusWords);
+}
+
 /*!
     Waits up to \a msecs milliseconds for the request \a id to complete.
     Returns \c true if the request completes successfully and the
@@ -102,6 +102,8 @@ public:
     // TagTypeSpecificAccess
     int maxCommandLength() const;
     RequestId sendCommand(const QByteArray &command);
+    RequestId sendCommands(const QList<QByteArray> &commands,
+                           const QList<quint16> &stopStatusWords = {});
 
     bool waitForRequestCompleted(const RequestId &id, int msecs = 5000);
     QVariant requestResponse(const RequestId &id) const;
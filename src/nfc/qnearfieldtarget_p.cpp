@@ -74,6 +74,18 @@ QNearFieldTarget::RequestId QNearFieldTargetPrivate::sendCommand(const QByteArra
     return id;
 }
 
+QNearFieldTarget::RequestId
+QNearFieldTargetPrivate::sendCommands(const QList<QByteArray> &commands,
+                                      const QList<quint16> &stopStatusWords)
+{
+    Q_UNUSED(commands);
+    Q_UNUSED(stopStatusWords);
+
+    const QNearFieldTarget::RequestId id;
+    Q_EMIT error(QNearFieldTarget::UnsupportedError, id);
+    return id;
+}
+
 bool QNearFieldTargetPrivate::waitForRequestCompleted(const QNearFieldTarget::RequestId &id,
                                                       int msecs)
 {
@@ -121,9 +133,10 @@ void QNearFieldTargetPrivate::setResponseForRequest(const QNearFieldTarget::Requ
 }
 
 void QNearFieldTargetPrivate::reportError(QNearFieldTarget::Error error,
-                                          const QNearFieldTarget::RequestId &id)
+                                          const QNearFieldTarget::RequestId &id,
+                                          const QVariant &response)
 {
-    setResponseForRequest(id, QVariant(), false);
+    setResponseForRequest(id, response, false);
     QMetaObject::invokeMethod(this, [this, error, id]() {
         Q_EMIT this->error(error, id);
     }, Qt::QueuedConnection);
@@ -54,6 +54,8 @@ public:
     // TagTypeSpecificAccess
     virtual int maxCommandLength() const;
     virtual QNearFieldTarget::RequestId sendCommand(const QByteArray &command);
+    virtual QNearFieldTarget::RequestId sendCommands(const QList<QByteArray> &commands,
+                                                     const QList<quint16> &stopStatusWords);
 
     bool waitForRequestCompleted(const QNearFieldTarget::RequestId &id, int msecs = 5000);
     QVariant requestResponse(const QNearFieldTarget::RequestId &id) const;
@@ -74,7 +76,8 @@ protected:
                                        const QVariant &response,
                                        bool emitRequestCompleted = true);
 
-    void reportError(QNearFieldTarget::Error error, const QNearFieldTarget::RequestId &id);
+    void reportError(QNearFieldTarget::Error error, const QNearFieldTarget::RequestId &id,
+                     const QVariant &response = QVariant());
 };
 
 QT_END_NAMESPACE
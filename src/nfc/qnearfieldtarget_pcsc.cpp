@@ -16,10 +16,11 @@ Q_DECLARE_LOGGING_CATEGORY(QT_NFC_PCSC)
     worker thread via signal-slot mechanism.
 */
 QNearFieldTargetPrivateImpl::QNearFieldTargetPrivateImpl(
-        const QByteArray &uid, QNearFieldTarget::AccessMethods accessMethods, int maxInputLength,
-        QObject *parent)
+        const QByteArray &uid, QNearFieldTarget::Type type,
+        QNearFieldTarget::AccessMethods accessMethods, int maxInputLength, QObject *parent)
     : QNearFieldTargetPrivate(parent),
       m_uid(uid),
+      m_type(type),
       m_accessMethods(accessMethods),
       m_maxInputLength(maxInputLength)
 {
@@ -40,12 +41,7 @@ QByteArray QNearFieldTargetPrivateImpl::uid() const
 QNearFieldTarget::Type QNearFieldTargetPrivateImpl::type() const
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
-
-    // Currently NDEF access is only supported for Type 4 tags
-    if (m_accessMethods & QNearFieldTarget::NdefAccess)
-        return QNearFieldTarget::NfcTagType4;
-
-    return QNearFieldTarget::ProprietaryTag;
+    return m_type;
 }
 
 QNearFieldTarget::AccessMethods QNearFieldTargetPrivateImpl::accessMethods() const
@@ -80,7 +76,7 @@ void QNearFieldTargetPrivateImpl::onRequestCompleted(const QNearFieldTarget::Req
     if (reason == QNearFieldTarget::NoError)
         setResponseForRequest(request, result);
     else
-        reportError(reason, request);
+        reportError(reason, request, result);
 }
 
 void QNearFieldTargetPrivateImpl::onNdefMessageRead(const QNdefMessage &message)
@@ -103,6 +99,27 @@ QNearFieldTarget::RequestId QNearFieldTargetPrivateImpl::sendCommand(const QByte
     return reqId;
 }
 
+/*
+    Sends all commands to the worker thread at once, instead of paying a
+    round trip between the threads for every command.
+*/
+QNearFieldTarget::RequestId
+QNearFieldTargetPrivateImpl::sendCommands(const QList<QByteArray> &commands,
+                                          const QList<quint16> &stopStatusWords)
+{
+    qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
+
+    if (!m_isValid)
+        return QNearFieldTarget::RequestId(nullptr);
+
+    m_connected = true;
+
+    QNearFieldTarget::RequestId reqId(new QNearFieldTarget::RequestIdPrivate);
+    Q_EMIT sendCommandsRequest(reqId, commands, stopStatusWords);
+
+    return reqId;
+}
+
 QNearFieldTarget::RequestId QNearFieldTargetPrivateImpl::readNdefMessages()
 {
     qCDebug(QT_NFC_PCSC) << Q_FUNC_INFO;
@@ -23,7 +23,7 @@ class QNearFieldTargetPrivateImpl : public QNearFieldTargetPrivate
 {
     Q_OBJECT
 public:
-    QNearFieldTargetPrivateImpl(const QByteArray &uid,
+    QNearFieldTargetPrivateImpl(const QByteArray &uid, QNearFieldTarget::Type type,
                                 QNearFieldTarget::AccessMethods accessMethods, int maxInputLength,
                                 QObject *parent);
     ~QNearFieldTargetPrivateImpl() override;
@@ -36,11 +36,14 @@ public:
 
     int maxCommandLength() const override;
     QNearFieldTarget::RequestId sendCommand(const QByteArray &command) override;
+    QNearFieldTarget::RequestId sendCommands(const QList<QByteArray> &commands,
+                                             const QList<quint16> &stopStatusWords) override;
     QNearFieldTarget::RequestId readNdefMessages() override;
     QNearFieldTarget::RequestId writeNdefMessages(const QList<QNdefMessage> &messages) override;
 
 private:
     const QByteArray m_uid;
+    QNearFieldTarget::Type m_type;
     QNearFieldTarget::AccessMethods m_accessMethods;
     int m_maxInputLength;
     bool m_connected = false;
@@ -56,6 +59,9 @@ public Q_SLOTS:
 Q_SIGNALS:
     void disconnectRequest();
     void sendCommandRequest(const QNearFieldTarget::RequestId &request, const QByteArray &command);
+    void sendCommandsRequest(const QNearFieldTarget::RequestId &request,
+                             const QList<QByteArray> &commands,
+                             const QList<quint16> &stopStatusWords);
     void readNdefMessagesRequest(const QNearFieldTarget::RequestId &request);
     void writeNdefMessagesRequest(const QNearFieldTarget::RequestId &request,
                                   const QList<QNdefMessage> &messages);
@@ -0,0 +1,304 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/QBluetoothDeviceDiscoveryAgent>
+#include <QtBluetooth/QBluetoothDeviceInfo>
+#include <QtBluetooth/private/bluez5_helper_p.h>
+#include <QtBluetooth/private/bluezobjecttree_p.h>
+
+#include <memory>
+
+#include "../../shared/fakebluetoothd_p.h"
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static QBluetoothAddress deviceAddress(int index)
+{
+    return QBluetoothAddress(u"00:11:22:33:44:%1"_s.arg(index, 2, 10, QChar(u'0')));
+}
+
+static QString devicePath(int index)
+{
+    return devicePathForAddress(fakeAdapterPath, deviceAddress(index));
+}
+
+/*
+ * Runs the BlueZ device discovery against a fake bluetoothd on a private bus.
+ * The adapter starts without devices, the tests let bluetoothd find and
+ * remove them.
+ */
+class tst_BluezDeviceDiscovery : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    void maximumDevices_data();
+    void maximumDevices();
+    void setMaximumDevices();
+    void leastRecentlySeenLost();
+    void lostDeviceSeenAgain();
+    void stopFromDeviceDiscovered();
+    void interfacesRemoved_data();
+    void interfacesRemoved();
+
+private:
+    std::unique_ptr<QBluetoothDeviceDiscoveryAgent> startedAgent(int timeout);
+    void addDevice(int index);
+
+    FakeSystemBus m_bus;
+    FakeBluetoothd *m_bluetoothd = nullptr;
+    // "found <index>" and "lost <index>" in the order the agent reported them
+    QStringList m_events;
+};
+
+void tst_BluezDeviceDiscovery::initTestCase()
+{
+    if (!FakeSystemBus::isSupported())
+        QSKIP("dbus-daemon is needed for the private bus");
+
+    QVERIFY(m_bus.start());
+    m_bluetoothd = m_bus.bluetoothd();
+}
+
+void tst_BluezDeviceDiscovery::cleanupTestCase()
+{
+    m_bus.stop();
+}
+
+void tst_BluezDeviceDiscovery::init()
+{
+    m_bluetoothd->setObjects(fakeAdapterTree());
+    m_bluetoothd->resetCalls();
+    m_events.clear();
+
+    QtBluezObjectTree::instance()->clear();
+    QVERIFY(QtBluezObjectTree::instance()->ensureLoaded());
+}
+
+std::unique_ptr<QBluetoothDeviceDiscoveryAgent>
+tst_BluezDeviceDiscovery::startedAgent(int timeout)
+{
+    std::unique_ptr<QBluetoothDeviceDiscoveryAgent> agent(new QBluetoothDeviceDiscoveryAgent);
+    const auto index = [](const QBluetoothDeviceInfo &info) {
+        return QString::number(info.address().toUInt64() & 0xff, 16);
+    };
+    connect(agent.get(), &QBluetoothDeviceDiscoveryAgent::deviceDiscovered,
+            this, [this, index](const QBluetoothDeviceInfo &info) {
+        m_events.append(u"found "_s + index(info));
+    });
+    connect(agent.get(), &QBluetoothDeviceDiscoveryAgent::deviceLost,
+            this, [this, index](const QBluetoothDeviceInfo &info) {
+        m_events.append(u"lost "_s + index(info));
+    });
+
+    agent->setLowEnergyDiscoveryTimeout(timeout);
+    agent->start(QBluetoothDeviceDiscoveryAgent::LowEnergyMethod);
+    if (!agent->isActive())
+        return {};
+    if (!waitFor([this]() { return !m_bluetoothd->calls(u"StartDiscovery"_s).isEmpty(); }))
+        return {};
+    return agent;
+}
+
+void tst_BluezDeviceDiscovery::addDevice(int index)
+{
+    m_bluetoothd->addInterfaces(devicePath(index),
+                                {{ u"org.bluez.Device1"_s,
+                                   fakeDeviceProperties(deviceAddress(index), false) }});
+}
+
+void tst_BluezDeviceDiscovery::maximumDevices_data()
+{
+    QTest::addColumn<QByteArray>("maximum");
+    QTest::addColumn<int>("expectedDevices");
+
+    QTest::newRow("default") << QByteArray() << 4;
+    QTest::newRow("2") << QByteArray("2") << 2;
+    QTest::newRow("0") << QByteArray("0") << 4;
+    QTest::newRow("invalid") << QByteArray("many") << 4;
+}
+
+void tst_BluezDeviceDiscovery::maximumDevices()
+{
+    QFETCH(QByteArray, maximum);
+    QFETCH(int, expectedDevices);
+
+    // The limit is read when the agent is created
+    if (maximum.isEmpty())
+        qunsetenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES");
+    else
+        qputenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES", maximum);
+    const auto restore = qScopeGuard([]() { qunsetenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES"); });
+
+    const std::unique_ptr<QBluetoothDeviceDiscoveryAgent> agent = startedAgent(0);
+    QVERIFY(agent);
+    QSignalSpy lostSpy(agent.get(), &QBluetoothDeviceDiscoveryAgent::deviceLost);
+
+    for (int i = 0; i < 4; ++i)
+        addDevice(i);
+    QVERIFY(waitFor([this]() { return m_events.count(u"found 3"_s) == 1; }));
+
+    QCOMPARE(agent->maximumDiscoveredDevices(), expectedDevices == 4 ? 0 : expectedDevices);
+    QCOMPARE(agent->discoveredDevices().size(), qsizetype(expectedDevices));
+    QCOMPARE(lostSpy.size(), 4 - expectedDevices);
+    // The devices found first are dropped first
+    for (int i = 0; i < lostSpy.size(); ++i)
+        QCOMPARE(lostSpy.at(i).at(0).value<QBluetoothDeviceInfo>().address(), deviceAddress(i));
+    QVERIFY(agent->isActive());
+}
+
+void tst_BluezDeviceDiscovery::setMaximumDevices()
+{
+    qputenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES", "3");
+    const auto restore = qScopeGuard([]() { qunsetenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES"); });
+
+    const std::unique_ptr<QBluetoothDeviceDiscoveryAgent> agent = startedAgent(0);
+    QVERIFY(agent);
+    QCOMPARE(agent->maximumDiscoveredDevices(), 3);
+    agent->setMaximumDiscoveredDevices(-1);
+    QCOMPARE(agent->maximumDiscoveredDevices(), 3);
+
+    addDevice(1);
+    addDevice(2);
+    QVERIFY(waitFor([this]() { return m_events.size() == 2; }));
+
+    // The new maximum is applied when the next device is found
+    agent->setMaximumDiscoveredDevices(1);
+    QCOMPARE(agent->maximumDiscoveredDevices(), 1);
+    QCOMPARE(agent->discoveredDevices().size(), qsizetype(2));
+    addDevice(3);
+    QVERIFY(waitFor([this]() { return m_events.size() == 5; }));
+    QCOMPARE(m_events, QStringList({ u"found 1"_s, u"found 2"_s, u"found 3"_s,
+                                     u"lost 1"_s, u"lost 2"_s }));
+
+    agent->setMaximumDiscoveredDevices(0);
+    addDevice(4);
+    QVERIFY(waitFor([this]() { return m_events.contains(u"found 4"_s); }));
+    QCOMPARE(agent->discoveredDevices().size(), qsizetype(2));
+}
+
+void tst_BluezDeviceDiscovery::leastRecentlySeenLost()
+{
+    qputenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES", "2");
+    const auto restore = qScopeGuard([]() { qunsetenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES"); });
+
+    const std::unique_ptr<QBluetoothDeviceDiscoveryAgent> agent = startedAgent(0);
+    QVERIFY(agent);
+
+    addDevice(1);
+    addDevice(2);
+    addDevice(3);
+    // The new device is reported before the one it replaces is lost
+    QVERIFY(waitFor([this]() { return m_events.size() == 4; }));
+    QCOMPARE(m_events, QStringList({ u"found 1"_s, u"found 2"_s, u"found 3"_s, u"lost 1"_s }));
+
+    // A property change counts as seeing the device again
+    m_events.clear();
+    m_bluetoothd->changeProperties(devicePath(2), u"org.bluez.Device1"_s,
+                                   {{ u"RSSI"_s, QVariant::fromValue(short(-40)) }});
+    addDevice(4);
+    QVERIFY(waitFor([this]() { return m_events.contains(u"lost 3"_s); }));
+    QVERIFY(!m_events.contains(u"lost 2"_s));
+
+    QList<QBluetoothAddress> addresses;
+    const QList<QBluetoothDeviceInfo> devices = agent->discoveredDevices();
+    for (const QBluetoothDeviceInfo &info : devices)
+        addresses.append(info.address());
+    QCOMPARE(addresses, QList<QBluetoothAddress>({ deviceAddress(2), deviceAddress(4) }));
+}
+
+void tst_BluezDeviceDiscovery::lostDeviceSeenAgain()
+{
+    const std::unique_ptr<QBluetoothDeviceDiscoveryAgent> agent = startedAgent(0);
+    QVERIFY(agent);
+    agent->setMaximumDiscoveredDevices(1);
+
+    addDevice(1);
+    addDevice(2);
+    QVERIFY(waitFor([this]() { return m_events.size() == 3; }));
+    QCOMPARE(m_events, QStringList({ u"found 1"_s, u"found 2"_s, u"lost 1"_s }));
+
+    // bluetoothd still knows the dropped device and only reports its changes
+    m_events.clear();
+    m_bluetoothd->changeProperties(devicePath(1), u"org.bluez.Device1"_s,
+                                   {{ u"RSSI"_s, QVariant::fromValue(short(-40)) }});
+    QVERIFY(waitFor([this]() { return m_events.size() == 2; }));
+    QCOMPARE(m_events, QStringList({ u"found 1"_s, u"lost 2"_s }));
+
+    const QList<QBluetoothDeviceInfo> devices = agent->discoveredDevices();
+    QCOMPARE(devices.size(), qsizetype(1));
+    QCOMPARE(devices.first().address(), deviceAddress(1));
+    QCOMPARE(devices.first().rssi(), qint16(-40));
+}
+
+void tst_BluezDeviceDiscovery::stopFromDeviceDiscovered()
+{
+    qputenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES", "1");
+    const auto restore = qScopeGuard([]() { qunsetenv("QT_BLUETOOTH_MAX_DISCOVERED_DEVICES"); });
+
+    const std::unique_ptr<QBluetoothDeviceDiscoveryAgent> agent = startedAgent(0);
+    QVERIFY(agent);
+    QSignalSpy canceledSpy(agent.get(), &QBluetoothDeviceDiscoveryAgent::canceled);
+
+    addDevice(1);
+    QVERIFY(waitFor([this]() { return m_events.size() == 1; }));
+
+    // A stopped discovery loses no devices
+    connect(agent.get(), &QBluetoothDeviceDiscoveryAgent::deviceDiscovered,
+            agent.get(), &QBluetoothDeviceDiscoveryAgent::stop);
+    addDevice(2);
+    QVERIFY(waitFor([&canceledSpy]() { return canceledSpy.size() == 1; }));
+    QCOMPARE(m_events, QStringList({ u"found 1"_s, u"found 2"_s }));
+    QCOMPARE(agent->discoveredDevices().size(), qsizetype(2));
+}
+
+void tst_BluezDeviceDiscovery::interfacesRemoved_data()
+{
+    QTest::addColumn<int>("timeout");
+    QTest::addColumn<bool>("lost");
+
+    QTest::newRow("continuous") << 0 << true;
+    QTest::newRow("timed") << 60000 << false;
+}
+
+void tst_BluezDeviceDiscovery::interfacesRemoved()
+{
+    QFETCH(int, timeout);
+    QFETCH(bool, lost);
+
+    const std::unique_ptr<QBluetoothDeviceDiscoveryAgent> agent = startedAgent(timeout);
+    QVERIFY(agent);
+
+    addDevice(1);
+    addDevice(2);
+    QVERIFY(waitFor([this]() { return m_events.size() == 2; }));
+
+    // bluetoothd drops devices it did not see for a while. The signals of
+    // bluetoothd arrive in order, the removal is handled once device 3 is found.
+    m_bluetoothd->removeInterfaces(devicePath(1), { u"org.bluez.Device1"_s });
+    addDevice(3);
+    QVERIFY(waitFor([this]() { return m_events.contains(u"found 3"_s); }));
+
+    QCOMPARE(m_events.contains(u"lost 1"_s), lost);
+    QCOMPARE(agent->discoveredDevices().size(), qsizetype(lost ? 2 : 3));
+    QVERIFY(agent->isActive());
+
+    // Removing other interfaces of a device keeps it
+    m_events.clear();
+    m_bluetoothd->removeInterfaces(devicePath(2), { u"org.bluez.MediaControl1"_s });
+    addDevice(4);
+    QVERIFY(waitFor([this]() { return m_events.contains(u"found 4"_s); }));
+    QCOMPARE(m_events, QStringList({ u"found 4"_s }));
+}
+
+QTEST_MAIN(tst_BluezDeviceDiscovery)
+
+#include "tst_bluezdevicediscovery.moc"
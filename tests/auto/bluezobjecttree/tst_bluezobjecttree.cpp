@@ -0,0 +1,273 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/private/bluez5_helper_p.h>
+#include <QtBluetooth/private/bluezobjecttree_p.h>
+
+#include <memory>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static const QString adapterPath = u"/org/bluez/hci0"_s;
+static const QString adapter1 = u"org.bluez.Adapter1"_s;
+static const QString device1 = u"org.bluez.Device1"_s;
+static const QString gattService1 = u"org.bluez.GattService1"_s;
+static const QString gattCharacteristic1 = u"org.bluez.GattCharacteristic1"_s;
+
+static QString devicePath(int index)
+{
+    return adapterPath + u"/dev_00_11_22_33_44_%1"_s.arg(index, 2, 10, QChar(u'0'));
+}
+
+static QBluetoothAddress deviceAddress(int index)
+{
+    return QBluetoothAddress(u"00:11:22:33:44:%1"_s.arg(index, 2, 10, QChar(u'0')));
+}
+
+static InterfaceList device(int index, const QString &adapter = adapterPath)
+{
+    QVariantMap properties;
+    properties.insert(u"Address"_s, deviceAddress(index).toString());
+    properties.insert(u"Adapter"_s, QVariant::fromValue(QDBusObjectPath(adapter)));
+    properties.insert(u"Connected"_s, false);
+    return {{ device1, properties }};
+}
+
+static ManagedObjectList initialObjects(int deviceCount)
+{
+    ManagedObjectList objects;
+    objects.insert(QDBusObjectPath(u"/org/bluez"_s), {{ u"org.bluez.AgentManager1"_s, {} }});
+    objects.insert(QDBusObjectPath(adapterPath),
+                   {{ adapter1, {{ u"Address"_s, u"AA:BB:CC:DD:EE:FF"_s }} }});
+    for (int i = 0; i < deviceCount; ++i)
+        objects.insert(QDBusObjectPath(devicePath(i)), device(i));
+    return objects;
+}
+
+class tst_BluezObjectTree : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initialTree();
+    void addRemoveDevices();
+    void gattHierarchy();
+    void propertyChanges();
+    void updatesBeforeLoad();
+    void devicePathConversion();
+    void otherThreads();
+};
+
+void tst_BluezObjectTree::initialTree()
+{
+    QtBluezObjectTree tree;
+    QVERIFY(!tree.isLoaded());
+
+    tree.setObjects(initialObjects(3));
+    QVERIFY(tree.isLoaded());
+
+    QCOMPARE(tree.adapterPaths(), QStringList{ adapterPath });
+    QCOMPARE(tree.properties(adapterPath, adapter1).value(u"Address"_s).toString(),
+             u"AA:BB:CC:DD:EE:FF"_s);
+    QVERIFY(tree.hasInterface(adapterPath, adapter1));
+    QVERIFY(!tree.hasInterface(adapterPath, device1));
+
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(tree.devicePath(adapterPath, deviceAddress(i)), devicePath(i));
+        QVERIFY(tree.hasInterface(devicePath(i), device1));
+    }
+    QVERIFY(tree.devicePath(adapterPath, deviceAddress(3)).isEmpty());
+    QVERIFY(tree.devicePath(u"/org/bluez/hci1"_s, deviceAddress(0)).isEmpty());
+
+    QCOMPARE(tree.childPaths(adapterPath),
+             (QStringList{ devicePath(0), devicePath(1), devicePath(2) }));
+    QCOMPARE(tree.childPaths(u"/org/bluez"_s), QStringList{ adapterPath });
+
+    tree.clear();
+    QVERIFY(!tree.isLoaded());
+    QVERIFY(tree.adapterPaths().isEmpty());
+    QVERIFY(tree.childPaths(adapterPath).isEmpty());
+    QVERIFY(tree.devicePath(adapterPath, deviceAddress(0)).isEmpty());
+}
+
+void tst_BluezObjectTree::addRemoveDevices()
+{
+    QtBluezObjectTree tree;
+    tree.setObjects(initialObjects(2));
+
+    QSignalSpy addedSpy(&tree, &QtBluezObjectTree::interfacesAdded);
+    QSignalSpy removedSpy(&tree, &QtBluezObjectTree::interfacesRemoved);
+
+    // Out of order insertion keeps the child list sorted
+    tree.addInterfaces(devicePath(5), device(5));
+    tree.addInterfaces(devicePath(3), device(3));
+    QCOMPARE(addedSpy.size(), 2);
+    QCOMPARE(addedSpy.at(1).at(0).value<QDBusObjectPath>().path(), devicePath(3));
+    QCOMPARE(tree.childPaths(adapterPath),
+             (QStringList{ devicePath(0), devicePath(1), devicePath(3), devicePath(5) }));
+    QCOMPARE(tree.devicePath(adapterPath, deviceAddress(3)), devicePath(3));
+
+    // Removing one of several interfaces keeps the object
+    tree.addInterfaces(devicePath(3), {{ u"org.bluez.Battery1"_s, {} }});
+    QVERIFY(tree.hasInterface(devicePath(3), device1));
+    tree.removeInterfaces(devicePath(3), { device1 });
+    QCOMPARE(removedSpy.size(), 1);
+    QVERIFY(tree.contains(devicePath(3)));
+    QVERIFY(tree.devicePath(adapterPath, deviceAddress(3)).isEmpty());
+
+    tree.removeInterfaces(devicePath(3), { u"org.bluez.Battery1"_s });
+    QVERIFY(!tree.contains(devicePath(3)));
+    QCOMPARE(tree.childPaths(adapterPath),
+             (QStringList{ devicePath(0), devicePath(1), devicePath(5) }));
+
+    // Adapters come and go as well
+    const QString secondAdapter = u"/org/bluez/hci1"_s;
+    tree.addInterfaces(secondAdapter, {{ adapter1, {} }});
+    tree.addInterfaces(secondAdapter + u"/dev_00_11_22_33_44_00"_s, device(0, secondAdapter));
+    QCOMPARE(tree.adapterPaths(), (QStringList{ adapterPath, secondAdapter }));
+    QCOMPARE(tree.devicePath(secondAdapter, deviceAddress(0)),
+             secondAdapter + u"/dev_00_11_22_33_44_00"_s);
+    QCOMPARE(tree.devicePath(adapterPath, deviceAddress(0)), devicePath(0));
+
+    tree.removeInterfaces(secondAdapter, { adapter1 });
+    QCOMPARE(tree.adapterPaths(), QStringList{ adapterPath });
+}
+
+void tst_BluezObjectTree::gattHierarchy()
+{
+    QtBluezObjectTree tree;
+    ManagedObjectList objects = initialObjects(1);
+    const QString service = devicePath(0) + u"/service0010"_s;
+    const QString otherService = devicePath(0) + u"/service0001"_s;
+    objects.insert(QDBusObjectPath(service), {{ gattService1, {} }});
+    objects.insert(QDBusObjectPath(otherService), {{ gattService1, {} }});
+    for (const QString &characteristic : { u"/char0013"_s, u"/char0011"_s })
+        objects.insert(QDBusObjectPath(service + characteristic), {{ gattCharacteristic1, {} }});
+    objects.insert(QDBusObjectPath(service + u"/char0013/desc0015"_s),
+                   {{ u"org.bluez.GattDescriptor1"_s, {} }});
+    tree.setObjects(objects);
+
+    QCOMPARE(tree.childPaths(devicePath(0)), (QStringList{ otherService, service }));
+    QCOMPARE(tree.childPaths(service),
+             (QStringList{ service + u"/char0011"_s, service + u"/char0013"_s }));
+    QCOMPARE(tree.childPaths(service + u"/char0013"_s),
+             QStringList{ service + u"/char0013/desc0015"_s });
+    QVERIFY(tree.childPaths(service + u"/char0011"_s).isEmpty());
+    QVERIFY(tree.childPaths(otherService).isEmpty());
+}
+
+void tst_BluezObjectTree::propertyChanges()
+{
+    QtBluezObjectTree tree;
+    tree.setObjects(initialObjects(1));
+
+    QSignalSpy changedSpy(&tree, &QtBluezObjectTree::propertiesChanged);
+
+    tree.changeProperties(devicePath(0), device1, {{ u"Connected"_s, true }}, {});
+    QCOMPARE(changedSpy.size(), 1);
+    QCOMPARE(changedSpy.at(0).at(0).toString(), devicePath(0));
+    QCOMPARE(tree.properties(devicePath(0), device1).value(u"Connected"_s), QVariant(true));
+
+    tree.changeProperties(devicePath(0), device1, {}, { u"Connected"_s });
+    QVERIFY(!tree.properties(devicePath(0), device1).contains(u"Connected"_s));
+
+    // A changed address moves the device in the index
+    tree.changeProperties(devicePath(0), device1,
+                          {{ u"Address"_s, deviceAddress(7).toString() }}, {});
+    QVERIFY(tree.devicePath(adapterPath, deviceAddress(0)).isEmpty());
+    QCOMPARE(tree.devicePath(adapterPath, deviceAddress(7)), devicePath(0));
+
+    // Changes of unknown objects are only forwarded
+    tree.changeProperties(devicePath(9), device1, {{ u"Connected"_s, true }}, {});
+    QCOMPARE(changedSpy.size(), 4);
+    QVERIFY(!tree.contains(devicePath(9)));
+}
+
+void tst_BluezObjectTree::updatesBeforeLoad()
+{
+    QtBluezObjectTree tree;
+    QSignalSpy addedSpy(&tree, &QtBluezObjectTree::interfacesAdded);
+
+    // Updates before the first fetch are forwarded but not stored,
+    // the fetched tree already contains them
+    tree.addInterfaces(devicePath(0), device(0));
+    QCOMPARE(addedSpy.size(), 1);
+    QVERIFY(!tree.contains(devicePath(0)));
+
+    tree.setObjects(initialObjects(1));
+    QCOMPARE(tree.devicePath(adapterPath, deviceAddress(0)), devicePath(0));
+}
+
+void tst_BluezObjectTree::devicePathConversion()
+{
+    for (int i : { 0, 9, 42 }) {
+        QCOMPARE(devicePathForAddress(adapterPath, deviceAddress(i)), devicePath(i));
+        QCOMPARE(addressFromDevicePath(devicePath(i)), deviceAddress(i));
+    }
+    QCOMPARE(addressFromDevicePath(u"/org/bluez/hci0/dev_aa_bb_cc_dd_ee_ff"_s),
+             QBluetoothAddress(Q_UINT64_C(0xAABBCCDDEEFF)));
+
+    // Neither adapters nor the GATT objects below a device are devices
+    QVERIFY(addressFromDevicePath(adapterPath).isNull());
+    QVERIFY(addressFromDevicePath(devicePath(0) + u"/service0010"_s).isNull());
+    QVERIFY(addressFromDevicePath(u"/org/bluez/hci0/xdev_00_11_22_33_44_00"_s).isNull());
+    QVERIFY(addressFromDevicePath(u"/org/bluez/hci0/dev_00:11:22:33:44:00"_s).isNull());
+    QVERIFY(addressFromDevicePath(u"dev_00_11_22_33_44_00"_s).isNull());
+}
+
+void tst_BluezObjectTree::otherThreads()
+{
+    // A tree created by another thread is moved to the application thread
+    std::unique_ptr<QtBluezObjectTree> created;
+    std::unique_ptr<QThread> creator(QThread::create([&created]() {
+        created = std::make_unique<QtBluezObjectTree>();
+    }));
+    creator->start();
+    QVERIFY(creator->wait());
+    QCOMPARE(created->thread(), QThread::currentThread());
+
+    // Lookups from other threads run concurrently with the updates
+    QtBluezObjectTree tree;
+    tree.setObjects(initialObjects(1));
+    QAtomicInt stop;
+    QAtomicInt lookups;
+    QAtomicInt mismatches;
+    std::unique_ptr<QThread> reader(QThread::create([&]() {
+        while (!stop.loadRelaxed()) {
+            const QString path = tree.devicePath(adapterPath, deviceAddress(1));
+            if (!path.isEmpty() && path != devicePath(1))
+                mismatches.ref();
+            tree.childPaths(adapterPath);
+            tree.properties(devicePath(0), device1);
+            lookups.fetchAndAddRelaxed(1);
+        }
+    }));
+    reader->start();
+    for (int i = 0; i < 1000 || lookups.loadRelaxed() < 100; ++i) {
+        tree.addInterfaces(devicePath(1), device(1));
+        tree.changeProperties(devicePath(0), device1, {{ u"Connected"_s, i % 2 == 0 }}, {});
+        tree.removeInterfaces(devicePath(1), { device1 });
+    }
+    stop.storeRelaxed(1);
+    QVERIFY(reader->wait());
+    QCOMPARE(mismatches.loadRelaxed(), 0);
+    QCOMPARE(tree.childPaths(adapterPath), QStringList{ devicePath(0) });
+
+    // Loading is passed on to the thread of the tree, which answers even if
+    // the tree has been loaded in the meantime
+    QSignalSpy loadSpy(&tree, &QtBluezObjectTree::loadFinished);
+    std::unique_ptr<QThread> loader(QThread::create([&tree]() { tree.load(); }));
+    loader->start();
+    QVERIFY(loader->wait());
+    QVERIFY(loadSpy.isEmpty());
+    QTRY_COMPARE(loadSpy.size(), 1);
+    QCOMPARE(loadSpy.at(0).at(0).toBool(), true);
+}
+
+QTEST_MAIN(tst_BluezObjectTree)
+
+#include "tst_bluezobjecttree.moc"
@@ -0,0 +1,302 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/private/bluezperipheralobjects_p.h>
+
+#include <QtDBus/QDBusPendingReply>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../../shared/fakebluetoothd_p.h"
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static const QString servicePath = u"/qt/btle/application/test/service0"_s;
+
+/*
+ * Registers peripheral characteristics on a private bus and lets the fake
+ * bluetoothd acquire their sockets through the GattCharacteristic1 adaptor,
+ * the same way bluetoothd does. The values then travel through the sockets.
+ */
+class tst_BluezPeripheralObjects : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void acquireWrite();
+    void acquireWriteInvalidLength();
+    void acquireWriteNotSupported();
+    void acquireNotify();
+    void acquireNotifyBurst();
+    void acquireNotifyFallback();
+
+private:
+    struct Acquired
+    {
+        int socket = -1;
+        quint16 mtu = 0;
+        QString error;
+    };
+
+    static QLowEnergyCharacteristicData characteristicData(
+            QLowEnergyCharacteristic::PropertyTypes properties);
+    Acquired acquire(QtBluezPeripheralCharacteristic &characteristic, const QString &method,
+                     quint16 mtu);
+    static QByteArray readNotification(int socket);
+
+    FakeSystemBus m_bus;
+    FakeBluetoothd *m_bluetoothd = nullptr;
+};
+
+void tst_BluezPeripheralObjects::initTestCase()
+{
+    if (!FakeSystemBus::isSupported())
+        QSKIP("dbus-daemon is needed for the private bus");
+
+    QVERIFY(m_bus.start());
+    m_bluetoothd = m_bus.bluetoothd();
+}
+
+void tst_BluezPeripheralObjects::cleanupTestCase()
+{
+    m_bus.stop();
+}
+
+QLowEnergyCharacteristicData tst_BluezPeripheralObjects::characteristicData(
+        QLowEnergyCharacteristic::PropertyTypes properties)
+{
+    QLowEnergyCharacteristicData data;
+    data.setUuid(QBluetoothUuid(QBluetoothUuid::CharacteristicType::HeartRateMeasurement));
+    data.setProperties(properties);
+    data.setValueLength(1, 20);
+    data.setValue(QByteArray(1, 0));
+    return data;
+}
+
+// Calls AcquireWrite() or AcquireNotify() of the characteristic over the bus.
+// The socket is ours to close, it is -1 if the reply was an error.
+tst_BluezPeripheralObjects::Acquired tst_BluezPeripheralObjects::acquire(
+        QtBluezPeripheralCharacteristic &characteristic, const QString &method, quint16 mtu)
+{
+    const QVariantMap options{
+        { u"device"_s, QVariant::fromValue(QDBusObjectPath(fakeAdapterPath
+                                                            + u"/dev_00_11_22_33_44_55"_s)) },
+        { u"link"_s, u"LE"_s },
+        { u"mtu"_s, QVariant::fromValue(mtu) }
+    };
+    QDBusPendingReply<QDBusUnixFileDescriptor, quint16> reply = m_bluetoothd->callObject(
+            QDBusConnection::systemBus().baseService(), characteristic.objectPath,
+            u"org.bluez.GattCharacteristic1"_s, method, { options });
+    Acquired acquired;
+    if (!waitFor([&reply]() { return reply.isFinished(); })) {
+        acquired.error = u"timeout"_s;
+        return acquired;
+    }
+
+    if (reply.isError()) {
+        acquired.error = reply.error().name();
+    } else if (reply.argumentAt<0>().isValid()) {
+        acquired.socket = ::dup(reply.argumentAt<0>().fileDescriptor());
+        acquired.mtu = reply.argumentAt<1>();
+    }
+    return acquired;
+}
+
+QByteArray tst_BluezPeripheralObjects::readNotification(int socket)
+{
+    QByteArray buffer(512, Qt::Uninitialized);
+    const auto size = ::recv(socket, buffer.data(), buffer.size(), MSG_DONTWAIT);
+    return size > 0 ? buffer.left(size) : QByteArray();
+}
+
+void tst_BluezPeripheralObjects::acquireWrite()
+{
+    QtBluezPeripheralCharacteristic characteristic(
+                characteristicData(QLowEnergyCharacteristic::WriteNoResponse),
+                servicePath, 0, 0x10, nullptr);
+    QVERIFY(characteristic.registerObject());
+    QSignalSpy valueSpy(&characteristic, &QtBluezPeripheralCharacteristic::valueUpdatedByRemote);
+    QSignalSpy accessSpy(&characteristic,
+                         &QtBluezPeripheralCharacteristic::remoteDeviceAccessEvent);
+
+    const auto interfaceProperties = characteristic.properties().value(
+                u"org.bluez.GattCharacteristic1"_s);
+    QVERIFY(interfaceProperties.contains(u"WriteAcquired"_s));
+    QVERIFY(!interfaceProperties.contains(u"NotifyAcquired"_s));
+    QVERIFY(!characteristic.writeAcquired());
+
+    Acquired acquired = acquire(characteristic, u"AcquireWrite"_s, 247);
+    QVERIFY2(acquired.socket != -1, qPrintable(acquired.error));
+    QCOMPARE(acquired.mtu, quint16(247));
+    QVERIFY(characteristic.writeAcquired());
+    QVERIFY(characteristic.property("WriteAcquired").toBool());
+    QCOMPARE(accessSpy.size(), 1);
+    QCOMPARE(accessSpy.at(0).at(1).value<quint16>(), quint16(247));
+
+    // A second acquire is rejected while the first one is active
+    const Acquired second = acquire(characteristic, u"AcquireWrite"_s, 247);
+    QCOMPARE(second.socket, -1);
+    QCOMPARE(second.error, u"org.bluez.Error.NotPermitted"_s);
+
+    // Values written through the socket arrive in order without DBus
+    const QList<QByteArray> values{"\x01"_ba, "\x02\x03"_ba, QByteArray(20, 'x')};
+    for (const auto &value : values)
+        QCOMPARE(::send(acquired.socket, value.constData(), value.size(), 0), value.size());
+    QTRY_COMPARE(valueSpy.size(), values.size());
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        QCOMPARE(valueSpy.at(i).at(0).value<QLowEnergyHandle>(), QLowEnergyHandle(0x10));
+        QCOMPARE(valueSpy.at(i).at(1).toByteArray(), values.at(i));
+    }
+    QString error;
+    QCOMPARE(characteristic.ReadValue({}, error), values.last());
+
+    // Closing the socket on bluetoothd side releases the acquisition
+    ::close(acquired.socket);
+    QTRY_VERIFY(!characteristic.writeAcquired());
+    acquired = acquire(characteristic, u"AcquireWrite"_s, 23);
+    QVERIFY2(acquired.socket != -1, qPrintable(acquired.error));
+    QCOMPARE(acquired.mtu, quint16(23));
+    ::close(acquired.socket);
+}
+
+void tst_BluezPeripheralObjects::acquireWriteInvalidLength()
+{
+    QtBluezPeripheralCharacteristic characteristic(
+                characteristicData(QLowEnergyCharacteristic::WriteNoResponse),
+                servicePath, 0, 0x10, nullptr);
+    QVERIFY(characteristic.registerObject());
+    QSignalSpy valueSpy(&characteristic, &QtBluezPeripheralCharacteristic::valueUpdatedByRemote);
+
+    const Acquired acquired = acquire(characteristic, u"AcquireWrite"_s, 247);
+    QVERIFY2(acquired.socket != -1, qPrintable(acquired.error));
+    const auto closeSocket = qScopeGuard([&acquired]() { ::close(acquired.socket); });
+
+    // Too long value is dropped, the acquisition stays usable
+    const QByteArray tooLong(21, 'x');
+    QCOMPARE(::send(acquired.socket, tooLong.constData(), tooLong.size(), 0), tooLong.size());
+    QCOMPARE(::send(acquired.socket, "\x05", 1, 0), ssize_t(1));
+    QTRY_COMPARE(valueSpy.size(), 1);
+    QCOMPARE(valueSpy.at(0).at(1).toByteArray(), "\x05"_ba);
+    QVERIFY(characteristic.writeAcquired());
+}
+
+void tst_BluezPeripheralObjects::acquireWriteNotSupported()
+{
+    QtBluezPeripheralCharacteristic characteristic(
+                characteristicData(QLowEnergyCharacteristic::Write
+                                   | QLowEnergyCharacteristic::Read),
+                servicePath, 0, 0x10, nullptr);
+    QVERIFY(characteristic.registerObject());
+    const auto interfaceProperties = characteristic.properties().value(
+                u"org.bluez.GattCharacteristic1"_s);
+    QVERIFY(!interfaceProperties.contains(u"WriteAcquired"_s));
+    QVERIFY(!interfaceProperties.contains(u"NotifyAcquired"_s));
+
+    Acquired acquired = acquire(characteristic, u"AcquireWrite"_s, 247);
+    QCOMPARE(acquired.socket, -1);
+    QCOMPARE(acquired.error, u"org.bluez.Error.NotSupported"_s);
+    acquired = acquire(characteristic, u"AcquireNotify"_s, 247);
+    QCOMPARE(acquired.socket, -1);
+    QCOMPARE(acquired.error, u"org.bluez.Error.NotSupported"_s);
+}
+
+void tst_BluezPeripheralObjects::acquireNotify()
+{
+    QtBluezPeripheralCharacteristic characteristic(
+                characteristicData(QLowEnergyCharacteristic::Notify
+                                   | QLowEnergyCharacteristic::Read),
+                servicePath, 0, 0x10, nullptr);
+    QVERIFY(characteristic.registerObject());
+    const auto interfaceProperties = characteristic.properties().value(
+                u"org.bluez.GattCharacteristic1"_s);
+    QVERIFY(interfaceProperties.contains(u"NotifyAcquired"_s));
+
+    const Acquired acquired = acquire(characteristic, u"AcquireNotify"_s, 185);
+    QVERIFY2(acquired.socket != -1, qPrintable(acquired.error));
+    QCOMPARE(acquired.mtu, quint16(185));
+    QVERIFY(characteristic.notifyAcquired());
+
+    // A second acquire is rejected while the first one is active
+    const Acquired second = acquire(characteristic, u"AcquireNotify"_s, 185);
+    QCOMPARE(second.socket, -1);
+    QCOMPARE(second.error, u"org.bluez.Error.NotPermitted"_s);
+
+    // Local value updates are delivered through the socket, one datagram each
+    const QList<QByteArray> values{"\x01"_ba, "\x02\x03"_ba, QByteArray(20, 'y')};
+    for (const auto &value : values)
+        QVERIFY(characteristic.localValueUpdate(value));
+    for (const auto &value : values)
+        QCOMPARE(readNotification(acquired.socket), value);
+    QVERIFY(readNotification(acquired.socket).isEmpty());
+
+    // Invalid values are neither stored nor sent
+    QVERIFY(!characteristic.localValueUpdate(QByteArray(21, 'z')));
+    QVERIFY(readNotification(acquired.socket).isEmpty());
+
+    // Remote client disabling notifications makes bluetoothd close the socket
+    ::close(acquired.socket);
+    QTRY_VERIFY(!characteristic.notifyAcquired());
+}
+
+void tst_BluezPeripheralObjects::acquireNotifyBurst()
+{
+    QtBluezPeripheralCharacteristic characteristic(
+                characteristicData(QLowEnergyCharacteristic::Notify),
+                servicePath, 0, 0x10, nullptr);
+    QVERIFY(characteristic.registerObject());
+
+    const Acquired acquired = acquire(characteristic, u"AcquireNotify"_s, 23);
+    QVERIFY2(acquired.socket != -1, qPrintable(acquired.error));
+    const auto closeSocket = qScopeGuard([&acquired]() { ::close(acquired.socket); });
+
+    // More notifications than the socket holds, bluetoothd does not read them
+    // in time. The acquisition stays and the latest value is sent later.
+    QByteArray value;
+    for (int i = 0; i < 10000; ++i) {
+        value = QByteArray::number(i);
+        QVERIFY(characteristic.localValueUpdate(value));
+    }
+    QVERIFY(characteristic.notifyAcquired());
+
+    QByteArray last;
+    QVERIFY(waitFor([&]() {
+        for (QByteArray read = readNotification(acquired.socket); !read.isEmpty();
+             read = readNotification(acquired.socket)) {
+            last = read;
+        }
+        return last == value;
+    }));
+    QVERIFY(characteristic.notifyAcquired());
+}
+
+void tst_BluezPeripheralObjects::acquireNotifyFallback()
+{
+    QtBluezPeripheralCharacteristic characteristic(
+                characteristicData(QLowEnergyCharacteristic::Notify),
+                servicePath, 0, 0x10, nullptr);
+    QVERIFY(characteristic.registerObject());
+
+    const Acquired acquired = acquire(characteristic, u"AcquireNotify"_s, 23);
+    QVERIFY2(acquired.socket != -1, qPrintable(acquired.error));
+    ::close(acquired.socket);
+
+    // Even if the notifier did not yet run, a failing write releases the
+    // socket and the value is still stored for DBus based access
+    QVERIFY(characteristic.localValueUpdate("\x07"_ba));
+    QTRY_VERIFY(!characteristic.notifyAcquired());
+    QString error;
+    QCOMPARE(characteristic.ReadValue({}, error), "\x07"_ba);
+    QVERIFY(error.isEmpty());
+}
+
+QTEST_MAIN(tst_BluezPeripheralObjects)
+
+#include "tst_bluezperipheralobjects.moc"
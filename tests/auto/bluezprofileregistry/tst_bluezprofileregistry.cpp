@@ -0,0 +1,243 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/private/bluezprofileregistry_p.h>
+
+#include <atomic>
+#include <memory>
+
+#include <unistd.h>
+
+#include "../../shared/fakebluetoothd_p.h"
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static const QString firstUuid = u"00001101-0000-1000-8000-00805f9b34fb"_s;
+static const QString secondUuid = u"00001102-0000-1000-8000-00805f9b34fb"_s;
+
+static QString devicePath(int index)
+{
+    return fakeAdapterPath + u"/dev_00_11_22_33_44_%1"_s.arg(index, 2, 10, QChar(u'0'));
+}
+
+// The path of the profile object passed to the nth RegisterProfile() call
+static QString registeredPath(FakeBluetoothd *bluetoothd, qsizetype index)
+{
+    const QList<QVariantList> calls = bluetoothd->calls(u"RegisterProfile"_s);
+    if (calls.size() <= index || calls.at(index).isEmpty())
+        return {};
+    return calls.at(index).constFirst().value<QDBusObjectPath>().path();
+}
+
+class tst_BluezProfileRegistry : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void sharedRegistration();
+    void unregisterOnLastRelease();
+    void connectionsByDevice();
+    void otherThread();
+
+private:
+    void handOverConnection(const QString &profilePath, const QString &devicePath);
+
+    FakeSystemBus m_bus;
+    FakeBluetoothd *m_bluetoothd = nullptr;
+};
+
+void tst_BluezProfileRegistry::initTestCase()
+{
+    if (!FakeSystemBus::isSupported())
+        QSKIP("dbus-daemon is needed for the private bus");
+
+    QVERIFY(m_bus.start());
+    m_bluetoothd = m_bus.bluetoothd();
+}
+
+void tst_BluezProfileRegistry::cleanupTestCase()
+{
+    m_bus.stop();
+}
+
+void tst_BluezProfileRegistry::init()
+{
+    m_bluetoothd->resetCalls();
+}
+
+void tst_BluezProfileRegistry::cleanup()
+{
+    // All profiles are released at the end of a test, their paths are reused
+    QVERIFY(waitFor([this]() {
+        return m_bluetoothd->calls(u"UnregisterProfile"_s).size()
+                == m_bluetoothd->calls(u"RegisterProfile"_s).size();
+    }));
+}
+
+void tst_BluezProfileRegistry::handOverConnection(const QString &profilePath,
+                                                  const QString &devicePath)
+{
+    int fds[2];
+    QCOMPARE(::pipe(fds), 0);
+    // The descriptor is duplicated, ours are closed right away
+    const QDBusUnixFileDescriptor fd(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+    m_bluetoothd->newConnection(QDBusConnection::systemBus().baseService(), profilePath,
+                                devicePath, fd);
+}
+
+void tst_BluezProfileRegistry::sharedRegistration()
+{
+    QtBluezProfileRegistry registry;
+    QObject owner;
+
+    QtBluezProfileClient *first = registry.acquire(firstUuid, devicePath(0), &owner);
+    QVERIFY(first);
+    QCOMPARE(first->parent(), &owner);
+    QCOMPARE(first->uuid(), firstUuid);
+    QCOMPARE(first->devicePath(), devicePath(0));
+    QVERIFY(!first->isRegistered());
+    QSignalSpy finishedSpy(first, &QtBluezProfileClient::registrationFinished);
+
+    // A second client of the UUID shares the pending registration
+    QtBluezProfileClient *second = registry.acquire(firstUuid, devicePath(1), &owner);
+    QVERIFY(second);
+    QSignalSpy secondFinishedSpy(second, &QtBluezProfileClient::registrationFinished);
+
+    QVERIFY(waitFor([&]() { return registry.isRegistered(firstUuid); }));
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(finishedSpy.at(0).at(0).toBool(), true);
+    QCOMPARE(secondFinishedSpy.size(), 1);
+    QVERIFY(first->isRegistered());
+    QVERIFY(second->isRegistered());
+
+    // Once registered, new clients do not wait
+    QtBluezProfileClient *third = registry.acquire(firstUuid, devicePath(2), &owner);
+    QVERIFY(third);
+    QVERIFY(third->isRegistered());
+
+    // Every UUID has a profile of its own
+    QtBluezProfileClient *other = registry.acquire(secondUuid, devicePath(0), &owner);
+    QVERIFY(other);
+    QVERIFY(waitFor([&]() { return registry.isRegistered(secondUuid); }));
+
+    const QList<QVariantList> calls = m_bluetoothd->calls(u"RegisterProfile"_s);
+    QCOMPARE(calls.size(), qsizetype(2));
+    QCOMPARE(calls.at(0).at(1).toString(), firstUuid);
+    QCOMPARE(calls.at(1).at(1).toString(), secondUuid);
+    QVERIFY(registeredPath(m_bluetoothd, 0) != registeredPath(m_bluetoothd, 1));
+}
+
+void tst_BluezProfileRegistry::unregisterOnLastRelease()
+{
+    QtBluezProfileRegistry registry;
+
+    std::unique_ptr<QtBluezProfileClient> first(
+            registry.acquire(firstUuid, devicePath(0), nullptr));
+    std::unique_ptr<QtBluezProfileClient> second(
+            registry.acquire(firstUuid, devicePath(1), nullptr));
+    std::unique_ptr<QtBluezProfileClient> other(
+            registry.acquire(secondUuid, devicePath(0), nullptr));
+    QVERIFY(first && second && other);
+    QVERIFY(waitFor([&]() {
+        return registry.isRegistered(firstUuid) && registry.isRegistered(secondUuid);
+    }));
+    const QString profilePath = registeredPath(m_bluetoothd, 0);
+    QVERIFY(!profilePath.isEmpty());
+
+    // The profile stays registered while a client uses it
+    first.reset();
+    QTest::qWait(50);
+    QVERIFY(m_bluetoothd->calls(u"UnregisterProfile"_s).isEmpty());
+    QVERIFY(registry.isRegistered(firstUuid));
+    QVERIFY(second->isRegistered());
+
+    second.reset();
+    QVERIFY(!registry.isRegistered(firstUuid));
+    QVERIFY(waitFor([&]() {
+        return !m_bluetoothd->calls(u"UnregisterProfile"_s).isEmpty();
+    }));
+    const QList<QVariantList> calls = m_bluetoothd->calls(u"UnregisterProfile"_s);
+    QCOMPARE(calls.size(), qsizetype(1));
+    QCOMPARE(calls.constFirst().constFirst().value<QDBusObjectPath>().path(), profilePath);
+    QVERIFY(registry.isRegistered(secondUuid));
+
+    // The next client registers the profile again
+    first.reset(registry.acquire(firstUuid, devicePath(0), nullptr));
+    QVERIFY(first);
+    QVERIFY(waitFor([&]() { return registry.isRegistered(firstUuid); }));
+    QCOMPARE(m_bluetoothd->calls(u"RegisterProfile"_s).size(), qsizetype(3));
+    QCOMPARE(registeredPath(m_bluetoothd, 2), profilePath);
+}
+
+void tst_BluezProfileRegistry::connectionsByDevice()
+{
+    QtBluezProfileRegistry registry;
+    QObject owner;
+
+    QtBluezProfileClient *first = registry.acquire(firstUuid, devicePath(0), &owner);
+    QtBluezProfileClient *second = registry.acquire(firstUuid, devicePath(1), &owner);
+    QVERIFY(first && second);
+    QVERIFY(waitFor([&]() { return registry.isRegistered(firstUuid); }));
+    const QString profilePath = registeredPath(m_bluetoothd, 0);
+
+    QSignalSpy firstSpy(first, &QtBluezProfileClient::newConnection);
+    QSignalSpy secondSpy(second, &QtBluezProfileClient::newConnection);
+
+    // The connection goes to the client of the device, not the first one
+    handOverConnection(profilePath, devicePath(1));
+    QVERIFY(waitFor([&]() { return secondSpy.size() == 1; }));
+    QVERIFY(firstSpy.isEmpty());
+    QVERIFY(secondSpy.at(0).at(0).value<QDBusUnixFileDescriptor>().isValid());
+
+    // A client gets a single connection, the others are dropped
+    QTest::ignoreMessage(QtWarningMsg,
+                         QRegularExpression(u"No socket is waiting for the connection of"_s));
+    handOverConnection(profilePath, devicePath(1));
+    handOverConnection(profilePath, devicePath(0));
+    QVERIFY(waitFor([&]() { return firstSpy.size() == 1; }));
+    QCOMPARE(secondSpy.size(), 1);
+}
+
+void tst_BluezProfileRegistry::otherThread()
+{
+    QtBluezProfileRegistry registry;
+    QCOMPARE(registry.thread(), QThread::currentThread());
+
+    // The registry registers and unregisters the profile in its own thread,
+    // while the client lives and dies in another one
+    std::atomic<bool> registered = false;
+    std::unique_ptr<QThread> user(QThread::create([&]() {
+        std::unique_ptr<QtBluezProfileClient> client(
+                registry.acquire(firstUuid, devicePath(0), nullptr));
+        if (!client)
+            return;
+        QDeadlineTimer deadline(5000);
+        while (!client->isRegistered() && !deadline.hasExpired())
+            QThread::msleep(10);
+        registered = client->isRegistered();
+    }));
+    user->start();
+    QVERIFY(waitFor([&]() { return user->isFinished(); }));
+    QVERIFY(registered);
+
+    QVERIFY(waitFor([&]() {
+        return !m_bluetoothd->calls(u"UnregisterProfile"_s).isEmpty();
+    }));
+    QVERIFY(!registry.isRegistered(firstUuid));
+    QCOMPARE(m_bluetoothd->calls(u"RegisterProfile"_s).size(), qsizetype(1));
+}
+
+QTEST_MAIN(tst_BluezProfileRegistry)
+
+#include "tst_bluezprofileregistry.moc"
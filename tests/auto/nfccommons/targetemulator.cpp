@@ -243,7 +243,7 @@ QByteArray NfcTagType1::processCommand(const QByteArray &command)
 
 
 NfcTagType2::NfcTagType2()
-:   memory(64, 0x00), currentSector(0), expectPacket2(false)
+:   memory(64, 0x00), currentSector(0), expectPacket2(false), fastReadSupported(false)
 {
 }
 
@@ -256,6 +256,7 @@ void NfcTagType2::load(QSettings *settings)
     settings->beginGroup(QStringLiteral("TagType2"));
 
     memory = settings->value(QStringLiteral("Data")).toByteArray();
+    fastReadSupported = settings->value(QStringLiteral("FastRead"), false).toBool();
 
     settings->endGroup();
 }
@@ -267,6 +268,21 @@ QByteArray NfcTagType2::uid() const
     return memory.left(3) + memory.mid(4, 4);
 }
 
+QByteArray NfcTagType2::data() const
+{
+    return memory;
+}
+
+void NfcTagType2::setData(const QByteArray &data)
+{
+    memory = data;
+}
+
+void NfcTagType2::setFastReadSupported(bool supported)
+{
+    fastReadSupported = supported;
+}
+
 #define NACK QByteArray("\x05")
 #define ACK QByteArray("\x0a")
 
@@ -304,6 +320,19 @@ QByteArray NfcTagType2::processCommand(const QByteArray &command)
 
         break;
     }
+    case 0x3a: {    // FAST_READ
+        if (!fastReadSupported)
+            return NACK;
+
+        quint8 startBlock = command.at(1);
+        quint8 endBlock = command.at(2);
+        if (endBlock < startBlock || (endBlock + 1) * 4 > memory.size())
+            return NACK;
+
+        response.append(memory.mid(startBlock * 4, (endBlock - startBlock + 1) * 4));
+
+        break;
+    }
     case 0xa2: {    // WRITE BLOCK
         quint8 block = command.at(1);
         int absoluteBlock = currentSector * 256 + block;
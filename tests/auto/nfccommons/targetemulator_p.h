@@ -75,10 +75,17 @@ public:
 
     QByteArray uid() const override;
 
+    QByteArray data() const;
+    void setData(const QByteArray &data);
+
+    // NTAG21x FAST_READ command, MIFARE Ultralight does not support it
+    void setFastReadSupported(bool supported);
+
 private:
     QByteArray memory;
     quint8 currentSector;
     bool expectPacket2;
+    bool fastReadSupported;
 };
 
 QT_END_NAMESPACE
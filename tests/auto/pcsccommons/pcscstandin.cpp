@@ -0,0 +1,477 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "pcscstandin_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+
+#include <winscard.h>
+#include <reader.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+constexpr char PnpNotificationReader[] = "\\\\?PnP?\\Notification";
+
+struct Reader
+{
+    QByteArray name;
+    PcscStandIn::CardHandler card;
+    // Identifies the inserted card, handles to removed cards become invalid
+    quint64 cardId = 0;
+    quint16 eventCount = 0;
+    std::chrono::milliseconds transmitDelay { 0 };
+    int maxInput = 0;
+
+    DWORD state() const
+    {
+        return (DWORD(eventCount) << 16) | (card ? SCARD_STATE_PRESENT : SCARD_STATE_EMPTY);
+    }
+};
+
+struct Context
+{
+    int waiting = 0;
+    bool cancelled = false;
+};
+
+struct Handle
+{
+    QByteArray reader;
+    quint64 cardId = 0;
+};
+
+struct StandIn
+{
+    QMutex mutex;
+    QWaitCondition changed;
+
+    QList<Reader> readers;
+    QHash<SCARDCONTEXT, Context> contexts;
+    QHash<SCARDHANDLE, Handle> handles;
+    SCARDCONTEXT nextContext = 1;
+    SCARDHANDLE nextHandle = 1;
+    quint64 nextCardId = 1;
+
+    PcscStandIn::Statistics statistics;
+    int blockedCalls = 0;
+
+    Reader *findReader(const QByteArray &name)
+    {
+        for (auto &reader : readers) {
+            if (reader.name == name)
+                return &reader;
+        }
+        return nullptr;
+    }
+
+    // Returns the reader if the card the handle was created for is still there
+    Reader *findCard(SCARDHANDLE handle)
+    {
+        const auto it = handles.constFind(handle);
+        if (it == handles.cend())
+            return nullptr;
+        Reader *reader = findReader(it->reader);
+        if (!reader || reader->cardId != it->cardId)
+            return nullptr;
+        return reader;
+    }
+
+    void notifyChange() { changed.wakeAll(); }
+};
+
+Q_GLOBAL_STATIC(StandIn, standIn)
+
+} // unnamed namespace
+
+namespace PcscStandIn {
+
+void reset()
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    s->readers.clear();
+    s->handles.clear();
+    s->statistics = {};
+    s->notifyChange();
+}
+
+void addReader(const QByteArray &name)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    if (s->findReader(name))
+        return;
+    s->readers.append(Reader{ name, {}, 0, 0, {} });
+    s->notifyChange();
+}
+
+void removeReader(const QByteArray &name)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    s->readers.removeIf([&name](const Reader &reader) { return reader.name == name; });
+    s->notifyChange();
+}
+
+void insertCard(const QByteArray &reader, CardHandler card)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    Reader *r = s->findReader(reader);
+    Q_ASSERT(r != nullptr);
+    r->card = std::move(card);
+    r->cardId = s->nextCardId++;
+    ++r->eventCount;
+    s->notifyChange();
+}
+
+void removeCard(const QByteArray &reader)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    Reader *r = s->findReader(reader);
+    if (!r || !r->card)
+        return;
+    r->card = {};
+    r->cardId = 0;
+    ++r->eventCount;
+    s->notifyChange();
+}
+
+void setTransmitDelay(const QByteArray &reader, std::chrono::milliseconds delay)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    Reader *r = s->findReader(reader);
+    Q_ASSERT(r != nullptr);
+    r->transmitDelay = delay;
+}
+
+void setMaxInput(const QByteArray &reader, int maxInput)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    Reader *r = s->findReader(reader);
+    Q_ASSERT(r != nullptr);
+    r->maxInput = maxInput;
+}
+
+Statistics statistics()
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    return s->statistics;
+}
+
+int openContexts()
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    return int(s->contexts.size());
+}
+
+int blockedCalls()
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    return s->blockedCalls;
+}
+
+bool waitForBlockedCalls(int count, QDeadlineTimer deadline)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    while (s->blockedCalls != count) {
+        if (!s->changed.wait(&s->mutex, deadline))
+            return s->blockedCalls == count;
+    }
+    return true;
+}
+
+} // namespace PcscStandIn
+
+QT_END_NAMESPACE
+
+QT_USE_NAMESPACE
+
+/*
+    The PCSCLite API used by the PC/SC backend. The declarations from
+    winscard.h give these functions C linkage.
+*/
+
+LONG SCardEstablishContext(DWORD dwScope, LPCVOID, LPCVOID, LPSCARDCONTEXT phContext)
+{
+    Q_UNUSED(dwScope);
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    *phContext = s->nextContext++;
+    s->contexts.insert(*phContext, Context{});
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardReleaseContext(SCARDCONTEXT hContext)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    return s->contexts.remove(hContext) ? SCARD_S_SUCCESS : SCARD_E_INVALID_HANDLE;
+}
+
+LONG SCardListReaders(SCARDCONTEXT hContext, LPCSTR, LPSTR mszReaders, LPDWORD pcchReaders)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    if (!s->contexts.contains(hContext))
+        return SCARD_E_INVALID_HANDLE;
+    if (s->readers.isEmpty())
+        return SCARD_E_NO_READERS_AVAILABLE;
+
+    QByteArray list;
+    for (const auto &reader : std::as_const(s->readers))
+        list += reader.name + '\0';
+    list += '\0';
+
+    if (*pcchReaders == SCARD_AUTOALLOCATE) {
+        char *buffer = static_cast<char *>(malloc(list.size()));
+        memcpy(buffer, list.constData(), list.size());
+        *reinterpret_cast<LPSTR *>(mszReaders) = buffer;
+    } else if (mszReaders) {
+        if (*pcchReaders < DWORD(list.size())) {
+            *pcchReaders = list.size();
+            return SCARD_E_INSUFFICIENT_BUFFER;
+        }
+        memcpy(mszReaders, list.constData(), list.size());
+    }
+    *pcchReaders = list.size();
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardFreeMemory(SCARDCONTEXT, LPCVOID pvMem)
+{
+    free(const_cast<void *>(pvMem));
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardGetStatusChange(SCARDCONTEXT hContext, DWORD dwTimeout,
+                          SCARD_READERSTATE *rgReaderStates, DWORD cReaders)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    if (!s->contexts.contains(hContext))
+        return SCARD_E_INVALID_HANDLE;
+
+    ++s->statistics.statusChangeCalls;
+    if (dwTimeout == 0)
+        ++s->statistics.pollingCalls;
+
+    const QDeadlineTimer deadline = dwTimeout == INFINITE
+            ? QDeadlineTimer(QDeadlineTimer::Forever)
+            : QDeadlineTimer(qint64(dwTimeout));
+
+    while (true) {
+        bool changed = false;
+        bool unknownReader = false;
+        for (DWORD i = 0; i < cReaders; ++i) {
+            auto &readerState = rgReaderStates[i];
+            const QByteArray name(readerState.szReader);
+
+            DWORD state;
+            if (name == PnpNotificationReader) {
+                state = DWORD(s->readers.size()) << 16;
+            } else if (const Reader *reader = s->findReader(name)) {
+                state = reader->state();
+            } else {
+                state = SCARD_STATE_UNKNOWN;
+                unknownReader = true;
+            }
+
+            if (readerState.dwCurrentState == SCARD_STATE_UNAWARE
+                || (readerState.dwCurrentState & ~SCARD_STATE_CHANGED) != state) {
+                readerState.dwEventState = state | SCARD_STATE_CHANGED;
+                changed = true;
+            } else {
+                readerState.dwEventState = readerState.dwCurrentState;
+            }
+        }
+
+        if (unknownReader)
+            return SCARD_E_UNKNOWN_READER;
+        if (changed)
+            return SCARD_S_SUCCESS;
+        if (dwTimeout == 0 || deadline.hasExpired())
+            return SCARD_E_TIMEOUT;
+
+        Context &context = s->contexts[hContext];
+        if (context.cancelled) {
+            context.cancelled = false;
+            return SCARD_E_CANCELLED;
+        }
+
+        ++context.waiting;
+        ++s->blockedCalls;
+        s->notifyChange();
+        s->changed.wait(&s->mutex, deadline);
+        --s->blockedCalls;
+        s->notifyChange();
+
+        // The context may have been released while waiting
+        const auto it = s->contexts.find(hContext);
+        if (it == s->contexts.end())
+            return SCARD_E_INVALID_HANDLE;
+        --it->waiting;
+        if (it->cancelled) {
+            it->cancelled = false;
+            return SCARD_E_CANCELLED;
+        }
+    }
+}
+
+LONG SCardCancel(SCARDCONTEXT hContext)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    const auto it = s->contexts.find(hContext);
+    if (it == s->contexts.end())
+        return SCARD_E_INVALID_HANDLE;
+
+    ++s->statistics.cancelCalls;
+    // Like in PCSCLite, only a call that is already blocking is cancelled
+    if (it->waiting > 0) {
+        it->cancelled = true;
+        s->notifyChange();
+    }
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardConnect(SCARDCONTEXT hContext, LPCSTR szReader, DWORD, DWORD, LPSCARDHANDLE phCard,
+                  LPDWORD pdwActiveProtocol)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    if (!s->contexts.contains(hContext))
+        return SCARD_E_INVALID_HANDLE;
+
+    const Reader *reader = s->findReader(QByteArray(szReader));
+    if (!reader)
+        return SCARD_E_UNKNOWN_READER;
+    if (!reader->card)
+        return SCARD_E_NO_SMARTCARD;
+
+    *phCard = s->nextHandle++;
+    s->handles.insert(*phCard, Handle{ reader->name, reader->cardId });
+    *pdwActiveProtocol = SCARD_PROTOCOL_T1;
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardReconnect(SCARDHANDLE hCard, DWORD, DWORD, DWORD, LPDWORD pdwActiveProtocol)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    if (!s->findCard(hCard))
+        return SCARD_W_REMOVED_CARD;
+    *pdwActiveProtocol = SCARD_PROTOCOL_T1;
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardDisconnect(SCARDHANDLE hCard, DWORD)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    return s->handles.remove(hCard) ? SCARD_S_SUCCESS : SCARD_E_INVALID_HANDLE;
+}
+
+LONG SCardBeginTransaction(SCARDHANDLE hCard)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    if (!s->findCard(hCard))
+        return SCARD_W_REMOVED_CARD;
+    ++s->statistics.transactionCalls;
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardEndTransaction(SCARDHANDLE hCard, DWORD)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    return s->findCard(hCard) ? SCARD_S_SUCCESS : SCARD_W_REMOVED_CARD;
+}
+
+LONG SCardStatus(SCARDHANDLE hCard, LPSTR, LPDWORD, LPDWORD pdwState, LPDWORD pdwProtocol, LPBYTE,
+                 LPDWORD)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    if (!s->findCard(hCard))
+        return SCARD_W_REMOVED_CARD;
+    if (pdwState)
+        *pdwState = SCARD_PRESENT | SCARD_POWERED | SCARD_SPECIFIC;
+    if (pdwProtocol)
+        *pdwProtocol = SCARD_PROTOCOL_T1;
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardTransmit(SCARDHANDLE hCard, const SCARD_IO_REQUEST *, LPCBYTE pbSendBuffer,
+                   DWORD cbSendLength, SCARD_IO_REQUEST *, LPBYTE pbRecvBuffer,
+                   LPDWORD pcbRecvLength)
+{
+    StandIn *s = standIn();
+    PcscStandIn::CardHandler card;
+    std::chrono::milliseconds delay;
+    {
+        QMutexLocker locker(&s->mutex);
+        const Reader *reader = s->findCard(hCard);
+        if (!reader)
+            return SCARD_W_REMOVED_CARD;
+        card = reader->card;
+        delay = reader->transmitDelay;
+        ++s->statistics.transmitCalls;
+    }
+
+    // The card is called without holding the lock, it may take its time
+    if (delay.count() > 0)
+        QThread::msleep(delay.count());
+    const QByteArray response =
+            card(QByteArray(reinterpret_cast<const char *>(pbSendBuffer), cbSendLength));
+    if (DWORD(response.size()) > *pcbRecvLength)
+        return SCARD_E_INSUFFICIENT_BUFFER;
+
+    memcpy(pbRecvBuffer, response.constData(), response.size());
+    *pcbRecvLength = response.size();
+    return SCARD_S_SUCCESS;
+}
+
+LONG SCardGetAttrib(SCARDHANDLE hCard, DWORD dwAttrId, LPBYTE pbAttr, LPDWORD pcbAttrLen)
+{
+    StandIn *s = standIn();
+    QMutexLocker locker(&s->mutex);
+    const Reader *reader = s->findCard(hCard);
+    if (!reader)
+        return SCARD_W_REMOVED_CARD;
+    if (dwAttrId != SCARD_ATTR_MAXINPUT || reader->maxInput == 0)
+        return SCARD_E_UNSUPPORTED_FEATURE;
+
+    const uint32_t maxInput = reader->maxInput;
+    if (*pcbAttrLen < sizeof(maxInput))
+        return SCARD_E_INSUFFICIENT_BUFFER;
+    memcpy(pbAttr, &maxInput, sizeof(maxInput));
+    *pcbAttrLen = sizeof(maxInput);
+    return SCARD_S_SUCCESS;
+}
+
+const char *pcsc_stringify_error(const LONG pcscError)
+{
+    thread_local char buffer[32];
+    std::snprintf(buffer, sizeof buffer, "stand-in error 0x%08lX",
+                  static_cast<unsigned long>(pcscError));
+    return buffer;
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef PCSCSTANDIN_P_H
+#define PCSCSTANDIN_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDeadlineTimer>
+
+#include <chrono>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    In-process replacement for the PCSCLite client library. Test executables
+    export its SCard functions, which the PC/SC backend of QtNfc then calls
+    instead of the ones of libpcsclite. Tests control the readers and cards
+    through the functions below. All functions are thread
+    safe.
+
+    A card is a function mapping each command APDU to its response APDU.
+*/
+namespace PcscStandIn {
+
+using CardHandler = std::function<QByteArray(const QByteArray &command)>;
+
+struct Statistics
+{
+    int statusChangeCalls = 0;
+    // SCardGetStatusChange() calls with a zero timeout
+    int pollingCalls = 0;
+    int cancelCalls = 0;
+    int transactionCalls = 0;
+    int transmitCalls = 0;
+};
+
+void reset();
+
+void addReader(const QByteArray &name);
+void removeReader(const QByteArray &name);
+void insertCard(const QByteArray &reader, CardHandler card);
+void removeCard(const QByteArray &reader);
+// Latency added to every SCardTransmit() call on the reader
+void setTransmitDelay(const QByteArray &reader, std::chrono::milliseconds delay);
+// SCARD_ATTR_MAXINPUT reported for the reader, zero if it is not supported
+void setMaxInput(const QByteArray &reader, int maxInput);
+
+Statistics statistics();
+
+// The number of contexts established and not released yet
+int openContexts();
+
+// The number of SCardGetStatusChange() calls currently waiting for a change
+int blockedCalls();
+bool waitForBlockedCalls(int count, QDeadlineTimer deadline = QDeadlineTimer(5000));
+
+} // namespace PcscStandIn
+
+QT_END_NAMESPACE
+
+#endif // PCSCSTANDIN_P_H
@@ -6,6 +6,7 @@
 #include <QDebug>
 
 #include <qbluetoothaddress.h>
+#include <QtBluetooth/private/qbluetoothaddress_p.h>
 
 QT_USE_NAMESPACE
 
@@ -31,6 +32,11 @@ private slots:
 
     void tst_clear_data();
     void tst_clear();
+
+    void tst_invalidStrings_data();
+    void tst_invalidStrings();
+
+    void tst_stringViews();
 };
 
 tst_QBluetoothAddress::tst_QBluetoothAddress()
@@ -207,6 +213,50 @@ void tst_QBluetoothAddress::tst_clear()
     QVERIFY(address.toString() == QString("00:00:00:00:00:00"));
 }
 
+void tst_QBluetoothAddress::tst_invalidStrings_data()
+{
+    QTest::addColumn<QString>("addressString");
+
+    QTest::newRow("too short") << QString("11:22:33:44:55");
+    QTest::newRow("too long") << QString("11:22:33:44:55:66:77");
+    QTest::newRow("misplaced colons") << QString("1122:33:44:55:66:");
+    QTest::newRow("wrong separator") << QString("11-22-33-44-55-66");
+    QTest::newRow("no hex digit") << QString("11:22:33:44:55:6G");
+    QTest::newRow("no hex digit without colons") << QString("11223344556G");
+    QTest::newRow("non-latin1") << QString(u"11:22:33:44:55:6٦");
+}
+
+void tst_QBluetoothAddress::tst_invalidStrings()
+{
+    QFETCH(QString, addressString);
+
+    QVERIFY(QBluetoothAddress(addressString).isNull());
+    QVERIFY(QtBluetoothPrivate::addressFromString(QStringView(addressString)).isNull());
+}
+
+void tst_QBluetoothAddress::tst_stringViews()
+{
+    const QBluetoothAddress address(Q_UINT64_C(0x0123456789AB));
+
+    QCOMPARE(QtBluetoothPrivate::addressFromString(QLatin1StringView("01:23:45:67:89:ab")),
+             address);
+    QCOMPARE(QtBluetoothPrivate::addressFromString(QByteArrayView("0123456789AB")), address);
+    QCOMPARE(QtBluetoothPrivate::addressFromString(QStringView(u"01_23_45_67_89_AB"), '_'),
+             address);
+    QVERIFY(QtBluetoothPrivate::addressFromString(QLatin1StringView("01_23_45_67_89_AB"))
+                    .isNull());
+
+    char buffer[QtBluetoothPrivate::AddressStringLength];
+    char *end = QtBluetoothPrivate::toAddressString(address, buffer);
+    QCOMPARE(end - buffer, QtBluetoothPrivate::AddressStringLength);
+    QCOMPARE(QLatin1StringView(buffer, end), QStringView(u"01:23:45:67:89:AB"));
+
+    char16_t pathBuffer[QtBluetoothPrivate::AddressStringLength];
+    QtBluetoothPrivate::toAddressString(address, pathBuffer, '_');
+    QCOMPARE(QStringView(pathBuffer, QtBluetoothPrivate::AddressStringLength),
+             QStringView(u"01_23_45_67_89_AB"));
+}
+
 QTEST_MAIN(tst_QBluetoothAddress)
 
 #include "tst_qbluetoothaddress.moc"
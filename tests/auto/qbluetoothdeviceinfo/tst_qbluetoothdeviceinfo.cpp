@@ -11,6 +11,8 @@
 #include <qbluetoothlocaldevice.h>
 #include <qbluetoothuuid.h>
 
+#include <QtBluetooth/private/qbluetoothdeviceinfo_p.h>
+
 QT_USE_NAMESPACE
 
 Q_DECLARE_METATYPE(QBluetoothDeviceInfo::ServiceClasses)
@@ -41,6 +43,11 @@ private slots:
     void tst_flags();
 
     void tst_manufacturerData();
+    void tst_serviceData();
+
+    void tst_sharedCopies();
+    void tst_internedNames();
+    void tst_memoryFootprint();
 };
 
 tst_QBluetoothDeviceInfo::tst_QBluetoothDeviceInfo()
@@ -523,6 +530,103 @@ void tst_QBluetoothDeviceInfo::tst_manufacturerData()
     QCOMPARE(info.manufacturerData(manufacturerAVM), QByteArray::fromHex("CDEF"));
 }
 
+void tst_QBluetoothDeviceInfo::tst_serviceData()
+{
+    const QBluetoothUuid heartRate(QBluetoothUuid::ServiceClassUuid::HeartRate);
+    const QBluetoothUuid battery(QBluetoothUuid::ServiceClassUuid::BatteryService);
+
+    QBluetoothDeviceInfo info;
+    QVERIFY(info.serviceIds().isEmpty());
+    QVERIFY(info.serviceData(heartRate).isNull());
+
+    QVERIFY(info.setServiceData(heartRate, QByteArray::fromHex("0102")));
+    QVERIFY(!info.setServiceData(heartRate, QByteArray::fromHex("0102")));
+    QVERIFY(info.setServiceData(battery, QByteArray::fromHex("64")));
+    QVERIFY(info.setServiceData(heartRate, QByteArray::fromHex("0304")));
+
+    QCOMPARE(info.serviceIds().size(), 3);
+    QCOMPARE(info.serviceIds().count(heartRate), 2);
+    QCOMPARE(info.serviceData().size(), 3);
+    QCOMPARE(info.serviceData().values(heartRate).size(), 2);
+    // return latest entry
+    QCOMPARE(info.serviceData(heartRate), QByteArray::fromHex("0304"));
+    QCOMPARE(info.serviceData(battery), QByteArray::fromHex("64"));
+
+    // the order in which the entries were advertised does not matter
+    QBluetoothDeviceInfo other;
+    other.setServiceData(battery, QByteArray::fromHex("64"));
+    other.setServiceData(heartRate, QByteArray::fromHex("0304"));
+    QVERIFY(info != other);
+    other.setServiceData(heartRate, QByteArray::fromHex("0102"));
+    QVERIFY(info == other);
+}
+
+void tst_QBluetoothDeviceInfo::tst_sharedCopies()
+{
+    QBluetoothDeviceInfo info(QBluetoothAddress("AABBCCDDEEFF"), QString("Tag"), 0);
+    info.setRssi(-60);
+    info.setManufacturerData(0x1F, QByteArray::fromHex("ABCD"));
+
+    QBluetoothDeviceInfo copy = info;
+    QCOMPARE(QBluetoothDeviceInfoPrivate::get(copy), QBluetoothDeviceInfoPrivate::get(info));
+
+    // setters that do not change anything keep sharing
+    copy.setRssi(-60);
+    QVERIFY(!copy.setManufacturerData(0x1F, QByteArray::fromHex("ABCD")));
+    QCOMPARE(QBluetoothDeviceInfoPrivate::get(copy), QBluetoothDeviceInfoPrivate::get(info));
+
+    copy.setRssi(-70);
+    QVERIFY(QBluetoothDeviceInfoPrivate::get(copy) != QBluetoothDeviceInfoPrivate::get(info));
+    QCOMPARE(info.rssi(), qint16(-60));
+    QCOMPARE(copy.rssi(), qint16(-70));
+
+    QBluetoothDeviceInfo assigned;
+    assigned = copy;
+    QVERIFY(assigned.setManufacturerData(0x1F, QByteArray::fromHex("CDEF")));
+    QCOMPARE(copy.manufacturerIds().size(), 1);
+    QCOMPARE(assigned.manufacturerIds().size(), 2);
+    QCOMPARE(assigned.address(), info.address());
+    QCOMPARE(assigned.name(), info.name());
+
+    // the packed classes keep all bits of the class of device
+    const QBluetoothDeviceInfo classes(QBluetoothAddress(), QString(), 0xfffffc);
+    QCOMPARE(classes.serviceClasses(), QBluetoothDeviceInfo::AllServices);
+    QCOMPARE(classes.majorDeviceClass(), QBluetoothDeviceInfo::UncategorizedDevice);
+    QCOMPARE(classes.minorDeviceClass(), quint8(0x3f));
+    QBluetoothDeviceInfo configured = classes;
+    configured.setCoreConfigurations(QBluetoothDeviceInfo::BaseRateAndLowEnergyCoreConfiguration);
+    QCOMPARE(configured.coreConfigurations(),
+             QBluetoothDeviceInfo::BaseRateAndLowEnergyCoreConfiguration);
+    QCOMPARE(classes.coreConfigurations(), QBluetoothDeviceInfo::UnknownCoreConfiguration);
+}
+
+void tst_QBluetoothDeviceInfo::tst_internedNames()
+{
+    // Each name is decoded into a string of its own
+    const QString first = QString::fromLatin1("Tag %1").arg(42);
+    const QString second = QString::fromLatin1("Tag %1").arg(42);
+    QVERIFY(first.constData() != second.constData());
+
+    QBluetoothDeviceInfo a(QBluetoothAddress("AABBCCDDEEFF"), first, 0);
+    QBluetoothDeviceInfo b(QBluetoothAddress("AABBCCDDEEF0"), second, 0);
+    QCOMPARE(b.name(), second);
+    QCOMPARE(b.name().constData(), a.name().constData());
+
+    QBluetoothDeviceInfo c;
+    c.setName(QString::fromLatin1("Tag %1").arg(42));
+    QCOMPARE(c.name().constData(), a.name().constData());
+    c.setName(QString());
+    QVERIFY(c.name().isEmpty());
+}
+
+void tst_QBluetoothDeviceInfo::tst_memoryFootprint()
+{
+    // The QMultiHash based layout took more than a kilobyte per device
+    // with one manufacturer and one service data entry. The heap use is
+    // reported by tst_bench_qbluetoothdeviceinfo.
+    QVERIFY(sizeof(QBluetoothDeviceInfoPrivate) <= 256);
+}
+
 QTEST_MAIN(tst_QBluetoothDeviceInfo)
 
 #include "tst_qbluetoothdeviceinfo.moc"
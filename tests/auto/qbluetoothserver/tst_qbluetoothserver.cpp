@@ -11,10 +11,30 @@
 #include <qbluetoothsocket.h>
 #include <qbluetoothlocaldevice.h>
 
+#if QT_CONFIG(bluez) && defined(QT_BUILD_INTERNAL)
+#include <QtBluetooth/private/qbluetoothserver_p.h>
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <memory>
+#endif
+
 QT_USE_NAMESPACE
 
 Q_DECLARE_METATYPE(QBluetooth::SecurityFlags)
 
+#if QT_CONFIG(bluez) && defined(QT_BUILD_INTERNAL)
+class AcceptQueueServer : public QBluetoothServer
+{
+public:
+    using QBluetoothServer::QBluetoothServer;
+    QBluetoothServerPrivate *d() const { return d_ptr; }
+};
+#endif
+
 class tst_QBluetoothServer : public QObject
 {
     Q_OBJECT
@@ -32,6 +52,9 @@ private slots:
     void tst_receive_data();
     void tst_receive();
 
+    void tst_acceptQueue();
+    void tst_acceptOutOfDescriptors();
+
     void setHostMode(const QBluetoothAddress &localAdapter, QBluetoothLocalDevice::HostMode newHostMode);
 
 private:
@@ -213,6 +236,140 @@ void tst_QBluetoothServer::tst_receive()
     QVERIFY(!server.hasPendingConnections());
 }
 
+void tst_QBluetoothServer::tst_acceptQueue()
+{
+#if !QT_CONFIG(bluez) || !defined(QT_BUILD_INTERNAL)
+    QSKIP("The accept queue is tested with BlueZ and a developer build only");
+#else
+    static constexpr int ConnectionCount = 20;
+    static constexpr int MaxPending = 8;
+
+    // A Unix domain socket stands in for the RFCOMM listening socket, the
+    // queue does not depend on the socket family
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    QVERIFY(listener >= 0);
+    QList<int> clients;
+    const auto closeSockets = qScopeGuard([&]() {
+        for (int client : std::as_const(clients))
+            ::close(client);
+        ::close(listener);
+    });
+
+    // An abstract address, nothing is left behind in the file system
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    const QByteArray name = "tst_qbluetoothserver_"
+            + QByteArray::number(QCoreApplication::applicationPid());
+    memcpy(address.sun_path + 1, name.constData(), name.size());
+    const socklen_t addressLength = socklen_t(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+    QCOMPARE(::bind(listener, reinterpret_cast<sockaddr *>(&address), addressLength), 0);
+    QCOMPARE(::listen(listener, ConnectionCount), 0);
+
+    AcceptQueueServer server(QBluetoothServiceInfo::RfcommProtocol);
+    server.setMaxPendingConnections(MaxPending);
+    QSignalSpy newConnectionSpy(&server, &QBluetoothServer::newConnection);
+    server.d()->startAccepting(listener);
+
+    for (int i = 0; i < ConnectionCount; ++i) {
+        const int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        QVERIFY(client >= 0);
+        clients.append(client);
+        QCOMPARE(::connect(client, reinterpret_cast<sockaddr *>(&address), addressLength), 0);
+    }
+
+    // The burst is accepted up to the limit, the rest waits in the backlog
+    QTRY_COMPARE(newConnectionSpy.size(), MaxPending);
+    QTest::qWait(50);
+    QCOMPARE(newConnectionSpy.size(), MaxPending);
+    QVERIFY(server.hasPendingConnections());
+
+    // Taking connections makes room for the waiting ones, in connect order
+    QList<std::shared_ptr<QBluetoothSocket>> sockets;
+    while (sockets.size() < ConnectionCount) {
+        QTRY_VERIFY(server.hasPendingConnections());
+        std::shared_ptr<QBluetoothSocket> socket(server.nextPendingConnection());
+        QVERIFY(socket);
+        QCOMPARE(socket->state(), QBluetoothSocket::SocketState::ConnectedState);
+
+        const char index = char(sockets.size());
+        QCOMPARE(::write(clients.at(sockets.size()), &index, 1), 1);
+        QTRY_COMPARE(socket->bytesAvailable(), 1);
+        QCOMPARE(socket->read(1), QByteArray(1, index));
+        sockets.append(socket);
+    }
+    QCOMPARE(newConnectionSpy.size(), ConnectionCount);
+    QVERIFY(!server.hasPendingConnections());
+    QVERIFY(!server.nextPendingConnection());
+#endif
+}
+
+void tst_QBluetoothServer::tst_acceptOutOfDescriptors()
+{
+#if !QT_CONFIG(bluez) || !defined(QT_BUILD_INTERNAL)
+    QSKIP("The accept queue is tested with BlueZ and a developer build only");
+#else
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    QVERIFY(listener >= 0);
+    const int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    QVERIFY(client >= 0);
+    QList<int> fillers;
+    rlimit originalLimit = {};
+    QCOMPARE(::getrlimit(RLIMIT_NOFILE, &originalLimit), 0);
+    const auto cleanup = qScopeGuard([&]() {
+        for (int filler : std::as_const(fillers))
+            ::close(filler);
+        ::setrlimit(RLIMIT_NOFILE, &originalLimit);
+        ::close(client);
+        ::close(listener);
+    });
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    const QByteArray name = "tst_qbluetoothserver_emfile_"
+            + QByteArray::number(QCoreApplication::applicationPid());
+    memcpy(address.sun_path + 1, name.constData(), name.size());
+    const socklen_t addressLength = socklen_t(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+    QCOMPARE(::bind(listener, reinterpret_cast<sockaddr *>(&address), addressLength), 0);
+    QCOMPARE(::listen(listener, 4), 0);
+
+    AcceptQueueServer server(QBluetoothServiceInfo::RfcommProtocol);
+    QSignalSpy newConnectionSpy(&server, &QBluetoothServer::newConnection);
+    QSignalSpy errorSpy(&server, &QBluetoothServer::errorOccurred);
+    server.d()->startAccepting(listener);
+
+    // Use up the descriptors, within a lowered limit to keep it quick
+    rlimit limit = originalLimit;
+    limit.rlim_cur = qMin<rlim_t>(originalLimit.rlim_cur, rlim_t(client + 64));
+    QCOMPARE(::setrlimit(RLIMIT_NOFILE, &limit), 0);
+    while (true) {
+        const int filler = ::dup(client);
+        if (filler < 0)
+            break;
+        fillers.append(filler);
+    }
+    QCOMPARE(errno, EMFILE);
+
+    // The connection cannot be accepted and stays in the backlog
+    QCOMPARE(::connect(client, reinterpret_cast<sockaddr *>(&address), addressLength), 0);
+    QTRY_COMPARE(errorSpy.size(), 1);
+    QCOMPARE(errorSpy.at(0).at(0).value<QBluetoothServer::Error>(),
+             QBluetoothServer::InputOutputError);
+    QVERIFY(!server.hasPendingConnections());
+    // The server backs off instead of retrying in a busy loop
+    QTest::qWait(200);
+    QVERIFY(errorSpy.size() < 10);
+
+    // Without anyone calling nextPendingConnection(), the server accepts
+    // again once descriptors are available
+    for (int filler : std::as_const(fillers))
+        ::close(filler);
+    fillers.clear();
+    QTRY_COMPARE(newConnectionSpy.size(), 1);
+    std::unique_ptr<QBluetoothSocket> socket(server.nextPendingConnection());
+    QVERIFY(socket);
+    QCOMPARE(socket->state(), QBluetoothSocket::SocketState::ConnectedState);
+#endif
+}
 
 QTEST_MAIN(tst_QBluetoothServer)
 
@@ -2,11 +2,15 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QtTest/QtTest>
+#include <QTranslator>
 #include <QUuid>
 
 #include <QDebug>
 
+#include <memory>
+
 #include <qbluetoothuuid.h>
+#include <QtBluetooth/private/qbluetoothuuid_p.h>
 
 #if defined(Q_OS_DARWIN)
 #include <QtCore/private/qcore_mac_p.h>
@@ -19,6 +23,8 @@
 
 QT_USE_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 class tst_QBluetoothUuid : public QObject
 {
     Q_OBJECT
@@ -36,6 +42,11 @@ private slots:
     void tst_conversion();
     void tst_comparison_data();
     void tst_comparison();
+    void tst_stringViews_data();
+    void tst_stringViews();
+    void tst_invalidStrings();
+    void tst_assignedNumbers();
+    void tst_translatedNames();
 };
 
 tst_QBluetoothUuid::tst_QBluetoothUuid()
@@ -385,6 +396,152 @@ void tst_QBluetoothUuid::tst_comparison()
     }
 }
 
+void tst_QBluetoothUuid::tst_stringViews_data()
+{
+    tst_conversion_data();
+}
+
+void tst_QBluetoothUuid::tst_stringViews()
+{
+    QFETCH(QUuid::Id128Bytes, uuid128);
+    QFETCH(QString, uuidS);
+
+    const QBluetoothUuid uuid(uuid128);
+    const QString withoutBraces = uuid.toString(QUuid::WithoutBraces);
+
+    QCOMPARE(QtBluetoothPrivate::uuidFromString(QStringView(uuidS)), uuid);
+    QCOMPARE(QtBluetoothPrivate::uuidFromString(QLatin1StringView(uuidS.toLatin1())), uuid);
+    QCOMPARE(QtBluetoothPrivate::uuidFromString(QByteArrayView(withoutBraces.toLatin1())), uuid);
+    QCOMPARE(QtBluetoothPrivate::uuidFromString(QStringView(withoutBraces.toUpper())), uuid);
+
+    char buffer[QtBluetoothPrivate::UuidStringLength];
+    char *end = QtBluetoothPrivate::toUuidString(uuid, buffer);
+    QCOMPARE(end - buffer, QtBluetoothPrivate::UuidStringLength);
+    QCOMPARE(QLatin1StringView(buffer, end), withoutBraces);
+
+    char16_t utf16Buffer[QtBluetoothPrivate::UuidStringLength];
+    QtBluetoothPrivate::toUuidString(uuid, utf16Buffer);
+    QCOMPARE(QStringView(utf16Buffer, QtBluetoothPrivate::UuidStringLength), withoutBraces);
+}
+
+void tst_QBluetoothUuid::tst_invalidStrings()
+{
+    const QLatin1StringView invalid[] = {
+        ""_L1,
+        "0000180d-0000-1000-8000-00805f9b34f"_L1,
+        "0000180d-0000-1000-8000-00805f9b34fbb"_L1,
+        "0000180d00000-1000-8000-00805f9b34fb"_L1,
+        "0000180d-0000-1000-8000-00805f9b34fg"_L1,
+        "{0000180d-0000-1000-8000-00805f9b34fb"_L1,
+        "(0000180d-0000-1000-8000-00805f9b34fb)"_L1,
+    };
+    for (QLatin1StringView string : invalid)
+        QVERIFY2(QtBluetoothPrivate::uuidFromString(string).isNull(), string.data());
+}
+
+void tst_QBluetoothUuid::tst_assignedNumbers()
+{
+    using namespace QtBluetoothPrivate;
+
+    QCOMPARE(QBluetoothUuid::serviceClassToString(QBluetoothUuid::ServiceClassUuid::HeartRate),
+             u"Heart Rate"_s);
+    QCOMPARE(QBluetoothUuid::protocolToString(QBluetoothUuid::ProtocolUuid::L2cap),
+             u"Layer 2 Control Protocol"_s);
+    QVERIFY(QBluetoothUuid::descriptorToString(
+                    QBluetoothUuid::DescriptorType::UnknownDescriptorType).isNull());
+
+    QCOMPARE(toAssignedNumber<QBluetoothUuid::CharacteristicType>(0x2A37).value(),
+             QBluetoothUuid::CharacteristicType::HeartRateMeasurement);
+    QVERIFY(!toAssignedNumber<QBluetoothUuid::CharacteristicType>(0x180D));
+    QVERIFY(!toAssignedNumber<QBluetoothUuid::ProtocolUuid>(0x0013));
+
+    QCOMPARE(uuidForAssignedName(AssignedNumberType::ServiceClass, "Heart Rate"_L1),
+             QBluetoothUuid(QBluetoothUuid::ServiceClassUuid::HeartRate));
+    QCOMPARE(uuidForAssignedName(AssignedNumberType::Descriptor,
+                                 u"Client Characteristic Configuration"),
+             QBluetoothUuid(QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration));
+    QVERIFY(uuidForAssignedName(AssignedNumberType::ServiceClass, "heart rate"_L1).isNull());
+    QVERIFY(uuidForAssignedName(AssignedNumberType::Characteristic, "Heart Rate"_L1).isNull());
+    // The classic and the LE service share the name
+    QCOMPARE(uuidForAssignedName(AssignedNumberType::ServiceClass, "Human Interface Device"_L1),
+             QBluetoothUuid(QBluetoothUuid::ServiceClassUuid::HumanInterfaceDeviceService));
+
+    // Every name leads back to its number or to a lower one with the same name
+    const AssignedNumberType types[] = { AssignedNumberType::Protocol,
+                                         AssignedNumberType::ServiceClass,
+                                         AssignedNumberType::Characteristic,
+                                         AssignedNumberType::Descriptor };
+    int nameCount = 0;
+    for (AssignedNumberType type : types) {
+        for (quint32 value = 0; value <= 0xFFFF; ++value) {
+            const char *name = assignedNumberName(type, quint16(value));
+            if (!name)
+                continue;
+            ++nameCount;
+            const std::optional<quint16> found = assignedNumber(type, QLatin1StringView(name));
+            QVERIFY(found);
+            QVERIFY(*found <= value);
+            QCOMPARE(assignedNumberName(type, *found), name);
+        }
+    }
+    QCOMPARE(nameCount, 25 + 91 + 137 + 12);
+}
+
+class TestTranslator : public QTranslator
+{
+public:
+    bool isEmpty() const override { return false; }
+    QString translate(const char *context, const char *sourceText, const char *, int) const override
+    {
+        if (qstrcmp(context, "QBluetoothServiceDiscoveryAgent") == 0
+                && qstrcmp(sourceText, "Heart Rate") == 0) {
+            return heartRate;
+        }
+        return QString();
+    }
+
+    // Announces the change like QTranslator::load() does for installed translators
+    void reload(const QString &name)
+    {
+        heartRate = name;
+        QCoreApplication::postEvent(QCoreApplication::instance(),
+                                    new QEvent(QEvent::LanguageChange));
+    }
+
+private:
+    QString heartRate = u"Herzfrequenz"_s;
+};
+
+void tst_QBluetoothUuid::tst_translatedNames()
+{
+    const auto heartRate = QBluetoothUuid::ServiceClassUuid::HeartRate;
+
+    // Cached translations follow translator changes
+    QCOMPARE(QBluetoothUuid::serviceClassToString(heartRate), u"Heart Rate"_s);
+
+    TestTranslator translator;
+    QVERIFY(QCoreApplication::installTranslator(&translator));
+    QCOMPARE(QBluetoothUuid::serviceClassToString(heartRate), u"Herzfrequenz"_s);
+    QCOMPARE(QBluetoothUuid::serviceClassToString(heartRate), u"Herzfrequenz"_s);
+
+    // Lookups from other threads use the same translators
+    QString otherThreadName;
+    std::unique_ptr<QThread> thread(QThread::create([&]() {
+        otherThreadName = QBluetoothUuid::serviceClassToString(heartRate);
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QCOMPARE(otherThreadName, u"Herzfrequenz"_s);
+
+    // Loading other translations into an installed translator
+    translator.reload(u"Puls"_s);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::LanguageChange);
+    QCOMPARE(QBluetoothUuid::serviceClassToString(heartRate), u"Puls"_s);
+
+    QVERIFY(QCoreApplication::removeTranslator(&translator));
+    QCOMPARE(QBluetoothUuid::serviceClassToString(heartRate), u"Heart Rate"_s);
+}
+
 QTEST_MAIN(tst_QBluetoothUuid)
 
 #include "tst_qbluetoothuuid.moc"
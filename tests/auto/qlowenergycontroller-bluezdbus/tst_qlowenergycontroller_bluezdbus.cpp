@@ -0,0 +1,351 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/QBluetoothDeviceInfo>
+#include <QtBluetooth/QLowEnergyController>
+#include <QtBluetooth/QLowEnergyService>
+#include <QtBluetooth/private/bluez5_helper_p.h>
+#include <QtBluetooth/private/bluezobjecttree_p.h>
+
+#include <memory>
+
+#include "../../shared/fakebluetoothd_p.h"
+
+using namespace Qt::StringLiterals;
+
+/*
+ * Runs the BlueZ D-Bus backend of QLowEnergyController against a fake
+ * bluetoothd on a private bus. Unless a test sets up another device, the
+ * remote device has one service with two characteristics, each with a
+ * ClientCharacteristicConfiguration descriptor.
+ */
+class tst_QLowEnergyControllerBluezDBus : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    void connectInvalidDevice_data();
+    void connectInvalidDevice();
+    void notificationHandler_data();
+    void notificationHandler();
+    void notificationHandlerDroppedOnDisconnect();
+    void gattJobOrder();
+    void gattJobConcurrency_data();
+    void gattJobConcurrency();
+
+private:
+    void setRemoteDevice(int characteristicCount, int descriptorsPerCharacteristic);
+    static QString characteristicPath(int index, int descriptorsPerCharacteristic = 1);
+    std::unique_ptr<QLowEnergyController> connectedController();
+    std::unique_ptr<QLowEnergyService> discoveredService(QLowEnergyController *controller);
+
+    FakeSystemBus m_bus;
+    FakeBluetoothd *m_bluetoothd = nullptr;
+};
+
+void tst_QLowEnergyControllerBluezDBus::initTestCase()
+{
+    if (!FakeSystemBus::isSupported())
+        QSKIP("dbus-daemon is needed for the private bus");
+
+    QVERIFY(m_bus.start());
+    m_bluetoothd = m_bus.bluetoothd();
+}
+
+void tst_QLowEnergyControllerBluezDBus::cleanupTestCase()
+{
+    m_bus.stop();
+}
+
+void tst_QLowEnergyControllerBluezDBus::init()
+{
+    m_bluetoothd->setReadLatency(0);
+    m_bluetoothd->setWriteLatency(0);
+    setRemoteDevice(2, 1);
+    QVERIFY(QtBluezObjectTree::instance()->isLoaded());
+}
+
+void tst_QLowEnergyControllerBluezDBus::setRemoteDevice(int characteristicCount,
+                                                        int descriptorsPerCharacteristic)
+{
+    ManagedObjectList objects = fakeAdapterTree();
+    addFakeDevice(objects, fakeRemoteAddress, 1, characteristicCount,
+                  descriptorsPerCharacteristic);
+    m_bluetoothd->setObjects(objects);
+    m_bluetoothd->resetValueCalls();
+
+    QtBluezObjectTree::instance()->clear();
+    QtBluezObjectTree::instance()->ensureLoaded();
+}
+
+QString tst_QLowEnergyControllerBluezDBus::characteristicPath(int index,
+                                                              int descriptorsPerCharacteristic)
+{
+    // The service has handle 1, every characteristic is followed by its descriptors
+    const int handle = 2 + (1 + descriptorsPerCharacteristic) * index;
+    return devicePathForAddress(fakeAdapterPath, fakeRemoteAddress)
+            + u"/service0001/char%1"_s.arg(handle, 4, 16, '0'_L1);
+}
+
+std::unique_ptr<QLowEnergyController> tst_QLowEnergyControllerBluezDBus::connectedController()
+{
+    std::unique_ptr<QLowEnergyController> controller(QLowEnergyController::createCentral(
+            QBluetoothDeviceInfo(fakeRemoteAddress, u"fake"_s, 0)));
+    controller->connectToDevice();
+    if (!waitFor([&]() { return controller->state() == QLowEnergyController::ConnectedState; }))
+        return {};
+    controller->discoverServices();
+    if (!waitFor([&]() { return controller->state() == QLowEnergyController::DiscoveredState; }))
+        return {};
+    return controller;
+}
+
+std::unique_ptr<QLowEnergyService> tst_QLowEnergyControllerBluezDBus::discoveredService(
+        QLowEnergyController *controller)
+{
+    std::unique_ptr<QLowEnergyService> service(
+            controller->createServiceObject(QBluetoothUuid(QUuid(fakeUuid(0)))));
+    if (!service)
+        return {};
+    service->discoverDetails(QLowEnergyService::SkipValueDiscovery);
+    if (!waitFor([&]() { return service->state() == QLowEnergyService::RemoteServiceDiscovered; }))
+        return {};
+    return service;
+}
+
+void tst_QLowEnergyControllerBluezDBus::connectInvalidDevice_data()
+{
+    QTest::addColumn<QBluetoothAddress>("address");
+
+    QTest::newRow("null") << QBluetoothAddress();
+    QTest::newRow("unknown") << QBluetoothAddress(u"11:22:33:44:55:77"_s);
+}
+
+void tst_QLowEnergyControllerBluezDBus::connectInvalidDevice()
+{
+    QFETCH(QBluetoothAddress, address);
+
+    const std::unique_ptr<QLowEnergyController> controller(QLowEnergyController::createCentral(
+            QBluetoothDeviceInfo(address, u"fake"_s, 0)));
+    QSignalSpy stateSpy(controller.get(), &QLowEnergyController::stateChanged);
+    QSignalSpy errorSpy(controller.get(), &QLowEnergyController::errorOccurred);
+
+    // The input is checked before the controller enters ConnectingState
+    controller->connectToDevice();
+    QCOMPARE(errorSpy.size(), qsizetype(1));
+    QCOMPARE(errorSpy.at(0).at(0).value<QLowEnergyController::Error>(),
+             QLowEnergyController::UnknownRemoteDeviceError);
+    QCOMPARE(controller->state(), QLowEnergyController::UnconnectedState);
+    QVERIFY(stateSpy.isEmpty());
+}
+
+void tst_QLowEnergyControllerBluezDBus::notificationHandler_data()
+{
+    QTest::addColumn<int>("options");
+    QTest::addColumn<bool>("valueCached");
+    QTest::addColumn<bool>("signalEmitted");
+
+    QTest::newRow("default")
+            << int(QLowEnergyService::DefaultNotificationHandling) << true << true;
+    QTest::newRow("skip cache")
+            << int(QLowEnergyService::SkipValueCacheUpdate) << false << true;
+    QTest::newRow("skip signal")
+            << int(QLowEnergyService::SkipChangedSignal) << true << false;
+    QTest::newRow("skip both")
+            << (QLowEnergyService::SkipValueCacheUpdate | QLowEnergyService::SkipChangedSignal)
+                       .toInt()
+            << false << false;
+}
+
+void tst_QLowEnergyControllerBluezDBus::notificationHandler()
+{
+    QFETCH(int, options);
+    QFETCH(bool, valueCached);
+    QFETCH(bool, signalEmitted);
+
+    const std::unique_ptr<QLowEnergyController> controller = connectedController();
+    QVERIFY(controller);
+    const std::unique_ptr<QLowEnergyService> service = discoveredService(controller.get());
+    QVERIFY(service);
+
+    const QLowEnergyCharacteristic characteristic =
+            service->characteristic(QBluetoothUuid(QUuid(fakeUuid(0x100))));
+    const QLowEnergyCharacteristic other =
+            service->characteristic(QBluetoothUuid(QUuid(fakeUuid(0x101))));
+    QVERIFY(characteristic.isValid());
+    QVERIFY(other.isValid());
+
+    QList<QByteArray> handled;
+    QVERIFY(service->setNotificationHandler(characteristic, [&handled](QByteArrayView value) {
+        handled.append(value.toByteArray());
+    }, QLowEnergyService::NotificationHandlingOptions::fromInt(options)));
+    QSignalSpy changedSpy(service.get(), &QLowEnergyService::characteristicChanged);
+
+    m_bluetoothd->notify(characteristicPath(0), "first");
+    QVERIFY(waitFor([&]() { return handled.size() == 1; }));
+    QCOMPARE(handled.constFirst(), QByteArray("first"));
+
+    // The cache and the signal are handled right after the handler returns
+    QCOMPARE(changedSpy.size(), qsizetype(signalEmitted ? 1 : 0));
+    QCOMPARE(service->characteristic(characteristic.uuid()).value(),
+             valueCached ? QByteArray("first") : QByteArray());
+
+    // The options apply to the characteristic of the handler only
+    m_bluetoothd->notify(characteristicPath(1), "other");
+    QVERIFY(waitFor([&]() { return changedSpy.size() == (signalEmitted ? 2 : 1); }));
+    QCOMPARE(changedSpy.constLast().at(0).value<QLowEnergyCharacteristic>(), other);
+    QCOMPARE(service->characteristic(other.uuid()).value(), QByteArray("other"));
+    QCOMPARE(handled.size(), qsizetype(1));
+
+    // Without the handler the defaults apply again
+    service->removeNotificationHandler(characteristic);
+    const qsizetype changedCount = changedSpy.size();
+    m_bluetoothd->notify(characteristicPath(0), "second");
+    QVERIFY(waitFor([&]() { return changedSpy.size() == changedCount + 1; }));
+    QCOMPARE(service->characteristic(characteristic.uuid()).value(), QByteArray("second"));
+    QCOMPARE(handled.size(), qsizetype(1));
+}
+
+void tst_QLowEnergyControllerBluezDBus::notificationHandlerDroppedOnDisconnect()
+{
+    const std::unique_ptr<QLowEnergyController> controller = connectedController();
+    QVERIFY(controller);
+    const std::unique_ptr<QLowEnergyService> service = discoveredService(controller.get());
+    QVERIFY(service);
+
+    const QLowEnergyCharacteristic characteristic =
+            service->characteristic(QBluetoothUuid(QUuid(fakeUuid(0x100))));
+    QVERIFY(characteristic.isValid());
+
+    // The handler owns what it captures, it is destroyed along with the handler
+    const auto capture = std::make_shared<int>(0);
+    QVERIFY(service->setNotificationHandler(characteristic, [capture](QByteArrayView) {
+        ++*capture;
+    }));
+    QCOMPARE(capture.use_count(), 2L);
+
+    controller->disconnectFromDevice();
+    QVERIFY(waitFor([&]() {
+        return controller->state() == QLowEnergyController::UnconnectedState;
+    }));
+    QCOMPARE(service->state(), QLowEnergyService::InvalidService);
+    QCOMPARE(capture.use_count(), 1L);
+
+    // A handler cannot be set on the invalid service
+    QVERIFY(!service->setNotificationHandler(characteristic, [capture](QByteArrayView) {
+        ++*capture;
+    }));
+    QCOMPARE(capture.use_count(), 1L);
+    QCOMPARE(*capture, 0);
+}
+
+void tst_QLowEnergyControllerBluezDBus::gattJobOrder()
+{
+    // Every characteristic has a second, writable descriptor
+    setRemoteDevice(2, 2);
+    m_bluetoothd->setWriteLatency(20);
+
+    const std::unique_ptr<QLowEnergyController> controller = connectedController();
+    QVERIFY(controller);
+    const std::unique_ptr<QLowEnergyService> service = discoveredService(controller.get());
+    QVERIFY(service);
+
+    const QLowEnergyCharacteristic first =
+            service->characteristic(QBluetoothUuid(QUuid(fakeUuid(0x100))));
+    const QLowEnergyCharacteristic second =
+            service->characteristic(QBluetoothUuid(QUuid(fakeUuid(0x101))));
+    const QLowEnergyDescriptor descriptor = first.descriptor(QBluetoothUuid(quint16(0xa201)));
+    QVERIFY(first.isValid());
+    QVERIFY(second.isValid());
+    QVERIFY(descriptor.isValid());
+
+    QSignalSpy charSpy(service.get(), &QLowEnergyService::characteristicWritten);
+    QSignalSpy descSpy(service.get(), &QLowEnergyService::descriptorWritten);
+    m_bluetoothd->resetValueCalls();
+
+    service->writeCharacteristic(first, QByteArray::fromHex("01"));
+    service->writeDescriptor(descriptor, QByteArray::fromHex("02"));
+    service->writeCharacteristic(first, QByteArray::fromHex("03"));
+    service->writeCharacteristic(second, QByteArray::fromHex("04"));
+    QVERIFY(waitFor([&]() { return charSpy.size() == 3 && descSpy.size() == 1; }));
+
+    // The operations on the first characteristic and its descriptor are sent
+    // one at a time in request order, the second one does not wait for them
+    const QString firstPath = characteristicPath(0, 2);
+    QStringList firstCalls;
+    for (const QString &call : m_bluetoothd->valueCalls()) {
+        if (call.contains(firstPath))
+            firstCalls.append(call);
+    }
+    QCOMPARE(firstCalls, (QStringList{ u"WriteValue "_s + firstPath + u" 01"_s,
+                                       u"WriteValue "_s + firstPath + u"/desc0004 02"_s,
+                                       u"WriteValue "_s + firstPath + u" 03"_s }));
+    QCOMPARE(m_bluetoothd->valueCalls().size(), qsizetype(4));
+    QCOMPARE(m_bluetoothd->peakRunningCallsPerCharacteristic(), 1);
+    QCOMPARE(m_bluetoothd->peakRunningCalls(), 2);
+
+    QCOMPARE(charSpy.at(0).at(1).toByteArray(), QByteArray::fromHex("01"));
+    QCOMPARE(charSpy.at(2).at(1).toByteArray(), QByteArray::fromHex("03"));
+}
+
+void tst_QLowEnergyControllerBluezDBus::gattJobConcurrency_data()
+{
+    QTest::addColumn<QByteArray>("concurrency");
+    QTest::addColumn<int>("expectedPeak");
+
+    QTest::newRow("default") << QByteArray() << 4;
+    QTest::newRow("1") << QByteArray("1") << 1;
+    QTest::newRow("2") << QByteArray("2") << 2;
+    QTest::newRow("invalid") << QByteArray("none") << 4;
+}
+
+void tst_QLowEnergyControllerBluezDBus::gattJobConcurrency()
+{
+    QFETCH(QByteArray, concurrency);
+    QFETCH(int, expectedPeak);
+
+    constexpr int CharacteristicCount = 6;
+    setRemoteDevice(CharacteristicCount, 1);
+    m_bluetoothd->setWriteLatency(20);
+
+    // The limit is read when the controller is created
+    if (concurrency.isEmpty())
+        qunsetenv("QT_BLUETOOTH_GATT_CONCURRENCY");
+    else
+        qputenv("QT_BLUETOOTH_GATT_CONCURRENCY", concurrency);
+    const auto restore = qScopeGuard([]() { qunsetenv("QT_BLUETOOTH_GATT_CONCURRENCY"); });
+
+    const std::unique_ptr<QLowEnergyController> controller = connectedController();
+    QVERIFY(controller);
+    const std::unique_ptr<QLowEnergyService> service = discoveredService(controller.get());
+    QVERIFY(service);
+
+    QSignalSpy writtenSpy(service.get(), &QLowEnergyService::characteristicWritten);
+    m_bluetoothd->resetValueCalls();
+
+    for (int i = 0; i < CharacteristicCount; ++i) {
+        const QLowEnergyCharacteristic characteristic =
+                service->characteristic(QBluetoothUuid(QUuid(fakeUuid(0x100 + i))));
+        QVERIFY(characteristic.isValid());
+        service->writeCharacteristic(characteristic, QByteArray(1, char(i)));
+    }
+    QVERIFY(waitFor([&]() { return writtenSpy.size() == CharacteristicCount; }));
+
+    QCOMPARE(m_bluetoothd->valueCalls().size(), qsizetype(CharacteristicCount));
+    QCOMPARE(m_bluetoothd->peakRunningCalls(), expectedPeak);
+    // Jobs on different characteristics start in request order too
+    for (int i = 0; i < CharacteristicCount; ++i) {
+        QCOMPARE(m_bluetoothd->valueCalls().at(i),
+                 u"WriteValue "_s + characteristicPath(i) + u" 0"_s + QString::number(i));
+    }
+}
+
+QTEST_MAIN(tst_QLowEnergyControllerBluezDBus)
+
+#include "tst_qlowenergycontroller_bluezdbus.moc"
@@ -453,6 +453,15 @@ void TestQLowEnergyControllerGattServer::serverCommunication()
     spy.reset(new QSignalSpy(customService.data(), &QLowEnergyService::descriptorWritten));
     QVERIFY(spy->wait(3000));
 
+    // The handler sees the notification before the changed signal is emitted
+    QList<QByteArray> handledNotifications;
+    QVERIFY(customService->setNotificationHandler(customChar4,
+            [&handledNotifications](QByteArrayView value) {
+        handledNotifications.append(value.toByteArray());
+    }));
+    QVERIFY(!customService->setNotificationHandler(QLowEnergyCharacteristic(),
+                                                   [](QByteArrayView) {}));
+
     // Server now changes the characteristic values.
 
     spy.reset(new QSignalSpy(customService.data(), &QLowEnergyService::characteristicChanged));
@@ -461,6 +470,8 @@ void TestQLowEnergyControllerGattServer::serverCommunication()
         QVERIFY(spy->wait(3000));
     QCOMPARE(customChar3.value().constData(), "indicated");
     QCOMPARE(customChar4.value().constData(), "notified");
+    QCOMPARE(handledNotifications, QList<QByteArray>{"notified"});
+    customService->removeNotificationHandler(customChar4);
 
     // signal requires root privileges on Linux
     spy.reset(new QSignalSpy(m_leController.data(), &QLowEnergyController::connectionUpdated));
@@ -19,6 +19,7 @@ class tst_QLowEnergyService : public QObject
 
 private slots:
     void tst_flags();
+    void tst_notificationHandlingOptions();
 };
 
 void tst_QLowEnergyService::tst_flags()
@@ -43,6 +44,18 @@ void tst_QLowEnergyService::tst_flags()
     QVERIFY(result.testFlag(QLowEnergyService::IncludedService));
 }
 
+void tst_QLowEnergyService::tst_notificationHandlingOptions()
+{
+    QLowEnergyService::NotificationHandlingOptions options;
+    QCOMPARE(options.toInt(), int(QLowEnergyService::DefaultNotificationHandling));
+    QVERIFY(!options.testFlag(QLowEnergyService::SkipValueCacheUpdate));
+    QVERIFY(!options.testFlag(QLowEnergyService::SkipChangedSignal));
+
+    options = QLowEnergyService::SkipValueCacheUpdate | QLowEnergyService::SkipChangedSignal;
+    QVERIFY(options.testFlag(QLowEnergyService::SkipValueCacheUpdate));
+    QVERIFY(options.testFlag(QLowEnergyService::SkipChangedSignal));
+}
+
 QTEST_MAIN(tst_QLowEnergyService)
 
 #include "tst_qlowenergyservice.moc"
@@ -7,6 +7,8 @@
 #include <qndefmessage.h>
 #include <qndefnfctextrecord.h>
 #include <qndefnfcurirecord.h>
+#include <QtNfc/private/qndefmessageview_p.h>
+#include <QtNfc/private/qndefmessagewriter_p.h>
 
 QT_USE_NAMESPACE
 
@@ -28,6 +30,13 @@ private slots:
     void parseCorruptedMessage();
     void parseCorruptedMessage_data();
     void parseComplexMessage();
+    void messageView();
+    void chunkedWriter_data();
+    void chunkedWriter();
+    void writerTargets();
+    void incrementalReader_data();
+    void incrementalReader();
+    void incrementalReaderErrors();
 };
 
 tst_QNdefMessage::tst_QNdefMessage()
@@ -491,6 +500,13 @@ void tst_QNdefMessage::parseSingleRecordMessage()
     QVERIFY(message == reparsedMessage);
     QVERIFY(reparsedMessage == message);
 
+    if (!QByteArray(QTest::currentDataTag()).startsWith("truncated ")) {
+        const QNdefMessageView view(data);
+        QVERIFY(view.isValid());
+        QCOMPARE(view.size(), parsedMessage.size());
+        QVERIFY(view.toMessage() == parsedMessage);
+    }
+
     for (qsizetype i = 0; i < message.size(); ++i) {
         const QNdefRecord &record = message.at(i);
         const QNdefRecord &parsedRecord = parsedMessage.at(i);
@@ -641,6 +657,22 @@ void tst_QNdefMessage::parseCorruptedMessage_data()
 
         QTest::newRow("Incorrect TYPE_LENGTH in chunk") << data << warningMsg;
     }
+    {
+        QByteArray data;
+        data.append(char(0xB1)); // MB=1, ME=0, CF=1, SR=1, IL=0, TNF=1 (NFC-RTD)
+        data.append(char(0x01)); // type length
+        data.append(char(0x01)); // payload length
+        data.append('U'); // type
+        data.append('a'); // payload
+        data.append(char(0x76)); // MB=0, ME=1, CF=1 (final chunk missing), SR=1, IL=0, TNF=6
+        data.append(char(0x00)); // type length
+        data.append(char(0x01)); // payload length
+        data.append('b'); // payload
+
+        const QByteArray warningMsg = "Malformed NDEF Message, missing begin or end";
+
+        QTest::newRow("Missing final chunk") << data << warningMsg;
+    }
     {
         QByteArray data;
         data.append(char(0xB1)); // MB=1, ME=0, CF=1, SR=1, IL=0, TNF=1 (NFC-RTD)
@@ -733,6 +765,220 @@ void tst_QNdefMessage::parseComplexMessage()
 
 }
 
+void tst_QNdefMessage::messageView()
+{
+    QByteArray data;
+    data.append(char(0xB1)); // MB=1, ME=0, CF=1, SR=1, IL=0, TNF=1 (NFC-RTD)
+    data.append(char(0x01)); // type length
+    data.append(char(0x02)); // payload length
+    data.append('U'); // type
+    data.append("ab"); // payload
+    data.append(char(0x36)); // MB=0, ME=0, CF=1, SR=1, IL=0, TNF=6 (Unchanged)
+    data.append(char(0x00)); // type length
+    data.append(char(0x00)); // payload length
+    data.append(char(0x16)); // MB=0, ME=0, CF=0, SR=1, IL=0, TNF=6 (Unchanged)
+    data.append(char(0x00)); // type length
+    data.append(char(0x01)); // payload length
+    data.append('c'); // payload
+    data.append(char(0x59)); // MB=0, ME=1, CF=0, SR=1, IL=1, TNF=1 (NFC-RTD)
+    data.append(char(0x01)); // type length
+    data.append(char(0x01)); // payload length
+    data.append(char(0x01)); // id length
+    data.append('T'); // type
+    data.append('i'); // id
+    data.append('d'); // payload
+    const qsizetype messageSize = data.size();
+    data.append("trailing data");
+
+    const QNdefMessageView view(data);
+    QVERIFY(view.isValid());
+    QCOMPARE(view.size(), 2);
+    QCOMPARE(std::distance(view.begin(), view.end()), 2);
+
+    auto it = view.begin();
+    QCOMPARE(it->typeNameFormat(), QNdefRecord::NfcRtd);
+    QCOMPARE(it->type().toByteArray(), QByteArray("U"));
+    QVERIFY(it->id().isEmpty());
+    QVERIFY(it->isChunked());
+    QCOMPARE(it->chunkCount(), 3);
+    QCOMPARE(it->payloadSize(), 3);
+    QByteArray payload;
+    it->forEachPayloadChunk([&payload](QByteArrayView chunk) { payload.append(chunk); });
+    QCOMPARE(payload, QByteArray("abc"));
+    QCOMPARE(it->toRecord().payload(), QByteArray("abc"));
+
+    ++it;
+    QCOMPARE(it->typeNameFormat(), QNdefRecord::NfcRtd);
+    QCOMPARE(it->type().toByteArray(), QByteArray("T"));
+    QCOMPARE(it->id().toByteArray(), QByteArray("i"));
+    QVERIFY(!it->isChunked());
+    QCOMPARE(it->payload().toByteArray(), QByteArray("d"));
+    QCOMPARE(it->encoded().data() + it->encoded().size(), data.constData() + messageSize);
+
+    ++it;
+    QVERIFY(it == view.end());
+
+    QTest::ignoreMessage(QtWarningMsg, "Unexpected end of message");
+    const QNdefMessageView truncated(QByteArrayView(data).first(messageSize - 1));
+    QVERIFY(!truncated.isValid());
+    QVERIFY(truncated.isEmpty());
+    QVERIFY(truncated.begin() == truncated.end());
+}
+
+static QNdefMessage largeMessage()
+{
+    QNdefMessage message;
+    for (int i = 0; i < 3; ++i) {
+        QNdefRecord record;
+        record.setTypeNameFormat(QNdefRecord::Mime);
+        record.setType("application/octet-stream");
+        if (i == 1)
+            record.setId("second");
+        QByteArray payload(1000 * (i + 1), Qt::Uninitialized);
+        for (qsizetype j = 0; j < payload.size(); ++j)
+            payload[j] = char(j * 7 + i);
+        record.setPayload(payload);
+        message.append(record);
+    }
+    message.append(QNdefNfcTextRecord());
+    return message;
+}
+
+void tst_QNdefMessage::chunkedWriter_data()
+{
+    QTest::addColumn<int>("chunkSize");
+    QTest::addColumn<int>("chunkCount");
+
+    // Records of 1000, 2000 and 3000 bytes, and a short text record
+    QTest::newRow("unchunked") << 0 << 4;
+    QTest::newRow("larger than payloads") << 4000 << 4;
+    QTest::newRow("1000") << 1000 << 1 + 2 + 3 + 1;
+    QTest::newRow("999") << 999 << 2 + 3 + 4 + 1;
+    QTest::newRow("short records") << 100 << 10 + 20 + 30 + 1;
+}
+
+void tst_QNdefMessage::chunkedWriter()
+{
+    QFETCH(int, chunkSize);
+    QFETCH(int, chunkCount);
+
+    const QNdefMessage message = largeMessage();
+    QNdefMessageWriter writer(message);
+    writer.setChunkSize(chunkSize);
+
+    const QByteArray data = writer.toByteArray();
+    QCOMPARE(writer.encodedSize(), data.size());
+    if (chunkSize == 0)
+        QCOMPARE(data, message.toByteArray());
+
+    // Walk the chunks
+    int chunks = 0;
+    qsizetype pos = 0;
+    while (pos < data.size()) {
+        const auto chunk = QtNfcPrivate::readNdefChunk(data, pos);
+        if (chunkSize > 0)
+            QVERIFY(chunk.payload.size() <= chunkSize);
+        pos += chunk.size;
+        ++chunks;
+    }
+    QCOMPARE(pos, data.size());
+    QCOMPARE(chunks, chunkCount);
+
+    const QNdefMessageView view(data);
+    QVERIFY(view.isValid());
+    QCOMPARE(view.size(), message.size());
+    QVERIFY(QNdefMessage::fromByteArray(data) == message);
+}
+
+void tst_QNdefMessage::writerTargets()
+{
+    const QNdefMessage message = largeMessage();
+    QNdefMessageWriter writer(message);
+    writer.setChunkSize(512);
+    const QByteArray expected = writer.toByteArray();
+
+    QBuffer device;
+    QVERIFY(device.open(QIODevice::WriteOnly));
+    QVERIFY(writer.write(&device));
+    QCOMPARE(device.data(), expected);
+
+    QByteArray buffer(expected.size() + 10, 'x');
+    QCOMPARE(writer.write(buffer.data(), buffer.size()), expected.size());
+    QCOMPARE(buffer.first(expected.size()), expected);
+    QCOMPARE(buffer.sliced(expected.size()), QByteArray(10, 'x'));
+
+    QCOMPARE(writer.write(buffer.data(), expected.size() - 1), -1);
+
+    QBuffer readOnly;
+    QVERIFY(readOnly.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("QIODevice::write.*"));
+    QVERIFY(!writer.write(&readOnly));
+
+    // An empty message is a single empty record
+    QCOMPARE(QNdefMessageWriter(QNdefMessage()).toByteArray(), QByteArray::fromHex("d00000"));
+}
+
+void tst_QNdefMessage::incrementalReader_data()
+{
+    QTest::addColumn<int>("chunkSize");
+    QTest::addColumn<int>("pieceSize");
+
+    QTest::newRow("unchunked, whole") << 0 << 0;
+    QTest::newRow("unchunked, bytes") << 0 << 1;
+    QTest::newRow("unchunked, 59 bytes") << 0 << 59;
+    QTest::newRow("chunked, bytes") << 100 << 1;
+    QTest::newRow("chunked, 251 bytes") << 300 << 251;
+}
+
+void tst_QNdefMessage::incrementalReader()
+{
+    QFETCH(int, chunkSize);
+    QFETCH(int, pieceSize);
+
+    const QNdefMessage message = largeMessage();
+    QNdefMessageWriter writer(message);
+    writer.setChunkSize(chunkSize);
+    const QByteArray data = writer.toByteArray() + "trailing data";
+
+    QNdefMessageReader reader;
+    const qsizetype step = pieceSize > 0 ? pieceSize : data.size();
+    qsizetype pos = 0;
+    for (; pos < data.size() && reader.status() == QNdefMessageReader::Status::NeedMoreData;
+         pos += step) {
+        reader.addData(QByteArrayView(data).sliced(pos, qMin(step, data.size() - pos)));
+    }
+    QCOMPARE(reader.status(), QNdefMessageReader::Status::Complete);
+    QVERIFY(reader.takeMessage() == message);
+
+    reader.reset();
+    QCOMPARE(reader.status(), QNdefMessageReader::Status::NeedMoreData);
+    QCOMPARE(reader.addData(data), QNdefMessageReader::Status::Complete);
+    QVERIFY(reader.takeMessage() == message);
+}
+
+void tst_QNdefMessage::incrementalReaderErrors()
+{
+    QNdefMessageReader reader;
+    const QByteArray data = largeMessage().toByteArray();
+
+    // Truncated data needs more
+    QCOMPARE(reader.addData(QByteArrayView(data).chopped(1)),
+             QNdefMessageReader::Status::NeedMoreData);
+    QVERIFY(reader.takeMessage().isEmpty());
+
+    reader.reset();
+    QTest::ignoreMessage(QtWarningMsg, "Haven't got message begin yet");
+    QCOMPARE(reader.addData(QByteArray::fromHex("500000")), QNdefMessageReader::Status::Error);
+
+    reader.reset();
+    QTest::ignoreMessage(QtWarningMsg, "Partial chunk not empty, but TNF not 0x06 as expected");
+    QCOMPARE(reader.addData(QByteArray::fromHex("b101015561" "510001" "63")),
+             QNdefMessageReader::Status::Error);
+
+    // Errors are final
+    QCOMPARE(reader.addData(data), QNdefMessageReader::Status::Error);
+}
+
 QTEST_MAIN(tst_QNdefMessage)
 
 #include "tst_qndefmessage.moc"
@@ -79,6 +79,7 @@ private slots:
     void tst_typeInfo();
     void tst_construct();
     void tst_downcast();
+    void tst_copies();
 };
 
 tst_QNdefNfcSmartPosterRecord::tst_QNdefNfcSmartPosterRecord()
@@ -538,6 +539,63 @@ void tst_QNdefNfcSmartPosterRecord::tst_downcast()
     QCOMPARE(basePayload, spPayload);
 }
 
+void tst_QNdefNfcSmartPosterRecord::tst_copies()
+{
+    QNdefNfcSmartPosterRecord record;
+    record.setUri(QUrl("http://qt.io"));
+    QVERIFY(record.addTitle(getTextRecord("en")));
+    record.setAction(QNdefNfcSmartPosterRecord::SaveAction);
+
+    QNdefMessage expected;
+    expected << getTextRecord("en");
+    QNdefNfcUriRecord uri;
+    uri.setUri(QUrl("http://qt.io"));
+    expected << uri;
+    QNdefRecord action;
+    action.setTypeNameFormat(QNdefRecord::NfcRtd);
+    action.setType("act");
+    action.setPayload(QByteArray(1, char(QNdefNfcSmartPosterRecord::SaveAction)));
+    expected << action;
+    const QByteArray payload = expected.toByteArray();
+
+    // Copies share the payload until they are modified
+    const QNdefRecord base = record;
+    QNdefNfcSmartPosterRecord copy = record;
+    QVERIFY(copy.addTitle(getTextRecord("fr")));
+    QVERIFY(!copy.addTitle(getTextRecord("fr")));
+
+    QCOMPARE(record.payload(), payload);
+    QCOMPARE(base.payload(), payload);
+    QVERIFY(base == record);
+    QVERIFY(copy.payload() != payload);
+    QVERIFY(copy != record);
+    QCOMPARE(QNdefNfcSmartPosterRecord(QNdefRecord(copy)).titleCount(), 2);
+    QCOMPARE(copy.titleCount(), 2);
+    QCOMPARE(record.titleCount(), 1);
+
+    // The record in a message is serialized with the current payload
+    const QByteArray message = QNdefMessage(copy).toByteArray();
+    QCOMPARE(QNdefMessage::fromByteArray(message).first().payload(), copy.payload());
+
+    QVERIFY(copy.removeTitle("fr"));
+    QCOMPARE(copy.payload(), payload);
+    QCOMPARE(copy, record);
+
+    // Assignment copies the payload as well
+    QNdefNfcSmartPosterRecord other;
+    other.setSize(100);
+    other = record;
+    QCOMPARE(other.payload(), payload);
+    QCOMPARE(QNdefRecord(other), base);
+    QVERIFY(!other.hasSize());
+
+    // Setting the payload replaces the records
+    other.setPayload(QNdefMessage(getTextRecord("de")).toByteArray());
+    QCOMPARE(other.titleCount(), 1);
+    QVERIFY(!other.hasAction());
+    QCOMPARE(record.payload(), payload);
+}
+
 QTEST_MAIN(tst_QNdefNfcSmartPosterRecord)
 
 #include "tst_qndefnfcsmartposterrecord.moc"
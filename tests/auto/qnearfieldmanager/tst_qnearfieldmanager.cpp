@@ -10,6 +10,9 @@
 #include <QtNfc/qndefmessage.h>
 #include <QtNfc/qndefrecord.h>
 
+#include <atomic>
+#include <memory>
+
 QT_USE_NAMESPACE
 
 Q_DECLARE_METATYPE(QNearFieldTarget*)
@@ -17,6 +20,22 @@ Q_DECLARE_METATYPE(QNearFieldTarget::Type)
 Q_DECLARE_METATYPE(QNdefFilter)
 Q_DECLARE_METATYPE(QNdefRecord::TypeNameFormat)
 
+class MessageHandler : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void ndefMessageRead(const QNdefMessage &message, QNearFieldTarget *target)
+    {
+        messages.append(message);
+        targets.append(target);
+    }
+
+public:
+    QList<QNdefMessage> messages;
+    QList<QNearFieldTarget *> targets;
+};
+
 class tst_QNearFieldManager : public QObject
 {
     Q_OBJECT
@@ -34,6 +53,9 @@ private slots:
 
     void targetDetected_data();
     void targetDetected();
+
+    void registerNdefMessageHandler();
+    void handlerRegistryMatch();
 };
 
 tst_QNearFieldManager::tst_QNearFieldManager()
@@ -153,6 +175,189 @@ void tst_QNearFieldManager::targetDetected()
     QCOMPARE(detectionStoppedSpy.size(), 1);
 }
 
+void tst_QNearFieldManager::registerNdefMessageHandler()
+{
+    QNearFieldManagerPrivateImpl *emulatorBackend = new QNearFieldManagerPrivateImpl;
+    QNearFieldManager manager(emulatorBackend, nullptr);
+
+    // The emulated tags contain a text and a URI record
+    QNdefFilter textAndUri;
+    textAndUri.appendRecord<QNdefNfcTextRecord>();
+    textAndUri.appendRecord<QNdefNfcUriRecord>();
+
+    QNdefFilter anyTwoRtd;
+    anyTwoRtd.appendRecord(QNdefRecord::NfcRtd, QByteArray(), 2, 2);
+
+    QNdefFilter uriThenText;
+    uriThenText.setOrderMatch(true);
+    uriThenText.appendRecord<QNdefNfcUriRecord>();
+    uriThenText.appendRecord<QNdefNfcTextRecord>();
+
+    QNdefFilter textOnly;
+    textOnly.appendRecord<QNdefNfcTextRecord>();
+
+    MessageHandler textAndUriHandler;
+    MessageHandler anyTwoRtdHandler;
+    MessageHandler uriThenTextHandler;
+    MessageHandler textOnlyHandler;
+
+    QCOMPARE(manager.registerNdefMessageHandler(textAndUri, static_cast<MessageHandler *>(nullptr),
+                                                &MessageHandler::ndefMessageRead),
+             -1);
+
+    const int textAndUriId = manager.registerNdefMessageHandler(
+            textAndUri, &textAndUriHandler, &MessageHandler::ndefMessageRead);
+    QVERIFY(textAndUriId != -1);
+    const int anyTwoRtdId = manager.registerNdefMessageHandler(
+            anyTwoRtd, &anyTwoRtdHandler, &MessageHandler::ndefMessageRead);
+    QVERIFY(anyTwoRtdId != -1);
+    const int uriThenTextId = manager.registerNdefMessageHandler(
+            uriThenText, &uriThenTextHandler, &MessageHandler::ndefMessageRead);
+    QVERIFY(uriThenTextId != -1);
+    const int textOnlyId = manager.registerNdefMessageHandler(
+            textOnly, &textOnlyHandler, &MessageHandler::ndefMessageRead);
+    QVERIFY(textOnlyId != -1);
+
+    // A functor with a context object, and one whose context is gone
+    QList<QNdefMessage> lambdaMessages;
+    const int lambdaId = manager.registerNdefMessageHandler(
+            textAndUri, this, [&lambdaMessages](const QNdefMessage &message) {
+                lambdaMessages.append(message);
+            });
+    QVERIFY(lambdaId != -1);
+    int destroyedContextCalls = 0;
+    auto destroyedContext = std::make_unique<QObject>();
+    const int destroyedContextId = manager.registerNdefMessageHandler(
+            textAndUri, destroyedContext.get(),
+            [&destroyedContextCalls](const QNdefMessage &, QNearFieldTarget *) {
+                ++destroyedContextCalls;
+            });
+    QVERIFY(destroyedContextId != -1);
+    destroyedContext.reset();
+
+    // A context in another thread gets the call in its own thread
+    QThread worker;
+    QObject workerContext;
+    workerContext.moveToThread(&worker);
+    worker.start();
+    const auto stopWorker = qScopeGuard([&worker]() {
+        worker.quit();
+        worker.wait();
+    });
+    std::atomic<QThread *> workerCallThread = nullptr;
+    const int workerContextId = manager.registerNdefMessageHandler(
+            textAndUri, &workerContext,
+            [&workerCallThread](const QNdefMessage &, QNearFieldTarget *) {
+                workerCallThread = QThread::currentThread();
+            });
+    QVERIFY(workerContextId != -1);
+
+    QNearFieldTarget *detectedTarget = nullptr;
+    connect(&manager, &QNearFieldManager::targetDetected, this,
+            [&detectedTarget](QNearFieldTarget *target) {
+                if (detectedTarget)
+                    return;
+                detectedTarget = target;
+                target->readNdefMessages();
+            });
+
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::NdefAccess));
+    QTRY_VERIFY(!textAndUriHandler.messages.isEmpty());
+    manager.stopTargetDetection();
+
+    QCOMPARE(textAndUriHandler.targets.first(), detectedTarget);
+    QCOMPARE(anyTwoRtdHandler.messages, textAndUriHandler.messages);
+    QVERIFY(uriThenTextHandler.messages.isEmpty());
+    QVERIFY(textOnlyHandler.messages.isEmpty());
+    QCOMPARE(lambdaMessages, textAndUriHandler.messages);
+    QCOMPARE(destroyedContextCalls, 0);
+    QTRY_COMPARE(workerCallThread.load(), &worker);
+
+    QVERIFY(manager.unregisterNdefMessageHandler(textAndUriId));
+    QVERIFY(!manager.unregisterNdefMessageHandler(textAndUriId));
+    QVERIFY(manager.unregisterNdefMessageHandler(anyTwoRtdId));
+    QVERIFY(manager.unregisterNdefMessageHandler(uriThenTextId));
+    QVERIFY(manager.unregisterNdefMessageHandler(textOnlyId));
+    QVERIFY(manager.unregisterNdefMessageHandler(lambdaId));
+    QVERIFY(manager.unregisterNdefMessageHandler(destroyedContextId));
+    QVERIFY(manager.unregisterNdefMessageHandler(workerContextId));
+}
+
+void tst_QNearFieldManager::handlerRegistryMatch()
+{
+    // The registry must agree with QNdefFilter::match() for every filter
+    QList<QNdefFilter> filters;
+
+    QNdefFilter empty;
+    filters << empty;
+
+    QNdefFilter text;
+    text.appendRecord<QNdefNfcTextRecord>(1, 2);
+    filters << text;
+
+    QNdefFilter textAndAnyMime;
+    textAndAnyMime.appendRecord<QNdefNfcTextRecord>(0, 1);
+    textAndAnyMime.appendRecord(QNdefRecord::Mime, QByteArray(), 1, 1);
+    textAndAnyMime.appendRecord<QNdefNfcTextRecord>(1, 1);
+    filters << textAndAnyMime;
+
+    QNdefFilter jpegOrAnyMime;
+    jpegOrAnyMime.appendRecord(QNdefRecord::Mime, "image/jpeg", 0, 1);
+    jpegOrAnyMime.appendRecord(QNdefRecord::Mime, QByteArray(), 0, 1);
+    filters << jpegOrAnyMime;
+
+    QNdefFilter orderedTextMime = textAndAnyMime;
+    orderedTextMime.setOrderMatch(true);
+    filters << orderedTextMime;
+
+    QNdefMessage textMessage;
+    textMessage << QNdefNfcTextRecord();
+    QNdefMessage textJpegText = textMessage;
+    textJpegText << QNdefRecord(QNdefRecord::Mime, "image/jpeg") << QNdefNfcTextRecord();
+    QNdefMessage jpegPng;
+    jpegPng << QNdefRecord(QNdefRecord::Mime, "image/jpeg")
+            << QNdefRecord(QNdefRecord::Mime, "image/png");
+    QNdefMessage uriMessage;
+    uriMessage << QNdefNfcUriRecord();
+
+    const QList<QNdefMessage> messages = { QNdefMessage(), textMessage, textJpegText,
+                                           jpegPng, uriMessage };
+
+    MessageHandler handler;
+    using Prototype = void (*)(const QNdefMessage &, QNearFieldTarget *);
+
+    QNdefMessageHandlerRegistry registry;
+    QList<int> ids;
+    for (const QNdefFilter &filter : std::as_const(filters)) {
+        ids << registry.registerHandler(
+                filter, &handler,
+                QtPrivate::makeCallableObject<Prototype>(&MessageHandler::ndefMessageRead));
+    }
+
+    for (const QNdefMessage &message : messages) {
+        QList<int> expected;
+        for (qsizetype i = 0; i < filters.size(); ++i) {
+            if (filters.at(i).match(message))
+                expected << ids.at(i);
+        }
+        QCOMPARE(registry.match(message), expected);
+    }
+
+    // Removing a filter must not disturb the index of the others
+    QVERIFY(registry.unregisterHandler(ids.at(1)));
+    for (const QNdefMessage &message : messages) {
+        QList<int> expected;
+        for (qsizetype i = 0; i < filters.size(); ++i) {
+            if (i != 1 && filters.at(i).match(message))
+                expected << ids.at(i);
+        }
+        QCOMPARE(registry.match(message), expected);
+    }
+
+    registry.dispatch(textJpegText, nullptr);
+    QCOMPARE(handler.messages.size(), 2); // textAndAnyMime and orderedTextMime
+}
+
 QTEST_MAIN(tst_QNearFieldManager)
 
 // Unset the moc namespace which is not required for the following include.
@@ -0,0 +1,981 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include "pcscstandin_p.h"
+#include "targetemulator_p.h"
+#include <QtNfc/qndefmessage.h>
+#include <QtNfc/qndefnfctextrecord.h>
+#include <QtNfc/qnearfieldmanager.h>
+#include <QtNfc/qnearfieldtarget.h>
+
+#include <memory>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+Q_DECLARE_METATYPE(QNearFieldTarget*)
+
+static constexpr char PollIntervalEnvVar[] = "QT_NFC_POLL_INTERVAL_MS";
+static constexpr char DifferentialWriteEnvVar[] = "QT_NFC_DIFFERENTIAL_NDEF_WRITES";
+static constexpr char ReaderName[] = "Stand-in Reader 00 00";
+
+// A card that only reports its UID, NDEF detection and all other commands
+// fail on it
+static PcscStandIn::CardHandler uidCard(const QByteArray &uid)
+{
+    return [uid](const QByteArray &command) -> QByteArray {
+        if (command.startsWith(QByteArray::fromHex("ffca0000")))
+            return uid + QByteArray::fromHex("9000");
+        return QByteArray::fromHex("6a82");
+    };
+}
+
+static const QByteArray DefaultUid = QByteArray::fromHex("04a1b2c3d4e5f6");
+static const PcscStandIn::CardHandler uidOnlyCard = uidCard(DefaultUid);
+
+class tst_QPcscManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void detectWithoutPolling();
+    void readerHotplug();
+    void stopCancelsWait();
+    void stopWithCardInFlight();
+    void destroyWhileWaiting();
+    void pollingFallback();
+    void slowReaderDoesNotBlockOthers();
+    void sendCommands();
+    void sendCommandsStopStatusWords();
+    void sendCommandsFailure();
+    void readType2Tag_data();
+    void readType2Tag();
+    void writeType2Tag();
+    void type4SessionCache();
+    void largeType4File_data();
+    void largeType4File();
+    void differentialType4Write_data();
+    void differentialType4Write();
+};
+
+void tst_QPcscManager::init()
+{
+    qunsetenv(PollIntervalEnvVar);
+    qunsetenv(DifferentialWriteEnvVar);
+    PcscStandIn::reset();
+}
+
+void tst_QPcscManager::cleanup()
+{
+    qunsetenv(PollIntervalEnvVar);
+    qunsetenv(DifferentialWriteEnvVar);
+    QCOMPARE(PcscStandIn::blockedCalls(), 0);
+}
+
+void tst_QPcscManager::detectWithoutPolling()
+{
+    PcscStandIn::addReader(ReaderName);
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QSignalSpy lostSpy(&manager, &QNearFieldManager::targetLost);
+
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    QVERIFY(PcscStandIn::waitForBlockedCalls(1));
+
+    // Nothing happens while waiting for a change
+    const int callsBefore = PcscStandIn::statistics().statusChangeCalls;
+    QTest::qWait(300);
+    QCOMPARE(PcscStandIn::statistics().statusChangeCalls, callsBefore);
+
+    QElapsedTimer timer;
+    qint64 latency = -1;
+    connect(&manager, &QNearFieldManager::targetDetected, this,
+            [&timer, &latency]() { latency = timer.elapsed(); });
+
+    timer.start();
+    PcscStandIn::insertCard(ReaderName, uidOnlyCard);
+    QTRY_COMPARE(detectedSpy.size(), 1);
+    qDebug() << "Card detected after" << latency << "ms";
+
+    auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+    QVERIFY(target);
+    QCOMPARE(target->uid(), DefaultUid);
+    QCOMPARE(target->accessMethods(), QNearFieldTarget::TagTypeSpecificAccess);
+
+    PcscStandIn::removeCard(ReaderName);
+    QTRY_COMPARE(lostSpy.size(), 1);
+    QCOMPARE(lostSpy.at(0).at(0).value<QNearFieldTarget *>(), target);
+
+    // Only the status changes have been checked, there was no polling
+    QVERIFY(PcscStandIn::statistics().pollingCalls < 10);
+}
+
+void tst_QPcscManager::readerHotplug()
+{
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QSignalSpy lostSpy(&manager, &QNearFieldManager::targetLost);
+
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+
+    // Without readers, only the reader list is watched
+    QVERIFY(PcscStandIn::waitForBlockedCalls(1));
+    const int idleContexts = PcscStandIn::openContexts();
+
+    for (int i = 1; i <= 3; ++i) {
+        PcscStandIn::addReader(ReaderName);
+        PcscStandIn::insertCard(ReaderName, uidOnlyCard);
+        QTRY_COMPARE(detectedSpy.size(), i);
+        // The worker of the slot has its own context
+        QVERIFY(PcscStandIn::openContexts() > idleContexts);
+
+        // The worker goes away with the reader
+        PcscStandIn::removeReader(ReaderName);
+        QTRY_COMPARE(lostSpy.size(), i);
+        QTRY_COMPARE(PcscStandIn::openContexts(), idleContexts);
+    }
+}
+
+void tst_QPcscManager::stopCancelsWait()
+{
+    PcscStandIn::addReader(ReaderName);
+
+    QNearFieldManager manager;
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    QVERIFY(PcscStandIn::waitForBlockedCalls(1));
+
+    // No card is present, so nothing needs to be tracked anymore
+    manager.stopTargetDetection();
+    QVERIFY(PcscStandIn::waitForBlockedCalls(0));
+    QVERIFY(PcscStandIn::statistics().cancelCalls > 0);
+
+    // Detection can be started again
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    PcscStandIn::insertCard(ReaderName, uidOnlyCard);
+    QTRY_COMPARE(detectedSpy.size(), 1);
+}
+
+void tst_QPcscManager::stopWithCardInFlight()
+{
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QSignalSpy lostSpy(&manager, &QNearFieldManager::targetLost);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    QVERIFY(PcscStandIn::waitForBlockedCalls(1));
+    const int idleContexts = PcscStandIn::openContexts();
+
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName, uidOnlyCard);
+    QTRY_VERIFY(PcscStandIn::openContexts() > idleContexts);
+
+    // The worker may still be connecting to the card. Its slot is kept until
+    // the worker answered, so a card it reports stays usable.
+    manager.stopTargetDetection();
+    QTest::qWait(100);
+    if (!detectedSpy.isEmpty()) {
+        auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+        QVERIFY(target);
+        QCOMPARE(target->uid(), DefaultUid);
+        QVERIFY(lostSpy.isEmpty());
+    }
+
+    // The slot goes away once it has no card
+    PcscStandIn::removeCard(ReaderName);
+    QTRY_COMPARE(lostSpy.size(), detectedSpy.size());
+    QTRY_VERIFY(PcscStandIn::openContexts() <= idleContexts);
+    QTRY_COMPARE(PcscStandIn::blockedCalls(), 0);
+}
+
+void tst_QPcscManager::destroyWhileWaiting()
+{
+    PcscStandIn::addReader(ReaderName);
+
+    auto manager = std::make_unique<QNearFieldManager>();
+    QVERIFY(manager->startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    QVERIFY(PcscStandIn::waitForBlockedCalls(1));
+
+    QElapsedTimer timer;
+    timer.start();
+    manager.reset();
+    qDebug() << "Manager destroyed after" << timer.elapsed() << "ms";
+
+    QCOMPARE(PcscStandIn::blockedCalls(), 0);
+}
+
+void tst_QPcscManager::pollingFallback()
+{
+    qputenv(PollIntervalEnvVar, "20");
+    PcscStandIn::addReader(ReaderName);
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+
+    PcscStandIn::insertCard(ReaderName, uidOnlyCard);
+    QTRY_COMPARE(detectedSpy.size(), 1);
+
+    QCOMPARE(PcscStandIn::blockedCalls(), 0);
+    QTRY_VERIFY(PcscStandIn::statistics().pollingCalls > 5);
+}
+
+void tst_QPcscManager::slowReaderDoesNotBlockOthers()
+{
+    using namespace std::chrono_literals;
+
+    constexpr int FastReaderCount = 3;
+    constexpr int CommandsPerTarget = 50;
+    const QByteArray slowReader = "Slow Reader";
+    const QByteArray slowUid = QByteArray::fromHex("04000000000000");
+
+    PcscStandIn::addReader(slowReader);
+    PcscStandIn::setTransmitDelay(slowReader, 200ms);
+    for (int i = 1; i <= FastReaderCount; ++i)
+        PcscStandIn::addReader("Fast Reader " + QByteArray::number(i));
+
+    QNearFieldManager manager;
+    QNearFieldTarget *slowTarget = nullptr;
+    QList<QNearFieldTarget *> fastTargets;
+    connect(&manager, &QNearFieldManager::targetDetected, this,
+            [&](QNearFieldTarget *target) {
+                if (target->uid() == slowUid)
+                    slowTarget = target;
+                else
+                    fastTargets.append(target);
+            });
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+
+    // The detection of the slow card takes several commands. The other cards
+    // are reported in the meantime.
+    PcscStandIn::insertCard(slowReader, uidCard(slowUid));
+    for (int i = 1; i <= FastReaderCount; ++i) {
+        PcscStandIn::insertCard("Fast Reader " + QByteArray::number(i),
+                                uidCard(QByteArray(7, char(i))));
+    }
+    QTRY_COMPARE(fastTargets.size(), FastReaderCount);
+    QVERIFY(!slowTarget);
+    QTRY_VERIFY(slowTarget);
+
+    // Keep the slow reader busy while the others serve a burst of commands
+    PcscStandIn::setTransmitDelay(slowReader, 1000ms);
+    bool slowCompleted = false;
+    connect(slowTarget, &QNearFieldTarget::requestCompleted, this,
+            [&slowCompleted] { slowCompleted = true; });
+    QVERIFY(slowTarget->sendCommand(QByteArray::fromHex("00b0000010")).isValid());
+
+    int completed = 0;
+    int completedWhileSlowBusy = 0;
+    for (auto target : std::as_const(fastTargets)) {
+        connect(target, &QNearFieldTarget::requestCompleted, this,
+                [&completed, &completedWhileSlowBusy, &slowCompleted] {
+                    ++completed;
+                    if (!slowCompleted)
+                        ++completedWhileSlowBusy;
+                });
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < CommandsPerTarget; ++i) {
+        for (auto target : std::as_const(fastTargets))
+            QVERIFY(target->sendCommand(QByteArray::fromHex("00b0000010")).isValid());
+    }
+
+    QTRY_COMPARE(completed, FastReaderCount * CommandsPerTarget);
+    qDebug() << completed << "commands completed in" << timer.elapsed() << "ms";
+    QTRY_VERIFY(slowCompleted);
+    QCOMPARE(completedWhileSlowBusy, FastReaderCount * CommandsPerTarget);
+}
+
+// A card answering READ BINARY with the offset given in P1-P2 and failing
+// all other commands except GET DATA for the UID
+static PcscStandIn::CardHandler readBinaryCard()
+{
+    return [](const QByteArray &command) -> QByteArray {
+        if (command.startsWith(QByteArray::fromHex("ffca0000")))
+            return DefaultUid + QByteArray::fromHex("9000");
+        if (command.size() >= 4 && command.startsWith(QByteArray::fromHex("00b0")))
+            return command.mid(2, 2) + QByteArray::fromHex("9000");
+        return QByteArray::fromHex("6a82");
+    };
+}
+
+static QByteArray readBinaryCommand(int offset)
+{
+    QByteArray command = QByteArray::fromHex("00b0000002");
+    command[2] = char(offset >> 8);
+    command[3] = char(offset & 0xff);
+    return command;
+}
+
+void tst_QPcscManager::sendCommands()
+{
+    constexpr int CommandCount = 40;
+
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName, readBinaryCard());
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    QTRY_COMPARE(detectedSpy.size(), 1);
+    auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+    QVERIFY(target);
+
+    QList<QByteArray> commands;
+    for (int i = 0; i < CommandCount; ++i)
+        commands.append(readBinaryCommand(i));
+
+    // One command at a time, for comparison
+    QElapsedTimer timer;
+    timer.start();
+    for (const auto &command : std::as_const(commands)) {
+        const auto id = target->sendCommand(command);
+        QVERIFY(target->waitForRequestCompleted(id));
+    }
+    qDebug() << CommandCount << "separate commands took" << timer.nsecsElapsed() / 1000 << "us";
+
+    QSignalSpy completedSpy(target, &QNearFieldTarget::requestCompleted);
+    const auto before = PcscStandIn::statistics();
+
+    timer.restart();
+    const auto id = target->sendCommands(commands);
+    QVERIFY(id.isValid());
+    QVERIFY(target->waitForRequestCompleted(id));
+    qDebug() << CommandCount << "batched commands took" << timer.nsecsElapsed() / 1000 << "us";
+
+    QCOMPARE(completedSpy.size(), 1);
+    const auto responses = target->requestResponse(id).value<QList<QByteArray>>();
+    QCOMPARE(responses.size(), CommandCount);
+    for (int i = 0; i < CommandCount; ++i)
+        QCOMPARE(responses.at(i), readBinaryCommand(i).mid(2, 2) + QByteArray::fromHex("9000"));
+
+    const auto after = PcscStandIn::statistics();
+    QCOMPARE(after.transmitCalls - before.transmitCalls, CommandCount);
+    // The automatic transaction started by the separate commands is reused
+    QCOMPARE(after.transactionCalls, before.transactionCalls);
+}
+
+void tst_QPcscManager::sendCommandsStopStatusWords()
+{
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName, readBinaryCard());
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    QTRY_COMPARE(detectedSpy.size(), 1);
+    auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+    QVERIFY(target);
+
+    const QList<QByteArray> commands = { readBinaryCommand(1),
+                                         QByteArray::fromHex("00a4040007d276000085010100"),
+                                         readBinaryCommand(2) };
+
+    // Without rules, all commands are sent
+    const auto before = PcscStandIn::statistics();
+    auto id = target->sendCommands(commands);
+    QVERIFY(target->waitForRequestCompleted(id));
+    auto responses = target->requestResponse(id).value<QList<QByteArray>>();
+    QCOMPARE(responses.size(), 3);
+    QCOMPARE(responses.at(1), QByteArray::fromHex("6a82"));
+    // Only the first command of the script started a transaction
+    QCOMPARE(PcscStandIn::statistics().transactionCalls - before.transactionCalls, 1);
+
+    // The script stops at the first matching status word
+    id = target->sendCommands(commands, { 0x6982, 0x6a82 });
+    QVERIFY(target->waitForRequestCompleted(id));
+    responses = target->requestResponse(id).value<QList<QByteArray>>();
+    QCOMPARE(responses.size(), 2);
+    QCOMPARE(responses.at(0), QByteArray::fromHex("00019000"));
+    QCOMPARE(responses.at(1), QByteArray::fromHex("6a82"));
+
+    // An empty script completes without sending anything
+    const int transmitCalls = PcscStandIn::statistics().transmitCalls;
+    id = target->sendCommands({});
+    QVERIFY(target->waitForRequestCompleted(id));
+    QVERIFY(target->requestResponse(id).value<QList<QByteArray>>().isEmpty());
+    QCOMPARE(PcscStandIn::statistics().transmitCalls, transmitCalls);
+}
+
+void tst_QPcscManager::sendCommandsFailure()
+{
+    // The response to the third command does not fit into any receive
+    // buffer, so transmitting it fails
+    const auto card = readBinaryCard();
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName, [card](const QByteArray &command) {
+        if (command == readBinaryCommand(3))
+            return QByteArray(0x20000, '\0');
+        return card(command);
+    });
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::TagTypeSpecificAccess));
+    QTRY_COMPARE(detectedSpy.size(), 1);
+    auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+    QVERIFY(target);
+
+    QSignalSpy completedSpy(target, &QNearFieldTarget::requestCompleted);
+    QSignalSpy errorSpy(target, &QNearFieldTarget::error);
+
+    const QList<QByteArray> commands = { readBinaryCommand(1), readBinaryCommand(2),
+                                         readBinaryCommand(3), readBinaryCommand(4) };
+    const auto before = PcscStandIn::statistics();
+    const auto id = target->sendCommands(commands);
+    QVERIFY(id.isValid());
+    QTRY_COMPARE(errorSpy.size(), 1);
+    QCOMPARE(errorSpy.at(0).at(0).value<QNearFieldTarget::Error>(),
+             QNearFieldTarget::CommandError);
+    QCOMPARE(errorSpy.at(0).at(1).value<QNearFieldTarget::RequestId>(), id);
+    QVERIFY(completedSpy.isEmpty());
+
+    // The responses received before the failure are kept, the rest of the
+    // script is skipped
+    const auto responses = target->requestResponse(id).value<QList<QByteArray>>();
+    QCOMPARE(responses.size(), 2);
+    QCOMPARE(responses.at(0), QByteArray::fromHex("00019000"));
+    QCOMPARE(responses.at(1), QByteArray::fromHex("00029000"));
+    QCOMPARE(PcscStandIn::statistics().transmitCalls - before.transmitCalls, 3);
+}
+
+// Translates the PC/SC storage card commands to Type 2 tag commands, as
+// contactless readers do. READ BINARY of more than 16 bytes uses FAST_READ.
+static PcscStandIn::CardHandler type2Reader(std::shared_ptr<NfcTagType2> tag)
+{
+    return [tag](const QByteArray &command) -> QByteArray {
+        const auto transceive = [&tag](QByteArray frame) {
+            const quint16 crc = qChecksum(frame, Qt::ChecksumItuV41);
+            frame.append(char(crc & 0xff));
+            frame.append(char(crc >> 8));
+            QByteArray response = tag->processCommand(frame);
+            if (response.size() > 1)
+                response.chop(2);
+            return response;
+        };
+
+        if (command.size() < 5 || quint8(command.at(0)) != 0xff)
+            return QByteArray::fromHex("6e00");
+
+        const quint8 ins = command.at(1);
+        const quint8 page = command.at(3);
+        if (ins == 0xca)
+            return tag->uid() + QByteArray::fromHex("9000");
+
+        if (ins == 0xb0) {
+            const int size = quint8(command.at(4)) ? quint8(command.at(4)) : 256;
+            QByteArray frame;
+            if (size == 16)
+                frame.append(char(0x30)).append(char(page));
+            else
+                frame.append(char(0x3a)).append(char(page)).append(char(page + size / 4 - 1));
+            const QByteArray response = transceive(frame);
+            if (response.size() <= 1)
+                return QByteArray::fromHex("6981");
+            return response + QByteArray::fromHex("9000");
+        }
+
+        if (ins == 0xd6 && command.size() == 9) {
+            QByteArray frame;
+            frame.append(char(0xa2)).append(char(page)).append(command.mid(5, 4));
+            if (transceive(frame) != QByteArray(1, 0x0a))
+                return QByteArray::fromHex("6581");
+            return QByteArray::fromHex("9000");
+        }
+
+        return QByteArray::fromHex("6a81");
+    };
+}
+
+// Memory of an NTAG21x with the given data area size and TLV blocks
+static QByteArray type2TagData(int dataAreaSize, const QByteArray &tlvs)
+{
+    QByteArray data = QByteArray::fromHex("04a1b28c" "c3d4e5f6" "a6480000");
+    data.append(char(0xe1)).append(char(0x10)).append(char(dataAreaSize / 8)).append(char(0x00));
+    data.append(tlvs);
+    // The data area is followed by the dynamic lock bytes and configuration pages
+    data.resize(16 + dataAreaSize + 20, '\0');
+    return data;
+}
+
+static QNearFieldTarget *detectType2Tag(QNearFieldManager &manager)
+{
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    if (!manager.startTargetDetection(QNearFieldTarget::NdefAccess))
+        return nullptr;
+    if (!QTest::qWaitFor([&detectedSpy] { return !detectedSpy.isEmpty(); }))
+        return nullptr;
+    return detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+}
+
+void tst_QPcscManager::readType2Tag_data()
+{
+    QTest::addColumn<bool>("fastRead");
+
+    QTest::newRow("FAST_READ") << true;
+    QTest::newRow("READ") << false;
+}
+
+void tst_QPcscManager::readType2Tag()
+{
+    QFETCH(bool, fastRead);
+
+    QNdefMessage message;
+    QNdefNfcTextRecord record;
+    record.setText(QString(590, u'x'));
+    message.append(record);
+    const QByteArray messageData = message.toByteArray();
+    QVERIFY(messageData.size() > 0xff);
+
+    QByteArray tlvs = QByteArray::fromHex("03ff");
+    tlvs.append(char(messageData.size() >> 8)).append(char(messageData.size() & 0xff));
+    tlvs.append(messageData).append(char(0xfe));
+
+    // NTAG216
+    auto tag = std::make_shared<NfcTagType2>();
+    tag->setData(type2TagData(872, tlvs));
+    tag->setFastReadSupported(fastRead);
+
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName, type2Reader(tag));
+
+    QNearFieldManager manager;
+    auto target = detectType2Tag(manager);
+    QVERIFY(target);
+    QCOMPARE(target->type(), QNearFieldTarget::NfcTagType2);
+    QVERIFY(target->accessMethods() & QNearFieldTarget::NdefAccess);
+    QCOMPARE(target->uid(), DefaultUid);
+
+    QSignalSpy messageSpy(target, &QNearFieldTarget::ndefMessageRead);
+    const int transmitCalls = PcscStandIn::statistics().transmitCalls;
+
+    const auto id = target->readNdefMessages();
+    QVERIFY(target->waitForRequestCompleted(id));
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(messageSpy.at(0).at(0).value<QNdefMessage>(), message);
+
+    // The memory up to the end of the message is read in as few commands as
+    // the reader allows. Without FAST_READ, the first large read fails.
+    const int endAddress = (16 + 4 + messageData.size() + 3) / 4 * 4;
+    const int expectedReads = fastRead ? (endAddress + 255) / 256 : 1 + (endAddress + 15) / 16;
+    QCOMPARE(PcscStandIn::statistics().transmitCalls - transmitCalls, expectedReads);
+}
+
+void tst_QPcscManager::writeType2Tag()
+{
+    // NTAG213 with a Lock Control TLV for the dynamic lock bytes after the
+    // data area, a Memory Control TLV reserving 8 bytes at address 64 and
+    // an empty NDEF message.
+    const QByteArray controlTlvs = QByteArray::fromHex("0103a00c34" "0203400804");
+    QByteArray tagData = type2TagData(144, controlTlvs + QByteArray::fromHex("0300fe"));
+    const QByteArray reserved(8, char(0xaa));
+    tagData.replace(64, reserved.size(), reserved);
+
+    auto tag = std::make_shared<NfcTagType2>();
+    tag->setData(tagData);
+    tag->setFastReadSupported(true);
+
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName, type2Reader(tag));
+
+    QNearFieldManager manager;
+    auto target = detectType2Tag(manager);
+    QVERIFY(target);
+    QCOMPARE(target->type(), QNearFieldTarget::NfcTagType2);
+
+    QNdefMessage message;
+    QNdefNfcTextRecord record;
+    record.setText(QString(100, u'q'));
+    message.append(record);
+    const QByteArray messageData = message.toByteArray();
+
+    auto id = target->writeNdefMessages({ message });
+    QVERIFY(target->waitForRequestCompleted(id));
+
+    // The TLV blocks are laid out around the reserved area
+    const QByteArray tlvs = controlTlvs + char(0x03) + char(messageData.size()) + messageData
+            + char(0xfe);
+    QByteArray expected = tagData;
+    expected.replace(16, 48, tlvs.left(48));
+    expected.replace(72, tlvs.size() - 48, tlvs.mid(48));
+    QCOMPARE(tag->data(), expected);
+
+    QSignalSpy messageSpy(target, &QNearFieldTarget::ndefMessageRead);
+    id = target->readNdefMessages();
+    QVERIFY(target->waitForRequestCompleted(id));
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(messageSpy.at(0).at(0).value<QNdefMessage>(), message);
+
+    // Writing the same message again only reads the tag
+    const int transmitCalls = PcscStandIn::statistics().transmitCalls;
+    id = target->writeNdefMessages({ message });
+    QVERIFY(target->waitForRequestCompleted(id));
+    QCOMPARE(PcscStandIn::statistics().transmitCalls - transmitCalls, 1);
+    QCOMPARE(tag->data(), expected);
+}
+
+// Capability container of a Type 4 tag with a writable NDEF file E104
+static QByteArray type4CapabilityContainer(quint16 mle, quint16 mlc, quint16 maxNdefSize)
+{
+    QByteArray cc = QByteArray::fromHex("000f20");
+    for (quint16 value : { mle, mlc })
+        cc += char(value >> 8) + QByteArray(1, char(value & 0xff));
+    cc += QByteArray::fromHex("0406e104");
+    cc += char(maxNdefSize >> 8) + QByteArray(1, char(maxNdefSize & 0xff));
+    return cc + QByteArray::fromHex("0000");
+}
+
+// Type 4 tag as in T4TOP 2.0. The handler may be called from the card
+// thread, the test only changes the state between tasks.
+struct Type4Tag
+{
+    QByteArray ccFile = type4CapabilityContainer(59, 52, 1024);
+    QByteArray ndefFile = QByteArray(2, 0);
+    bool extendedLengthSupported = true;
+
+    QByteArray selectedFile;
+    bool applicationSelected = false;
+
+    QByteArray processCommand(const QByteArray &command);
+};
+
+QByteArray Type4Tag::processCommand(const QByteArray &command)
+{
+    static const QByteArray ApplicationId = QByteArray::fromHex("d2760000850101");
+    static const QByteArray CCFileId = QByteArray::fromHex("e103");
+    static const QByteArray NdefFileId = QByteArray::fromHex("e104");
+
+    const auto ok = QByteArray::fromHex("9000");
+    const auto wrongLength = QByteArray::fromHex("6700");
+
+    if (command.startsWith(QByteArray::fromHex("ffca0000")))
+        return DefaultUid + ok;
+    if (command.size() < 4 || command.at(0) != 0)
+        return QByteArray::fromHex("6e00");
+
+    // Decode the body in short or extended form, ISO/IEC 7816-3 12.1.3
+    const QByteArrayView body = QByteArrayView(command).sliced(4);
+    const bool extended = body.size() >= 3 && body.at(0) == 0;
+    auto length = [](QByteArrayView field) {
+        int value = 0;
+        for (char c : field)
+            value = value << 8 | quint8(c);
+        return value ? value : 1 << (8 * field.size());
+    };
+    QByteArrayView data;
+    int ne = 0;
+    if (!body.isEmpty()) {
+        const qsizetype lengthSize = extended ? 2 : 1;
+        const qsizetype lcPos = extended ? 1 : 0;
+        const qsizetype shortLe = extended ? 3 : 1;
+        if (body.size() == shortLe) {
+            ne = length(body.last(lengthSize));
+        } else {
+            int nc = 0;
+            for (char c : body.sliced(lcPos, lengthSize))
+                nc = nc << 8 | quint8(c);
+            const qsizetype dataEnd = lcPos + lengthSize + nc;
+            if (body.size() == dataEnd + lengthSize)
+                ne = length(body.last(lengthSize));
+            else if (body.size() != dataEnd)
+                return wrongLength;
+            data = body.sliced(lcPos + lengthSize, nc);
+        }
+    }
+    if (extended && !extendedLengthSupported)
+        return wrongLength;
+
+    const quint8 p1 = command.at(2);
+    const quint8 p2 = command.at(3);
+    const int offset = p1 << 8 | p2;
+
+    switch (quint8(command.at(1))) {
+    case 0xa4:
+        if (p1 == 0x04) {
+            applicationSelected = data == ApplicationId;
+            selectedFile.clear();
+            return applicationSelected ? ok : QByteArray::fromHex("6a82");
+        }
+        if (applicationSelected && p1 == 0x00 && p2 == 0x0c) {
+            if (data == CCFileId || data == NdefFileId) {
+                selectedFile = data.toByteArray();
+                return ok;
+            }
+        }
+        return QByteArray::fromHex("6a82");
+    case 0xb0: {
+        if (selectedFile.isEmpty())
+            return QByteArray::fromHex("6986");
+        const QByteArray &file = selectedFile == CCFileId ? ccFile : ndefFile;
+        return file.mid(offset, ne) + ok;
+    }
+    case 0xd6:
+        if (selectedFile != NdefFileId)
+            return QByteArray::fromHex("6986");
+        if (ndefFile.size() < offset + data.size())
+            ndefFile.resize(offset + data.size());
+        ndefFile.replace(offset, data.size(), data);
+        return ok;
+    }
+    return QByteArray::fromHex("6d00");
+}
+
+void tst_QPcscManager::type4SessionCache()
+{
+    constexpr int Iterations = 5;
+
+    auto makeMessage = [](const QString &text) {
+        QNdefNfcTextRecord record;
+        record.setText(text);
+        return QNdefMessage(record);
+    };
+
+    auto tag = std::make_shared<Type4Tag>();
+    const QByteArray initialData = makeMessage(u"initial"_s).toByteArray();
+    tag->ndefFile = char(0) + QByteArray(1, char(initialData.size())) + initialData;
+
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName,
+                            [tag](const QByteArray &command) { return tag->processCommand(command); });
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::NdefAccess));
+    QTRY_COMPARE(detectedSpy.size(), 1);
+    auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+    QCOMPARE(target->type(), QNearFieldTarget::NfcTagType4);
+
+    QSignalSpy messageSpy(target, &QNearFieldTarget::ndefMessageRead);
+    auto transmitsFor = [&](auto task) {
+        const int before = PcscStandIn::statistics().transmitCalls;
+        const auto id = task();
+        if (!target->waitForRequestCompleted(id))
+            return -1;
+        return PcscStandIn::statistics().transmitCalls - before;
+    };
+    auto read = [&] { return transmitsFor([&] { return target->readNdefMessages(); }); };
+    auto write = [&](const QNdefMessage &message) {
+        return transmitsFor([&] { return target->writeNdefMessages({ message }); });
+    };
+
+    // The first read selects the application and the NDEF file, the
+    // capability container is not read again
+    QCOMPARE(read(), 4);
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(messageSpy.takeFirst().at(0).value<QNdefMessage>(), makeMessage(u"initial"_s));
+
+    // Other applications may select other files between the transactions of
+    // the tasks, so each task selects the NDEF file again
+    QCOMPARE(write(makeMessage(u"shared"_s)), 5);
+    QCOMPARE(read(), 4);
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(messageSpy.takeFirst().at(0).value<QNdefMessage>(), makeMessage(u"shared"_s));
+
+    // Commands from the user start a transaction that lasts until the target
+    // is disconnected. They may change the selection themselves.
+    auto id = target->sendCommand(QByteArray::fromHex("00a4000c02e103"));
+    QVERIFY(target->waitForRequestCompleted(id));
+    QCOMPARE(read(), 4);
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(messageSpy.takeFirst().at(0).value<QNdefMessage>(), makeMessage(u"shared"_s));
+
+    // Within the transaction, later tasks keep the selection
+    int saved = 0;
+    for (int i = 0; i < Iterations; ++i) {
+        const QNdefMessage message = makeMessage(u"message %1"_s.arg(i));
+        const int writeTransmits = write(message);
+        QCOMPARE(writeTransmits, 3);
+        const int readTransmits = read();
+        QCOMPARE(readTransmits, 2);
+        QCOMPARE(messageSpy.size(), 1);
+        QCOMPARE(messageSpy.takeFirst().at(0).value<QNdefMessage>(), message);
+        saved += 2 + 2;
+    }
+    qDebug() << "Saved" << saved << "APDUs in" << 2 * Iterations << "tasks";
+
+    // A selection lost behind our back is detected by the status word, and
+    // the task selects the file again
+    tag->selectedFile.clear();
+    QCOMPARE(read(), 1 + 4);
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(read(), 2);
+    QCOMPARE(messageSpy.size(), 2);
+}
+
+void tst_QPcscManager::largeType4File_data()
+{
+    QTest::addColumn<int>("maxInput");
+    QTest::addColumn<int>("mle");
+    QTest::addColumn<int>("mlc");
+    QTest::addColumn<bool>("cardExtended");
+    QTest::addColumn<int>("readChunk");
+    QTest::addColumn<int>("updateChunk");
+
+    QTest::newRow("short-reader") << 0 << 0xffff << 0xffff << true << 256 << 255;
+    QTest::newRow("extended") << 65544 << 0xffff << 0xffff << true << 0xffff << 0xffff;
+    QTest::newRow("card-limits") << 65544 << 0x1000 << 0x0800 << true << 0x1000 << 0x0800;
+    QTest::newRow("reader-limits") << 2048 << 0xffff << 0xffff << true << 2046 << 2041;
+    // The card rejects the first extended APDU of each kind
+    QTest::newRow("fallback") << 65544 << 0xffff << 0xffff << false << 256 << 255;
+}
+
+void tst_QPcscManager::largeType4File()
+{
+    QFETCH(int, maxInput);
+    QFETCH(int, mle);
+    QFETCH(int, mlc);
+    QFETCH(bool, cardExtended);
+    QFETCH(int, readChunk);
+    QFETCH(int, updateChunk);
+
+    auto tag = std::make_shared<Type4Tag>();
+    tag->ccFile = type4CapabilityContainer(mle, mlc, 0x4000);
+    tag->extendedLengthSupported = cardExtended;
+    const bool fallback = !cardExtended && maxInput > 0;
+
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::setMaxInput(ReaderName, maxInput);
+    PcscStandIn::insertCard(ReaderName,
+                            [tag](const QByteArray &command) { return tag->processCommand(command); });
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::NdefAccess));
+    QTRY_COMPARE(detectedSpy.size(), 1);
+    auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+
+    QNdefNfcTextRecord record;
+    record.setText(QString(8000, u'x'));
+    const QNdefMessage message(record);
+    const int messageSize = message.toByteArray().size();
+    auto chunks = [messageSize](int chunkSize) {
+        return (messageSize + chunkSize - 1) / chunkSize;
+    };
+
+    // Selection, clearing the length, the data and the final length, plus the
+    // failed extended update
+    int transmitCalls = PcscStandIn::statistics().transmitCalls;
+    auto id = target->writeNdefMessages({ message });
+    QVERIFY(target->waitForRequestCompleted(id));
+    const int writeTransmits = PcscStandIn::statistics().transmitCalls - transmitCalls;
+    QCOMPARE(writeTransmits, 2 + 1 + chunks(updateChunk) + 1 + (fallback ? 1 : 0));
+    QCOMPARE(tag->ndefFile.size(), 2 + messageSize);
+
+    QSignalSpy messageSpy(target, &QNearFieldTarget::ndefMessageRead);
+    transmitCalls = PcscStandIn::statistics().transmitCalls;
+    id = target->readNdefMessages();
+    QVERIFY(target->waitForRequestCompleted(id));
+    const int readTransmits = PcscStandIn::statistics().transmitCalls - transmitCalls;
+    // Selection, the length, the data and the failed extended read
+    QCOMPARE(readTransmits, 2 + 1 + chunks(readChunk) + (fallback ? 1 : 0));
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(messageSpy.at(0).at(0).value<QNdefMessage>(), message);
+
+    qDebug() << messageSize << "bytes written in" << writeTransmits << "and read in"
+             << readTransmits << "APDUs";
+}
+
+void tst_QPcscManager::differentialType4Write_data()
+{
+    QTest::addColumn<bool>("differential");
+
+    QTest::newRow("full") << false;
+    QTest::newRow("differential") << true;
+}
+
+void tst_QPcscManager::differentialType4Write()
+{
+    QFETCH(bool, differential);
+
+    if (differential)
+        qputenv(DifferentialWriteEnvVar, "1");
+
+    auto makeMessage = [](int points) {
+        QNdefNfcTextRecord owner;
+        owner.setText(u"Loyalty card of Jane Doe, member since 2020, gold tier"_s);
+        QNdefNfcTextRecord counter;
+        counter.setText(u"Points: %1"_s.arg(points, 6, 10, u'0'));
+        QNdefMessage message;
+        message << owner << counter;
+        return message;
+    };
+    auto fileContent = [](const QNdefMessage &message) -> QByteArray {
+        const QByteArray data = message.toByteArray();
+        return char(data.size() >> 8) + QByteArray(1, char(data.size() & 0xff)) + data;
+    };
+
+    auto tag = std::make_shared<Type4Tag>();
+    tag->ndefFile = fileContent(makeMessage(1));
+
+    PcscStandIn::addReader(ReaderName);
+    PcscStandIn::insertCard(ReaderName,
+                            [tag](const QByteArray &command) { return tag->processCommand(command); });
+
+    QNearFieldManager manager;
+    QSignalSpy detectedSpy(&manager, &QNearFieldManager::targetDetected);
+    QVERIFY(manager.startTargetDetection(QNearFieldTarget::NdefAccess));
+    QTRY_COMPARE(detectedSpy.size(), 1);
+    auto target = detectedSpy.at(0).at(0).value<QNearFieldTarget *>();
+
+    auto transmitsFor = [&](auto task) {
+        const int before = PcscStandIn::statistics().transmitCalls;
+        const auto id = task();
+        if (!target->waitForRequestCompleted(id))
+            return -1;
+        return PcscStandIn::statistics().transmitCalls - before;
+    };
+    auto write = [&](const QNdefMessage &message) {
+        return transmitsFor([&] { return target->writeNdefMessages({ message }); });
+    };
+
+    // Clearing the length, 52 byte updates and writing the length
+    const int messageSize = makeMessage(1).toByteArray().size();
+    const int fullWrite = 1 + (messageSize + 51) / 52 + 1;
+
+    QCOMPARE(transmitsFor([&] { return target->readNdefMessages(); }), 4);
+
+    // Only the counter changes. Each write selects the NDEF file first.
+    int saved = 0;
+    for (int points = 2; points <= 4; ++points) {
+        const int transmits = write(makeMessage(points));
+        QCOMPARE(transmits, 2 + (differential ? 3 : fullWrite));
+        QCOMPARE(tag->ndefFile, fileContent(makeMessage(points)));
+        saved += 2 + fullWrite - transmits;
+    }
+    qDebug() << "Saved" << saved << "of" << 3 * fullWrite << "APDUs";
+
+    // Nothing to do if the message has not changed
+    QCOMPARE(write(makeMessage(4)), differential ? 0 : 2 + fullWrite);
+
+    // The content is unknown after other commands
+    auto id = target->sendCommand(QByteArray::fromHex("00b0000002"));
+    QVERIFY(target->waitForRequestCompleted(id));
+    QCOMPARE(write(makeMessage(5)), 2 + fullWrite);
+    QCOMPARE(tag->ndefFile, fileContent(makeMessage(5)));
+
+    // A longer message is written from the first changed byte on
+    QNdefMessage longer = makeMessage(6);
+    QNdefNfcTextRecord note;
+    note.setText(u"Free coffee on the next visit"_s);
+    longer << note;
+    QVERIFY(write(longer) > 0);
+    QCOMPARE(tag->ndefFile, fileContent(longer));
+
+    QSignalSpy messageSpy(target, &QNearFieldTarget::ndefMessageRead);
+    id = target->readNdefMessages();
+    QVERIFY(target->waitForRequestCompleted(id));
+    QCOMPARE(messageSpy.size(), 1);
+    QCOMPARE(messageSpy.at(0).at(0).value<QNdefMessage>(), longer);
+}
+
+QTEST_MAIN(tst_QPcscManager)
+
+#include "tst_qpcscmanager.moc"
@@ -0,0 +1,170 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QSocketNotifier>
+#include <QtBluetooth/private/attioreader_p.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// The peer side of a socketpair stands in for the remote GATT server. It sends
+// notifications and indications and waits for the confirmation, the same way
+// a real device would over the L2CAP ATT channel.
+class tst_bench_AttIoReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void indicationConfirmation_data();
+    void indicationConfirmation();
+    void indicationConfirmationOnOwnerThread_data();
+    void indicationConfirmationOnOwnerThread();
+    void notificationDelivery_data();
+    void notificationDelivery();
+
+private:
+    static QByteArray pdu(quint8 opCode, int payloadSize);
+    void addPayloadSizes();
+
+    int m_fds[2] = { -1, -1 };
+};
+
+static constexpr char AttOpHandleValueNotification = 0x1B;
+static constexpr char AttOpHandleValueIndication = 0x1D;
+static constexpr char AttOpHandleValueConfirmation = 0x1E;
+
+void tst_bench_AttIoReader::init()
+{
+    QCOMPARE(::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, m_fds), 0);
+
+    // never hang the benchmark if a confirmation goes missing
+    timeval timeout = { 5, 0 };
+    QCOMPARE(::setsockopt(m_fds[1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout), 0);
+}
+
+void tst_bench_AttIoReader::cleanup()
+{
+    for (int &fd : m_fds) {
+        if (fd != -1)
+            ::close(fd);
+        fd = -1;
+    }
+}
+
+QByteArray tst_bench_AttIoReader::pdu(quint8 opCode, int payloadSize)
+{
+    QByteArray packet(3 + payloadSize, 'x');
+    packet[0] = char(opCode);
+    packet[1] = 0x10; // handle 0x0010
+    packet[2] = 0x00;
+    return packet;
+}
+
+void tst_bench_AttIoReader::addPayloadSizes()
+{
+    QTest::addColumn<int>("payloadSize");
+
+    // default MTU, typical negotiated MTU and maximum MTU
+    QTest::newRow("20") << 20;
+    QTest::newRow("244") << 244;
+    QTest::newRow("509") << 509;
+}
+
+void tst_bench_AttIoReader::indicationConfirmation_data()
+{
+    addPayloadSizes();
+}
+
+void tst_bench_AttIoReader::indicationConfirmation()
+{
+    QFETCH(int, payloadSize);
+
+    AttIoReader *reader = AttIoReader::start(m_fds[0]);
+    QVERIFY(reader);
+
+    // This thread never returns to its event loop while measuring,
+    // the confirmations are sent by the I/O thread alone.
+    const QByteArray indication = pdu(AttOpHandleValueIndication, payloadSize);
+    QBENCHMARK {
+        QCOMPARE(::send(m_fds[1], indication.constData(), indication.size(), MSG_NOSIGNAL),
+                 ssize_t(indication.size()));
+        char confirmation = 0;
+        QCOMPARE(::recv(m_fds[1], &confirmation, 1, 0), ssize_t(1));
+        QCOMPARE(confirmation, AttOpHandleValueConfirmation);
+    }
+
+    reader->stop();
+}
+
+void tst_bench_AttIoReader::indicationConfirmationOnOwnerThread_data()
+{
+    addPayloadSizes();
+}
+
+void tst_bench_AttIoReader::indicationConfirmationOnOwnerThread()
+{
+    // Baseline: what the controller does without the I/O thread
+    QFETCH(int, payloadSize);
+
+    QSocketNotifier notifier(m_fds[0], QSocketNotifier::Read);
+    connect(&notifier, &QSocketNotifier::activated, this, [this]() {
+        char buffer[1024];
+        const auto size = ::recv(m_fds[0], buffer, sizeof buffer, MSG_DONTWAIT);
+        if (size > 0 && buffer[0] == AttOpHandleValueIndication)
+            ::send(m_fds[0], &AttOpHandleValueConfirmation, 1, MSG_NOSIGNAL);
+    });
+
+    const QByteArray indication = pdu(AttOpHandleValueIndication, payloadSize);
+    QBENCHMARK {
+        QCOMPARE(::send(m_fds[1], indication.constData(), indication.size(), MSG_NOSIGNAL),
+                 ssize_t(indication.size()));
+        char confirmation = 0;
+        while (::recv(m_fds[1], &confirmation, 1, MSG_DONTWAIT) != 1)
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        QCOMPARE(confirmation, AttOpHandleValueConfirmation);
+    }
+}
+
+void tst_bench_AttIoReader::notificationDelivery_data()
+{
+    addPayloadSizes();
+}
+
+void tst_bench_AttIoReader::notificationDelivery()
+{
+    // Time until a notification reaches the thread owning the controller
+    QFETCH(int, payloadSize);
+
+    AttIoReader *reader = AttIoReader::start(m_fds[0]);
+    QVERIFY(reader);
+
+    qsizetype received = 0;
+    const auto connection = connect(reader, &AttIoReader::packetReceived, this,
+            [&received, payloadSize](const QByteArray &packet, bool indicationConfirmed) {
+                QCOMPARE(packet.size(), qsizetype(3 + payloadSize));
+                QVERIFY(!indicationConfirmed);
+                ++received;
+            });
+
+    const QByteArray notification = pdu(AttOpHandleValueNotification, payloadSize);
+    QBENCHMARK {
+        const qsizetype expected = received + 1;
+        QCOMPARE(::send(m_fds[1], notification.constData(), notification.size(), MSG_NOSIGNAL),
+                 ssize_t(notification.size()));
+        while (received < expected)
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+
+    reader->stop();
+    disconnect(connection);
+}
+
+QTEST_GUILESS_MAIN(tst_bench_AttIoReader)
+
+#include "tst_bench_attioreader.moc"
@@ -0,0 +1,114 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/qbluetoothaddress.h>
+#include <QtBluetooth/private/qbluetoothaddress_p.h>
+#include <QtBluetooth/private/qtbluetoothglobal_p.h>
+#if QT_CONFIG(bluez)
+#include <QtBluetooth/private/bluez5_helper_p.h>
+#endif
+
+using namespace Qt::StringLiterals;
+
+class tst_bench_QBluetoothAddress : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void toString();
+    void toBuffer();
+    void fromString();
+    void fromLatin1();
+#if QT_CONFIG(bluez)
+    void devicePath();
+#endif
+};
+
+// Each iteration converts a batch, a single conversion is too short to measure
+static constexpr int BatchSize = 256;
+
+static QList<QBluetoothAddress> addresses()
+{
+    QList<QBluetoothAddress> result;
+    for (int i = 0; i < BatchSize; ++i)
+        result.append(QBluetoothAddress(Q_UINT64_C(0x0123456789AB) * quint64(i + 1)
+                                        & Q_UINT64_C(0xFFFFFFFFFFFF)));
+    return result;
+}
+
+void tst_bench_QBluetoothAddress::toString()
+{
+    const QList<QBluetoothAddress> input = addresses();
+    qsizetype length = 0;
+    QBENCHMARK {
+        for (const QBluetoothAddress &address : input)
+            length += address.toString().size();
+    }
+    QVERIFY(length > 0);
+}
+
+void tst_bench_QBluetoothAddress::toBuffer()
+{
+    const QList<QBluetoothAddress> input = addresses();
+    char buffer[QtBluetoothPrivate::AddressStringLength];
+    int checksum = 0;
+    QBENCHMARK {
+        for (const QBluetoothAddress &address : input) {
+            QtBluetoothPrivate::toAddressString(address, buffer);
+            checksum += buffer[16];
+        }
+    }
+    QVERIFY(checksum > 0);
+}
+
+void tst_bench_QBluetoothAddress::fromString()
+{
+    QStringList input;
+    for (const QBluetoothAddress &address : addresses())
+        input.append(address.toString());
+
+    quint64 checksum = 0;
+    QBENCHMARK {
+        for (const QString &string : input)
+            checksum += QBluetoothAddress(string).toUInt64();
+    }
+    QVERIFY(checksum > 0);
+}
+
+// D-Bus strings and advertisement data arrive as Latin-1
+void tst_bench_QBluetoothAddress::fromLatin1()
+{
+    QList<QByteArray> input;
+    for (const QBluetoothAddress &address : addresses())
+        input.append(address.toString().toLatin1());
+
+    quint64 checksum = 0;
+    QBENCHMARK {
+        for (const QByteArray &string : input)
+            checksum += QtBluetoothPrivate::addressFromString(QLatin1StringView(string)).toUInt64();
+    }
+    QVERIFY(checksum > 0);
+}
+
+#if QT_CONFIG(bluez)
+void tst_bench_QBluetoothAddress::devicePath()
+{
+    const QList<QBluetoothAddress> input = addresses();
+    const QString adapterPath = u"/org/bluez/hci0"_s;
+
+    quint64 checksum = 0;
+    QBENCHMARK {
+        for (const QBluetoothAddress &address : input) {
+            const QString path = devicePathForAddress(adapterPath, address);
+            checksum += addressFromDevicePath(path).toUInt64();
+        }
+    }
+    QVERIFY(checksum > 0);
+}
+#endif
+
+QTEST_MAIN(tst_bench_QBluetoothAddress)
+
+#include "tst_bench_qbluetoothaddress.moc"
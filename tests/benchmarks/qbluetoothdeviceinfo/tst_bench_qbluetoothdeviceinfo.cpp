@@ -0,0 +1,114 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/qbluetoothaddress.h>
+#include <QtBluetooth/qbluetoothdeviceinfo.h>
+#include <QtBluetooth/qbluetoothuuid.h>
+#include <QtBluetooth/private/qbluetoothdeviceinfo_p.h>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define HAS_MALLINFO2
+#endif
+
+using namespace Qt::StringLiterals;
+
+/*
+ * Reports the heap a scanner holding many discovered devices pays per device.
+ * The numbers depend on the allocator, they are meant for comparing builds
+ * on the same machine and are not checked against a limit.
+ */
+class tst_bench_QBluetoothDeviceInfo : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void privateSize();
+    void heapPerDevice();
+    void heapPerCopy();
+};
+
+static constexpr int DeviceCount = 1000;
+
+#ifdef HAS_MALLINFO2
+static QList<QByteArray> payloads()
+{
+    QList<QByteArray> result;
+    for (int i = 0; i < DeviceCount; ++i)
+        result.append(QByteArray::number(i));
+    return result;
+}
+
+// A Low Energy device with one manufacturer and one service data entry
+static QBluetoothDeviceInfo device(int index, const QByteArray &payload)
+{
+    const QBluetoothUuid service(QBluetoothUuid::ServiceClassUuid::BatteryService);
+    QBluetoothDeviceInfo info(QBluetoothAddress(quint64(index)), u"Tag"_s, 0);
+    info.setCoreConfigurations(QBluetoothDeviceInfo::LowEnergyCoreConfiguration);
+    info.setRssi(-50);
+    info.setServiceUuids({ service });
+    info.setManufacturerData(0x1F, payload);
+    info.setServiceData(service, payload);
+    return info;
+}
+
+static size_t allocatedBytes()
+{
+    return mallinfo2().uordblks;
+}
+#endif
+
+void tst_bench_QBluetoothDeviceInfo::privateSize()
+{
+    QTest::setBenchmarkResult(sizeof(QBluetoothDeviceInfoPrivate), QTest::BytesAllocated);
+}
+
+void tst_bench_QBluetoothDeviceInfo::heapPerDevice()
+{
+#ifdef HAS_MALLINFO2
+    const QList<QByteArray> input = payloads();
+    QList<QBluetoothDeviceInfo> devices;
+    devices.reserve(DeviceCount);
+
+    const size_t before = allocatedBytes();
+    for (int i = 0; i < DeviceCount; ++i)
+        devices.append(device(i, input.at(i)));
+    const size_t after = allocatedBytes();
+
+    QTest::setBenchmarkResult(after > before ? qreal(after - before) / DeviceCount : 0,
+                              QTest::BytesAllocated);
+    QCOMPARE(devices.size(), qsizetype(DeviceCount));
+#else
+    QSKIP("mallinfo2() is needed to measure the heap");
+#endif
+}
+
+void tst_bench_QBluetoothDeviceInfo::heapPerCopy()
+{
+#ifdef HAS_MALLINFO2
+    const QList<QByteArray> input = payloads();
+    QList<QBluetoothDeviceInfo> devices;
+    devices.reserve(DeviceCount);
+    for (int i = 0; i < DeviceCount; ++i)
+        devices.append(device(i, input.at(i)));
+    QList<QBluetoothDeviceInfo> copies;
+    copies.reserve(DeviceCount);
+
+    const size_t before = allocatedBytes();
+    for (const QBluetoothDeviceInfo &info : std::as_const(devices))
+        copies.append(info);
+    const size_t after = allocatedBytes();
+
+    QTest::setBenchmarkResult(after > before ? qreal(after - before) / DeviceCount : 0,
+                              QTest::BytesAllocated);
+    QCOMPARE(copies, devices);
+#else
+    QSKIP("mallinfo2() is needed to measure the heap");
+#endif
+}
+
+QTEST_MAIN(tst_bench_QBluetoothDeviceInfo)
+
+#include "tst_bench_qbluetoothdeviceinfo.moc"
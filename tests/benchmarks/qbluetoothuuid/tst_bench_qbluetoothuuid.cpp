@@ -0,0 +1,129 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/qbluetoothuuid.h>
+#include <QtBluetooth/private/qbluetoothuuid_p.h>
+
+class tst_bench_QBluetoothUuid : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void toString();
+    void toBuffer();
+    void fromString();
+    void fromLatin1();
+    void characteristicNames();
+    void assignedNumberFromName();
+};
+
+// Each iteration converts a batch, a single conversion is too short to measure
+static constexpr int BatchSize = 256;
+
+static QList<QBluetoothUuid> uuids()
+{
+    QList<QBluetoothUuid> result;
+    for (int i = 0; i < BatchSize; ++i) {
+        // Mix of 16 bit assigned numbers and vendor specific UUIDs
+        if (i % 2)
+            result.append(QBluetoothUuid(quint16(0x2A00 + i)));
+        else
+            result.append(QBluetoothUuid(quint32(0x6E400001 + i), 0xB5A3, 0xF393, 0xE0, 0xA9,
+                                         0xE5, 0x0E, 0x24, 0xDC, 0xCA, 0x9E));
+    }
+    return result;
+}
+
+// BlueZ expects the form without braces
+void tst_bench_QBluetoothUuid::toString()
+{
+    const QList<QBluetoothUuid> input = uuids();
+    qsizetype length = 0;
+    QBENCHMARK {
+        for (const QBluetoothUuid &uuid : input)
+            length += uuid.toString(QUuid::WithoutBraces).size();
+    }
+    QVERIFY(length > 0);
+}
+
+void tst_bench_QBluetoothUuid::toBuffer()
+{
+    const QList<QBluetoothUuid> input = uuids();
+    char buffer[QtBluetoothPrivate::UuidStringLength];
+    int checksum = 0;
+    QBENCHMARK {
+        for (const QBluetoothUuid &uuid : input) {
+            QtBluetoothPrivate::toUuidString(uuid, buffer);
+            checksum += buffer[35];
+        }
+    }
+    QVERIFY(checksum > 0);
+}
+
+void tst_bench_QBluetoothUuid::fromString()
+{
+    QStringList input;
+    for (const QBluetoothUuid &uuid : uuids())
+        input.append(uuid.toString(QUuid::WithoutBraces));
+
+    int nullCount = 0;
+    QBENCHMARK {
+        for (const QString &string : input)
+            nullCount += QBluetoothUuid(string).isNull();
+    }
+    QCOMPARE(nullCount, 0);
+}
+
+void tst_bench_QBluetoothUuid::fromLatin1()
+{
+    QList<QByteArray> input;
+    for (const QBluetoothUuid &uuid : uuids())
+        input.append(uuid.toString(QUuid::WithoutBraces).toLatin1());
+
+    int nullCount = 0;
+    QBENCHMARK {
+        for (const QByteArray &string : input)
+            nullCount += QtBluetoothPrivate::uuidFromString(QLatin1StringView(string)).isNull();
+    }
+    QCOMPARE(nullCount, 0);
+}
+
+// A scanner labeling the characteristics it discovered
+void tst_bench_QBluetoothUuid::characteristicNames()
+{
+    QList<QBluetoothUuid::CharacteristicType> input;
+    for (quint16 value = 0x2A00; value < 0x2AA0; ++value)
+        input.append(QBluetoothUuid::CharacteristicType(value));
+
+    qsizetype length = 0;
+    QBENCHMARK {
+        for (QBluetoothUuid::CharacteristicType type : input)
+            length += QBluetoothUuid::characteristicToString(type).size();
+    }
+    QVERIFY(length > 0);
+}
+
+void tst_bench_QBluetoothUuid::assignedNumberFromName()
+{
+    using namespace QtBluetoothPrivate;
+
+    QList<QLatin1StringView> input;
+    for (quint32 value = 0x2A00; value < 0x2AA0; ++value) {
+        if (const char *name = assignedNumberName(AssignedNumberType::Characteristic,
+                                                  quint16(value)))
+            input.append(QLatin1StringView(name));
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        for (QLatin1StringView name : input)
+            found += assignedNumber(AssignedNumberType::Characteristic, name).has_value();
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_MAIN(tst_bench_QBluetoothUuid)
+
+#include "tst_bench_qbluetoothuuid.moc"
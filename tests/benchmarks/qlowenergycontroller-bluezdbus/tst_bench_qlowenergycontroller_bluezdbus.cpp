@@ -0,0 +1,264 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/QBluetoothDeviceInfo>
+#include <QtBluetooth/QLowEnergyController>
+#include <QtBluetooth/QLowEnergyService>
+#include <QtBluetooth/private/bluez5_helper_p.h>
+#include <QtBluetooth/private/bluezobjecttree_p.h>
+
+#include <memory>
+#include <vector>
+
+#include "../../shared/fakebluetoothd_p.h"
+
+using namespace Qt::StringLiterals;
+
+static constexpr int DescriptorsPerCharacteristic = 2;
+
+class tst_bench_QLowEnergyControllerBluezDBus : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void discoverAll_data();
+    void discoverAll();
+    void discoverValues();
+    void readAll_data();
+    void readAll();
+    void connectMany();
+
+private:
+    static QBluetoothAddress otherAddress(int index);
+    static ManagedObjectList objectTree(int serviceCount, int characteristicsPerService,
+                                        int otherDeviceCount, bool connected = true);
+    static std::unique_ptr<QLowEnergyController> connectedController();
+
+    FakeSystemBus m_bus;
+    FakeBluetoothd *m_bluetoothd = nullptr;
+};
+
+void tst_bench_QLowEnergyControllerBluezDBus::initTestCase()
+{
+    if (!FakeSystemBus::isSupported())
+        QSKIP("dbus-daemon is needed for the private bus");
+
+    QVERIFY(m_bus.start());
+    m_bluetoothd = m_bus.bluetoothd();
+}
+
+void tst_bench_QLowEnergyControllerBluezDBus::cleanupTestCase()
+{
+    m_bus.stop();
+}
+
+QBluetoothAddress tst_bench_QLowEnergyControllerBluezDBus::otherAddress(int index)
+{
+    return QBluetoothAddress(0x001122000000 + index);
+}
+
+ManagedObjectList tst_bench_QLowEnergyControllerBluezDBus::objectTree(
+        int serviceCount, int characteristicsPerService, int otherDeviceCount, bool connected)
+{
+    // Every device exports the same GATT hierarchy, the other devices make
+    // the tree large without being part of the discovery
+    ManagedObjectList objects = fakeAdapterTree();
+    addFakeDevice(objects, fakeRemoteAddress, serviceCount, characteristicsPerService,
+                  DescriptorsPerCharacteristic, connected);
+    for (int i = 0; i < otherDeviceCount; ++i) {
+        addFakeDevice(objects, otherAddress(i), serviceCount, characteristicsPerService,
+                      DescriptorsPerCharacteristic, connected);
+    }
+    return objects;
+}
+
+std::unique_ptr<QLowEnergyController> tst_bench_QLowEnergyControllerBluezDBus::connectedController()
+{
+    std::unique_ptr<QLowEnergyController> controller(QLowEnergyController::createCentral(
+            QBluetoothDeviceInfo(fakeRemoteAddress, u"fake"_s, 0)));
+    controller->connectToDevice();
+    if (!waitFor([&]() { return controller->state() == QLowEnergyController::ConnectedState; }))
+        return {};
+    controller->discoverServices();
+    if (!waitFor([&]() { return controller->state() == QLowEnergyController::DiscoveredState; }))
+        return {};
+    return controller;
+}
+
+void tst_bench_QLowEnergyControllerBluezDBus::discoverAll_data()
+{
+    QTest::addColumn<int>("serviceCount");
+    QTest::addColumn<int>("otherDeviceCount");
+
+    QTest::newRow("1 service") << 1 << 0;
+    QTest::newRow("15 services") << 15 << 0;
+    QTest::newRow("15 services, 50 other devices") << 15 << 50;
+    QTest::newRow("15 services, 500 other devices") << 15 << 500;
+}
+
+// Connects to an already connected device and discovers all of its services
+// and their details, as an application does after connecting
+void tst_bench_QLowEnergyControllerBluezDBus::discoverAll()
+{
+    QFETCH(int, serviceCount);
+    QFETCH(int, otherDeviceCount);
+
+    static constexpr int CharacteristicsPerService = 8;
+    m_bluetoothd->setObjects(objectTree(serviceCount, CharacteristicsPerService,
+                                        otherDeviceCount));
+
+    // Fetch the new tree up front, the benchmark measures the discovery
+    QtBluezObjectTree::instance()->clear();
+    QVERIFY(QtBluezObjectTree::instance()->ensureLoaded());
+
+    QBENCHMARK {
+        const std::unique_ptr<QLowEnergyController> controller = connectedController();
+        QVERIFY(controller);
+
+        const QList<QBluetoothUuid> services = controller->services();
+        QCOMPARE(services.size(), qsizetype(serviceCount));
+        for (const QBluetoothUuid &serviceUuid : services) {
+            std::unique_ptr<QLowEnergyService> service(
+                    controller->createServiceObject(serviceUuid));
+            QVERIFY(service);
+            service->discoverDetails(QLowEnergyService::SkipValueDiscovery);
+            QVERIFY(waitFor([&]() {
+                return service->state() == QLowEnergyService::RemoteServiceDiscovered;
+            }));
+            QCOMPARE(service->characteristics().size(), qsizetype(CharacteristicsPerService));
+            QCOMPARE(service->characteristics().constFirst().descriptors().size(),
+                     qsizetype(DescriptorsPerCharacteristic));
+        }
+    }
+}
+
+// Discovers one service including the initial values of its characteristics
+// and descriptors, which are read from the device
+void tst_bench_QLowEnergyControllerBluezDBus::discoverValues()
+{
+    m_bluetoothd->setObjects(objectTree(1, 16, 0));
+    m_bluetoothd->setReadLatency(2);
+    QtBluezObjectTree::instance()->clear();
+    QVERIFY(QtBluezObjectTree::instance()->ensureLoaded());
+
+    const std::unique_ptr<QLowEnergyController> controller = connectedController();
+    QVERIFY(controller);
+    QCOMPARE(controller->services().size(), qsizetype(1));
+
+    QBENCHMARK {
+        std::unique_ptr<QLowEnergyService> service(
+                controller->createServiceObject(controller->services().constFirst()));
+        QVERIFY(service);
+        service->discoverDetails(QLowEnergyService::FullDiscovery);
+        QVERIFY(waitFor([&]() {
+            return service->state() == QLowEnergyService::RemoteServiceDiscovered;
+        }));
+        QCOMPARE(service->characteristics().constFirst().value(), QByteArray("value"));
+    }
+
+    m_bluetoothd->setReadLatency(0);
+}
+
+void tst_bench_QLowEnergyControllerBluezDBus::readAll_data()
+{
+    QTest::addColumn<QByteArray>("concurrency");
+
+    QTest::newRow("1 in flight") << QByteArray("1");
+    QTest::newRow("4 in flight") << QByteArray("4");
+    QTest::newRow("16 in flight") << QByteArray("16");
+}
+
+// Reads every characteristic of a service, the reads of different
+// characteristics wait for bluetoothd at the same time
+void tst_bench_QLowEnergyControllerBluezDBus::readAll()
+{
+    QFETCH(QByteArray, concurrency);
+
+    static constexpr int CharacteristicCount = 16;
+    m_bluetoothd->setObjects(objectTree(1, CharacteristicCount, 0));
+    m_bluetoothd->setReadLatency(2);
+    QtBluezObjectTree::instance()->clear();
+    QVERIFY(QtBluezObjectTree::instance()->ensureLoaded());
+
+    // Read when the controller is created
+    qputenv("QT_BLUETOOTH_GATT_CONCURRENCY", concurrency);
+    const std::unique_ptr<QLowEnergyController> controller = connectedController();
+    qunsetenv("QT_BLUETOOTH_GATT_CONCURRENCY");
+    QVERIFY(controller);
+
+    std::unique_ptr<QLowEnergyService> service(
+            controller->createServiceObject(controller->services().constFirst()));
+    QVERIFY(service);
+    service->discoverDetails(QLowEnergyService::SkipValueDiscovery);
+    QVERIFY(waitFor([&]() {
+        return service->state() == QLowEnergyService::RemoteServiceDiscovered;
+    }));
+    const QList<QLowEnergyCharacteristic> characteristics = service->characteristics();
+    QCOMPARE(characteristics.size(), qsizetype(CharacteristicCount));
+
+    int readCount = 0;
+    connect(service.get(), &QLowEnergyService::characteristicRead, this, [&readCount]() {
+        ++readCount;
+    });
+
+    QBENCHMARK {
+        readCount = 0;
+        for (const QLowEnergyCharacteristic &characteristic : characteristics)
+            service->readCharacteristic(characteristic);
+        QVERIFY(waitFor([&]() { return readCount == CharacteristicCount; }));
+    }
+
+    m_bluetoothd->setReadLatency(0);
+}
+
+// Connects many controllers at once to devices that are not connected yet.
+// Neither fetching the object tree nor connecting blocks, so the controllers
+// wait for bluetoothd at the same time.
+void tst_bench_QLowEnergyControllerBluezDBus::connectMany()
+{
+    static constexpr int ControllerCount = 50;
+    static constexpr int ConnectLatency = 20;
+    m_bluetoothd->setObjects(objectTree(0, 0, ControllerCount - 1, false));
+    m_bluetoothd->setConnectLatency(ConnectLatency);
+
+    QList<QBluetoothAddress> addresses = { fakeRemoteAddress };
+    for (int i = 0; i < ControllerCount - 1; ++i)
+        addresses.append(otherAddress(i));
+
+    qint64 elapsed = 0;
+    QBENCHMARK {
+        // The connections are reported by signals only, the fetched tree
+        // still knows the devices as not connected
+        QtBluezObjectTree::instance()->clear();
+
+        QElapsedTimer timer;
+        timer.start();
+
+        std::vector<std::unique_ptr<QLowEnergyController>> controllers;
+        int connectedCount = 0;
+        for (const QBluetoothAddress &address : std::as_const(addresses)) {
+            controllers.emplace_back(QLowEnergyController::createCentral(
+                    QBluetoothDeviceInfo(address, u"fake"_s, 0)));
+            connect(controllers.back().get(), &QLowEnergyController::connected,
+                    this, [&connectedCount]() { ++connectedCount; });
+            controllers.back()->connectToDevice();
+        }
+        QVERIFY(waitFor([&]() { return connectedCount == ControllerCount; }));
+        elapsed = timer.elapsed();
+    }
+
+    // One after the other the connects take ControllerCount * ConnectLatency
+    QVERIFY2(elapsed < ControllerCount * ConnectLatency / 2,
+             qPrintable(u"%1 ms to connect %2 controllers"_s.arg(elapsed).arg(ControllerCount)));
+
+    m_bluetoothd->setConnectLatency(0);
+}
+
+QTEST_MAIN(tst_bench_QLowEnergyControllerBluezDBus)
+
+#include "tst_bench_qlowenergycontroller_bluezdbus.moc"
@@ -0,0 +1,317 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtBluetooth/QBluetoothDeviceInfo>
+#include <QtBluetooth/QLowEnergyCharacteristicData>
+#include <QtBluetooth/QLowEnergyController>
+#include <QtBluetooth/QLowEnergyDescriptorData>
+#include <QtBluetooth/QLowEnergyService>
+#include <QtBluetooth/QLowEnergyServiceData>
+#include <QtBluetooth/private/qlowenergycontroller_bluez_p.h>
+
+#include <functional>
+#include <memory>
+
+#include <sys/socket.h>
+
+using namespace Qt::StringLiterals;
+
+static constexpr quint16 ServiceUuid = 0xfff0;
+static constexpr quint16 ReadWriteCharUuid = 0xfff1;
+static constexpr quint16 NotifyCharUuid = 0xfff2;
+static constexpr int NotificationsPerIteration = 100;
+
+// A central and a peripheral QLowEnergyControllerPrivateBluez talking ATT
+// to each other over a socketpair instead of an L2CAP channel
+struct Loopback
+{
+    std::unique_ptr<QLowEnergyController> peripheral;
+    std::unique_ptr<QLowEnergyController> central;
+    std::unique_ptr<QLowEnergyService> localService;
+    std::unique_ptr<QLowEnergyService> remoteService;
+};
+
+class tst_bench_QLowEnergyControllerLoopback : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void connectAndDiscover_data();
+    void connectAndDiscover();
+    void readRoundTrip_data();
+    void readRoundTrip();
+    void writeRoundTrip_data();
+    void writeRoundTrip();
+    void notificationThroughput_data();
+    void notificationThroughput();
+
+private:
+    static void addMtuSizes();
+    static QLowEnergyServiceData serviceData(quint16 mtu);
+    static QLowEnergyControllerPrivateBluez *bluezPrivate(QLowEnergyController *controller);
+    static bool waitFor(const std::function<bool()> &condition);
+
+    void connectLoopback(Loopback &loopback, quint16 mtu);
+    void discoverRemoteService(Loopback &loopback);
+
+    QTimer m_wakeUp;
+};
+
+void tst_bench_QLowEnergyControllerLoopback::initTestCase()
+{
+    // Select the kernel ATT backend for both roles
+    qputenv("BLUETOOTH_FORCE_DBUS_LE_VERSION", "5.0");
+    qputenv("QT_BLUETOOTH_USE_KERNEL_PERIPHERAL", "1");
+
+    // Bounds the time waitFor() blocks in the event loop
+    m_wakeUp.setInterval(100);
+    m_wakeUp.start();
+}
+
+void tst_bench_QLowEnergyControllerLoopback::addMtuSizes()
+{
+    QTest::addColumn<quint16>("mtu");
+
+    QTest::newRow("mtu23") << quint16(23);
+    QTest::newRow("mtu185") << quint16(185);
+    QTest::newRow("mtu247") << quint16(247);
+    QTest::newRow("mtu512") << quint16(512);
+}
+
+QLowEnergyServiceData tst_bench_QLowEnergyControllerLoopback::serviceData(quint16 mtu)
+{
+    // A full read response (MTU - 1 value bytes) makes the central continue
+    // with blob reads, stay one byte below to measure a single round trip.
+    // A notification carries up to MTU - 3 value bytes.
+    QLowEnergyCharacteristicData readWrite;
+    readWrite.setUuid(QBluetoothUuid(ReadWriteCharUuid));
+    readWrite.setProperties(QLowEnergyCharacteristic::Read | QLowEnergyCharacteristic::Write);
+    readWrite.setValue(QByteArray(mtu - 2, 'r'));
+    readWrite.setValueLength(0, 512);
+
+    QLowEnergyCharacteristicData notify;
+    notify.setUuid(QBluetoothUuid(NotifyCharUuid));
+    notify.setProperties(QLowEnergyCharacteristic::Notify);
+    notify.setValue(QByteArray(mtu - 3, 'n'));
+    notify.setValueLength(0, 512);
+    notify.addDescriptor(QLowEnergyDescriptorData(
+            QBluetoothUuid::DescriptorType::ClientCharacteristicConfiguration, QByteArray(2, 0)));
+
+    QLowEnergyServiceData service;
+    service.setType(QLowEnergyServiceData::ServiceTypePrimary);
+    service.setUuid(QBluetoothUuid(ServiceUuid));
+    service.addCharacteristic(readWrite);
+    service.addCharacteristic(notify);
+    return service;
+}
+
+QLowEnergyControllerPrivateBluez *
+tst_bench_QLowEnergyControllerLoopback::bluezPrivate(QLowEnergyController *controller)
+{
+    return qobject_cast<QLowEnergyControllerPrivateBluez *>(
+            QLowEnergyControllerPrivate::get(controller));
+}
+
+// Unlike QTRY_VERIFY this does not sleep between checks, which would
+// dominate the measured round trips
+bool tst_bench_QLowEnergyControllerLoopback::waitFor(const std::function<bool()> &condition)
+{
+    QDeadlineTimer deadline(5000);
+    while (!condition()) {
+        if (deadline.hasExpired())
+            return false;
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+    return true;
+}
+
+void tst_bench_QLowEnergyControllerLoopback::connectLoopback(Loopback &loopback, quint16 mtu)
+{
+    loopback.peripheral.reset(QLowEnergyController::createPeripheral());
+    QLowEnergyControllerPrivateBluez *peripheral = bluezPrivate(loopback.peripheral.get());
+    QVERIFY2(peripheral, "Kernel ATT backend not available for the peripheral role");
+    loopback.localService.reset(loopback.peripheral->addService(serviceData(mtu)));
+    QVERIFY(loopback.localService);
+
+    const QBluetoothDeviceInfo remoteDevice(QBluetoothAddress(u"11:22:33:44:55:66"_s),
+                                            u"loopback"_s, 0);
+    loopback.central.reset(QLowEnergyController::createCentral(remoteDevice));
+    QLowEnergyControllerPrivateBluez *central = bluezPrivate(loopback.central.get());
+    QVERIFY2(central, "Kernel ATT backend not available for the central role");
+
+    int fds[2];
+    QCOMPARE(::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, fds), 0);
+    // the controllers' sockets take ownership of the descriptors
+    peripheral->connectToAttSocket(fds[0], mtu);
+    central->connectToAttSocket(fds[1], mtu);
+
+    QCOMPARE(loopback.peripheral->state(), QLowEnergyController::ConnectedState);
+    QCOMPARE(loopback.central->state(), QLowEnergyController::ConnectedState);
+    QVERIFY(waitFor([&]() { return loopback.central->mtu() == mtu; }));
+}
+
+void tst_bench_QLowEnergyControllerLoopback::discoverRemoteService(Loopback &loopback)
+{
+    loopback.central->discoverServices();
+    QVERIFY(waitFor([&]() {
+        return loopback.central->state() == QLowEnergyController::DiscoveredState;
+    }));
+
+    loopback.remoteService.reset(
+            loopback.central->createServiceObject(QBluetoothUuid(ServiceUuid)));
+    QVERIFY(loopback.remoteService);
+    loopback.remoteService->discoverDetails();
+    QVERIFY(waitFor([&]() {
+        return loopback.remoteService->state() == QLowEnergyService::RemoteServiceDiscovered;
+    }));
+}
+
+void tst_bench_QLowEnergyControllerLoopback::connectAndDiscover_data()
+{
+    addMtuSizes();
+}
+
+void tst_bench_QLowEnergyControllerLoopback::connectAndDiscover()
+{
+    QFETCH(quint16, mtu);
+
+    QBENCHMARK {
+        Loopback loopback;
+        connectLoopback(loopback, mtu);
+        if (QTest::currentTestFailed())
+            return;
+        discoverRemoteService(loopback);
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
+void tst_bench_QLowEnergyControllerLoopback::readRoundTrip_data()
+{
+    addMtuSizes();
+}
+
+void tst_bench_QLowEnergyControllerLoopback::readRoundTrip()
+{
+    QFETCH(quint16, mtu);
+
+    Loopback loopback;
+    connectLoopback(loopback, mtu);
+    if (QTest::currentTestFailed())
+        return;
+    discoverRemoteService(loopback);
+    if (QTest::currentTestFailed())
+        return;
+
+    const QLowEnergyCharacteristic characteristic =
+            loopback.remoteService->characteristic(QBluetoothUuid(ReadWriteCharUuid));
+    QVERIFY(characteristic.isValid());
+
+    int reads = 0;
+    connect(loopback.remoteService.get(), &QLowEnergyService::characteristicRead, this,
+            [&reads](const QLowEnergyCharacteristic &, const QByteArray &value) {
+                QVERIFY(!value.isEmpty());
+                ++reads;
+            });
+
+    QBENCHMARK {
+        const int expected = reads + 1;
+        loopback.remoteService->readCharacteristic(characteristic);
+        QVERIFY(waitFor([&]() { return reads == expected; }));
+    }
+    QCOMPARE(loopback.remoteService->error(), QLowEnergyService::NoError);
+}
+
+void tst_bench_QLowEnergyControllerLoopback::writeRoundTrip_data()
+{
+    addMtuSizes();
+}
+
+void tst_bench_QLowEnergyControllerLoopback::writeRoundTrip()
+{
+    QFETCH(quint16, mtu);
+
+    Loopback loopback;
+    connectLoopback(loopback, mtu);
+    if (QTest::currentTestFailed())
+        return;
+    discoverRemoteService(loopback);
+    if (QTest::currentTestFailed())
+        return;
+
+    const QLowEnergyCharacteristic characteristic =
+            loopback.remoteService->characteristic(QBluetoothUuid(ReadWriteCharUuid));
+    QVERIFY(characteristic.isValid());
+
+    int writes = 0;
+    connect(loopback.remoteService.get(), &QLowEnergyService::characteristicWritten, this,
+            [&writes]() { ++writes; });
+
+    // a single Write Request carries up to MTU - 3 value bytes
+    const QByteArray value(mtu - 3, 'w');
+    QBENCHMARK {
+        const int expected = writes + 1;
+        loopback.remoteService->writeCharacteristic(characteristic, value);
+        QVERIFY(waitFor([&]() { return writes == expected; }));
+    }
+    QCOMPARE(loopback.remoteService->error(), QLowEnergyService::NoError);
+}
+
+void tst_bench_QLowEnergyControllerLoopback::notificationThroughput_data()
+{
+    addMtuSizes();
+}
+
+void tst_bench_QLowEnergyControllerLoopback::notificationThroughput()
+{
+    // Time to deliver NotificationsPerIteration full-sized notifications
+    QFETCH(quint16, mtu);
+
+    Loopback loopback;
+    connectLoopback(loopback, mtu);
+    if (QTest::currentTestFailed())
+        return;
+    discoverRemoteService(loopback);
+    if (QTest::currentTestFailed())
+        return;
+
+    const QLowEnergyCharacteristic remoteCharacteristic =
+            loopback.remoteService->characteristic(QBluetoothUuid(NotifyCharUuid));
+    QVERIFY(remoteCharacteristic.isValid());
+    const QLowEnergyDescriptor cccd = remoteCharacteristic.clientCharacteristicConfiguration();
+    QVERIFY(cccd.isValid());
+
+    bool subscribed = false;
+    connect(loopback.remoteService.get(), &QLowEnergyService::descriptorWritten, this,
+            [&subscribed]() { subscribed = true; });
+    loopback.remoteService->writeDescriptor(cccd,
+                                            QLowEnergyCharacteristic::CCCDEnableNotification);
+    QVERIFY(waitFor([&]() { return subscribed; }));
+
+    qsizetype received = 0;
+    connect(loopback.remoteService.get(), &QLowEnergyService::characteristicChanged, this,
+            [&received, mtu](const QLowEnergyCharacteristic &, const QByteArray &value) {
+                QCOMPARE(value.size(), qsizetype(mtu - 3));
+                ++received;
+            });
+
+    const QLowEnergyCharacteristic localCharacteristic =
+            loopback.localService->characteristic(QBluetoothUuid(NotifyCharUuid));
+    QVERIFY(localCharacteristic.isValid());
+    const QByteArray values[] = { QByteArray(mtu - 3, 'a'), QByteArray(mtu - 3, 'b') };
+
+    QBENCHMARK {
+        const qsizetype expected = received + NotificationsPerIteration;
+        for (int i = 0; i < NotificationsPerIteration; ++i)
+            loopback.localService->writeCharacteristic(localCharacteristic, values[i % 2]);
+        QVERIFY(waitFor([&]() { return received == expected; }));
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_bench_QLowEnergyControllerLoopback)
+
+#include "tst_bench_qlowenergycontroller_loopback.moc"
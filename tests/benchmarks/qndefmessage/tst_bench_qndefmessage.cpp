@@ -0,0 +1,186 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtNfc/qndefmessage.h>
+#include <QtNfc/qndefrecord.h>
+#include <QtNfc/private/qndefmessageview_p.h>
+#include <QtNfc/private/qndefmessagewriter_p.h>
+
+class tst_bench_QNdefMessage : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data();
+    void parse();
+    void serialize_data();
+    void serialize();
+    void incrementalParse_data();
+    void incrementalParse();
+
+private:
+    enum Mode { Copy, View };
+};
+
+static QNdefMessage createMessage(int recordCount, int payloadSize)
+{
+    QNdefMessage message;
+    for (int i = 0; i < recordCount; ++i) {
+        QNdefRecord record;
+        record.setTypeNameFormat(QNdefRecord::Mime);
+        record.setType("application/octet-stream");
+        record.setId("record" + QByteArray::number(i));
+        record.setPayload(QByteArray(payloadSize, char(i)));
+        message.append(record);
+    }
+    return message;
+}
+
+static QByteArray encodedMessage(int recordCount, int payloadSize)
+{
+    return createMessage(recordCount, payloadSize).toByteArray();
+}
+
+void tst_bench_QNdefMessage::parse_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<int>("recordCount");
+    QTest::addColumn<int>("payloadSize");
+
+    const struct
+    {
+        const char *name;
+        Mode mode;
+    } modes[] = { { "copy", Copy }, { "view", View } };
+
+    const struct
+    {
+        int recordCount;
+        int payloadSize;
+    } shapes[] = { { 1, 32 }, { 16, 32 }, { 16, 4096 }, { 256, 1024 }, { 4, 1 << 20 } };
+
+    for (const auto &shape : shapes) {
+        for (const auto &mode : modes) {
+            QTest::addRow("%s-%dx%d", mode.name, shape.recordCount, shape.payloadSize)
+                    << int(mode.mode) << shape.recordCount << shape.payloadSize;
+        }
+    }
+}
+
+// fromByteArray() copies each field of each record, the view does not create
+// records at all
+void tst_bench_QNdefMessage::parse()
+{
+    QFETCH(int, mode);
+    QFETCH(int, recordCount);
+    QFETCH(int, payloadSize);
+
+    const QByteArray buffer = encodedMessage(recordCount, payloadSize);
+
+    qsizetype total = 0;
+    switch (mode) {
+    case Copy:
+        QBENCHMARK {
+            const QNdefMessage message = QNdefMessage::fromByteArray(buffer);
+            total = message.size();
+        }
+        break;
+    case View:
+        QBENCHMARK {
+            total = 0;
+            for (const auto &record : QNdefMessageView(buffer)) {
+                Q_UNUSED(record);
+                ++total;
+            }
+        }
+        break;
+    }
+
+    QCOMPARE(total, recordCount);
+}
+
+void tst_bench_QNdefMessage::serialize_data()
+{
+    QTest::addColumn<int>("recordCount");
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<int>("chunkSize");
+    QTest::addColumn<bool>("device");
+
+    QTest::newRow("16x32") << 16 << 32 << 0 << false;
+    QTest::newRow("256x1024") << 256 << 1024 << 0 << false;
+    QTest::newRow("4x1M") << 4 << (1 << 20) << 0 << false;
+    QTest::newRow("4x1M-chunked") << 4 << (1 << 20) << 4096 << false;
+    QTest::newRow("4x1M-device") << 4 << (1 << 20) << 0 << true;
+    QTest::newRow("4x1M-chunked-device") << 4 << (1 << 20) << 4096 << true;
+}
+
+void tst_bench_QNdefMessage::serialize()
+{
+    QFETCH(int, recordCount);
+    QFETCH(int, payloadSize);
+    QFETCH(int, chunkSize);
+    QFETCH(bool, device);
+
+    QNdefMessageWriter writer(createMessage(recordCount, payloadSize));
+    writer.setChunkSize(chunkSize);
+
+    QByteArray data;
+    data.reserve(writer.encodedSize());
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    qsizetype size = 0;
+    if (device) {
+        QBENCHMARK {
+            buffer.seek(0);
+            QVERIFY(writer.write(&buffer));
+            size = buffer.pos();
+        }
+    } else {
+        QBENCHMARK {
+            size = writer.toByteArray().size();
+        }
+    }
+
+    QCOMPARE(size, writer.encodedSize());
+}
+
+void tst_bench_QNdefMessage::incrementalParse_data()
+{
+    QTest::addColumn<int>("recordCount");
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<int>("pieceSize");
+
+    // Pieces the size of typical Type 2 and Type 4 reads
+    QTest::newRow("16x32-16") << 16 << 32 << 16;
+    QTest::newRow("16x4096-16") << 16 << 4096 << 16;
+    QTest::newRow("16x4096-253") << 16 << 4096 << 253;
+    QTest::newRow("4x1M-65533") << 4 << (1 << 20) << 65533;
+}
+
+void tst_bench_QNdefMessage::incrementalParse()
+{
+    QFETCH(int, recordCount);
+    QFETCH(int, payloadSize);
+    QFETCH(int, pieceSize);
+
+    const QByteArray data = encodedMessage(recordCount, payloadSize);
+
+    qsizetype total = 0;
+    QBENCHMARK {
+        QNdefMessageReader reader;
+        for (qsizetype pos = 0; pos < data.size(); pos += pieceSize) {
+            const qsizetype size = qMin<qsizetype>(pieceSize, data.size() - pos);
+            reader.addData(QByteArrayView(data).sliced(pos, size));
+        }
+        total = reader.takeMessage().size();
+    }
+
+    QCOMPARE(total, recordCount);
+}
+
+QTEST_MAIN(tst_bench_QNdefMessage)
+
+#include "tst_bench_qndefmessage.moc"
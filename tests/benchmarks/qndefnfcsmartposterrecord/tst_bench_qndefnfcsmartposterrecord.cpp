@@ -0,0 +1,105 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtNfc/qndefmessage.h>
+#include <QtNfc/qndefnfcsmartposterrecord.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_bench_QNdefNfcSmartPosterRecord : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void build_data();
+    void build();
+    void modify_data();
+    void modify();
+};
+
+static QNdefNfcTextRecord title(int index)
+{
+    QNdefNfcTextRecord record;
+    record.setLocale(u"x-%1"_s.arg(index));
+    record.setEncoding(QNdefNfcTextRecord::Utf8);
+    record.setText(u"Localized title number %1"_s.arg(index));
+    return record;
+}
+
+static void addData()
+{
+    QTest::addColumn<int>("titleCount");
+    QTest::addColumn<int>("iconSize");
+
+    QTest::newRow("8 titles") << 8 << 0;
+    QTest::newRow("64 titles") << 64 << 0;
+    QTest::newRow("512 titles") << 512 << 0;
+    QTest::newRow("64 titles, 64k icon") << 64 << 64 * 1024;
+}
+
+void tst_bench_QNdefNfcSmartPosterRecord::build_data()
+{
+    addData();
+}
+
+// Builds a poster title by title and serializes it once
+void tst_bench_QNdefNfcSmartPosterRecord::build()
+{
+    QFETCH(int, titleCount);
+    QFETCH(int, iconSize);
+
+    QList<QNdefNfcTextRecord> titles;
+    for (int i = 0; i < titleCount; ++i)
+        titles.append(title(i));
+
+    qsizetype size = 0;
+    QBENCHMARK {
+        QNdefNfcSmartPosterRecord record;
+        record.setUri(QUrl(u"https://www.qt.io"_s));
+        if (iconSize > 0)
+            record.addIcon("image/png", QByteArray(iconSize, 'i'));
+        for (const QNdefNfcTextRecord &text : std::as_const(titles))
+            record.addTitle(text);
+        record.setAction(QNdefNfcSmartPosterRecord::DoAction);
+        size = QNdefMessage(record).toByteArray().size();
+    }
+
+    QVERIFY(size > titleCount * 25 + iconSize);
+}
+
+void tst_bench_QNdefNfcSmartPosterRecord::modify_data()
+{
+    addData();
+}
+
+// Changes one title of a shared poster and serializes the result
+void tst_bench_QNdefNfcSmartPosterRecord::modify()
+{
+    QFETCH(int, titleCount);
+    QFETCH(int, iconSize);
+
+    QNdefNfcSmartPosterRecord poster;
+    poster.setUri(QUrl(u"https://www.qt.io"_s));
+    if (iconSize > 0)
+        poster.addIcon("image/png", QByteArray(iconSize, 'i'));
+    for (int i = 0; i < titleCount; ++i)
+        poster.addTitle(title(i));
+
+    const QNdefNfcTextRecord replacement = title(titleCount);
+    qsizetype size = 0;
+    QBENCHMARK {
+        QNdefNfcSmartPosterRecord record = poster;
+        record.removeTitle(title(0).locale());
+        record.addTitle(replacement);
+        size = record.payload().size();
+    }
+
+    // The replacement title is at least as long as the removed one
+    QVERIFY(size >= poster.payload().size());
+}
+
+QTEST_MAIN(tst_bench_QNdefNfcSmartPosterRecord)
+
+#include "tst_bench_qndefnfcsmartposterrecord.moc"
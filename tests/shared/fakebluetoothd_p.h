@@ -0,0 +1,447 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef FAKEBLUETOOTHD_P_H
+#define FAKEBLUETOOTHD_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtBluetooth/QBluetoothAddress>
+#include <QtBluetooth/QBluetoothUuid>
+#include <QtBluetooth/private/bluez5_helper_p.h>
+
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QProcess>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusMetaType>
+#include <QtDBus/QDBusPendingCall>
+#include <QtDBus/QDBusUnixFileDescriptor>
+#include <QtDBus/QDBusVirtualObject>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+// Plays the part of bluetoothd: serves GetManagedObjects() and property reads
+// from an object tree the test sets up, and sends the signals bluetoothd
+// sends when the tree changes. It lives in its own thread with its own bus
+// connection, the code under test blocks the main thread while waiting for
+// it. Value reads, value writes and connects are answered after a delay,
+// like a remote device would.
+class FakeBluetoothd : public QDBusVirtualObject
+{
+public:
+    static QString connectionName() { return u"fakebluetoothd"_s; }
+
+    void setObjects(const ManagedObjectList &objects)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_objects = objects;
+    }
+
+    void setReadLatency(int milliseconds)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_readLatency = milliseconds;
+    }
+
+    void setWriteLatency(int milliseconds)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_writeLatency = milliseconds;
+    }
+
+    void setConnectLatency(int milliseconds)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_connectLatency = milliseconds;
+    }
+
+    // The ReadValue() and WriteValue() calls received so far, as
+    // "<member> <path> <hex value>"
+    QStringList valueCalls() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_valueCalls;
+    }
+
+    // The most ReadValue() and WriteValue() calls that were answered later
+    // at the same time, in total and on one characteristic and its descriptors
+    int peakRunningCalls() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_peakRunningCalls;
+    }
+
+    int peakRunningCallsPerCharacteristic() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_peakRunningCallsPerCharacteristic;
+    }
+
+    void resetValueCalls()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_valueCalls.clear();
+        m_peakRunningCalls = 0;
+        m_peakRunningCallsPerCharacteristic = 0;
+    }
+
+    // The arguments of the calls received so far which got an empty reply,
+    // like RegisterProfile(), in order
+    QList<QVariantList> calls(const QString &member) const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_calls.value(member);
+    }
+
+    void resetCalls()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_calls.clear();
+    }
+
+    // Hands a connection of the device at devicePath to the profile exported
+    // by the bus client service at profilePath
+    void newConnection(const QString &service, const QString &profilePath,
+                       const QString &devicePath, const QDBusUnixFileDescriptor &fd)
+    {
+        QDBusMessage call = QDBusMessage::createMethodCall(
+                service, profilePath, u"org.bluez.Profile1"_s, u"NewConnection"_s);
+        call << QVariant::fromValue(QDBusObjectPath(devicePath)) << QVariant::fromValue(fd)
+             << QVariantMap();
+        QDBusConnection(connectionName()).send(call);
+    }
+
+    // Calls a method of an object exported by the bus client service, the way
+    // bluetoothd calls the GATT objects of a peripheral application
+    QDBusPendingCall callObject(const QString &service, const QString &path,
+                                const QString &interface, const QString &method,
+                                const QVariantList &arguments = {})
+    {
+        QDBusMessage call = QDBusMessage::createMethodCall(service, path, interface, method);
+        call.setArguments(arguments);
+        return QDBusConnection(connectionName()).asyncCall(call);
+    }
+
+    // Sends a notification of a new characteristic value
+    void notify(const QString &characteristicPath, const QByteArray &value)
+    {
+        changeProperties(characteristicPath, u"org.bluez.GattCharacteristic1"_s,
+                         {{ u"Value"_s, value }});
+    }
+
+    void changeProperties(const QString &path, const QString &interface,
+                          const QVariantMap &changedProperties)
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            QVariantMap &properties = m_objects[QDBusObjectPath(path)][interface];
+            for (auto it = changedProperties.cbegin(); it != changedProperties.cend(); ++it)
+                properties.insert(it.key(), it.value());
+        }
+
+        QDBusMessage signal = QDBusMessage::createSignal(
+                path, u"org.freedesktop.DBus.Properties"_s, u"PropertiesChanged"_s);
+        signal << interface << changedProperties << QStringList();
+        QDBusConnection(connectionName()).send(signal);
+    }
+
+    void addInterfaces(const QString &path, const InterfaceList &interfaces)
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_objects[QDBusObjectPath(path)].insert(interfaces);
+        }
+
+        QDBusMessage signal = QDBusMessage::createSignal(
+                u"/"_s, u"org.freedesktop.DBus.ObjectManager"_s, u"InterfacesAdded"_s);
+        signal << QVariant::fromValue(QDBusObjectPath(path)) << QVariant::fromValue(interfaces);
+        QDBusConnection(connectionName()).send(signal);
+    }
+
+    void removeInterfaces(const QString &path, const QStringList &interfaces)
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            const auto it = m_objects.find(QDBusObjectPath(path));
+            if (it != m_objects.end()) {
+                for (const QString &interface : interfaces)
+                    it->remove(interface);
+                if (it->isEmpty())
+                    m_objects.erase(it);
+            }
+        }
+
+        QDBusMessage signal = QDBusMessage::createSignal(
+                u"/"_s, u"org.freedesktop.DBus.ObjectManager"_s, u"InterfacesRemoved"_s);
+        signal << QVariant::fromValue(QDBusObjectPath(path)) << interfaces;
+        QDBusConnection(connectionName()).send(signal);
+    }
+
+    QString introspect(const QString &) const override { return {}; }
+
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override
+    {
+        QMutexLocker locker(&m_mutex);
+        const QList<QVariant> arguments = message.arguments();
+        QDBusMessage reply;
+        if (message.member() == "GetManagedObjects"_L1) {
+            reply = message.createReply(QVariant::fromValue(m_objects));
+        } else if (message.member() == "ReadValue"_L1) {
+            // The replies of concurrent reads overlap their delays
+            reply = message.createReply(QVariant::fromValue(QByteArray("value")));
+            replyLater(message, reply, m_readLatency, QByteArray());
+            return true;
+        } else if (message.member() == "WriteValue"_L1 && !arguments.isEmpty()) {
+            reply = message.createReply();
+            replyLater(message, reply, m_writeLatency, arguments.at(0).toByteArray());
+            return true;
+        } else if (message.member() == "Connect"_L1
+                   && message.interface() == "org.bluez.Device1"_L1) {
+            // bluetoothd reports the resolved services before it answers
+            QDBusMessage changed = QDBusMessage::createSignal(
+                    message.path(), u"org.freedesktop.DBus.Properties"_s, u"PropertiesChanged"_s);
+            changed << u"org.bluez.Device1"_s
+                    << QVariantMap{{ u"Connected"_s, true }, { u"ServicesResolved"_s, true }}
+                    << QStringList();
+            reply = message.createReply();
+            QTimer::singleShot(m_connectLatency, this, [connection, changed, reply]() {
+                connection.send(changed);
+                connection.send(reply);
+            });
+            return true;
+        } else if (message.member() == "GetAll"_L1 && arguments.size() == 1) {
+            reply = message.createReply(properties(message.path(), arguments.at(0).toString()));
+        } else if (message.member() == "Get"_L1 && arguments.size() == 2) {
+            const QVariant value = properties(message.path(), arguments.at(0).toString())
+                                           .value(arguments.at(1).toString());
+            if (value.isValid()) {
+                reply = message.createReply(QVariant::fromValue(QDBusVariant(value)));
+            } else {
+                reply = message.createErrorReply(QDBusError::InvalidArgs,
+                                                 u"No such property"_s);
+            }
+        } else {
+            // StartNotify(), StartDiscovery() and the like succeed without
+            // doing anything
+            m_calls[message.member()].append(arguments);
+            reply = message.createReply();
+        }
+        connection.send(reply);
+        return true;
+    }
+
+private:
+    QVariantMap properties(const QString &path, const QString &interface) const
+    {
+        return m_objects.value(QDBusObjectPath(path)).value(interface);
+    }
+
+    // The descriptors are below their characteristic
+    static QString characteristicPath(const QString &path)
+    {
+        const qsizetype index = path.lastIndexOf(u'/');
+        return QStringView(path).sliced(index + 1).startsWith("desc"_L1)
+                ? path.left(index) : path;
+    }
+
+    // Called with m_mutex locked
+    void replyLater(const QDBusMessage &message, const QDBusMessage &reply, int latency,
+                    const QByteArray &value)
+    {
+        m_valueCalls.append(message.member() + u' ' + message.path() + u' '
+                            + QString::fromLatin1(value.toHex()));
+
+        const QString path = characteristicPath(message.path());
+        const int running = ++m_runningCalls;
+        const int runningPerCharacteristic = ++m_runningCallsPerCharacteristic[path];
+        m_peakRunningCalls = qMax(m_peakRunningCalls, running);
+        m_peakRunningCallsPerCharacteristic =
+                qMax(m_peakRunningCallsPerCharacteristic, runningPerCharacteristic);
+
+        const QDBusConnection connection(connectionName());
+        QTimer::singleShot(latency, this, [this, connection, reply, path]() {
+            {
+                QMutexLocker locker(&m_mutex);
+                --m_runningCalls;
+                --m_runningCallsPerCharacteristic[path];
+            }
+            connection.send(reply);
+        });
+    }
+
+    mutable QMutex m_mutex;
+    ManagedObjectList m_objects;
+    int m_readLatency = 0;
+    int m_writeLatency = 0;
+    int m_connectLatency = 0;
+
+    QStringList m_valueCalls;
+    QHash<QString, QList<QVariantList>> m_calls;
+    int m_runningCalls = 0;
+    int m_peakRunningCalls = 0;
+    QHash<QString, int> m_runningCallsPerCharacteristic;
+    int m_peakRunningCallsPerCharacteristic = 0;
+};
+
+// Runs a private bus in place of the system bus, with a FakeBluetoothd
+// registered as org.bluez
+class FakeSystemBus
+{
+public:
+    ~FakeSystemBus() { stop(); }
+
+    static bool isSupported()
+    {
+        return !QStandardPaths::findExecutable(u"dbus-daemon"_s).isEmpty();
+    }
+
+    bool start()
+    {
+        m_dbusDaemon.start(QStandardPaths::findExecutable(u"dbus-daemon"_s),
+                           { u"--session"_s, u"--nofork"_s, u"--print-address"_s });
+        if (!m_dbusDaemon.waitForStarted() || !m_dbusDaemon.waitForReadyRead())
+            return false;
+        const QByteArray address = m_dbusDaemon.readLine().trimmed();
+        if (address.isEmpty())
+            return false;
+
+        // The D-Bus backend is used for the central role
+        qputenv("DBUS_SYSTEM_BUS_ADDRESS", address);
+        qputenv("BLUETOOTH_FORCE_DBUS_LE_VERSION", "5.48");
+
+        qDBusRegisterMetaType<InterfaceList>();
+        qDBusRegisterMetaType<ManagedObjectList>();
+
+        m_bluetoothd = new FakeBluetoothd;
+        m_bluetoothd->moveToThread(&m_bluetoothdThread);
+        m_bluetoothdThread.start();
+
+        QDBusConnection bus = QDBusConnection::connectToBus(QString::fromLatin1(address),
+                                                            FakeBluetoothd::connectionName());
+        return bus.isConnected()
+                && bus.registerVirtualObject(u"/"_s, m_bluetoothd, QDBusConnection::SubPath)
+                && bus.registerService(u"org.bluez"_s);
+    }
+
+    void stop()
+    {
+        if (m_bluetoothd) {
+            QDBusConnection::disconnectFromBus(FakeBluetoothd::connectionName());
+            m_bluetoothdThread.quit();
+            m_bluetoothdThread.wait();
+            delete m_bluetoothd;
+            m_bluetoothd = nullptr;
+        }
+        if (m_dbusDaemon.state() != QProcess::NotRunning) {
+            m_dbusDaemon.terminate();
+            m_dbusDaemon.waitForFinished();
+        }
+    }
+
+    FakeBluetoothd *bluetoothd() const { return m_bluetoothd; }
+
+private:
+    QProcess m_dbusDaemon;
+    QThread m_bluetoothdThread;
+    FakeBluetoothd *m_bluetoothd = nullptr;
+};
+
+static const QString fakeAdapterPath = u"/org/bluez/hci0"_s;
+static const QBluetoothAddress fakeRemoteAddress(u"11:22:33:44:55:66"_s);
+
+inline QString fakeUuid(int value)
+{
+    return QBluetoothUuid(quint16(0xa000 + value)).toString(QUuid::WithoutBraces);
+}
+
+// An adapter without devices
+inline ManagedObjectList fakeAdapterTree()
+{
+    ManagedObjectList objects;
+    objects.insert(QDBusObjectPath(u"/org/bluez"_s), {{ u"org.bluez.AgentManager1"_s, {} }});
+    objects.insert(QDBusObjectPath(fakeAdapterPath),
+                   {{ u"org.bluez.Adapter1"_s,
+                      {{ u"Address"_s, u"AA:BB:CC:DD:EE:FF"_s }, { u"Powered"_s, true }} }});
+    return objects;
+}
+
+inline QVariantMap fakeDeviceProperties(const QBluetoothAddress &address, bool connected)
+{
+    return {{ u"Address"_s, address.toString() },
+            { u"Alias"_s, address.toString() },
+            { u"Adapter"_s, QVariant::fromValue(QDBusObjectPath(fakeAdapterPath)) },
+            { u"Connected"_s, connected },
+            { u"ServicesResolved"_s, connected }};
+}
+
+// Adds a device exporting serviceCount services with characteristicsPerService
+// readable and notifying characteristics. The first descriptor of every
+// characteristic is its ClientCharacteristicConfiguration.
+inline void addFakeDevice(ManagedObjectList &objects, const QBluetoothAddress &address,
+                          int serviceCount, int characteristicsPerService,
+                          int descriptorsPerCharacteristic, bool connected = true)
+{
+    const QString devicePath = devicePathForAddress(fakeAdapterPath, address);
+    objects.insert(QDBusObjectPath(devicePath),
+                   {{ u"org.bluez.Device1"_s, fakeDeviceProperties(address, connected) }});
+
+    int handle = 1;
+    for (int s = 0; s < serviceCount; ++s) {
+        const QString servicePath = devicePath + u"/service%1"_s.arg(handle++, 4, 16, '0'_L1);
+        objects.insert(QDBusObjectPath(servicePath),
+                       {{ u"org.bluez.GattService1"_s,
+                          {{ u"UUID"_s, fakeUuid(s) }, { u"Primary"_s, true }} }});
+        for (int c = 0; c < characteristicsPerService; ++c) {
+            const QString charPath = servicePath + u"/char%1"_s.arg(handle++, 4, 16, '0'_L1);
+            objects.insert(QDBusObjectPath(charPath),
+                           {{ u"org.bluez.GattCharacteristic1"_s,
+                              {{ u"UUID"_s, fakeUuid(0x100 + c) },
+                               { u"Flags"_s,
+                                 QStringList{ u"read"_s, u"write"_s, u"notify"_s } }} }});
+            for (int d = 0; d < descriptorsPerCharacteristic; ++d) {
+                const QString descPath = charPath + u"/desc%1"_s.arg(handle++, 4, 16, '0'_L1);
+                const QBluetoothUuid descUuid = d == 0
+                        ? QBluetoothUuid(QBluetoothUuid::DescriptorType::
+                                                 ClientCharacteristicConfiguration)
+                        : QBluetoothUuid(quint16(0xa200 + d));
+                objects.insert(QDBusObjectPath(descPath),
+                               {{ u"org.bluez.GattDescriptor1"_s,
+                                  {{ u"UUID"_s, descUuid.toString(QUuid::WithoutBraces) }} }});
+            }
+        }
+    }
+}
+
+inline bool waitFor(const std::function<bool()> &condition, int timeout = 5000)
+{
+    QDeadlineTimer deadline(timeout);
+    while (!condition()) {
+        if (deadline.hasExpired())
+            return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
+
+#endif // FAKEBLUETOOTHD_P_H